@@ -0,0 +1,244 @@
+/*
+ * Autobaud Detector
+ *
+ * Measures the bit time of a sync character (0x55, 'U') on the
+ * synchronized RX line and produces the BAUD_DIV / BAUD_FRAC pair for
+ * the current oversampling, so the host's rate is found from a single
+ * character instead of probing divisors.
+ *
+ * Features:
+ * - 0x55 in 8N1 has a falling edge every second bit (start, D1, D3, D5,
+ *   D7): the first and fifth edge are 8 bit times apart, measured in
+ *   uart_clk cycles
+ * - Result with fraction: divisor + frac/64 = cycles / (8 × OSR), a
+ *   shift for 16× / 8× / 4× (no divider)
+ * - The first edge pair must be half low, half high and each later pair
+ *   as long as the first (within 1/4), so noise, glitches or another
+ *   character restart the measurement at the next plausible start edge
+ *   instead of locking
+ * - Lock at the stop bit: the line is high again when the result is
+ *   loaded, so uart_rx never sees the tail of the sync character
+ *
+ * Usage:
+ *   autobaud autobaud_inst (
+ *       .uart_clk   (uart_clk),
+ *       .rst_n      (rst_n),
+ *       .enable     (ctrl_autobaud),  // Hunt while 1
+ *       .osr_sel    (osr_sel),        // 16× / 8× / 4× oversampling
+ *       .rx_sync    (rx_line),        // After bit_sync
+ *       .busy       (hold_rx),        // Keep uart_rx on an idle line
+ *       .done       (load_divisor),   // 1-cycle pulse with the result
+ *       .divisor    (new_div),
+ *       .frac       (new_frac)
+ *   );
+ *
+ * IMPORTANT:
+ * - rx_sync must already be synchronized (uart_rx_path.rx_line)
+ * - The far end must send 0x55 as the first character after enable,
+ *   after at least 2 idle bit times; other traffic is rejected, but a
+ *   0x55 that directly follows it may be missed (or, rarely, mimicked)
+ * - enable must drop after done (uart_regs clears CTRL.AUTOBAUD); the
+ *   detector holds its result until then
+ * - Rates giving a divisor of 0 or above 0xFFFF are rejected
+ *
+ * References:
+ * - INTERFACE_SPECIFICATIONS.md - Module 12: autobaud
+ */
+
+module autobaud (
+    // Clock and reset
+    input  logic        uart_clk,
+    input  logic        rst_n,
+
+    // Control
+    input  logic        enable,        // Search for a sync character
+    input  logic [1:0]  osr_sel,       // Ticks per bit: 00=16, 01=8, 10=4
+
+    // Serial input (synchronized!)
+    input  logic        rx_sync,
+
+    // Result
+    output logic        busy,          // Searching or measuring
+    output logic        done,          // divisor/frac valid (1 cycle)
+    output logic [15:0] divisor,
+    output logic [5:0]  frac           // 1/64 steps
+);
+
+    // 8 bit times at 16× with divisor 0xFFFF+63/64 fit, plus a bit of margin
+    localparam int COUNT_WIDTH = 24;
+
+    typedef enum logic [2:0] {
+        OFF     = 3'b000,
+        ARM     = 3'b001,   // Wait for an idle (high) line
+        HUNT    = 3'b010,   // Wait for the start bit
+        MEASURE = 3'b011,   // Count the next four falling edges
+        STOP    = 3'b100,   // Wait for the stop bit
+        LOCKED  = 3'b101    // Result loaded, until enable drops
+    } state_t;
+
+    state_t state;
+
+    logic [COUNT_WIDTH-1:0] count;      // Cycles since the start bit edge
+    logic [COUNT_WIDTH-1:0] last_fall;  // count at the previous falling edge
+    logic [COUNT_WIDTH-1:0] last_rise;  // count at the rising edge after it
+    logic [COUNT_WIDTH-1:0] first_iv;   // Start + D0: 2 bit times
+    logic [COUNT_WIDTH-1:0] interval;   // Since the previous falling edge
+    logic [COUNT_WIDTH-1:0] pair_low;   // Low part of interval
+    logic [COUNT_WIDTH-1:0] pair_dev;   // |high - low| of interval
+    logic [COUNT_WIDTH-1:0] dev;        // |interval - first_iv|
+    logic [1:0]             falls;      // Edges accepted after the start bit
+    logic                   rose;       // Rising edge since the previous fall
+    logic                   rx_prev;
+    logic                   fall;
+    logic                   pair_ok;
+    logic                   match_ok;
+    logic                   stalled;
+
+    // Candidate result from count (= 8 bit times) at the fifth edge:
+    // (divisor.frac) × 64 = count × 64 / (8 × OSR)
+    logic [COUNT_WIDTH:0]   scaled;
+    logic                   scaled_ok;
+
+    assign fall     = rx_prev && !rx_sync;
+    assign interval = count - last_fall;
+    assign pair_low = last_rise - last_fall;
+
+    // A start bit and D0 pair: low and high equal within 1/4
+    assign pair_dev = (interval > {pair_low[COUNT_WIDTH-2:0], 1'b0}) ?
+                          interval - {pair_low[COUNT_WIDTH-2:0], 1'b0} :
+                          {pair_low[COUNT_WIDTH-2:0], 1'b0} - interval;
+    assign pair_ok  = rose && (pair_dev <= (pair_low >> 2));
+
+    // Later pairs: as long as the first, within 1/4
+    assign dev      = (interval > first_iv) ? interval - first_iv : first_iv - interval;
+    assign match_ok = (dev <= (first_iv >> 2));
+
+    // No edge where the next one was due: give up on this candidate
+    assign stalled = (count == '1) ||
+                     ((falls == 2'd0) ? (rose && ({1'b0, interval} > {pair_low, 1'b0} + {1'b0, pair_low}))
+                                      : ({1'b0, interval} > {first_iv, 1'b0}));
+
+    always_comb begin
+        case (osr_sel)
+            2'b01:   scaled = {1'b0, count};                  // 8×: count
+            2'b10:   scaled = {count, 1'b0};                  // 4×: count × 2
+            default: scaled = ({1'b0, count} + 1'b1) >> 1;    // 16×: count / 2, rounded
+        endcase
+    end
+
+    assign scaled_ok = (scaled[COUNT_WIDTH:22] == '0) && (scaled[21:6] != 16'h0000);
+
+    always_ff @(posedge uart_clk or negedge rst_n) begin
+        if (!rst_n) begin
+            state     <= OFF;
+            count     <= '0;
+            last_fall <= '0;
+            last_rise <= '0;
+            first_iv  <= '0;
+            falls     <= 2'd0;
+            rose      <= 1'b0;
+            rx_prev   <= 1'b1;
+            done      <= 1'b0;
+            divisor   <= 16'h0000;
+            frac      <= 6'h00;
+        end else begin
+            rx_prev <= rx_sync;
+            done    <= 1'b0;
+
+            if (!enable) begin
+                state <= OFF;
+            end else begin
+                case (state)
+                    OFF: state <= ARM;
+
+                    ARM: if (rx_sync) state <= HUNT;
+
+                    HUNT: begin
+                        if (!rx_sync) begin
+                            // Start bit edge: cycle 0 of the measurement
+                            state     <= MEASURE;
+                            count     <= COUNT_WIDTH'(1);
+                            last_fall <= '0;
+                            falls     <= 2'd0;
+                            rose      <= 1'b0;
+                        end
+                    end
+
+                    MEASURE: begin
+                        count <= count + 1'b1;
+                        if (rx_sync && !rx_prev) begin
+                            rose      <= 1'b1;
+                            last_rise <= count;
+                        end
+
+                        if (fall) begin
+                            rose <= 1'b0;
+                            if (((falls == 2'd0) ? pair_ok : match_ok) &&
+                                (falls != 2'd3 || scaled_ok)) begin
+                                if (falls == 2'd0) first_iv <= interval;
+                                last_fall <= count;
+                                falls     <= falls + 1'b1;
+                                if (falls == 2'd3) begin
+                                    // Fifth edge (D7): 8 bit times counted
+                                    state   <= STOP;
+                                    divisor <= scaled[21:6];
+                                    frac    <= scaled[5:0];
+                                end
+                            end else if (pair_ok) begin
+                                // Previous edge may be the real start bit,
+                                // this one its D1: measure from there
+                                count     <= interval + 1'b1;
+                                last_fall <= interval;
+                                first_iv  <= interval;
+                                falls     <= 2'd1;
+                            end else begin
+                                // Or this edge is: measure from here
+                                count     <= COUNT_WIDTH'(1);
+                                last_fall <= '0;
+                                falls     <= 2'd0;
+                            end
+                        end else if (stalled) begin
+                            state <= ARM;
+                        end
+                    end
+
+                    STOP: begin
+                        count <= count + 1'b1;
+                        if (rx_sync) begin
+                            state <= LOCKED;
+                            done  <= 1'b1;
+                        end else if (interval > first_iv) begin
+                            state <= ARM;            // No stop bit after D7
+                        end
+                    end
+
+                    LOCKED: ;                        // Until enable drops
+
+                    default: state <= OFF;
+                endcase
+            end
+        end
+    end
+
+    assign busy = (state == ARM) || (state == HUNT) || (state == MEASURE) || (state == STOP);
+
+    // Assertions for verification
+`ifdef SIMULATION
+    always @(posedge uart_clk) begin
+        if (rst_n) begin
+            // A result is only reported with a usable divisor
+            if (done) begin
+                assert (divisor != 16'h0000)
+                    else $error("autobaud: Locked with divisor 0");
+            end
+
+            // The measurement never wraps
+            if (state == MEASURE || state == STOP) begin
+                assert (count >= last_fall)
+                    else $error("autobaud: Edge counter wrapped");
+            end
+        end
+    end
+`endif
+
+endmodule
@@ -11,11 +11,26 @@
  * - SLVERR response for register errors
  * - Write and read paths are independent
  * - Byte enable support (wstrb) passed through to register file
+ * - Write response held off while the register file reports reg_busy
+ *   (e.g. a packed TX_DATA write still unpacking into the TX FIFO)
+ * - Optional pipelined mode (PIPELINED=1): one access per cycle
  *
- * Protocol:
+ * Protocol (PIPELINED=0, default):
  * - Write: awvalid+wvalid → awready+wready → reg_wen pulse → bvalid
+ *   (bvalid waits for !reg_busy)
  * - Read: arvalid → arready → reg_ren pulse → capture rdata → rvalid
  *
+ * Protocol (PIPELINED=1):
+ * - awready/wready/arready are combinational: a request is accepted in the
+ *   same cycle it is presented, provided the response slot is empty or its
+ *   B/R handshake completes in that cycle
+ * - reg_wen/reg_ren are asserted on the accept cycle itself; bvalid/rvalid
+ *   follow on the next edge, so back-to-back accesses sustain one per cycle
+ * - A write accepted while reg_busy holds bvalid, and further writes, until
+ *   reg_busy drops; reads keep flowing
+ * - Reads and writes share reg_addr: when both are presented one is
+ *   accepted per cycle, alternating
+ *
  * References:
  * - INTERFACE_SPECIFICATIONS.md - Module 8: axi_lite_slave_if
  * - AXI4-Lite Protocol Specification v1.0
@@ -24,7 +39,8 @@
 module axi_lite_slave_if #(
     parameter int DATA_WIDTH = 32,
     parameter int ADDR_WIDTH = 32,
-    parameter int REG_ADDR_WIDTH = 4  // Supports 16 32-bit registers
+    parameter int REG_ADDR_WIDTH = 4,  // Supports 16 32-bit registers
+    parameter bit PIPELINED = 1'b0     // 1 = one access per cycle (see above)
 ) (
     // Clock and reset
     input  logic                    clk,
@@ -60,10 +76,12 @@ module axi_lite_slave_if #(
     // Register Interface (to uart_regs)
     output logic [REG_ADDR_WIDTH-1:0] reg_addr,
     output logic [DATA_WIDTH-1:0]   reg_wdata,
+    output logic [DATA_WIDTH/8-1:0] reg_wstrb,
     output logic                    reg_wen,
     output logic                    reg_ren,
     input  logic [DATA_WIDTH-1:0]   reg_rdata,
-    input  logic                    reg_error
+    input  logic                    reg_error,
+    input  logic                    reg_busy
 );
 
     // ========================================
@@ -72,37 +90,6 @@ module axi_lite_slave_if #(
     localparam logic [1:0] AXI_RESP_OKAY   = 2'b00;
     localparam logic [1:0] AXI_RESP_SLVERR = 2'b10;
 
-    // ========================================
-    // Write Path State Machine
-    // ========================================
-    typedef enum logic [1:0] {
-        W_IDLE,
-        W_WAIT_READY,
-        W_RESP
-    } write_state_t;
-
-    write_state_t write_state;
-
-    // Write address and data latches
-    logic [REG_ADDR_WIDTH-1:0] wr_addr_latched;
-    logic [DATA_WIDTH-1:0]     wr_data_latched;
-    logic                      wr_error_latched;
-
-    // ========================================
-    // Read Path State Machine
-    // ========================================
-    typedef enum logic [1:0] {
-        R_IDLE,
-        R_READ,
-        R_RESP
-    } read_state_t;
-
-    read_state_t read_state;
-
-    // Read data latch
-    logic [DATA_WIDTH-1:0] rd_data_latched;
-    logic                  rd_error_latched;
-
     // ========================================
     // Address Decoding
     // ========================================
@@ -114,150 +101,284 @@ module axi_lite_slave_if #(
     assign ar_word_addr = araddr[REG_ADDR_WIDTH+1:2];
 
     // ========================================
-    // Write Path Logic
+    // Pipelined Mode
     // ========================================
-    always_ff @(posedge clk or negedge rst_n) begin
-        if (!rst_n) begin
-            write_state <= W_IDLE;
-            awready <= 1'b0;
-            wready <= 1'b0;
-            bvalid <= 1'b0;
-            bresp <= AXI_RESP_OKAY;
-            reg_wen <= 1'b0;
-            wr_addr_latched <= '0;
-            wr_data_latched <= '0;
-            wr_error_latched <= 1'b0;
-        end else begin
-            // Default: deassert pulses
-            reg_wen <= 1'b0;
-
-            case (write_state)
-                W_IDLE: begin
-                    awready <= 1'b0;
-                    wready <= 1'b0;
+    // Address and data go straight to the register file on the cycle they
+    // are accepted; rdata is captured at that edge and the response is
+    // registered. A new request is accepted whenever the response slot is
+    // empty or being handshaked, so back-to-back accesses run one per cycle.
+    // Reads and writes share reg_addr: contention alternates between them.
+    if (PIPELINED) begin : g_pipelined
+        logic w_slot_free;
+        logic r_slot_free;
+        logic w_req;
+        logic r_req;
+        logic w_grant;
+        logic r_grant;
+        logic w_wait;         // Accepted write waiting out reg_busy
+        logic w_error;
+        logic write_first;    // Round-robin pointer for read/write contention
+
+        assign w_slot_free = !bvalid || bready;
+        assign r_slot_free = !rvalid || rready;
+
+        assign w_req = awvalid && wvalid && w_slot_free && !w_wait;
+        assign r_req = arvalid && r_slot_free;
+
+        assign w_grant = w_req && (!r_req || write_first);
+        assign r_grant = r_req && !w_grant;
+
+        assign awready = w_grant;
+        assign wready  = w_grant;
+        assign arready = r_grant;
+        assign reg_wen = w_grant;
+        assign reg_ren = r_grant;
+
+        assign reg_addr  = r_grant ? ar_word_addr : aw_word_addr;
+        assign reg_wdata = wdata;
+        assign reg_wstrb = wstrb;
+
+        // Write response
+        always_ff @(posedge clk or negedge rst_n) begin
+            if (!rst_n) begin
+                bvalid <= 1'b0;
+                bresp <= AXI_RESP_OKAY;
+                w_wait <= 1'b0;
+                w_error <= 1'b0;
+            end else begin
+                if (w_grant) begin
+                    if (reg_busy) begin
+                        // Register file still completing the write
+                        bvalid <= 1'b0;
+                        w_wait <= 1'b1;
+                        w_error <= reg_error;
+                    end else begin
+                        bvalid <= 1'b1;
+                        bresp <= reg_error ? AXI_RESP_SLVERR : AXI_RESP_OKAY;
+                    end
+                end else if (w_wait) begin
+                    if (!reg_busy) begin
+                        bvalid <= 1'b1;
+                        bresp <= w_error ? AXI_RESP_SLVERR : AXI_RESP_OKAY;
+                        w_wait <= 1'b0;
+                    end
+                end else if (bready) begin
                     bvalid <= 1'b0;
+                end
+            end
+        end
+
+        // Read response (reg_rdata available in same cycle as reg_ren)
+        always_ff @(posedge clk or negedge rst_n) begin
+            if (!rst_n) begin
+                rvalid <= 1'b0;
+                rdata <= '0;
+                rresp <= AXI_RESP_OKAY;
+            end else if (r_grant) begin
+                rvalid <= 1'b1;
+                rdata <= reg_rdata;
+                rresp <= reg_error ? AXI_RESP_SLVERR : AXI_RESP_OKAY;
+            end else if (rready) begin
+                rvalid <= 1'b0;
+            end
+        end
+
+        // Arbitration: the side that lost gets the next contended cycle
+        always_ff @(posedge clk or negedge rst_n) begin
+            if (!rst_n) begin
+                write_first <= 1'b0;
+            end else if (w_req && r_req) begin
+                write_first <= !w_grant;
+            end
+        end
 
-                    // Wait for both address and data valid
-                    if (awvalid && wvalid) begin
-                        // Accept both in same cycle
-                        awready <= 1'b1;
-                        wready <= 1'b1;
+    end else begin : g_serial
+
+        // ========================================
+        // Write Path State Machine
+        // ========================================
+        typedef enum logic [1:0] {
+            W_IDLE,
+            W_WAIT_READY,
+            W_RESP
+        } write_state_t;
+
+        write_state_t write_state;
+
+        // Write address and data latches
+        logic [REG_ADDR_WIDTH-1:0] wr_addr_latched;
+        logic [DATA_WIDTH-1:0]     wr_data_latched;
+        logic [DATA_WIDTH/8-1:0]   wr_strb_latched;
+        logic                      wr_error_latched;
+
+        // ========================================
+        // Read Path State Machine
+        // ========================================
+        typedef enum logic [1:0] {
+            R_IDLE,
+            R_READ,
+            R_RESP
+        } read_state_t;
+
+        read_state_t read_state;
+
+        // Read data latch
+        logic [DATA_WIDTH-1:0] rd_data_latched;
+        logic                  rd_error_latched;
+
+        // ========================================
+        // Write Path Logic
+        // ========================================
+        always_ff @(posedge clk or negedge rst_n) begin
+            if (!rst_n) begin
+                write_state <= W_IDLE;
+                awready <= 1'b0;
+                wready <= 1'b0;
+                bvalid <= 1'b0;
+                bresp <= AXI_RESP_OKAY;
+                reg_wen <= 1'b0;
+                wr_addr_latched <= '0;
+                wr_data_latched <= '0;
+                wr_strb_latched <= '0;
+                wr_error_latched <= 1'b0;
+            end else begin
+                // Default: deassert pulses
+                reg_wen <= 1'b0;
+
+                case (write_state)
+                    W_IDLE: begin
+                        awready <= 1'b0;
+                        wready <= 1'b0;
+                        bvalid <= 1'b0;
 
-                        // Latch address and data
-                        wr_addr_latched <= aw_word_addr;
-                        wr_data_latched <= wdata;
-                        wr_error_latched <= reg_error;
+                        // Wait for both address and data valid
+                        if (awvalid && wvalid) begin
+                            // Accept both in same cycle
+                            awready <= 1'b1;
+                            wready <= 1'b1;
 
-                        // Pulse write enable to register file
-                        reg_wen <= 1'b1;
+                            // Latch address and data
+                            wr_addr_latched <= aw_word_addr;
+                            wr_data_latched <= wdata;
+                            wr_strb_latched <= wstrb;
+                            wr_error_latched <= reg_error;
 
-                        write_state <= W_RESP;
-                    end
-                end
+                            // Pulse write enable to register file
+                            reg_wen <= 1'b1;
 
-                W_RESP: begin
-                    // Deassert ready signals
-                    awready <= 1'b0;
-                    wready <= 1'b0;
+                            write_state <= W_RESP;
+                        end
+                    end
 
-                    // Generate response
-                    if (!bvalid) begin
-                        // First cycle in W_RESP: assert bvalid
-                        bvalid <= 1'b1;
-                        bresp <= wr_error_latched ? AXI_RESP_SLVERR : AXI_RESP_OKAY;
-                    end else if (bready) begin
-                        // Wait for bready after bvalid is asserted
-                        bvalid <= 1'b0;
-                        write_state <= W_IDLE;
+                    W_RESP: begin
+                        // Deassert ready signals
+                        awready <= 1'b0;
+                        wready <= 1'b0;
+
+                        // Generate response
+                        if (!bvalid) begin
+                            // First cycle in W_RESP: assert bvalid, unless the
+                            // register file is still completing the write
+                            if (!reg_busy) begin
+                                bvalid <= 1'b1;
+                                bresp <= wr_error_latched ? AXI_RESP_SLVERR : AXI_RESP_OKAY;
+                            end
+                        end else if (bready) begin
+                            // Wait for bready after bvalid is asserted
+                            bvalid <= 1'b0;
+                            write_state <= W_IDLE;
+                        end
                     end
-                end
 
-                default: write_state <= W_IDLE;
-            endcase
+                    default: write_state <= W_IDLE;
+                endcase
+            end
         end
-    end
 
-    // Connect address to register interface (mux between read and write)
-    // Priority: active read/write in progress, then new transactions
-    logic [REG_ADDR_WIDTH-1:0] rd_addr_latched;
+        // Connect address to register interface (mux between read and write)
+        // Priority: active read/write in progress, then new transactions
+        logic [REG_ADDR_WIDTH-1:0] rd_addr_latched;
 
-    always_ff @(posedge clk or negedge rst_n) begin
-        if (!rst_n) begin
-            rd_addr_latched <= '0;
-        end else if (read_state == R_IDLE && arvalid) begin
-            rd_addr_latched <= ar_word_addr;
+        always_ff @(posedge clk or negedge rst_n) begin
+            if (!rst_n) begin
+                rd_addr_latched <= '0;
+            end else if (read_state == R_IDLE && arvalid) begin
+                rd_addr_latched <= ar_word_addr;
+            end
         end
-    end
 
-    // Mux between read and write paths
-    assign reg_addr = (read_state != R_IDLE) ? rd_addr_latched :
-                      (write_state == W_IDLE && awvalid && wvalid) ? aw_word_addr :
-                      wr_addr_latched;
+        // Mux between read and write paths
+        assign reg_addr = (read_state != R_IDLE) ? rd_addr_latched :
+                          (write_state == W_IDLE && awvalid && wvalid) ? aw_word_addr :
+                          wr_addr_latched;
+
+        assign reg_wdata = (write_state == W_IDLE && awvalid && wvalid) ? wdata : wr_data_latched;
+        assign reg_wstrb = (write_state == W_IDLE && awvalid && wvalid) ? wstrb : wr_strb_latched;
+
+        // ========================================
+        // Read Path Logic
+        // ========================================
+        always_ff @(posedge clk or negedge rst_n) begin
+            if (!rst_n) begin
+                read_state <= R_IDLE;
+                arready <= 1'b0;
+                rvalid <= 1'b0;
+                rdata <= '0;
+                rresp <= AXI_RESP_OKAY;
+                reg_ren <= 1'b0;
+                rd_data_latched <= '0;
+                rd_error_latched <= 1'b0;
+            end else begin
+                // Default: deassert pulses
+                reg_ren <= 1'b0;
+
+                case (read_state)
+                    R_IDLE: begin
+                        arready <= 1'b0;
+                        rvalid <= 1'b0;
 
-    assign reg_wdata = (write_state == W_IDLE && awvalid && wvalid) ? wdata : wr_data_latched;
+                        // Wait for read address valid
+                        if (arvalid) begin
+                            arready <= 1'b1;
 
-    // ========================================
-    // Read Path Logic
-    // ========================================
-    always_ff @(posedge clk or negedge rst_n) begin
-        if (!rst_n) begin
-            read_state <= R_IDLE;
-            arready <= 1'b0;
-            rvalid <= 1'b0;
-            rdata <= '0;
-            rresp <= AXI_RESP_OKAY;
-            reg_ren <= 1'b0;
-            rd_data_latched <= '0;
-            rd_error_latched <= 1'b0;
-        end else begin
-            // Default: deassert pulses
-            reg_ren <= 1'b0;
-
-            case (read_state)
-                R_IDLE: begin
-                    arready <= 1'b0;
-                    rvalid <= 1'b0;
-
-                    // Wait for read address valid
-                    if (arvalid) begin
-                        arready <= 1'b1;
-
-                        // Pulse read enable to register file
-                        reg_ren <= 1'b1;
-
-                        read_state <= R_READ;
+                            // Pulse read enable to register file
+                            reg_ren <= 1'b1;
+
+                            read_state <= R_READ;
+                        end
                     end
-                end
 
-                R_READ: begin
-                    // Deassert arready
-                    arready <= 1'b0;
+                    R_READ: begin
+                        // Deassert arready
+                        arready <= 1'b0;
 
-                    // Capture register data and error
-                    // (reg_rdata available in same cycle as reg_ren in uart_regs)
-                    rd_data_latched <= reg_rdata;
-                    rd_error_latched <= reg_error;
+                        // Capture register data and error
+                        // (reg_rdata available in same cycle as reg_ren in uart_regs)
+                        rd_data_latched <= reg_rdata;
+                        rd_error_latched <= reg_error;
 
-                    read_state <= R_RESP;
-                end
+                        read_state <= R_RESP;
+                    end
 
-                R_RESP: begin
-                    // Generate response
-                    if (!rvalid) begin
-                        // First cycle in R_RESP: assert rvalid
-                        rvalid <= 1'b1;
-                        rdata <= rd_data_latched;
-                        rresp <= rd_error_latched ? AXI_RESP_SLVERR : AXI_RESP_OKAY;
-                    end else if (rready) begin
-                        // Wait for rready after rvalid is asserted
-                        rvalid <= 1'b0;
-                        read_state <= R_IDLE;
+                    R_RESP: begin
+                        // Generate response
+                        if (!rvalid) begin
+                            // First cycle in R_RESP: assert rvalid
+                            rvalid <= 1'b1;
+                            rdata <= rd_data_latched;
+                            rresp <= rd_error_latched ? AXI_RESP_SLVERR : AXI_RESP_OKAY;
+                        end else if (rready) begin
+                            // Wait for rready after rvalid is asserted
+                            rvalid <= 1'b0;
+                            read_state <= R_IDLE;
+                        end
                     end
-                end
 
-                default: read_state <= R_IDLE;
-            endcase
+                    default: read_state <= R_IDLE;
+                endcase
+            end
         end
+
     end
 
     // ========================================
@@ -302,14 +423,20 @@ module axi_lite_slave_if #(
                 assert (rvalid)
                     else $error("axi_lite_slave_if: rvalid deasserted before rready");
 
-            // reg_wen and reg_ren should be single-cycle pulses
-            if ($past(reg_wen))
-                assert (!reg_wen)
-                    else $error("axi_lite_slave_if: reg_wen not a single-cycle pulse");
-
-            if ($past(reg_ren))
-                assert (!reg_ren)
-                    else $error("axi_lite_slave_if: reg_ren not a single-cycle pulse");
+            if (!PIPELINED) begin
+                // reg_wen and reg_ren should be single-cycle pulses
+                if ($past(reg_wen))
+                    assert (!reg_wen)
+                        else $error("axi_lite_slave_if: reg_wen not a single-cycle pulse");
+
+                if ($past(reg_ren))
+                    assert (!reg_ren)
+                        else $error("axi_lite_slave_if: reg_ren not a single-cycle pulse");
+            end else begin
+                // Shared reg_addr: never a read and a write in one cycle
+                assert (!(reg_wen && reg_ren))
+                    else $error("axi_lite_slave_if: reg_wen and reg_ren in same cycle");
+            end
         end
     end
 `endif
@@ -6,28 +6,40 @@
  * Features:
  * - Parameterizable divisor width
  * - Configurable baud rate via divisor register
+ * - Fractional divisor: FRAC_WIDTH-bit fraction accumulator (PL011-style),
+ *   so high baud rates from a non-baud-friendly clock stay accurate
  * - Enable/disable control
+ * - Phase restart: restart=1 makes the current cycle the first of a fresh
+ *   tick period (uart_tx_path early accept aligns a frame start to it)
  * - Zero-error tick generation (for 7.3728 MHz clock)
  * - 1 cycle pulse width
  *
  * Timing:
- * - Output frequency = uart_clk / baud_divisor
+ * - Output frequency = uart_clk / (baud_divisor + baud_frac / 2^FRAC_WIDTH)
+ * - Each tick period is baud_divisor or baud_divisor+1 cycles; the
+ *   accumulator adds baud_frac per tick and stretches the period on carry
  * - Pulse width = 1 uart_clk cycle
- * - Jitter = 0 (clock-synchronous)
+ * - Jitter = 0 with baud_frac=0, at most 1 uart_clk cycle otherwise
  *
  * Usage:
- *   baud_gen #(.DIVISOR_WIDTH(8)) baud_gen_inst (
+ *   baud_gen #(.DIVISOR_WIDTH(8), .FRAC_WIDTH(6)) baud_gen_inst (
  *       .uart_clk     (uart_clk),
  *       .rst_n        (rst_n),
  *       .baud_divisor (divisor),
+ *       .baud_frac    (fraction),
  *       .enable       (enable),
+ *       .restart      (1'b0),         // Or a frame-start strobe
  *       .baud_tick    (tick_16x)
  *   );
  *
  * IMPORTANT:
  * - baud_divisor must be ≥ 1 (0 is invalid, disables output)
- * - baud_divisor can be changed dynamically
- * - enable=0 stops tick generation
+ * - baud_divisor and baud_frac can be changed dynamically
+ * - baud_frac=0 gives exactly the integer divisor behaviour
+ * - enable=0 stops tick generation (and clears the fraction accumulator)
+ * - restart clears the count and the fraction accumulator, so the next
+ *   tick is exactly one period (baud_divisor cycles) after the restart
+ *   cycle; every consumer of the tick sees the phase jump
  *
  * References:
  * - INTERFACE_SPECIFICATIONS.md - Module 3: baud_gen
@@ -35,6 +47,7 @@
 
 module baud_gen #(
     parameter int DIVISOR_WIDTH = 8,
+    parameter int FRAC_WIDTH = 6,      // Fraction bits (1/64 cycle steps)
     parameter int UART_CLK_FREQ = 7372800
 ) (
     // Clock and reset
@@ -43,7 +56,9 @@ module baud_gen #(
 
     // Configuration
     input  logic [DIVISOR_WIDTH-1:0]  baud_divisor,
+    input  logic [FRAC_WIDTH-1:0]     baud_frac,
     input  logic                      enable,
+    input  logic                      restart,      // Start a new tick period this cycle
 
     // Output
     output logic                      baud_tick
@@ -52,24 +67,46 @@ module baud_gen #(
     // Internal counter
     logic [DIVISOR_WIDTH-1:0] counter;
 
+    // Fraction accumulator: carry out of (frac_acc + baud_frac) stretches
+    // the current period by one cycle
+    logic [FRAC_WIDTH-1:0]    frac_acc;
+    logic [FRAC_WIDTH:0]      frac_sum;
+    logic                     stretch;
+    logic [DIVISOR_WIDTH:0]   terminal;   // Last count of this period
+
+    // Count and accumulator this cycle: a restart counts from a new period
+    logic [DIVISOR_WIDTH-1:0] count;
+    logic [FRAC_WIDTH-1:0]    acc;
+
+    assign count = restart ? '0 : counter;
+    assign acc   = restart ? '0 : frac_acc;
+
+    assign frac_sum = {1'b0, acc} + {1'b0, baud_frac};
+    assign stretch  = frac_sum[FRAC_WIDTH];
+    assign terminal = {1'b0, baud_divisor} - 1'b1 + (DIVISOR_WIDTH+1)'(stretch);
+
     // Counter and tick generation
     always_ff @(posedge uart_clk or negedge rst_n) begin
         if (!rst_n) begin
             counter <= '0;
+            frac_acc <= '0;
             baud_tick <= 1'b0;
         end else if (!enable || baud_divisor == 0) begin
             // Disabled or invalid divisor
             counter <= '0;
+            frac_acc <= '0;
             baud_tick <= 1'b0;
         end else begin
-            if (counter == baud_divisor - 1) begin
-                // Reached divisor, generate tick
+            if ({1'b0, count} == terminal) begin
+                // Reached divisor (+1 on fraction carry), generate tick
                 baud_tick <= 1'b1;
                 counter <= '0;
+                frac_acc <= frac_sum[FRAC_WIDTH-1:0];
             end else begin
                 // Count up
                 baud_tick <= 1'b0;
-                counter <= counter + 1'b1;
+                counter <= count + 1'b1;
+                frac_acc <= acc;
             end
         end
     end
@@ -81,6 +118,9 @@ module baud_gen #(
         assert (DIVISOR_WIDTH >= 4 && DIVISOR_WIDTH <= 16)
             else $warning("baud_gen: Unusual DIVISOR_WIDTH=%0d", DIVISOR_WIDTH);
 
+        assert (FRAC_WIDTH >= 1 && FRAC_WIDTH <= 8)
+            else $error("baud_gen: FRAC_WIDTH must be 1..8");
+
         assert (UART_CLK_FREQ > 0)
             else $error("baud_gen: UART_CLK_FREQ must be positive");
     end
@@ -88,9 +128,9 @@ module baud_gen #(
     // Runtime assertions
     always @(posedge uart_clk) begin
         if (rst_n) begin
-            // Counter should never exceed divisor-1
+            // Counter should never exceed divisor-1 (divisor on a stretched period)
             if (enable && baud_divisor > 0) begin
-                assert (counter < baud_divisor)
+                assert ({1'b0, count} <= terminal)
                     else $error("baud_gen: counter=%0d exceeds divisor=%0d",
                                counter, baud_divisor);
             end
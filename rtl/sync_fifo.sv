@@ -125,7 +125,7 @@ module sync_fifo #(
         assert (DATA_WIDTH >= 1 && DATA_WIDTH <= 32)
             else $warning("sync_fifo: Unusual DATA_WIDTH=%0d", DATA_WIDTH);
 
-        assert (DEPTH >= 4 && DEPTH <= 256)
+        assert (DEPTH >= 4 && DEPTH <= 32768)
             else $warning("sync_fifo: Unusual DEPTH=%0d", DEPTH);
     end
 
@@ -133,7 +133,7 @@ module sync_fifo #(
     always_ff @(posedge clk) begin
         if (rst_n) begin
             // Level should never exceed DEPTH
-            assert (level <= ADDR_WIDTH'(DEPTH))
+            assert (level <= (ADDR_WIDTH+1)'(DEPTH))
                 else $error("sync_fifo: level=%0d exceeds DEPTH=%0d", level, DEPTH);
 
             // Consistency checks
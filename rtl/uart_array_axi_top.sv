@@ -0,0 +1,396 @@
+/*
+ * UART Array AXI Top-Level Module
+ *
+ * NUM_CHANNELS UART channels behind a single AXI-Lite slave. All channels
+ * share uart_clk (= clk), so one axi_lite_slave_if decodes every channel
+ * and the baud generators are shared between channels that run at the
+ * same rate.
+ *
+ * Architecture:
+ *   AXI-Lite Bus → axi_lite_slave_if → page decode ─┬→ uart_top[0] → pins[0]
+ *                                                   ├→ uart_top[1] → pins[1]
+ *                                                   ├→ ...
+ *                                                   └→ array registers
+ *   baud_gen[g] → ext_baud_tick of every channel c with c % NUM_BAUD_GENS == g
+ *
+ * Address Map (byte addresses):
+ *   0x40 * c + 0x00..0x3C : channel c register file (uart_regs map)
+ *   0x40 * NUM_CHANNELS   : array registers
+ *     +0x00: IRQ_STATUS   - RO, bit c = channel c interrupt pending
+ *     +0x04: IRQ_MASK     - RW, bit c routes channel c to irq (reset all 1)
+ *     +0x08: INFO         - RO, [7:0] NUM_CHANNELS, [15:8] NUM_BAUD_GENS
+ *   Pages above NUM_CHANNELS read 0 and respond SLVERR
+ *
+ * Features:
+ * - One AXI-Lite slave for all channels (channel = address bits above [5:2])
+ * - NUM_BAUD_GENS shared baud generators: channel c ticks from generator
+ *   c % NUM_BAUD_GENS, programmed by the BAUD_DIV/BAUD_FRAC of channel g
+ *   (the lowest channel in the group) and enabled while any channel in
+ *   the group has TX_EN or RX_EN set (with IDLE_GATING=1: while any
+ *   channel in the group is active, so an idle array runs no generator)
+ * - IRQ_STATUS: one read tells the ISR which channels need service
+ * - Per-channel AXI-Stream / DMA ports and serial pins (packed vectors,
+ *   channel c in slice c)
+ *
+ * Usage:
+ *   uart_array_axi_top #(
+ *       .NUM_CHANNELS  (8),
+ *       .NUM_BAUD_GENS (1)   // All channels at one rate
+ *   ) uart_array (
+ *       .clk         (sys_clk),
+ *       .rst_n       (rst_n),
+ *       // AXI-Lite interface
+ *       .awaddr      (s_axi_awaddr),
+ *       // ... other AXI signals
+ *       // Per-channel stream / DMA / pins: [NUM_CHANNELS-1:0] (tdata x8)
+ *       .uart_tx     (uart_tx_pins),
+ *       .uart_rx     (uart_rx_pins),
+ *       .uart_rts_n  (uart_rts_pins),
+ *       .uart_cts_n  ('0),
+ *       .ch_irq      (),
+ *       .irq         (uart_irq)
+ *   );
+ *
+ * IMPORTANT:
+ * - Within a baud group only the leader's (channel g) BAUD_DIV/BAUD_FRAC
+ *   set the rate; on the other channels they are read-only and return the
+ *   leader's value, so a read shows the rate the channel actually runs at
+ * - NUM_BAUD_GENS = NUM_CHANNELS (default) gives every channel its own
+ *   generator, as with separate uart_axi_top instances
+ *
+ * References:
+ * - INTERFACE_SPECIFICATIONS.md - Module 11: uart_array_axi_top
+ */
+
+module uart_array_axi_top #(
+    parameter int DATA_WIDTH = 32,
+    parameter int ADDR_WIDTH = 32,
+    parameter int NUM_CHANNELS = 4,
+    parameter int NUM_BAUD_GENS = NUM_CHANNELS,  // Channel c uses c % NUM_BAUD_GENS
+    parameter int TX_FIFO_DEPTH = 8,
+    parameter int RX_FIFO_DEPTH = 8,
+    parameter bit AXI_PIPELINED = 1'b0,
+    parameter bit IDLE_GATING = 1'b0    // Per-channel idle gating (see uart_top)
+) (
+    // Clock and reset
+    input  logic                    clk,
+    input  logic                    rst_n,
+
+    // AXI-Lite Write Address Channel
+    input  logic [ADDR_WIDTH-1:0]   awaddr,
+    input  logic                    awvalid,
+    output logic                    awready,
+
+    // AXI-Lite Write Data Channel
+    input  logic [DATA_WIDTH-1:0]   wdata,
+    input  logic [DATA_WIDTH/8-1:0] wstrb,
+    input  logic                    wvalid,
+    output logic                    wready,
+
+    // AXI-Lite Write Response Channel
+    output logic [1:0]              bresp,
+    output logic                    bvalid,
+    input  logic                    bready,
+
+    // AXI-Lite Read Address Channel
+    input  logic [ADDR_WIDTH-1:0]   araddr,
+    input  logic                    arvalid,
+    output logic                    arready,
+
+    // AXI-Lite Read Data Channel
+    output logic [DATA_WIDTH-1:0]   rdata,
+    output logic [1:0]              rresp,
+    output logic                    rvalid,
+    input  logic                    rready,
+
+    // AXI-Stream TX / RX and DMA requests, per channel (CTRL.STREAM_EN)
+    input  logic [NUM_CHANNELS*8-1:0] s_axis_tdata,
+    input  logic [NUM_CHANNELS-1:0] s_axis_tvalid,
+    output logic [NUM_CHANNELS-1:0] s_axis_tready,
+    output logic [NUM_CHANNELS*8-1:0] m_axis_tdata,
+    output logic [NUM_CHANNELS-1:0] m_axis_tvalid,
+    input  logic [NUM_CHANNELS-1:0] m_axis_tready,
+    output logic [NUM_CHANNELS-1:0] tx_dma_req,
+    output logic [NUM_CHANNELS-1:0] rx_dma_req,
+
+    // UART serial interface and flow control, per channel
+    output logic [NUM_CHANNELS-1:0] uart_tx,
+    input  logic [NUM_CHANNELS-1:0] uart_rx,
+    output logic [NUM_CHANNELS-1:0] uart_rts_n,
+    input  logic [NUM_CHANNELS-1:0] uart_cts_n,
+
+    // Interrupts: per channel, and aggregated through IRQ_MASK
+    output logic [NUM_CHANNELS-1:0] ch_irq,
+    output logic                    irq
+);
+
+    // ========================================
+    // Local Parameters
+    // ========================================
+    localparam int PAGE_BITS = $clog2(NUM_CHANNELS + 1);  // Channels + array page
+    localparam int REG_ADDR_WIDTH = 4 + PAGE_BITS;        // 16 registers per page
+
+    localparam logic [3:0] ADDR_IRQ_STATUS = 4'h0;
+    localparam logic [3:0] ADDR_IRQ_MASK   = 4'h1;
+    localparam logic [3:0] ADDR_INFO       = 4'h2;
+
+    // Channel registers redirected to the group leader (uart_regs map)
+    localparam logic [3:0] ADDR_BAUD_DIV   = 4'h4;
+    localparam logic [3:0] ADDR_BAUD_FRAC  = 4'hA;
+
+    // ========================================
+    // Internal Signals - Register Interface
+    // ========================================
+    logic [REG_ADDR_WIDTH-1:0] reg_addr;
+    logic [DATA_WIDTH-1:0]     reg_wdata;
+    logic [DATA_WIDTH/8-1:0]   reg_wstrb;
+    logic                      reg_wen;
+    logic                      reg_ren;
+    logic [DATA_WIDTH-1:0]     reg_rdata;
+    logic                      reg_error;
+    logic                      reg_busy;
+
+    logic [PAGE_BITS-1:0]      page;
+    logic [3:0]                page_addr;
+    logic                      array_sel;   // Array register page
+    logic                      page_valid;  // Channel or array page
+
+    assign page      = reg_addr[REG_ADDR_WIDTH-1:4];
+    assign page_addr = reg_addr[3:0];
+    assign array_sel = (page == PAGE_BITS'(NUM_CHANNELS));
+    assign page_valid = (page <= PAGE_BITS'(NUM_CHANNELS));
+
+    logic                      baud_sel;    // BAUD_DIV or BAUD_FRAC in a channel page
+
+    assign baud_sel = (page_addr == ADDR_BAUD_DIV) || (page_addr == ADDR_BAUD_FRAC);
+
+    // Per-channel register interface returns
+    logic [DATA_WIDTH-1:0]     ch_rdata [NUM_CHANNELS];
+    logic [NUM_CHANNELS-1:0]   ch_busy;
+
+    // Per-channel baud generator controls
+    logic [15:0]               ch_baud_divisor [NUM_CHANNELS];
+    logic [5:0]                ch_baud_frac [NUM_CHANNELS];
+    logic [NUM_CHANNELS-1:0]   ch_baud_enable;
+
+    // Shared baud generators
+    logic [NUM_BAUD_GENS-1:0]  gen_enable;
+    logic [NUM_BAUD_GENS-1:0]  gen_tick;
+
+    // ========================================
+    // Module: axi_lite_slave_if
+    // ========================================
+    // One AXI-Lite slave for every channel plus the array page
+    axi_lite_slave_if #(
+        .DATA_WIDTH      (DATA_WIDTH),
+        .ADDR_WIDTH      (ADDR_WIDTH),
+        .REG_ADDR_WIDTH  (REG_ADDR_WIDTH),
+        .PIPELINED       (AXI_PIPELINED)
+    ) axi_if (
+        .clk         (clk),
+        .rst_n       (rst_n),
+        // AXI-Lite Write Address Channel
+        .awaddr      (awaddr),
+        .awvalid     (awvalid),
+        .awready     (awready),
+        // AXI-Lite Write Data Channel
+        .wdata       (wdata),
+        .wstrb       (wstrb),
+        .wvalid      (wvalid),
+        .wready      (wready),
+        // AXI-Lite Write Response Channel
+        .bresp       (bresp),
+        .bvalid      (bvalid),
+        .bready      (bready),
+        // AXI-Lite Read Address Channel
+        .araddr      (araddr),
+        .arvalid     (arvalid),
+        .arready     (arready),
+        // AXI-Lite Read Data Channel
+        .rdata       (rdata),
+        .rresp       (rresp),
+        .rvalid      (rvalid),
+        .rready      (rready),
+        // Register Interface
+        .reg_addr    (reg_addr),
+        .reg_wdata   (reg_wdata),
+        .reg_wstrb   (reg_wstrb),
+        .reg_wen     (reg_wen),
+        .reg_ren     (reg_ren),
+        .reg_rdata   (reg_rdata),
+        .reg_error   (reg_error),
+        .reg_busy    (reg_busy)
+    );
+
+    // ========================================
+    // Shared Baud Generators
+    // ========================================
+    // Generator g runs while any channel in its group is enabled, at the
+    // rate programmed into the group leader (channel g)
+    always_comb begin
+        gen_enable = '0;
+        for (int c = 0; c < NUM_CHANNELS; c++) begin
+            if (ch_baud_enable[c]) gen_enable[c % NUM_BAUD_GENS] = 1'b1;
+        end
+    end
+
+    generate
+        for (genvar g = 0; g < NUM_BAUD_GENS; g++) begin : g_baud
+            baud_gen #(
+                .DIVISOR_WIDTH  (16),
+                .FRAC_WIDTH     (6)
+            ) baud_gen_inst (
+                .uart_clk       (clk),
+                .rst_n          (rst_n),
+                .baud_divisor   (ch_baud_divisor[g]),
+                .baud_frac      (ch_baud_frac[g]),
+                .enable         (gen_enable[g]),
+                .restart        (1'b0),     // Shared: no per-channel phase
+                .baud_tick      (gen_tick[g])
+            );
+        end
+    endgenerate
+
+    // ========================================
+    // Module: uart_top (one per channel)
+    // ========================================
+    generate
+        for (genvar c = 0; c < NUM_CHANNELS; c++) begin : g_channel
+            logic sel;
+            logic wr_sel;
+
+            assign sel = (page == PAGE_BITS'(c));
+
+            // Non-leaders do not take BAUD_DIV/BAUD_FRAC writes (read-only)
+            assign wr_sel = sel && !(c >= NUM_BAUD_GENS && baud_sel);
+
+            uart_top #(
+                .DATA_WIDTH     (DATA_WIDTH),
+                .TX_FIFO_DEPTH  (TX_FIFO_DEPTH),
+                .RX_FIFO_DEPTH  (RX_FIFO_DEPTH),
+                .EXT_BAUD_TICK  (1'b1),
+                .IDLE_GATING    (IDLE_GATING)
+            ) uart_core (
+                .uart_clk    (clk),
+                .rst_n       (rst_n),
+                // Register interface, decoded by page
+                .reg_addr    (page_addr),
+                .reg_wdata   (reg_wdata),
+                .reg_wstrb   (reg_wstrb),
+                .reg_wen     (reg_wen && wr_sel),
+                .reg_ren     (reg_ren && sel),
+                .reg_rdata   (ch_rdata[c]),
+                .reg_error   (),
+                .reg_busy    (ch_busy[c]),
+                // Stream / DMA interface
+                .s_axis_tdata  (s_axis_tdata[c*8 +: 8]),
+                .s_axis_tvalid (s_axis_tvalid[c]),
+                .s_axis_tready (s_axis_tready[c]),
+                .m_axis_tdata  (m_axis_tdata[c*8 +: 8]),
+                .m_axis_tvalid (m_axis_tvalid[c]),
+                .m_axis_tready (m_axis_tready[c]),
+                .tx_dma_req    (tx_dma_req[c]),
+                .rx_dma_req    (rx_dma_req[c]),
+                // UART serial interface
+                .uart_tx     (uart_tx[c]),
+                .uart_rx     (uart_rx[c]),
+                // Flow control
+                .uart_rts_n  (uart_rts_n[c]),
+                .uart_cts_n  (uart_cts_n[c]),
+                // Shared baud generator
+                .ext_baud_tick    (gen_tick[c % NUM_BAUD_GENS]),
+                .baud_divisor_out (ch_baud_divisor[c]),
+                .baud_frac_out    (ch_baud_frac[c]),
+                .baud_enable_out  (ch_baud_enable[c]),
+                // Interrupt output
+                .irq         (ch_irq[c])
+            );
+        end
+    endgenerate
+
+    // ========================================
+    // Array Registers
+    // ========================================
+    // IRQ_MASK: channels routed to the aggregated irq output
+    logic [NUM_CHANNELS-1:0] irq_mask_reg;
+
+    always_ff @(posedge clk or negedge rst_n) begin
+        if (!rst_n) begin
+            irq_mask_reg <= '1;
+        end else if (reg_wen && array_sel && page_addr == ADDR_IRQ_MASK) begin
+            irq_mask_reg <= reg_wdata[NUM_CHANNELS-1:0];
+        end
+    end
+
+    assign irq = |(ch_irq & irq_mask_reg);
+
+    // ========================================
+    // Register Read Mux
+    // ========================================
+    // Combinational, like uart_regs (axi_lite_slave_if samples on reg_ren).
+    // A non-leader's BAUD_DIV/BAUD_FRAC read returns its group leader's.
+    always_comb begin
+        reg_rdata = '0;
+        if (array_sel) begin
+            case (page_addr)
+                ADDR_IRQ_STATUS: reg_rdata = DATA_WIDTH'(ch_irq);
+                ADDR_IRQ_MASK:   reg_rdata = DATA_WIDTH'(irq_mask_reg);
+                ADDR_INFO:       reg_rdata = DATA_WIDTH'({8'(NUM_BAUD_GENS), 8'(NUM_CHANNELS)});
+                default:         reg_rdata = '0;
+            endcase
+        end else begin
+            for (int c = 0; c < NUM_CHANNELS; c++) begin
+                if (page == PAGE_BITS'(c)) begin
+                    if (c >= NUM_BAUD_GENS && page_addr == ADDR_BAUD_DIV) begin
+                        reg_rdata = DATA_WIDTH'(ch_baud_divisor[c % NUM_BAUD_GENS]);
+                    end else if (c >= NUM_BAUD_GENS && page_addr == ADDR_BAUD_FRAC) begin
+                        reg_rdata = DATA_WIDTH'(ch_baud_frac[c % NUM_BAUD_GENS]);
+                    end else begin
+                        reg_rdata = ch_rdata[c];
+                    end
+                end
+            end
+        end
+    end
+
+    // Busy while any channel is unpacking a TX_DATA write: the pipelined
+    // slave may already present the next (other-page) access on reg_addr
+    assign reg_busy = |ch_busy;
+
+    // Unmapped pages respond SLVERR
+    assign reg_error = !page_valid;
+
+    // ========================================
+    // Assertions for Verification
+    // ========================================
+`ifdef SIMULATION
+    initial begin
+        // Check parameters
+        assert (DATA_WIDTH == 32)
+            else $error("uart_array_axi_top: Only DATA_WIDTH=32 supported");
+
+        assert (NUM_CHANNELS >= 1 && NUM_CHANNELS <= 32)
+            else $error("uart_array_axi_top: NUM_CHANNELS must be 1..32 (IRQ_STATUS width)");
+
+        assert (NUM_BAUD_GENS >= 1 && NUM_BAUD_GENS <= NUM_CHANNELS)
+            else $error("uart_array_axi_top: NUM_BAUD_GENS must be 1..NUM_CHANNELS");
+
+        assert (ADDR_WIDTH >= REG_ADDR_WIDTH + 2)
+            else $error("uart_array_axi_top: ADDR_WIDTH must be >= REG_ADDR_WIDTH + 2");
+    end
+
+    // Runtime assertions
+    always_ff @(posedge clk) begin
+        if (rst_n) begin
+            // Serial outputs should never be X or Z
+            assert (!$isunknown(uart_tx))
+                else $error("uart_array_axi_top: uart_tx is X or Z");
+
+            // The array page has no side effects on a channel
+            assert (!(reg_wen && !page_valid))
+                else $warning("uart_array_axi_top: write to unmapped page (SLVERR)");
+        end
+    end
+`endif
+
+endmodule
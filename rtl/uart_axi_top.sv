@@ -12,6 +12,12 @@
  * - 8N1 UART with configurable baud rate
  * - TX/RX FIFOs for buffering
  * - Interrupt generation
+ * - AXI_PIPELINED=1 selects the one-access-per-cycle AXI-Lite slave
+ * - AXI-Stream byte ports plus burst requests for a DMA engine
+ *   (CTRL.STREAM_EN): TX bytes in on s_axis, RX bytes out on m_axis
+ * - RTS/CTS hardware flow control (CTRL.RTS_EN / CTRL.CTS_EN)
+ * - IDLE_GATING=1: baud tick and input synchronizers gated while idle
+ *   (see uart_top)
  * - Single clock domain (simplified for Phase 5.3, CDC in Phase 5.4)
  *
  * Usage:
@@ -26,9 +32,20 @@
  *       .awvalid     (s_axi_awvalid),
  *       .awready     (s_axi_awready),
  *       // ... other AXI signals
+ *       // AXI-Stream / DMA (tie s_axis_tvalid and m_axis_tready low if unused)
+ *       .s_axis_tdata  (dma_tx_tdata),
+ *       .s_axis_tvalid (dma_tx_tvalid),
+ *       .s_axis_tready (dma_tx_tready),
+ *       .m_axis_tdata  (dma_rx_tdata),
+ *       .m_axis_tvalid (dma_rx_tvalid),
+ *       .m_axis_tready (dma_rx_tready),
+ *       .tx_dma_req    (dma_tx_req),
+ *       .rx_dma_req    (dma_rx_req),
  *       // UART pins
  *       .uart_tx     (uart_tx_pin),
  *       .uart_rx     (uart_rx_pin),
+ *       .uart_rts_n  (uart_rts_pin),
+ *       .uart_cts_n  (uart_cts_pin),   // Tie low if unused
  *       .irq         (uart_irq)
  *   );
  *
@@ -40,7 +57,10 @@ module uart_axi_top #(
     parameter int DATA_WIDTH = 32,
     parameter int ADDR_WIDTH = 32,
     parameter int TX_FIFO_DEPTH = 8,
-    parameter int RX_FIFO_DEPTH = 8
+    parameter int RX_FIFO_DEPTH = 8,
+    parameter bit AXI_PIPELINED = 1'b0, // axi_lite_slave_if PIPELINED mode
+    parameter bit PERF_COUNTERS = 1'b1, // uart_regs performance counters
+    parameter bit IDLE_GATING = 1'b0    // uart_top idle gating of baud tick and syncs
 ) (
     // Clock and reset
     input  logic                    clk,
@@ -73,10 +93,28 @@ module uart_axi_top #(
     output logic                    rvalid,
     input  logic                    rready,
 
+    // AXI-Stream TX (bytes into the TX FIFO, CTRL.STREAM_EN)
+    input  logic [7:0]              s_axis_tdata,
+    input  logic                    s_axis_tvalid,
+    output logic                    s_axis_tready,
+
+    // AXI-Stream RX (bytes out of the RX FIFO, CTRL.STREAM_EN)
+    output logic [7:0]              m_axis_tdata,
+    output logic                    m_axis_tvalid,
+    input  logic                    m_axis_tready,
+
+    // DMA burst requests (FIFO watermarks, CTRL.STREAM_EN)
+    output logic                    tx_dma_req,
+    output logic                    rx_dma_req,
+
     // UART serial interface
     output logic                    uart_tx,
     input  logic                    uart_rx,
 
+    // Flow control (active low)
+    output logic                    uart_rts_n,
+    input  logic                    uart_cts_n,
+
     // Interrupt output
     output logic                    irq
 );
@@ -91,10 +129,12 @@ module uart_axi_top #(
     // ========================================
     logic [REG_ADDR_WIDTH-1:0] reg_addr;
     logic [DATA_WIDTH-1:0]     reg_wdata;
+    logic [DATA_WIDTH/8-1:0]   reg_wstrb;
     logic                      reg_wen;
     logic                      reg_ren;
     logic [DATA_WIDTH-1:0]     reg_rdata;
     logic                      reg_error;
+    logic                      reg_busy;
 
     // ========================================
     // Module: axi_lite_slave_if
@@ -103,7 +143,8 @@ module uart_axi_top #(
     axi_lite_slave_if #(
         .DATA_WIDTH      (DATA_WIDTH),
         .ADDR_WIDTH      (ADDR_WIDTH),
-        .REG_ADDR_WIDTH  (REG_ADDR_WIDTH)
+        .REG_ADDR_WIDTH  (REG_ADDR_WIDTH),
+        .PIPELINED       (AXI_PIPELINED)
     ) axi_if (
         .clk         (clk),
         .rst_n       (rst_n),
@@ -132,10 +173,12 @@ module uart_axi_top #(
         // Register Interface
         .reg_addr    (reg_addr),
         .reg_wdata   (reg_wdata),
+        .reg_wstrb   (reg_wstrb),
         .reg_wen     (reg_wen),
         .reg_ren     (reg_ren),
         .reg_rdata   (reg_rdata),
-        .reg_error   (reg_error)
+        .reg_error   (reg_error),
+        .reg_busy    (reg_busy)
     );
 
     // ========================================
@@ -145,20 +188,41 @@ module uart_axi_top #(
     uart_top #(
         .DATA_WIDTH     (DATA_WIDTH),
         .TX_FIFO_DEPTH  (TX_FIFO_DEPTH),
-        .RX_FIFO_DEPTH  (RX_FIFO_DEPTH)
+        .RX_FIFO_DEPTH  (RX_FIFO_DEPTH),
+        .PERF_COUNTERS  (PERF_COUNTERS),
+        .IDLE_GATING    (IDLE_GATING)
     ) uart_core (
         .uart_clk    (clk),       // Single clock for Phase 5.3
         .rst_n       (rst_n),
         // Register interface from AXI
         .reg_addr    (reg_addr),
         .reg_wdata   (reg_wdata),
+        .reg_wstrb   (reg_wstrb),
         .reg_wen     (reg_wen),
         .reg_ren     (reg_ren),
         .reg_rdata   (reg_rdata),
         .reg_error   (reg_error),
+        .reg_busy    (reg_busy),
+        // Stream / DMA interface
+        .s_axis_tdata  (s_axis_tdata),
+        .s_axis_tvalid (s_axis_tvalid),
+        .s_axis_tready (s_axis_tready),
+        .m_axis_tdata  (m_axis_tdata),
+        .m_axis_tvalid (m_axis_tvalid),
+        .m_axis_tready (m_axis_tready),
+        .tx_dma_req    (tx_dma_req),
+        .rx_dma_req    (rx_dma_req),
         // UART serial interface
         .uart_tx     (uart_tx),
         .uart_rx     (uart_rx),
+        // Flow control
+        .uart_rts_n  (uart_rts_n),
+        .uart_cts_n  (uart_cts_n),
+        // Own baud_gen
+        .ext_baud_tick    (1'b0),
+        .baud_divisor_out (),
+        .baud_frac_out    (),
+        .baud_enable_out  (),
         // Interrupt output
         .irq         (irq)
     );
@@ -5,7 +5,9 @@
  * Connects register interface to UART TX/RX paths with proper side effects.
  *
  * Register Map (byte-addressed, 32-bit aligned):
- *   0x00: CTRL        - Control register (TX_EN, RX_EN)
+ *   0x00: CTRL        - Control register (TX_EN, RX_EN, PACK_EN, STREAM_EN,
+ *                       OSR, RTS_EN, CTS_EN, INT_RTC, LOOPBACK, PRBS_EN,
+ *                       TX_EARLY, AUTOBAUD)
  *   0x04: STATUS      - Status register (RO, reflects hardware state)
  *   0x08: TX_DATA     - Transmit data (WO, pushes to TX FIFO)
  *   0x0C: RX_DATA     - Receive data (RO, pops from RX FIFO)
@@ -13,20 +15,69 @@
  *   0x14: INT_ENABLE  - Interrupt enable
  *   0x18: INT_STATUS  - Interrupt status (W1C)
  *   0x1C: FIFO_CTRL   - FIFO control (self-clearing)
+ *   0x20: FIFO_THRESH - FIFO watermark thresholds (TX low, RX high)
+ *   0x24: RX_TIMEOUT  - RX character timeout (bit times)
+ *   0x28: BAUD_FRAC   - Baud divisor fraction (1/64 steps)
+ *   0x2C: FLOW_CTRL   - RTS threshold (RX FIFO level)
+ *   0x30: ISR_SNAPSHOT - Pending interrupts, levels and errors (RO)
+ *   0x34: PERF_CTRL   - Performance counter select, snapshot, clear
+ *   0x38: PERF_DATA   - Selected counter snapshot (RO)
  *
  * Features:
  * - Register read/write with proper access control (RW/RO/WO)
  * - TX_DATA write → automatic FIFO push
  * - RX_DATA read → automatic FIFO pop (with prefetch)
- * - W1C (Write-1-to-Clear) for INT_STATUS
+ * - W1C (Write-1-to-Clear) for INT_STATUS, or read-to-clear with
+ *   CTRL.INT_RTC
+ * - ISR_SNAPSHOT: masked pending interrupts, TX/RX levels and sticky
+ *   errors in one read, so an ISR needs one bus access to find its work
  * - Self-clearing bits in FIFO_CTRL
  * - Interrupt generation based on enable and status
+ * - Level-based TX-low / RX-high watermark interrupts (one IRQ per burst
+ *   instead of per byte)
+ * - RX character timeout: flags bytes left below the RX watermark once the
+ *   line has been idle for RX_TIMEOUT bit times (16550-style)
+ * - Packed access (CTRL.PACK_EN): a TX_DATA write queues every byte lane
+ *   enabled in reg_wstrb (lane 0 first); an RX_DATA read returns up to
+ *   three bytes in [23:0] with the byte count in [25:24]
+ * - Stream mode (CTRL.STREAM_EN): the TX FIFO write side and the RX
+ *   holding buffer are handed to valid/ready byte streams for a DMA
+ *   engine, with burst requests driven by the FIFO watermarks
+ * - Fractional baud divisor: BAUD_DIV + BAUD_FRAC/64 uart_clk cycles per
+ *   baud tick
+ * - Oversampling select (CTRL.OSR): 16, 8 or 4 baud ticks per bit, for
+ *   2× / 4× the baud rate from the same divisor
+ * - Hardware flow control: RTS deasserts while the RX FIFO holds
+ *   FLOW_CTRL.RTS_THRESH bytes or more (CTRL.RTS_EN); CTS gates TX frame
+ *   starts (CTRL.CTS_EN, applied in uart_top)
  * - Error flag management (sticky, clear via INT_STATUS)
+ * - Performance counters (PERF_COUNTERS=1): TX/RX bytes, frame errors,
+ *   overruns, TX FIFO-empty stall cycles and the RX FIFO high-water mark,
+ *   read through a coherent snapshot and cleared together
+ * - Internal loopback (CTRL.LOOPBACK, applied in uart_top): the TX serial
+ *   line feeds the RX path and RTS feeds CTS, for a self-test without a
+ *   cable
+ * - PRBS self-test (CTRL.PRBS_EN, PERF_COUNTERS=1): a PRBS-15 generator
+ *   keeps the TX FIFO full and a self-synchronizing checker consumes every
+ *   received byte, counting checked bits and bit errors in PERF counters
+ *   6 and 7
+ * - Early TX accept (CTRL.TX_EARLY, applied in uart_tx_path): a byte
+ *   written to an idle transmitter skips the TX FIFO and starts its frame
+ *   on a fresh baud phase, for the lowest first-byte latency
+ * - Autobaud (CTRL.AUTOBAUD, measured by autobaud in uart_top): the
+ *   detector's result is loaded into BAUD_DIV/BAUD_FRAC, AUTOBAUD clears
+ *   itself and INT_STATUS.AUTOBAUD is set
  *
  * Critical Implementation:
- * - RX prefetch logic handles FIFO 1-cycle read latency
+ * - RX prefetch logic handles FIFO 1-cycle read latency (two bytes held so
+ *   back-to-back reads see no bubble, three in packed mode)
+ * - Packed TX bytes drain into the TX FIFO one per cycle; reg_busy is high
+ *   until they have (bytes that meet a full FIFO are dropped, like a
+ *   TX_DATA write to a full FIFO, and set the sticky STATUS.TX_OVERRUN)
  * - Reserved bits read as 0, writes ignored
- * - Baud enable when TX_EN or RX_EN set
+ * - Baud enable when TX_EN or RX_EN set (uart_top may gate it further
+ *   while idle, with rx_timer_run keeping the RX idle timer ticking)
+ * - STATUS level fields are 8 bits and saturate at 255 for deep FIFOs
  *
  * References:
  * - INTERFACE_SPECIFICATIONS.md - Module 9: uart_regs
@@ -34,7 +85,8 @@
 
 module uart_regs #(
     parameter int DATA_WIDTH = 32,
-    parameter int FIFO_ADDR_WIDTH = 3  // For 8-deep FIFOs
+    parameter int FIFO_ADDR_WIDTH = 3,  // For 8-deep FIFOs (up to 15)
+    parameter bit PERF_COUNTERS = 1'b1  // 0 = PERF_* read 0 (no counter logic)
 ) (
     // Clock and reset
     input  logic                    uart_clk,
@@ -43,10 +95,12 @@ module uart_regs #(
     // Register interface
     input  logic [3:0]              reg_addr,      // Word address (byte addr >> 2)
     input  logic [DATA_WIDTH-1:0]   reg_wdata,
+    input  logic [DATA_WIDTH/8-1:0] reg_wstrb,     // Byte lanes (packed TX_DATA)
     input  logic                    reg_wen,
     input  logic                    reg_ren,
     output logic [DATA_WIDTH-1:0]   reg_rdata,
     output logic                    reg_error,
+    output logic                    reg_busy,      // Packed write in progress
 
     // TX path interface
     output logic [7:0]              wr_data,
@@ -65,15 +119,44 @@ module uart_regs #(
     input  logic [FIFO_ADDR_WIDTH:0] rx_level,
     input  logic                    frame_error,
     input  logic                    overrun_error,
+    input  logic                    rx_done,       // Byte received (perf counters)
+    input  logic                    rx_frame_error, // rx_done with a bad stop bit
 
     // Baud generator interface
     output logic [15:0]             baud_divisor,
+    output logic [5:0]              baud_frac,     // Divisor fraction, /64
     output logic                    baud_enable,
+    input  logic                    baud_tick,     // RX idle timer time base
+    output logic                    rx_timer_run,  // RX idle timer needs baud_tick
+    output logic [1:0]              osr_sel,       // CTRL.OSR to uart_tx/uart_rx
+
+    // Flow control
+    output logic                    rts_n,         // Request to send (active low)
+    output logic                    cts_en,        // CTRL.CTS_EN to the TX gate
+    output logic                    loopback,      // CTRL.LOOPBACK to the pin muxes
+    output logic                    tx_early,      // CTRL.TX_EARLY to uart_tx_path
+
+    // Autobaud detector
+    output logic                    autobaud_en,   // CTRL.AUTOBAUD: search for 0x55
+    output logic                    rx_enable,     // CTRL.RX_EN (RX input isolation)
+    input  logic                    autobaud_done, // Result valid: load and clear
+    input  logic [15:0]             autobaud_div,
+    input  logic [5:0]              autobaud_frac,
 
     // FIFO control
     output logic                    tx_fifo_rst,
     output logic                    rx_fifo_rst,
 
+    // Stream interface (CTRL.STREAM_EN)
+    input  logic [7:0]              s_axis_tdata,  // TX bytes in
+    input  logic                    s_axis_tvalid,
+    output logic                    s_axis_tready,
+    output logic [7:0]              m_axis_tdata,  // RX bytes out
+    output logic                    m_axis_tvalid,
+    input  logic                    m_axis_tready,
+    output logic                    tx_dma_req,    // TX burst request
+    output logic                    rx_dma_req,    // RX burst request
+
     // Interrupt output
     output logic                    irq
 );
@@ -87,56 +170,120 @@ module uart_regs #(
     localparam logic [3:0] ADDR_INT_ENABLE = 4'h5;
     localparam logic [3:0] ADDR_INT_STATUS = 4'h6;
     localparam logic [3:0] ADDR_FIFO_CTRL  = 4'h7;
+    localparam logic [3:0] ADDR_FIFO_THRESH = 4'h8;
+    localparam logic [3:0] ADDR_RX_TIMEOUT  = 4'h9;
+    localparam logic [3:0] ADDR_BAUD_FRAC   = 4'hA;
+    localparam logic [3:0] ADDR_FLOW_CTRL   = 4'hB;
+    localparam logic [3:0] ADDR_ISR_SNAPSHOT = 4'hC;
+    localparam logic [3:0] ADDR_PERF_CTRL   = 4'hD;
+    localparam logic [3:0] ADDR_PERF_DATA   = 4'hE;
+
+    localparam int LEVEL_WIDTH = FIFO_ADDR_WIDTH + 1;  // 0..DEPTH
 
     // Registers
-    logic [1:0]  ctrl_reg;          // [1:0] = {RX_EN, TX_EN}
+    logic [12:0] ctrl_reg /*verilator public_flat_rd*/;
+                                    // [12:0] = {AUTOBAUD, TX_EARLY, PRBS_EN, LOOPBACK,
+                                    //           INT_RTC, CTS_EN, RTS_EN, OSR[1:0],
+                                    //           STREAM_EN, PACK_EN, RX_EN, TX_EN}
     logic [15:0] baud_div_reg;
-    logic [3:0]  int_enable_reg;
-    logic [3:0]  int_status_reg;
+    logic [5:0]  baud_frac_reg;     // Divisor fraction, 1/64 cycle steps
+    logic [7:0]  int_enable_reg;
+    logic [7:0]  int_status_reg;
+    logic [LEVEL_WIDTH-1:0] tx_low_wm_reg;   // TX_LOW_WM threshold
+    logic [LEVEL_WIDTH-1:0] rx_high_wm_reg;  // RX_HIGH_WM threshold
+    logic [7:0]  rx_timeout_reg;    // RX character timeout, bit times
+    logic [LEVEL_WIDTH-1:0] rts_thresh_reg;  // RTS deassert level
 
     // Internal signals
     logic        reg_write;
     logic        reg_read;
-    logic [7:0]  rx_holding_reg;
-    logic        rx_data_valid;
+    logic        rx_data_read;      // RX_DATA read (pop side effect)
+    logic        stream_en;         // Data path owned by the stream ports
+    logic        prbs_en;           // Data path owned by the PRBS generator/checker
+    logic        rx_reg_pop;        // RX_DATA read that pops (not streaming)
+    logic        rx_stream_pop;     // m_axis handshake
+    logic        rx_prbs_pop;       // PRBS checker takes the oldest held byte
+    logic        prbs_push;         // PRBS generator byte to the TX FIFO
+    logic [7:0]  prbs_tx_byte;      // Next generated byte (bit 0 sent first)
+    logic [7:0]  rx_holding_reg;    // Oldest held byte (RX_DATA[7:0])
+    logic [1:0]  rx_hold_count;     // Bytes held for RX_DATA (0..2, 3 packed)
     logic        frame_error_sticky;
     logic        overrun_error_sticky;
 
-    // RX prefetch state machine
-    typedef enum logic [1:0] {
-        RX_IDLE,
-        RX_FETCHING,
-        RX_READY
-    } rx_state_t;
-    rx_state_t rx_state;
-
     // Decode register accesses
     assign reg_write = reg_wen;
     assign reg_read = reg_ren;
+    assign rx_data_read = reg_read && (reg_addr == ADDR_RX_DATA);
+    assign prbs_en = ctrl_reg[10];
+    assign stream_en = ctrl_reg[3] && !prbs_en;  // PRBS_EN wins over STREAM_EN
+    assign rx_reg_pop = rx_data_read && !stream_en && !prbs_en;
 
     // ========================================
     // CTRL Register (0x00) - RW
     // ========================================
+    // PRBS_EN needs the PERF counters for its results: RAZ/WI without them
+    localparam logic [12:0] CTRL_WMASK = PERF_COUNTERS ? 13'h1FFF : 13'h1BFF;
+
     always_ff @(posedge uart_clk or negedge rst_n) begin
         if (!rst_n) begin
-            ctrl_reg <= 2'b00;
+            ctrl_reg <= 13'h0000;
         end else if (reg_write && reg_addr == ADDR_CTRL) begin
-            ctrl_reg <= reg_wdata[1:0];
+            ctrl_reg <= reg_wdata[12:0] & CTRL_WMASK;
+        end else if (autobaud_done) begin
+            ctrl_reg[12] <= 1'b0;       // AUTOBAUD clears on lock
         end
     end
 
+    // OSR: 00 = 16×, 01 = 8×, 10 = 4× baud ticks per bit (11 reserved, 16×)
+    assign osr_sel = ctrl_reg[5:4];
+
+    // CTS_EN: uart_tx only starts a frame while the far end asserts CTS
+    assign cts_en = ctrl_reg[7];
+
+    // LOOPBACK: uart_top routes TX into RX (and RTS into CTS) internally
+    assign loopback = ctrl_reg[9];
+
+    // TX_EARLY: uart_tx_path hands a write to an idle uart_tx directly
+    assign tx_early = ctrl_reg[11];
+
+    // AUTOBAUD: the detector hunts for a sync character while set
+    assign autobaud_en = ctrl_reg[12];
+
+    // RX_EN: uart_top (IDLE_GATING=1) isolates the RX synchronizer while
+    // neither RX_EN nor AUTOBAUD is set
+    assign rx_enable = ctrl_reg[1];
+
     // ========================================
     // BAUD_DIV Register (0x10) - RW
     // ========================================
+    // Also loaded by the autobaud detector (a write on the same cycle wins)
     always_ff @(posedge uart_clk or negedge rst_n) begin
         if (!rst_n) begin
             baud_div_reg <= 16'h0004;  // Default 115200
         end else if (reg_write && reg_addr == ADDR_BAUD_DIV) begin
             baud_div_reg <= reg_wdata[15:0];
+        end else if (autobaud_done) begin
+            baud_div_reg <= autobaud_div;
         end
     end
 
     assign baud_divisor = baud_div_reg;
+
+    // ========================================
+    // BAUD_FRAC Register (0x28) - RW
+    // ========================================
+    // Tick period = BAUD_DIV + BAUD_FRAC/64 cycles (0 = integer divisor)
+    always_ff @(posedge uart_clk or negedge rst_n) begin
+        if (!rst_n) begin
+            baud_frac_reg <= 6'h00;
+        end else if (reg_write && reg_addr == ADDR_BAUD_FRAC) begin
+            baud_frac_reg <= reg_wdata[5:0];
+        end else if (autobaud_done) begin
+            baud_frac_reg <= autobaud_frac;
+        end
+    end
+
+    assign baud_frac = baud_frac_reg;
     assign baud_enable = (ctrl_reg[0] || ctrl_reg[1]);  // TX_EN or RX_EN
 
     // ========================================
@@ -144,9 +291,26 @@ module uart_regs #(
     // ========================================
     always_ff @(posedge uart_clk or negedge rst_n) begin
         if (!rst_n) begin
-            int_enable_reg <= 4'h0;
+            int_enable_reg <= 8'h00;
         end else if (reg_write && reg_addr == ADDR_INT_ENABLE) begin
-            int_enable_reg <= reg_wdata[3:0];
+            int_enable_reg <= reg_wdata[7:0];
+        end
+    end
+
+    // ========================================
+    // FIFO_THRESH Register (0x20) - RW
+    // ========================================
+    // [15:0]  TX_LOW_WM  - TX_LOW_WM fires while tx_level <= threshold
+    // [31:16] RX_HIGH_WM - RX_HIGH_WM fires while rx_count >= threshold
+    //                      (0 disables)
+    // Only the low LEVEL_WIDTH bits of each field are implemented.
+    always_ff @(posedge uart_clk or negedge rst_n) begin
+        if (!rst_n) begin
+            tx_low_wm_reg  <= '0;                  // TX FIFO empty
+            rx_high_wm_reg <= LEVEL_WIDTH'(1);     // Any received byte
+        end else if (reg_write && reg_addr == ADDR_FIFO_THRESH) begin
+            tx_low_wm_reg  <= reg_wdata[LEVEL_WIDTH-1:0];
+            rx_high_wm_reg <= reg_wdata[16 +: LEVEL_WIDTH];
         end
     end
 
@@ -158,30 +322,109 @@ module uart_regs #(
     // [1] RX_READY   - RX FIFO not empty
     // [2] FRAME_ERR  - Frame error detected
     // [3] OVERRUN    - Overrun error detected
+    // [4] TX_LOW_WM  - TX FIFO level at or below TX_LOW_WM
+    // [5] RX_HIGH_WM - RX byte count at or above RX_HIGH_WM
+    // [6] RX_TIMEOUT - RX bytes waiting and line idle for RX_TIMEOUT bits
+    // [7] AUTOBAUD   - Autobaud locked, BAUD_DIV/BAUD_FRAC loaded
 
     logic tx_ready_event, rx_ready_event;
+    logic tx_low_wm_event, rx_high_wm_event;
+    logic rx_timeout_event;
+    logic [LEVEL_WIDTH:0] rx_count;
+    logic [7:0] int_pending;        // Enabled and set
+    logic [7:0] int_rtc_clear;      // Bits returned by a read-to-clear read
+
     assign tx_ready_event = !tx_full && ctrl_reg[0];   // TX enabled and not full
     assign rx_ready_event = !rx_empty && ctrl_reg[1];  // RX enabled and not empty
 
+    // RX count includes the bytes waiting in the RX_DATA holding buffer
+    assign rx_count = {1'b0, rx_level} + (LEVEL_WIDTH+1)'(rx_hold_count);
+
+    assign tx_low_wm_event  = ctrl_reg[0] && (tx_level <= tx_low_wm_reg);
+    assign rx_high_wm_event = ctrl_reg[1] && (rx_high_wm_reg != '0) &&
+                              (rx_count >= {1'b0, rx_high_wm_reg});
+
+    assign int_pending = int_status_reg & int_enable_reg;
+
+    // Read-to-clear (CTRL.INT_RTC): an INT_STATUS read clears every bit it
+    // returns, an ISR_SNAPSHOT read the pending bits it returns. Only the
+    // bits read are cleared, so an event on the read cycle is not lost.
+    always_comb begin
+        int_rtc_clear = 8'h00;
+        if (reg_read && ctrl_reg[8]) begin
+            if (reg_addr == ADDR_INT_STATUS)   int_rtc_clear = int_status_reg;
+            if (reg_addr == ADDR_ISR_SNAPSHOT) int_rtc_clear = int_pending;
+        end
+    end
+
     always_ff @(posedge uart_clk or negedge rst_n) begin
         if (!rst_n) begin
-            int_status_reg <= 4'h0;
+            int_status_reg <= 8'h00;
         end else begin
+            // Clear bits on read-to-clear (events below take priority)
+            int_status_reg <= int_status_reg & ~int_rtc_clear;
+
             // Set bits on events
             if (tx_ready_event) int_status_reg[0] <= 1'b1;
             if (rx_ready_event) int_status_reg[1] <= 1'b1;
             if (frame_error) int_status_reg[2] <= 1'b1;
             if (overrun_error) int_status_reg[3] <= 1'b1;
+            if (tx_low_wm_event) int_status_reg[4] <= 1'b1;
+            if (rx_high_wm_event) int_status_reg[5] <= 1'b1;
+            if (rx_timeout_event) int_status_reg[6] <= 1'b1;
+            if (autobaud_done) int_status_reg[7] <= 1'b1;
 
             // Clear bits on W1C
             if (reg_write && reg_addr == ADDR_INT_STATUS) begin
-                int_status_reg <= int_status_reg & ~reg_wdata[3:0];
+                int_status_reg <= int_status_reg & ~reg_wdata[7:0];
             end
         end
     end
 
     // Generate IRQ output
-    assign irq = |(int_status_reg & int_enable_reg);
+    assign irq = |int_pending;
+
+    // ========================================
+    // RX_TIMEOUT Register (0x24) - RW
+    // ========================================
+    // [7:0] Character timeout in bit times (0 disables)
+    always_ff @(posedge uart_clk or negedge rst_n) begin
+        if (!rst_n) begin
+            rx_timeout_reg <= 8'h00;
+        end else if (reg_write && reg_addr == ADDR_RX_TIMEOUT) begin
+            rx_timeout_reg <= reg_wdata[7:0];
+        end
+    end
+
+    // Idle timer: counts baud ticks (16, 8 or 4 per bit, per CTRL.OSR)
+    // while bytes are waiting, the line is idle and RX_DATA is not being
+    // read. A new start bit or an RX_DATA read (or stream pop) restarts it;
+    // it holds at the limit until then.
+    logic [11:0] rx_idle_count;
+    logic [11:0] rx_timeout_limit;
+    logic        rx_timeout_armed;
+
+    assign rx_timeout_limit = (osr_sel == 2'b01) ? {1'b0, rx_timeout_reg, 3'h0} :
+                              (osr_sel == 2'b10) ? {2'b0, rx_timeout_reg, 2'h0} :
+                                                   {rx_timeout_reg, 4'h0};
+    assign rx_timeout_armed = ctrl_reg[1] && (rx_timeout_reg != 8'h00) &&
+                              (rx_count != '0) && !rx_active &&
+                              !rx_data_read && !rx_stream_pop && !rx_prbs_pop;
+
+    always_ff @(posedge uart_clk or negedge rst_n) begin
+        if (!rst_n) begin
+            rx_idle_count <= 12'h000;
+        end else if (!rx_timeout_armed) begin
+            rx_idle_count <= 12'h000;
+        end else if (baud_tick && rx_idle_count != rx_timeout_limit) begin
+            rx_idle_count <= rx_idle_count + 12'h001;
+        end
+    end
+
+    assign rx_timeout_event = rx_timeout_armed && (rx_idle_count == rx_timeout_limit);
+
+    // Still counting: uart_top (IDLE_GATING=1) keeps baud_tick running
+    assign rx_timer_run = rx_timeout_armed && (rx_idle_count != rx_timeout_limit);
 
     // ========================================
     // Sticky Error Flags
@@ -191,6 +434,10 @@ module uart_regs #(
             frame_error_sticky <= 1'b0;
             overrun_error_sticky <= 1'b0;
         end else begin
+            // Clear with the INT_STATUS bit on read-to-clear
+            if (int_rtc_clear[2]) frame_error_sticky <= 1'b0;
+            if (int_rtc_clear[3]) overrun_error_sticky <= 1'b0;
+
             // Set on error
             if (frame_error) frame_error_sticky <= 1'b1;
             if (overrun_error) overrun_error_sticky <= 1'b1;
@@ -207,59 +454,138 @@ module uart_regs #(
     // TX_DATA Register (0x08) - WO
     // ========================================
     // Write side effect: push to TX FIFO
-    assign wr_en = reg_write && (reg_addr == ADDR_TX_DATA) && !tx_full;
-    assign wr_data = reg_wdata[7:0];
+    // Packed mode: enabled byte lanes are staged and pushed lowest lane
+    // first, one per cycle. A write that arrives while lanes are still
+    // staged is dropped (reg_busy tells the bus to wait). A byte that meets
+    // a full FIFO is dropped and sets STATUS.TX_OVERRUN.
+    // Stream mode: writes are dropped, the FIFO is fed from s_axis.
+    // PRBS mode: writes are dropped, the FIFO is fed by the generator.
+    logic        tx_data_write;
+    logic [31:0] tx_pack_data;
+    logic [3:0]  tx_pack_valid;
+    logic [1:0]  tx_pack_lane;
+    logic        tx_pack_pending;
+
+    assign tx_data_write = reg_write && (reg_addr == ADDR_TX_DATA) && !stream_en && !prbs_en;
+    assign tx_pack_pending = (tx_pack_valid != 4'h0);
+
+    // Lowest staged lane
+    always_comb begin
+        if (tx_pack_valid[0])      tx_pack_lane = 2'd0;
+        else if (tx_pack_valid[1]) tx_pack_lane = 2'd1;
+        else if (tx_pack_valid[2]) tx_pack_lane = 2'd2;
+        else                       tx_pack_lane = 2'd3;
+    end
+
+    always_ff @(posedge uart_clk or negedge rst_n) begin
+        if (!rst_n) begin
+            tx_pack_data <= 32'h0;
+            tx_pack_valid <= 4'h0;
+        end else if (tx_fifo_rst) begin
+            tx_pack_valid <= 4'h0;
+        end else if (tx_pack_pending) begin
+            // One lane per cycle (dropped if the FIFO is full)
+            tx_pack_valid[tx_pack_lane] <= 1'b0;
+        end else if (tx_data_write && ctrl_reg[2]) begin
+            tx_pack_data <= reg_wdata[31:0];
+            tx_pack_valid <= reg_wstrb[3:0];
+        end
+    end
+
+    assign wr_en = !tx_full && (tx_pack_pending || (tx_data_write && !ctrl_reg[2]) ||
+                                (s_axis_tvalid && s_axis_tready) || prbs_push);
+    assign wr_data = tx_pack_pending ? tx_pack_data[{tx_pack_lane, 3'b000} +: 8] :
+                     prbs_en         ? prbs_tx_byte :
+                     stream_en       ? s_axis_tdata :
+                                       reg_wdata[7:0];
+
+    // Busy from the write cycle until the last staged lane has drained
+    assign reg_busy = tx_pack_pending ||
+                      (tx_data_write && ctrl_reg[2] && (reg_wstrb[3:0] != 4'h0));
+
+    // TX overrun: a packed lane or a TX_DATA write met a full FIFO. Sticky
+    // until a TX FIFO reset (the byte stream has a hole from here on).
+    logic tx_drop;
+    logic tx_overrun_sticky;
+
+    assign tx_drop = tx_full && (tx_pack_pending || (tx_data_write && !ctrl_reg[2]));
+
+    always_ff @(posedge uart_clk or negedge rst_n) begin
+        if (!rst_n) begin
+            tx_overrun_sticky <= 1'b0;
+        end else if (tx_fifo_rst) begin
+            tx_overrun_sticky <= 1'b0;
+        end else if (tx_drop) begin
+            tx_overrun_sticky <= 1'b1;
+        end
+    end
 
     // ========================================
     // RX_DATA Register (0x0C) - RO
     // ========================================
     // Read side effect: pop from RX FIFO (with prefetch)
-    // Prefetch FSM to handle FIFO 1-cycle read latency
+    // Prefetch keeps bytes outside the FIFO so RX_DATA is available
+    // combinationally, hiding the FIFO 1-cycle read latency. A fetch issues
+    // rd_en and the byte is appended to the holding buffer on the next
+    // cycle. Normally two bytes are held (skid buffer): a read frees a slot
+    // while the second byte covers the refill latency, so back-to-back
+    // RX_DATA reads each return a fresh byte. Packed mode holds three.
+    logic [23:0] rx_hold_data;      // Lane 0 = oldest byte
+    logic [23:0] rx_hold_shifted;
+    logic [1:0]  rx_hold_limit;
+    logic [1:0]  rx_hold_consume;
+    logic [1:0]  rx_hold_remain;
+    logic        rx_fetch_pending;  // rd_en issued last cycle
+
+    assign rx_hold_limit = ctrl_reg[2] ? 2'd3 : 2'd2;
+
+    // A read consumes the oldest byte, or every held byte in packed mode;
+    // a stream handshake or the PRBS checker always consumes one
+    assign rx_hold_consume = (rx_stream_pop || rx_prbs_pop) ? 2'd1 :
+                             !rx_reg_pop   ? 2'd0 :
+                             ctrl_reg[2]   ? rx_hold_count :
+                             {1'b0, (rx_hold_count != 2'd0)};
+    assign rx_hold_remain = rx_hold_count - rx_hold_consume;
+
+    // Remaining bytes move down to lane 0; when none remain the old value
+    // stays visible (RX_DATA re-reads the last byte, as before)
+    assign rx_hold_shifted = (rx_hold_remain == 2'd0) ? rx_hold_data :
+                             (rx_hold_data >> {rx_hold_consume, 3'b000});
 
     always_ff @(posedge uart_clk or negedge rst_n) begin
         if (!rst_n) begin
-            rx_state <= RX_IDLE;
-            rx_holding_reg <= 8'h00;
-            rx_data_valid <= 1'b0;
+            rx_hold_data <= 24'h0;
+            rx_hold_count <= 2'd0;
+            rx_fetch_pending <= 1'b0;
         end else begin
-            case (rx_state)
-                RX_IDLE: begin
-                    if (!rx_empty) begin
-                        // Data available, start fetch
-                        rx_state <= RX_FETCHING;
-                        rx_data_valid <= 1'b0;
-                    end
-                end
+            rx_fetch_pending <= rd_en;
+            rx_hold_data <= rx_hold_shifted;
+            if (rx_fetch_pending) begin
+                rx_hold_data[{rx_hold_remain, 3'b000} +: 8] <= rx_data;
+            end
+            rx_hold_count <= rx_hold_remain + {1'b0, rx_fetch_pending};
+        end
+    end
 
-                RX_FETCHING: begin
-                    // Wait one cycle for FIFO read latency
-                    rx_holding_reg <= rx_data;
-                    rx_data_valid <= 1'b1;
-                    rx_state <= RX_READY;
-                end
+    assign rx_holding_reg = rx_hold_data[7:0];
 
-                RX_READY: begin
-                    if (reg_read && reg_addr == ADDR_RX_DATA) begin
-                        // Data consumed, check if more available
-                        if (!rx_empty) begin
-                            rx_state <= RX_FETCHING;
-                            rx_data_valid <= 1'b0;
-                        end else begin
-                            rx_state <= RX_IDLE;
-                            rx_data_valid <= 1'b0;
-                        end
-                    end
-                end
+    // Generate rd_en for RX FIFO: fetch while the holding buffer (counting
+    // the fetch in flight) has room
+    assign rd_en = !rx_empty &&
+                   (({1'b0, rx_hold_remain} + {2'b00, rx_fetch_pending}) < {1'b0, rx_hold_limit});
 
-                default: rx_state <= RX_IDLE;
-            endcase
+    // Packed RX_DATA: {count, byte2, byte1, byte0}, unused lanes zero
+    logic [31:0] rx_packed_value;
+
+    always_comb begin
+        rx_packed_value = {6'h00, rx_hold_count, 24'h000000};
+        for (int i = 0; i < 3; i++) begin
+            if (2'(i) < rx_hold_count) begin
+                rx_packed_value[i*8 +: 8] = rx_hold_data[i*8 +: 8];
+            end
         end
     end
 
-    // Generate rd_en for RX FIFO
-    assign rd_en = (rx_state == RX_IDLE && !rx_empty) ||  // Initial fetch
-                   (rx_state == RX_READY && reg_read && reg_addr == ADDR_RX_DATA && !rx_empty);  // Refetch
-
     // ========================================
     // FIFO_CTRL Register (0x1C) - Self-clearing
     // ========================================
@@ -281,15 +607,147 @@ module uart_regs #(
     assign tx_fifo_rst = fifo_ctrl_reg[0];
     assign rx_fifo_rst = fifo_ctrl_reg[1];
 
+    // ========================================
+    // FLOW_CTRL Register (0x2C) - RW
+    // ========================================
+    // [15:0] RTS_THRESH - RTS deasserts while rx_level >= threshold
+    //                     (0 holds RTS deasserted)
+    // Only the low LEVEL_WIDTH bits are implemented. Reset is half the
+    // largest FIFO, leaving room for the frame the far end may already
+    // have started when RTS drops.
+    always_ff @(posedge uart_clk or negedge rst_n) begin
+        if (!rst_n) begin
+            rts_thresh_reg <= LEVEL_WIDTH'(1 << (FIFO_ADDR_WIDTH - 1));
+        end else if (reg_write && reg_addr == ADDR_FLOW_CTRL) begin
+            rts_thresh_reg <= reg_wdata[LEVEL_WIDTH-1:0];
+        end
+    end
+
+    // RTS follows the RX FIFO level (not the holding buffer, which drains
+    // into RX_DATA reads) so the FIFO never overruns while the far end
+    // honours it. Registered: the pin must not glitch. With RTS_EN clear
+    // RTS stays asserted.
+    always_ff @(posedge uart_clk or negedge rst_n) begin
+        if (!rst_n) begin
+            rts_n <= 1'b1;
+        end else begin
+            rts_n <= ctrl_reg[6] && (rx_level >= rts_thresh_reg);
+        end
+    end
+
+    // ========================================
+    // Stream Interface (CTRL.STREAM_EN)
+    // ========================================
+    // TX: s_axis bytes are pushed straight into the TX FIFO, one per cycle
+    // while it has room (after any packed lanes still draining).
+    // RX: m_axis presents the oldest held byte; each handshake pops it and
+    // the prefetch refills behind it, so a ready sink drains one byte per
+    // cycle. TX_DATA writes are dropped and RX_DATA reads return 0 without
+    // popping while the streams own the data path.
+    assign s_axis_tready = stream_en && !tx_full && !tx_pack_pending;
+
+    assign m_axis_tdata  = rx_holding_reg;
+    assign m_axis_tvalid = stream_en && (rx_hold_count != 2'd0);
+    assign rx_stream_pop = m_axis_tvalid && m_axis_tready;
+
+    // Burst requests, level-sensitive on the watermark conditions: TX when
+    // the FIFO is at or below TX_LOW_WM (room for DEPTH - TX_LOW_WM bytes),
+    // RX when at least RX_HIGH_WM bytes are waiting
+    assign tx_dma_req = stream_en && tx_low_wm_event;
+    assign rx_dma_req = stream_en && rx_high_wm_event;
+
+    // ========================================
+    // PRBS Generator / Checker (CTRL.PRBS_EN)
+    // ========================================
+    // PRBS-15 (x^15 + x^14 + 1, ITU-T O.150) at line rate, 8 LFSR steps
+    // per byte with byte bit 0 as the earliest sequence bit, so the 8N1
+    // line carries the sequence in order.
+    // TX: a generated byte is pushed whenever the TX FIFO has room (after
+    // any packed lanes have drained); TX_DATA writes and s_axis are ignored.
+    // RX: every held byte goes to the checker instead of RX_DATA/m_axis.
+    // The checker predicts each bit from the previous 15 received bits, so
+    // it locks to whatever phase arrives (the far end may be another UART)
+    // and recovers by itself after a dropped byte. Bits are checked once
+    // two bytes have filled the history. One flipped line bit counts as
+    // three errors: the bit itself and the two later predictions using it.
+    // Clearing PRBS_EN restarts generator and checker.
+    localparam logic [14:0] PRBS_SEED = 15'h7FFF;
+
+    logic [14:0] prbs_tx_state;
+    logic [14:0] prbs_tx_next;
+    logic [14:0] prbs_rx_hist;      // Last 15 received bits, newest in [0]
+    logic [14:0] prbs_rx_next;
+    logic [3:0]  prbs_bit_errs;     // Mismatches in the byte being checked
+    logic [1:0]  prbs_rx_fill;      // Bytes of history (saturates at 2)
+    logic        prbs_check;        // Byte checked this cycle
+    logic        prbs_lock;         // Last checked byte had no errors
+
+    always_comb begin
+        prbs_tx_next = prbs_tx_state;
+        for (int i = 0; i < 8; i++) begin
+            prbs_tx_byte[i] = prbs_tx_next[14] ^ prbs_tx_next[13];
+            prbs_tx_next = {prbs_tx_next[13:0], prbs_tx_byte[i]};
+        end
+    end
+
+    always_comb begin
+        prbs_rx_next = prbs_rx_hist;
+        prbs_bit_errs = 4'd0;
+        for (int i = 0; i < 8; i++) begin
+            prbs_bit_errs = prbs_bit_errs +
+                            4'(rx_holding_reg[i] != (prbs_rx_next[14] ^ prbs_rx_next[13]));
+            prbs_rx_next = {prbs_rx_next[13:0], rx_holding_reg[i]};
+        end
+    end
+
+    assign prbs_push   = prbs_en && !tx_pack_pending;
+    assign rx_prbs_pop = prbs_en && (rx_hold_count != 2'd0);
+    assign prbs_check  = rx_prbs_pop && (prbs_rx_fill == 2'd2);
+
+    always_ff @(posedge uart_clk or negedge rst_n) begin
+        if (!rst_n) begin
+            prbs_tx_state <= PRBS_SEED;
+            prbs_rx_hist <= 15'h0;
+            prbs_rx_fill <= 2'd0;
+            prbs_lock <= 1'b0;
+        end else if (!prbs_en) begin
+            prbs_tx_state <= PRBS_SEED;
+            prbs_rx_hist <= 15'h0;
+            prbs_rx_fill <= 2'd0;
+            prbs_lock <= 1'b0;
+        end else begin
+            if (prbs_push && !tx_full) begin
+                prbs_tx_state <= prbs_tx_next;
+            end
+            if (rx_prbs_pop) begin
+                prbs_rx_hist <= prbs_rx_next;
+                if (prbs_rx_fill != 2'd2) prbs_rx_fill <= prbs_rx_fill + 2'd1;
+            end
+            if (prbs_check) begin
+                prbs_lock <= (prbs_bit_errs == 4'd0);
+            end
+        end
+    end
+
     // ========================================
     // STATUS Register (0x04) - RO
     // ========================================
     logic [DATA_WIDTH-1:0] status_value;
+    logic [15:0] tx_level_ext, rx_level_ext;
+    logic [7:0]  tx_level_sat, rx_level_sat;
+
+    // 8-bit level fields saturate at 255 (FIFO depths of 256 and above)
+    assign tx_level_ext = 16'(tx_level);
+    assign rx_level_ext = 16'(rx_level);
+    assign tx_level_sat = (tx_level_ext > 16'd255) ? 8'hFF : tx_level_ext[7:0];
+    assign rx_level_sat = (rx_level_ext > 16'd255) ? 8'hFF : rx_level_ext[7:0];
 
     assign status_value = {
-        8'h00,                          // [31:24] Reserved
-        rx_level[7:0],                  // [23:16] RX FIFO level
-        tx_level[7:0],                  // [15:8]  TX FIFO level
+        6'h00,                          // [31:26] Reserved
+        tx_overrun_sticky,              // [25]    TX byte dropped (FIFO full)
+        prbs_lock,                      // [24]    PRBS checker locked
+        rx_level_sat,                   // [23:16] RX FIFO level
+        tx_level_sat,                   // [15:8]  TX FIFO level
         overrun_error_sticky,           // [7]     Overrun error
         frame_error_sticky,             // [6]     Frame error
         rx_active,                      // [5]     RX active
@@ -300,20 +758,164 @@ module uart_regs #(
         tx_empty                        // [0]     TX FIFO empty
     };
 
+    // ========================================
+    // ISR_SNAPSHOT Register (0x30) - RO
+    // ========================================
+    // Everything an ISR needs to decide what to service, in one read:
+    // RX count includes the holding buffer, so it is the number of RX_DATA
+    // reads with data behind them
+    logic [DATA_WIDTH-1:0] isr_snapshot_value;
+    logic [15:0] rx_count_ext;
+    logic [7:0]  rx_count_sat;
+
+    assign rx_count_ext = 16'(rx_count);
+    assign rx_count_sat = (rx_count_ext > 16'd255) ? 8'hFF : rx_count_ext[7:0];
+
+    assign isr_snapshot_value = {
+        6'h00,                          // [31:26] Reserved
+        overrun_error_sticky,           // [25]    Overrun error
+        frame_error_sticky,             // [24]    Frame error
+        rx_count_sat,                   // [23:16] RX bytes readable
+        tx_level_sat,                   // [15:8]  TX FIFO level
+        int_pending                     // [7:0]   INT_STATUS & INT_ENABLE
+    };
+
+    // ========================================
+    // PERF_CTRL (0x34) / PERF_DATA (0x38) - Performance Counters
+    // ========================================
+    // PERF_CTRL:
+    // [2:0] SEL      - Counter returned by PERF_DATA (written on every
+    //                  PERF_CTRL write)
+    // [8]   SNAPSHOT - Write 1: copy every counter to the PERF_DATA shadow
+    // [9]   CLEAR    - Write 1: restart the counters (with SNAPSHOT, the
+    //                  shadow gets the values from before the clear)
+    // [31]  PRESENT  - RO: 1 when built with PERF_COUNTERS
+    //
+    // Counters (SEL), 32 bits, saturating:
+    // 0 TX_BYTES   - Frames completed on uart_tx (tx_active falling edge)
+    // 1 RX_BYTES   - Bytes stored in the RX FIFO
+    // 2 FRAME_ERRS - Frames received with a bad stop bit
+    // 3 OVERRUNS   - Bytes dropped on a full RX FIFO
+    // 4 TX_STALLS  - Cycles with TX_EN set, uart_tx idle and the TX FIFO empty
+    // 5 RX_HWM     - Highest RX FIFO level since the last clear
+    // 6 PRBS_BITS  - Bits checked by the PRBS checker (+8 per byte)
+    // 7 PRBS_ERRS  - PRBS bit errors (see PRBS Generator / Checker)
+    //
+    // PERF_DATA returns the snapshot, not the live counter, so all counters
+    // read after one SNAPSHOT describe the same cycle.
+    //
+    // Simulation: ctrl_reg and perf_count are public so the testbench's
+    // idle fast-forward (DutDriver, DUT_DRIVER_UART_REGS) can add the
+    // skipped cycles to TX_STALLS, the one counter that moves while idle.
+    localparam int PERF_NUM    = 8;
+    localparam int PERF_RX_HWM = 5;
+    localparam int PERF_PRBS_BITS = 6;
+    localparam int PERF_PRBS_ERRS = 7;
+
+    logic [2:0]  perf_sel_reg;
+    logic        perf_ctrl_write;
+    logic        perf_snapshot;
+    logic        perf_clear;
+    logic [PERF_NUM-1:0][31:0] perf_count /*verilator public_flat_rw*/;
+    logic [PERF_NUM-1:0][31:0] perf_shadow;
+
+    assign perf_ctrl_write = reg_write && (reg_addr == ADDR_PERF_CTRL);
+    assign perf_snapshot   = perf_ctrl_write && reg_wdata[8];
+    assign perf_clear      = perf_ctrl_write && reg_wdata[9];
+
+    always_ff @(posedge uart_clk or negedge rst_n) begin
+        if (!rst_n) begin
+            perf_sel_reg <= 3'h0;
+        end else if (perf_ctrl_write) begin
+            perf_sel_reg <= reg_wdata[2:0];
+        end
+    end
+
+    generate
+        if (PERF_COUNTERS) begin : g_perf
+            logic [PERF_RX_HWM-1:0] perf_event;  // Incrementing counters
+            logic [31:0] rx_level_ext32;
+            logic        tx_active_q;
+
+            always_ff @(posedge uart_clk or negedge rst_n) begin
+                if (!rst_n) begin
+                    tx_active_q <= 1'b0;
+                end else begin
+                    tx_active_q <= tx_active;
+                end
+            end
+
+            assign perf_event = {
+                ctrl_reg[0] && tx_empty && !tx_active,  // 4 TX_STALLS
+                rx_done && rx_full,                     // 3 OVERRUNS
+                rx_frame_error,                         // 2 FRAME_ERRS
+                rx_done && !rx_full,                    // 1 RX_BYTES
+                tx_active_q && !tx_active               // 0 TX_BYTES
+            };
+            assign rx_level_ext32 = 32'(rx_level);
+
+            always_ff @(posedge uart_clk or negedge rst_n) begin
+                if (!rst_n) begin
+                    perf_count <= '0;
+                end else if (perf_clear) begin
+                    perf_count <= '0;
+                    perf_count[PERF_RX_HWM] <= rx_level_ext32;
+                end else begin
+                    for (int i = 0; i < PERF_RX_HWM; i++) begin
+                        if (perf_event[i] && perf_count[i] != 32'hFFFFFFFF) begin
+                            perf_count[i] <= perf_count[i] + 32'd1;
+                        end
+                    end
+                    if (rx_level_ext32 > perf_count[PERF_RX_HWM]) begin
+                        perf_count[PERF_RX_HWM] <= rx_level_ext32;
+                    end
+                    if (prbs_check) begin
+                        perf_count[PERF_PRBS_BITS] <=
+                            (perf_count[PERF_PRBS_BITS] > 32'hFFFFFFF7) ? 32'hFFFFFFFF :
+                            perf_count[PERF_PRBS_BITS] + 32'd8;
+                        perf_count[PERF_PRBS_ERRS] <=
+                            (perf_count[PERF_PRBS_ERRS] > ~32'(prbs_bit_errs)) ? 32'hFFFFFFFF :
+                            perf_count[PERF_PRBS_ERRS] + 32'(prbs_bit_errs);
+                    end
+                end
+            end
+
+            always_ff @(posedge uart_clk or negedge rst_n) begin
+                if (!rst_n) begin
+                    perf_shadow <= '0;
+                end else if (perf_snapshot) begin
+                    perf_shadow <= perf_count;
+                end
+            end
+        end else begin : g_no_perf
+            assign perf_count  = '0;
+            assign perf_shadow = '0;
+        end
+    endgenerate
+
     // ========================================
     // Register Read Mux
     // ========================================
     // Combinational read for same-cycle availability (required by AXI-Lite interface)
     always_comb begin
         case (reg_addr)
-            ADDR_CTRL:       reg_rdata = {30'h0, ctrl_reg};
+            ADDR_CTRL:       reg_rdata = {19'h0, ctrl_reg};
             ADDR_STATUS:     reg_rdata = status_value;
             ADDR_TX_DATA:    reg_rdata = 32'h0;  // Write-only
-            ADDR_RX_DATA:    reg_rdata = {24'h0, rx_holding_reg};
+            ADDR_RX_DATA:    reg_rdata = (stream_en || prbs_en) ? 32'h0 :
+                                         ctrl_reg[2]            ? rx_packed_value :
+                                                                  {24'h0, rx_holding_reg};
             ADDR_BAUD_DIV:   reg_rdata = {16'h0, baud_div_reg};
-            ADDR_INT_ENABLE: reg_rdata = {28'h0, int_enable_reg};
-            ADDR_INT_STATUS: reg_rdata = {28'h0, int_status_reg};
+            ADDR_INT_ENABLE: reg_rdata = {24'h0, int_enable_reg};
+            ADDR_INT_STATUS: reg_rdata = {24'h0, int_status_reg};
             ADDR_FIFO_CTRL:  reg_rdata = {30'h0, fifo_ctrl_reg};
+            ADDR_FIFO_THRESH: reg_rdata = {16'(rx_high_wm_reg), 16'(tx_low_wm_reg)};
+            ADDR_RX_TIMEOUT: reg_rdata = {24'h0, rx_timeout_reg};
+            ADDR_BAUD_FRAC:  reg_rdata = {26'h0, baud_frac_reg};
+            ADDR_FLOW_CTRL:  reg_rdata = {16'h0, 16'(rts_thresh_reg)};
+            ADDR_ISR_SNAPSHOT: reg_rdata = isr_snapshot_value;
+            ADDR_PERF_CTRL:  reg_rdata = {PERF_COUNTERS, 28'h0, perf_sel_reg};
+            ADDR_PERF_DATA:  reg_rdata = perf_shadow[perf_sel_reg];
             default:         reg_rdata = 32'h0;
         endcase
     end
@@ -332,6 +934,9 @@ module uart_regs #(
 
         assert (FIFO_ADDR_WIDTH >= 3)
             else $warning("uart_regs: FIFO_ADDR_WIDTH < 3 may cause level truncation");
+
+        assert (FIFO_ADDR_WIDTH <= 15)
+            else $error("uart_regs: FIFO_ADDR_WIDTH > 15 exceeds FIFO_THRESH field width");
     end
 
     // Runtime assertions
@@ -345,9 +950,9 @@ module uart_regs #(
             assert (!(rd_en && rx_empty))
                 else $error("uart_regs: RX FIFO read when empty");
 
-            // CTRL register should only have 2 bits
-            assert (ctrl_reg <= 2'b11)
-                else $error("uart_regs: ctrl_reg out of range");
+            // Packed TX_DATA writes must wait for reg_busy to clear
+            assert (!(tx_data_write && ctrl_reg[2] && tx_pack_pending))
+                else $warning("uart_regs: packed TX_DATA write while busy (dropped)");
         end
     end
 `endif
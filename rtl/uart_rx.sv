@@ -1,27 +1,31 @@
 /*
  * UART Receiver
  *
- * Deserializes UART frame format (8N1) with 16× oversampling.
+ * Deserializes UART frame format (8N1) with 16×, 8× or 4× oversampling.
  * Frame: 1 start bit (0) + 8 data bits (LSB first) + 1 stop bit (1)
  *
  * Features:
  * - 8N1 format (8 data bits, no parity, 1 stop bit)
- * - 16× oversampling for noise immunity
- * - Bit-center sampling (sample at count 8 of 16)
+ * - 16× oversampling for noise immunity (8×/4× selectable at runtime via
+ *   osr_sel for higher baud rates from the same uart_clk)
+ * - Bit-center sampling (sample at count 8 of 16, 3 of 8, 1 of 4)
  * - Start bit validation (false start detection)
  * - Stop bit validation (frame error detection)
  * - Ready/valid handshake interface
  *
  * Timing:
- * - Bit period = 16 sample_ticks
+ * - Bit period = 16 sample_ticks (8 / 4 with osr_sel = 2'b01 / 2'b10)
  * - Frame time = 160 sample_ticks (10 bits × 16)
- * - Sample point = count 8 (middle of bit)
+ * - Sample point = count 8 (middle of bit); at 8×/4× one count earlier
+ *   than the middle, since the start-edge latency (bit_sync + IDLE exit)
+ *   is a larger fraction of a short bit
  *
  * Usage:
  *   uart_rx rx_inst (
  *       .uart_clk        (uart_clk),
  *       .rst_n           (rst_n),
  *       .sample_tick     (sample_tick_16x),
+ *       .osr_sel         (osr_sel),
  *       .rx_serial_sync  (rx_synchronized),
  *       .rx_data         (data_out),
  *       .rx_valid        (valid),
@@ -32,8 +36,11 @@
  *
  * IMPORTANT:
  * - rx_serial_sync must be synchronized (use bit_sync)
- * - sample_tick must be 16× baud rate
+ * - sample_tick must be 16× baud rate (8× / 4× when osr_sel selects it)
  * - Sample at middle of bit (count 8) for noise immunity
+ * - Change osr_sel only while idle (rx_active=0)
+ * - At 4× the 3-cycle synchronizer latency is most of a bit when
+ *   sample_tick fires every uart_clk; keep 2+ uart_clk per sample_tick
  *
  * References:
  * - INTERFACE_SPECIFICATIONS.md - Module 5: uart_rx
@@ -49,6 +56,7 @@ module uart_rx #(
 
     // Sample rate tick
     input  logic                  sample_tick,
+    input  logic [1:0]            osr_sel,         // 00: 16×, 01: 8×, 10: 4×
 
     // Serial input (synchronized!)
     input  logic                  rx_serial_sync,
@@ -80,6 +88,18 @@ module uart_rx #(
     logic [2:0]            bit_counter;    // Count 0-7 for data bits
     logic                  frame_error_reg;
 
+    // Oversampling: last count of a bit period and the sample point
+    logic [3:0]            bit_last;
+    logic [3:0]            bit_mid;
+
+    always_comb begin
+        case (osr_sel)
+            2'b01:   begin bit_last = 4'd7; bit_mid = 4'd3; end  // 8×
+            2'b10:   begin bit_last = 4'd3; bit_mid = 4'd1; end  // 4×
+            default: begin bit_last = 4'd15; bit_mid = 4'd8; end // 16× (11 reserved)
+        endcase
+    end
+
     // State register
     always_ff @(posedge uart_clk or negedge rst_n) begin
         if (!rst_n)
@@ -100,14 +120,14 @@ module uart_rx #(
 
             START_BIT: begin
                 if (sample_tick) begin
-                    if (sample_counter == 8) begin
+                    if (sample_counter == bit_mid) begin
                         // Sample at middle of start bit
                         if (rx_serial_sync == 1'b1) begin
                             // False start - line went back high
                             next_state = IDLE;
                         end
                         // Valid start bit - continue
-                    end else if (sample_counter == 15) begin
+                    end else if (sample_counter == bit_last) begin
                         // End of start bit period
                         next_state = DATA_BITS;
                     end
@@ -115,14 +135,14 @@ module uart_rx #(
             end
 
             DATA_BITS: begin
-                if (sample_tick && sample_counter == 15) begin
+                if (sample_tick && sample_counter == bit_last) begin
                     if (bit_counter == 7)
                         next_state = STOP_BIT;
                 end
             end
 
             STOP_BIT: begin
-                if (sample_tick && sample_counter == 15) begin
+                if (sample_tick && sample_counter == bit_last) begin
                     next_state = WAIT_ACK;
                 end
             end
@@ -134,7 +154,7 @@ module uart_rx #(
         endcase
     end
 
-    // Sample counter (counts 0-15 within each bit period)
+    // Sample counter (counts 0-bit_last within each bit period)
     always_ff @(posedge uart_clk or negedge rst_n) begin
         if (!rst_n) begin
             sample_counter <= '0;
@@ -142,7 +162,7 @@ module uart_rx #(
             if (state == IDLE) begin
                 sample_counter <= '0;
             end else if (sample_tick) begin
-                if (sample_counter == 15)
+                if (sample_counter == bit_last)
                     sample_counter <= '0;
                 else
                     sample_counter <= sample_counter + 1'b1;
@@ -155,7 +175,7 @@ module uart_rx #(
         if (!rst_n) begin
             bit_counter <= '0;
         end else begin
-            if (state == DATA_BITS && sample_tick && sample_counter == 15) begin
+            if (state == DATA_BITS && sample_tick && sample_counter == bit_last) begin
                 bit_counter <= bit_counter + 1'b1;
             end else if (state != DATA_BITS) begin
                 bit_counter <= '0;
@@ -168,7 +188,7 @@ module uart_rx #(
         if (!rst_n) begin
             shift_reg <= '0;
         end else begin
-            if (state == DATA_BITS && sample_tick && sample_counter == 8) begin
+            if (state == DATA_BITS && sample_tick && sample_counter == bit_mid) begin
                 // Sample at middle of bit period, shift right (LSB first)
                 shift_reg <= {rx_serial_sync, shift_reg[DATA_WIDTH-1:1]};
             end
@@ -180,7 +200,7 @@ module uart_rx #(
         if (!rst_n) begin
             rx_data <= '0;
         end else begin
-            if (state == STOP_BIT && sample_tick && sample_counter == 8) begin
+            if (state == STOP_BIT && sample_tick && sample_counter == bit_mid) begin
                 // Latch data at stop bit sample point
                 rx_data <= shift_reg;
             end
@@ -192,7 +212,7 @@ module uart_rx #(
         if (!rst_n) begin
             frame_error_reg <= 1'b0;
         end else begin
-            if (state == STOP_BIT && sample_tick && sample_counter == 8) begin
+            if (state == STOP_BIT && sample_tick && sample_counter == bit_mid) begin
                 // Check stop bit at middle of bit period
                 if (rx_serial_sync != 1'b1)
                     frame_error_reg <= 1'b1;
@@ -208,7 +228,7 @@ module uart_rx #(
         if (!rst_n) begin
             rx_valid <= 1'b0;
         end else begin
-            if (state == STOP_BIT && sample_tick && sample_counter == 15) begin
+            if (state == STOP_BIT && sample_tick && sample_counter == bit_last) begin
                 // Assert valid at end of stop bit
                 rx_valid <= 1'b1;
             end else if (rx_valid && rx_ready) begin
@@ -236,9 +256,9 @@ module uart_rx #(
     // Runtime assertions
     always_ff @(posedge uart_clk) begin
         if (rst_n) begin
-            // sample_counter should never exceed 15
-            assert (sample_counter <= 15)
-                else $error("uart_rx: sample_counter=%0d exceeds 15", sample_counter);
+            // sample_counter should never exceed the bit period
+            assert (sample_counter <= bit_last)
+                else $error("uart_rx: sample_counter=%0d exceeds %0d", sample_counter, bit_last);
 
             // bit_counter should never exceed 7
             assert (bit_counter <= 7)
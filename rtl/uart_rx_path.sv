@@ -15,6 +15,10 @@
  * - Frame error detection (invalid stop bit)
  * - Overrun error detection (FIFO full when new data arrives)
  * - Duplicate write prevention (one byte per rx_valid assertion)
+ * - rx_done pulse per received byte, stored or dropped, and rx_frame_error
+ *   with it for each byte with a bad stop bit (perf counters)
+ * - Synchronized line out (rx_line) and an idle-line hold (rx_hold) for
+ *   the autobaud detector
  *
  * Usage:
  *   uart_rx_path #(
@@ -24,7 +28,10 @@
  *       .uart_clk      (uart_clk),
  *       .rst_n         (rst_n),
  *       .sample_tick   (sample_tick_16x),
+ *       .osr_sel       (osr_sel),      // 16× / 8× / 4× oversampling
  *       .rx_serial     (uart_rx_pin),  // Async input - will be synchronized
+ *       .rx_hold       (measuring),    // 1: uart_rx sees an idle line
+ *       .rx_line       (rx_sync),      // bit_sync output
  *       .rd_data       (rx_data),
  *       .rd_en         (read_enable),
  *       .rx_empty      (empty),
@@ -32,6 +39,8 @@
  *       .rx_active     (receiving),
  *       .frame_error   (framing_error),
  *       .overrun_error (overrun_err),
+ *       .rx_done       (byte_received), // 1-cycle pulse per frame
+ *       .rx_frame_error(bad_frame),     // rx_done of a bad-stop frame
  *       .rx_level      (fifo_level)
  *   );
  *
@@ -39,6 +48,8 @@
  * - rx_serial is asynchronous and MUST be synchronized internally
  * - Duplicate write prevention ensures exactly one FIFO write per byte received
  * - Errors (frame_error, overrun_error) are sticky and must be cleared by software
+ * - Raise rx_hold while uart_rx is idle (rx_active=0): a frame already in
+ *   progress completes on mark bits and is stored
  *
  * References:
  * - INTERFACE_SPECIFICATIONS.md - Module 7: uart_rx_path
@@ -55,9 +66,12 @@ module uart_rx_path #(
 
     // Sample rate tick
     input  logic                  sample_tick,
+    input  logic [1:0]            osr_sel,       // Ticks per bit: 00=16, 01=8, 10=4
 
     // Serial input (asynchronous!)
     input  logic                  rx_serial,
+    input  logic                  rx_hold,       // Hide the line from uart_rx
+    output logic                  rx_line,       // Synchronized rx_serial
 
     // FIFO read interface
     output logic [DATA_WIDTH-1:0] rd_data,
@@ -69,6 +83,8 @@ module uart_rx_path #(
     output logic                  rx_active,
     output logic                  frame_error,
     output logic                  overrun_error,
+    output logic                  rx_done,       // Byte received (stored or overrun)
+    output logic                  rx_frame_error, // rx_done with a bad stop bit
     output logic [$clog2(FIFO_DEPTH):0] rx_level
 );
 
@@ -98,6 +114,8 @@ module uart_rx_path #(
         .data_out   (rx_serial_sync)
     );
 
+    assign rx_line = rx_serial_sync;
+
     // =====================================================
     // Stage 2: UART Receiver
     // =====================================================
@@ -109,7 +127,8 @@ module uart_rx_path #(
         .uart_clk        (uart_clk),
         .rst_n           (rst_n),
         .sample_tick     (sample_tick),
-        .rx_serial_sync  (rx_serial_sync),
+        .osr_sel         (osr_sel),
+        .rx_serial_sync  (rx_serial_sync || rx_hold),
         .rx_data         (rx_data_internal),
         .rx_valid        (rx_valid_internal),
         .rx_ready        (rx_ready_internal),
@@ -137,8 +156,12 @@ module uart_rx_path #(
         end
     end
 
+    // First cycle of rx_valid: one pulse per received byte. The byte is
+    // written if the FIFO has room, otherwise it is dropped (overrun).
+    assign rx_done = rx_valid_internal && !rx_data_written;
+
     // Generate FIFO write enable: write on first cycle of rx_valid only
-    assign fifo_wr_en = rx_valid_internal && !rx_data_written && !rx_full;
+    assign fifo_wr_en = rx_done && !rx_full;
 
     // Generate rx_ready: handshake back to uart_rx
     // Ready when we've written to FIFO or when FIFO is full (discard)
@@ -179,6 +202,10 @@ module uart_rx_path #(
 
     assign frame_error = frame_error_reg;
 
+    // Per-frame strobe: uart_rx holds its flag from the stop bit until it
+    // returns to IDLE, so it is still set on the frame's rx_done cycle
+    assign rx_frame_error = rx_done && frame_error_internal;
+
     // =====================================================
     // Stage 6: RX FIFO
     // =====================================================
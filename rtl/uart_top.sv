@@ -4,6 +4,7 @@
  * Complete UART peripheral integrating all components:
  * - uart_regs: Register file
  * - baud_gen: Baud rate generator
+ * - autobaud: Sync-character rate detector (CTRL.AUTOBAUD)
  * - uart_tx_path: Transmit datapath (FIFO + TX)
  * - uart_rx_path: Receive datapath (bit_sync + RX + FIFO)
  *
@@ -15,10 +16,36 @@
  * Features:
  * - Complete UART peripheral with register interface
  * - 8N1 format (8 data bits, no parity, 1 stop bit)
- * - Configurable baud rate via divisor
- * - TX/RX FIFOs for buffering
+ * - Configurable baud rate via divisor (integer + 6-bit fraction)
+ * - Runtime oversampling select (CTRL.OSR: 16×, 8×, 4× baud ticks per bit)
+ * - RTS/CTS hardware flow control (CTRL.RTS_EN / CTRL.CTS_EN): RTS drops
+ *   at the FLOW_CTRL RX FIFO level, CTS low holds the next TX frame
+ * - TX/RX FIFOs for buffering (depth configurable, power of 2, up to 32768)
  * - Interrupt generation
+ * - Packed TX_DATA/RX_DATA access (CTRL.PACK_EN): several bytes per bus
+ *   transaction, reg_busy stalls the write response while unpacking
+ * - Byte stream ports for a DMA engine (CTRL.STREAM_EN): s_axis feeds the
+ *   TX FIFO, m_axis drains the RX FIFO, tx/rx_dma_req request bursts
  * - Error detection (frame, overrun)
+ * - Optional external baud tick (EXT_BAUD_TICK=1): baud_gen is left out and
+ *   the tick comes from a generator shared with other channels, driven
+ *   from this channel's baud_*_out (see uart_array_axi_top)
+ * - Performance counters behind PERF_CTRL/PERF_DATA (PERF_COUNTERS=1)
+ * - Internal loopback (CTRL.LOOPBACK): TX serial into the RX path and
+ *   RTS into the CTS synchronizer; uart_tx and uart_rts_n idle high and
+ *   uart_rx / uart_cts_n are ignored, so a cable and far end are not needed
+ * - PRBS-15 line-rate self-test (CTRL.PRBS_EN), with or without loopback
+ * - Early TX accept (CTRL.TX_EARLY): a write to an idle transmitter goes
+ *   straight to uart_tx (start bit 1 cycle after the write instead of 3)
+ *   and restarts baud_gen's tick period, unless a frame is being received
+ *   or the tick is external (EXT_BAUD_TICK=1 keeps the shared phase)
+ * - Idle gating (IDLE_GATING=1): baud_gen (or the shared tick) only runs
+ *   while a frame is on either line, the RX line is low or the RX idle
+ *   timer is counting, and the RX / CTS synchronizer inputs are held at
+ *   mark while RX_EN+AUTOBAUD / CTS_EN are clear. A falling edge on
+ *   uart_rx wakes the generator from a zero phase; uart_tx and uart_rx
+ *   only move on baud_tick or a frame start, so the gated tick is their
+ *   clock enable as well
  * - All logic in single uart_clk domain (simplified)
  *
  * Usage:
@@ -30,12 +57,24 @@
  *       .rst_n       (rst_n),
  *       .reg_addr    (addr),
  *       .reg_wdata   (wdata),
+ *       .reg_wstrb   (wstrb),
  *       .reg_wen     (wen),
  *       .reg_ren     (ren),
  *       .reg_rdata   (rdata),
  *       .reg_error   (error),
+ *       .reg_busy    (busy),
+ *       .s_axis_tdata (tx_tdata),   // ... s_axis_tvalid/tready
+ *       .m_axis_tdata (rx_tdata),   // ... m_axis_tvalid/tready
+ *       .tx_dma_req  (tx_req),
+ *       .rx_dma_req  (rx_req),
  *       .uart_tx     (tx_pin),
  *       .uart_rx     (rx_pin),
+ *       .uart_rts_n  (rts_pin),
+ *       .uart_cts_n  (cts_pin),     // Tie low when unused
+ *       .ext_baud_tick    (1'b0),   // EXT_BAUD_TICK=0: unused
+ *       .baud_divisor_out (),
+ *       .baud_frac_out    (),
+ *       .baud_enable_out  (),
  *       .irq         (interrupt)
  *   );
  *
@@ -46,7 +85,10 @@
 module uart_top #(
     parameter int DATA_WIDTH = 32,
     parameter int TX_FIFO_DEPTH = 8,
-    parameter int RX_FIFO_DEPTH = 8
+    parameter int RX_FIFO_DEPTH = 8,
+    parameter bit EXT_BAUD_TICK = 1'b0, // 1 = tick from ext_baud_tick, no baud_gen
+    parameter bit PERF_COUNTERS = 1'b1, // uart_regs performance counters
+    parameter bit IDLE_GATING = 1'b0    // 1 = baud tick and input syncs gated while idle
 ) (
     // Clock and reset
     input  logic                    uart_clk,
@@ -55,15 +97,37 @@ module uart_top #(
     // Register interface (simplified, no AXI for testing)
     input  logic [3:0]              reg_addr,
     input  logic [DATA_WIDTH-1:0]   reg_wdata,
+    input  logic [DATA_WIDTH/8-1:0] reg_wstrb,
     input  logic                    reg_wen,
     input  logic                    reg_ren,
     output logic [DATA_WIDTH-1:0]   reg_rdata,
     output logic                    reg_error,
+    output logic                    reg_busy,
+
+    // Byte stream interface (CTRL.STREAM_EN, tie off when unused)
+    input  logic [7:0]              s_axis_tdata,
+    input  logic                    s_axis_tvalid,
+    output logic                    s_axis_tready,
+    output logic [7:0]              m_axis_tdata,
+    output logic                    m_axis_tvalid,
+    input  logic                    m_axis_tready,
+    output logic                    tx_dma_req,
+    output logic                    rx_dma_req,
 
     // UART serial interface
     output logic                    uart_tx,
     input  logic                    uart_rx,
 
+    // Flow control (active low, CTRL.RTS_EN / CTRL.CTS_EN)
+    output logic                    uart_rts_n,
+    input  logic                    uart_cts_n,    // Asynchronous
+
+    // Shared baud generator (EXT_BAUD_TICK=1; tie ext_baud_tick low otherwise)
+    input  logic                    ext_baud_tick,
+    output logic [15:0]             baud_divisor_out,
+    output logic [5:0]              baud_frac_out,
+    output logic                    baud_enable_out,
+
     // Interrupt output
     output logic                    irq
 );
@@ -73,6 +137,8 @@ module uart_top #(
     // ========================================
     localparam int TX_FIFO_ADDR_WIDTH = $clog2(TX_FIFO_DEPTH);
     localparam int RX_FIFO_ADDR_WIDTH = $clog2(RX_FIFO_DEPTH);
+    localparam int REGS_FIFO_ADDR_WIDTH = (TX_FIFO_ADDR_WIDTH > RX_FIFO_ADDR_WIDTH) ?
+                                          TX_FIFO_ADDR_WIDTH : RX_FIFO_ADDR_WIDTH;
 
     // ========================================
     // Internal Signals
@@ -80,6 +146,8 @@ module uart_top #(
 
     // Baud generator
     logic [15:0] baud_divisor;
+    logic [5:0]  baud_frac;
+    logic [1:0]  osr_sel;       // CTRL.OSR, to uart_tx and uart_rx
     logic        baud_enable;
     logic        baud_tick;
 
@@ -100,66 +168,206 @@ module uart_top #(
     logic [RX_FIFO_ADDR_WIDTH:0] rx_level;
     logic        frame_error;
     logic        overrun_error;
+    logic        rx_done;       // Byte received (perf counters)
+    logic        rx_frame_error; // rx_done of a bad-stop frame (perf counters)
 
     // FIFO control
     logic        tx_fifo_rst;
     logic        rx_fifo_rst;
 
+    // Flow control
+    logic        cts_en;
+    logic        cts_n_sync;
+    logic        tx_cts;        // uart_tx may start a frame
+
+    // Loopback
+    logic        loopback;      // CTRL.LOOPBACK
+    logic        tx_serial;     // uart_tx_path output, before the pin mux
+    logic        rts_n;         // uart_regs RTS, before the pin mux
+    logic        rx_serial;     // uart_rx_path input, after the pin mux
+    logic        cts_n_in;      // CTS synchronizer input
+
+    // Early TX accept
+    logic        tx_early;      // CTRL.TX_EARLY
+    logic        tx_bypass;     // Write went straight to uart_tx
+
+    // Autobaud
+    logic        autobaud_en;   // CTRL.AUTOBAUD
+    logic        autobaud_busy; // Measuring: uart_rx held on an idle line
+    logic        autobaud_done;
+    logic [15:0] autobaud_div;
+    logic [5:0]  autobaud_frac;
+    logic        rx_line;       // Synchronized RX line (uart_rx_path)
+
+    // Idle gating
+    logic        rx_enable;     // CTRL.RX_EN
+    logic        rx_timer_run;  // RX idle timer counting baud ticks
+    logic        baud_demand;   // A block is waiting for baud ticks
+    logic        baud_run;      // baud_enable, gated while idle
+    logic        rx_sync_in;    // RX synchronizer input, isolated while off
+    logic        cts_sync_in;   // CTS synchronizer input, isolated while off
+
+    // Levels zero-extended to the register file width (TX/RX depths may differ)
+    logic [REGS_FIFO_ADDR_WIDTH:0] regs_tx_level;
+    logic [REGS_FIFO_ADDR_WIDTH:0] regs_rx_level;
+
+    assign regs_tx_level = (REGS_FIFO_ADDR_WIDTH+1)'(tx_level);
+    assign regs_rx_level = (REGS_FIFO_ADDR_WIDTH+1)'(rx_level);
+
     // ========================================
     // Module: uart_regs
     // ========================================
     // Register file connecting register interface to UART paths
     uart_regs #(
         .DATA_WIDTH       (DATA_WIDTH),
-        .FIFO_ADDR_WIDTH  ($clog2(TX_FIFO_DEPTH > RX_FIFO_DEPTH ? TX_FIFO_DEPTH : RX_FIFO_DEPTH))
+        .FIFO_ADDR_WIDTH  (REGS_FIFO_ADDR_WIDTH),
+        .PERF_COUNTERS    (PERF_COUNTERS)
     ) uart_regs_inst (
         .uart_clk       (uart_clk),
         .rst_n          (rst_n),
         // Register interface
         .reg_addr       (reg_addr),
         .reg_wdata      (reg_wdata),
+        .reg_wstrb      (reg_wstrb),
         .reg_wen        (reg_wen),
         .reg_ren        (reg_ren),
         .reg_rdata      (reg_rdata),
         .reg_error      (reg_error),
+        .reg_busy       (reg_busy),
         // TX path interface
         .wr_data        (wr_data),
         .wr_en          (wr_en),
         .tx_empty       (tx_empty),
         .tx_full        (tx_full),
         .tx_active      (tx_active),
-        .tx_level       (tx_level),
+        .tx_level       (regs_tx_level),
         // RX path interface
         .rx_data        (rx_data),
         .rd_en          (rd_en),
         .rx_empty       (rx_empty),
         .rx_full        (rx_full),
         .rx_active      (rx_active),
-        .rx_level       (rx_level),
+        .rx_level       (regs_rx_level),
         .frame_error    (frame_error),
         .overrun_error  (overrun_error),
+        .rx_done        (rx_done),
+        .rx_frame_error (rx_frame_error),
         // Baud generator interface
         .baud_divisor   (baud_divisor),
+        .baud_frac      (baud_frac),
         .baud_enable    (baud_enable),
+        .baud_tick      (baud_tick),
+        .rx_timer_run   (rx_timer_run),
+        .osr_sel        (osr_sel),
+        // Flow control
+        .rts_n          (rts_n),
+        .cts_en         (cts_en),
+        .loopback       (loopback),
+        .tx_early       (tx_early),
+        // Autobaud
+        .autobaud_en    (autobaud_en),
+        .rx_enable      (rx_enable),
+        .autobaud_done  (autobaud_done),
+        .autobaud_div   (autobaud_div),
+        .autobaud_frac  (autobaud_frac),
         // FIFO control
         .tx_fifo_rst    (tx_fifo_rst),
         .rx_fifo_rst    (rx_fifo_rst),
+        // Stream interface
+        .s_axis_tdata   (s_axis_tdata),
+        .s_axis_tvalid  (s_axis_tvalid),
+        .s_axis_tready  (s_axis_tready),
+        .m_axis_tdata   (m_axis_tdata),
+        .m_axis_tvalid  (m_axis_tvalid),
+        .m_axis_tready  (m_axis_tready),
+        .tx_dma_req     (tx_dma_req),
+        .rx_dma_req     (rx_dma_req),
         // Interrupt output
         .irq            (irq)
     );
 
+    // ========================================
+    // Idle Gating
+    // ========================================
+    // With IDLE_GATING=1 the baud tick only runs while something counts
+    // it: a frame in uart_tx or uart_rx, a low (possibly starting) RX line
+    // or the RX idle timer. uart_tx and uart_rx take their frame start
+    // without a tick, and the generator restarts from a zero phase, so the
+    // first tick is one period after the start edge. FIFO bytes held off
+    // by CTS do not run it. Synchronizers of disabled inputs see mark.
+    assign baud_demand = tx_active || tx_bypass || rx_active || !rx_line || rx_timer_run;
+    assign baud_run    = baud_enable && (!IDLE_GATING || baud_demand);
+    assign rx_sync_in  = rx_serial || (IDLE_GATING && !rx_enable && !autobaud_en);
+    assign cts_sync_in = cts_n_in || (IDLE_GATING && !cts_en);
+
     // ========================================
     // Module: baud_gen
     // ========================================
     // Baud rate generator producing sample tick for TX/RX
-    baud_gen baud_gen_inst (
-        .uart_clk       (uart_clk),
-        .rst_n          (rst_n),
-        .baud_divisor   (baud_divisor),
-        .enable         (baud_enable),
-        .baud_tick      (baud_tick)
+    // Full 16-bit divisor (BAUD_DIV[15:0]) so real baud rates are reachable,
+    // plus the BAUD_FRAC[5:0] fraction for accurate high rates
+    generate
+        if (EXT_BAUD_TICK) begin : g_ext_baud
+            // Shared generator: gated by this channel's own enable so a
+            // channel with TX_EN = RX_EN = 0 (or an idle one, with
+            // IDLE_GATING) stays frozen
+            assign baud_tick = ext_baud_tick && baud_run;
+        end else begin : g_baud_gen
+            baud_gen #(
+                .DIVISOR_WIDTH  (16),
+                .FRAC_WIDTH     (6)
+            ) baud_gen_inst (
+                .uart_clk       (uart_clk),
+                .rst_n          (rst_n),
+                .baud_divisor   (baud_divisor),
+                .baud_frac      (baud_frac),
+                .enable         (baud_run),
+                // A bypassed frame starts on a fresh tick period, so its
+                // start bit is a full bit time; not while uart_rx is
+                // counting ticks through a frame
+                .restart        (tx_bypass && !rx_active),
+                .baud_tick      (baud_tick)
+            );
+        end
+    endgenerate
+
+    // Divisor and enable for a shared generator
+    assign baud_divisor_out = baud_divisor;
+    assign baud_frac_out    = baud_frac;
+    assign baud_enable_out  = baud_run;
+
+    // ========================================
+    // Loopback Muxes
+    // ========================================
+    // CTRL.LOOPBACK turns the pins around inside the core (16550 MCR.LOOP
+    // style): the RX path samples the TX serial line through its own
+    // bit_sync, so the loop exercises the real synchronizer, sampling and
+    // FIFOs. The uart_tx pin is held at the idle (mark) level so the far
+    // end sees no traffic, and uart_rts_n deasserted so it does not send
+    // any: the RX FIFO filling in the loop must not pace the far end.
+    assign uart_tx    = loopback ? 1'b1 : tx_serial;
+    assign uart_rts_n = loopback ? 1'b1 : rts_n;
+    assign rx_serial  = loopback ? tx_serial : uart_rx;
+    assign cts_n_in   = loopback ? rts_n : uart_cts_n;
+
+    // ========================================
+    // Module: bit_sync (CTS)
+    // ========================================
+    // uart_cts_n is asynchronous; reset to deasserted. The gate is only
+    // sampled when uart_tx is idle, so a CTS drop lets the current frame
+    // finish and holds the next one.
+    bit_sync #(
+        .STAGES         (2),
+        .RESET_VALUE    (1'b1)
+    ) cts_sync_inst (
+        .clk_dst        (uart_clk),
+        .rst_n_dst      (rst_n),
+        .data_in        (cts_sync_in),
+        .data_out       (cts_n_sync)
     );
 
+    assign tx_cts = !cts_en || !cts_n_sync;
+
     // ========================================
     // Module: uart_tx_path
     // ========================================
@@ -171,6 +379,9 @@ module uart_top #(
         .uart_clk       (uart_clk),
         .rst_n          (rst_n && !tx_fifo_rst),  // Allow FIFO reset
         .baud_tick      (baud_tick),
+        .osr_sel        (osr_sel),
+        .tx_cts         (tx_cts),
+        .early_accept   (tx_early),
         // FIFO write interface
         .wr_data        (wr_data),
         .wr_en          (wr_en),
@@ -179,8 +390,9 @@ module uart_top #(
         .tx_full        (tx_full),
         .tx_active      (tx_active),
         .tx_level       (tx_level),
+        .tx_bypass      (tx_bypass),
         // Serial output
-        .tx_serial      (uart_tx)
+        .tx_serial      (tx_serial)
     );
 
     // ========================================
@@ -195,8 +407,11 @@ module uart_top #(
         .uart_clk       (uart_clk),
         .rst_n          (rst_n && !rx_fifo_rst),  // Allow FIFO reset
         .sample_tick    (baud_tick),
+        .osr_sel        (osr_sel),
         // Serial input (async)
-        .rx_serial      (uart_rx),
+        .rx_serial      (rx_sync_in),
+        .rx_hold        (autobaud_busy),
+        .rx_line        (rx_line),
         // FIFO read interface
         .rd_data        (rx_data),
         .rd_en          (rd_en),
@@ -206,9 +421,28 @@ module uart_top #(
         .rx_active      (rx_active),
         .frame_error    (frame_error),
         .overrun_error  (overrun_error),
+        .rx_done        (rx_done),
+        .rx_frame_error (rx_frame_error),
         .rx_level       (rx_level)
     );
 
+    // ========================================
+    // Module: autobaud
+    // ========================================
+    // Measures a 0x55 on the synchronized RX line; uart_regs loads the
+    // result into BAUD_DIV/BAUD_FRAC (so it also reaches baud_divisor_out)
+    autobaud autobaud_inst (
+        .uart_clk       (uart_clk),
+        .rst_n          (rst_n),
+        .enable         (autobaud_en),
+        .osr_sel        (osr_sel),
+        .rx_sync        (rx_line),
+        .busy           (autobaud_busy),
+        .done           (autobaud_done),
+        .divisor        (autobaud_div),
+        .frac           (autobaud_frac)
+    );
+
     // ========================================
     // Assertions for Verification
     // ========================================
@@ -223,6 +457,9 @@ module uart_top #(
 
         assert (RX_FIFO_DEPTH > 0 && (RX_FIFO_DEPTH & (RX_FIFO_DEPTH - 1)) == 0)
             else $error("uart_top: RX_FIFO_DEPTH must be power of 2");
+
+        assert (REGS_FIFO_ADDR_WIDTH <= 15)
+            else $error("uart_top: FIFO depth above 32768 not supported by FIFO_THRESH");
     end
 
     // Runtime assertions
@@ -7,12 +7,15 @@
  * Features:
  * - 8N1 format (8 data bits, no parity, 1 stop bit)
  * - Ready/valid handshake interface
- * - 16× oversampling (16 baud_ticks per bit period)
+ * - 16× oversampling (16 baud_ticks per bit period); 8× or 4× selectable
+ *   at runtime via osr_sel
  * - LSB-first transmission
  * - Idle line high (mark state)
+ * - CTS-gated start: a frame only starts while tx_cts is high; a frame
+ *   already on the line always completes
  *
  * Timing:
- * - Bit period = 16 baud_ticks
+ * - Bit period = 16 baud_ticks (8 / 4 with osr_sel = 2'b01 / 2'b10)
  * - Frame time = 160 baud_ticks (10 bits × 16)
  *
  * Usage:
@@ -20,6 +23,8 @@
  *       .uart_clk   (uart_clk),
  *       .rst_n      (rst_n),
  *       .baud_tick  (baud_tick_16x),
+ *       .osr_sel    (osr_sel),
+ *       .tx_cts     (clear_to_send),
  *       .tx_data    (data),
  *       .tx_valid   (valid),
  *       .tx_ready   (ready),
@@ -28,8 +33,11 @@
  *   );
  *
  * IMPORTANT:
- * - baud_tick must be 16× baud rate (from baud_gen)
+ * - baud_tick must be 16× baud rate (from baud_gen), 8× / 4× when osr_sel
+ *   selects it
+ * - Change osr_sel only while idle (tx_active=0)
  * - tx_data must be stable when tx_valid && tx_ready
+ * - tx_cts must be synchronous to uart_clk (tie high when unused)
  * - Transaction occurs in single cycle when both valid and ready
  *
  * References:
@@ -46,6 +54,10 @@ module uart_tx #(
 
     // Baud rate tick
     input  logic                  baud_tick,
+    input  logic [1:0]            osr_sel,         // 00: 16×, 01: 8×, 10: 4×
+
+    // Flow control
+    input  logic                  tx_cts,          // Clear to send (start gate)
 
     // Data interface (ready/valid)
     input  logic [DATA_WIDTH-1:0] tx_data,
@@ -72,6 +84,17 @@ module uart_tx #(
     logic [3:0]            tick_counter;   // Count 0-15 for bit period
     logic [2:0]            bit_counter;    // Count 0-7 for data bits
 
+    // Oversampling: last tick count of a bit period
+    logic [3:0]            bit_last;
+
+    always_comb begin
+        case (osr_sel)
+            2'b01:   bit_last = 4'd7;   // 8×
+            2'b10:   bit_last = 4'd3;   // 4×
+            default: bit_last = 4'd15;  // 16× (11 reserved)
+        endcase
+    end
+
     // State register
     always_ff @(posedge uart_clk or negedge rst_n) begin
         if (!rst_n)
@@ -90,17 +113,17 @@ module uart_tx #(
             end
 
             START: begin
-                if (baud_tick && tick_counter == OVERSAMPLE_RATE - 1)
+                if (baud_tick && tick_counter == bit_last)
                     next_state = DATA;
             end
 
             DATA: begin
-                if (baud_tick && tick_counter == OVERSAMPLE_RATE - 1 && bit_counter == 7)
+                if (baud_tick && tick_counter == bit_last && bit_counter == 7)
                     next_state = STOP;
             end
 
             STOP: begin
-                if (baud_tick && tick_counter == OVERSAMPLE_RATE - 1)
+                if (baud_tick && tick_counter == bit_last)
                     next_state = IDLE;
             end
         endcase
@@ -114,7 +137,7 @@ module uart_tx #(
             if (state == IDLE) begin
                 tick_counter <= '0;
             end else if (baud_tick) begin
-                if (tick_counter == OVERSAMPLE_RATE - 1)
+                if (tick_counter == bit_last)
                     tick_counter <= '0;
                 else
                     tick_counter <= tick_counter + 1'b1;
@@ -127,7 +150,7 @@ module uart_tx #(
         if (!rst_n) begin
             bit_counter <= '0;
         end else begin
-            if (state == DATA && baud_tick && tick_counter == OVERSAMPLE_RATE - 1) begin
+            if (state == DATA && baud_tick && tick_counter == bit_last) begin
                 bit_counter <= bit_counter + 1'b1;
             end else if (state != DATA) begin
                 bit_counter <= '0;
@@ -143,7 +166,7 @@ module uart_tx #(
             if (state == IDLE && tx_valid && tx_ready) begin
                 // Load data on transaction
                 shift_reg <= tx_data;
-            end else if (state == DATA && baud_tick && tick_counter == OVERSAMPLE_RATE - 1) begin
+            end else if (state == DATA && baud_tick && tick_counter == bit_last) begin
                 // Shift right after each bit transmitted
                 shift_reg <= {1'b0, shift_reg[DATA_WIDTH-1:1]};
             end
@@ -164,8 +187,8 @@ module uart_tx #(
         end
     end
 
-    // Ready signal
-    assign tx_ready = (state == IDLE);
+    // Ready signal (held off while the far end is not clear to send)
+    assign tx_ready = (state == IDLE) && tx_cts;
 
     // Active signal
     assign tx_active = (state != IDLE);
@@ -184,16 +207,16 @@ module uart_tx #(
     // Runtime assertions
     always_ff @(posedge uart_clk) begin
         if (rst_n) begin
-            // tick_counter should never exceed OVERSAMPLE_RATE-1
-            assert (tick_counter < OVERSAMPLE_RATE)
+            // tick_counter should never exceed the bit period
+            assert (tick_counter <= bit_last)
                 else $error("uart_tx: tick_counter=%0d exceeds max", tick_counter);
 
             // bit_counter should never exceed 7
             assert (bit_counter <= 7)
                 else $error("uart_tx: bit_counter=%0d exceeds 7", bit_counter);
 
-            // tx_ready should only be high in IDLE
-            assert ((state == IDLE) == tx_ready)
+            // tx_ready should only be high in IDLE, and only with CTS
+            assert (((state == IDLE) && tx_cts) == tx_ready)
                 else $error("uart_tx: tx_ready mismatch with state");
 
             // tx_active should be low only in IDLE
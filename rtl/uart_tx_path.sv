@@ -9,28 +9,41 @@
  * - Automatic drain from FIFO to uart_tx
  * - Status flags (empty, full, active, level)
  * - Simple write interface
+ * - CTS flow control: tx_cts low holds the next byte (FIFO keeps filling)
+ * - Early accept (early_accept=1): a byte written while the FIFO is empty
+ *   and uart_tx is idle goes straight to uart_tx in the write cycle,
+ *   skipping the FIFO's registered read; tx_bypass flags that cycle so
+ *   the baud generator can start a fresh tick period with the frame
  *
  * Architecture:
  *   wr_data → sync_fifo → uart_tx → tx_serial
  *   wr_en               (auto drain)
+ *      └──── bypass ────────┘   (early_accept, FIFO empty, uart_tx idle)
  *
  * Usage:
  *   uart_tx_path tx_path (
  *       .uart_clk   (uart_clk),
  *       .rst_n      (rst_n),
  *       .baud_tick  (baud_tick_16x),
+ *       .osr_sel    (osr_sel),     // 16× / 8× / 4× oversampling
+ *       .tx_cts     (cts),         // 1 when unused
+ *       .early_accept (low_latency), // 0: every byte through the FIFO
  *       .wr_data    (data),
  *       .wr_en      (write_strobe),
  *       .tx_serial  (uart_tx_pin),
  *       .tx_empty   (fifo_empty),
  *       .tx_full    (fifo_full),
  *       .tx_active  (transmitting),
- *       .tx_level   (fifo_level)
+ *       .tx_level   (fifo_level),
+ *       .tx_bypass  (fresh_baud)   // Byte sent without the FIFO this cycle
  *   );
  *
  * IMPORTANT:
  * - Check tx_full before writing
- * - uart_tx automatically drains FIFO when not empty
+ * - Write-to-start-bit latency: 3 cycles through the FIFO, 1 with early
+ *   accept (tx_serial is registered in uart_tx); a bypassed byte never
+ *   shows in tx_empty/tx_level, tx_active rises at the same edge
+ * - uart_tx automatically drains FIFO when not empty (while tx_cts is high)
  * - All signals in uart_clk domain (no CDC)
  *
  * References:
@@ -47,6 +60,9 @@ module uart_tx_path #(
 
     // Baud rate tick
     input  logic                 baud_tick,
+    input  logic [1:0]           osr_sel,      // Ticks per bit: 00=16, 01=8, 10=4
+    input  logic                 tx_cts,       // Clear to send (synchronous)
+    input  logic                 early_accept, // Idle-line writes bypass the FIFO
 
     // Write interface (to FIFO)
     input  logic [DATA_WIDTH-1:0] wr_data,
@@ -59,17 +75,20 @@ module uart_tx_path #(
     output logic                  tx_empty,
     output logic                  tx_full,
     output logic                  tx_active,
-    output logic [$clog2(FIFO_DEPTH):0] tx_level
+    output logic [$clog2(FIFO_DEPTH):0] tx_level,
+    output logic                  tx_bypass     // Write handed to uart_tx this cycle
 );
 
     // FIFO signals
+    logic                  fifo_wr_en;
     logic [DATA_WIDTH-1:0] fifo_rd_data;
     logic                  fifo_rd_en;
     logic                  fifo_rd_empty;
 
     // uart_tx signals
-    logic tx_ready;
-    logic tx_valid;
+    logic                  tx_ready;
+    logic                  tx_valid;
+    logic [DATA_WIDTH-1:0] tx_data;
 
     // TX FIFO instance
     sync_fifo #(
@@ -78,7 +97,7 @@ module uart_tx_path #(
     ) tx_fifo (
         .clk       (uart_clk),
         .rst_n     (rst_n),
-        .wr_en     (wr_en),
+        .wr_en     (fifo_wr_en),
         .wr_data   (wr_data),
         .wr_full   (tx_full),
         .rd_en     (fifo_rd_en),
@@ -95,7 +114,9 @@ module uart_tx_path #(
         .uart_clk   (uart_clk),
         .rst_n      (rst_n),
         .baud_tick  (baud_tick),
-        .tx_data    (fifo_rd_data),
+        .osr_sel    (osr_sel),
+        .tx_cts     (tx_cts),
+        .tx_data    (tx_data),
         .tx_valid   (tx_valid),
         .tx_ready   (tx_ready),
         .tx_serial  (tx_serial),
@@ -111,15 +132,24 @@ module uart_tx_path #(
         if (!rst_n) begin
             fifo_data_valid <= 1'b0;
         end else begin
-            // Data becomes valid 1 cycle after rd_en
-            fifo_data_valid <= fifo_rd_en;
+            // Data becomes valid 1 cycle after rd_en and stays valid until
+            // uart_tx takes it (CTS can drop between the read and the start)
+            fifo_data_valid <= fifo_rd_en || (fifo_data_valid && !tx_ready);
         end
     end
 
     // Automatic drain logic
     // Read from FIFO when: uart_tx is ready and (FIFO not empty and no pending read)
     assign fifo_rd_en = tx_ready && !fifo_rd_empty && !fifo_data_valid;
-    assign tx_valid = fifo_data_valid;
+
+    // Early accept: nothing queued (FIFO empty, no byte fetched) and
+    // uart_tx ready, so the written byte is the next one out anyway - hand
+    // it over in the write cycle instead of a FIFO round trip
+    assign tx_bypass  = early_accept && wr_en && tx_ready && fifo_rd_empty && !fifo_data_valid;
+    assign fifo_wr_en = wr_en && !tx_bypass;
+
+    assign tx_valid = fifo_data_valid || tx_bypass;
+    assign tx_data  = tx_bypass ? wr_data : fifo_rd_data;
 
     // Pass through empty flag
     assign tx_empty = fifo_rd_empty;
@@ -153,6 +183,12 @@ module uart_tx_path #(
                     else $error("uart_tx_path: Empty but level=%0d", tx_level);
             end
 
+            // A bypassed byte never competes with a queued one
+            if (tx_bypass) begin
+                assert (tx_empty && !fifo_data_valid && !fifo_rd_en)
+                    else $error("uart_tx_path: Bypass with a byte queued");
+            end
+
             // If full, level should be FIFO_DEPTH
             if (tx_full) begin
                 assert (tx_level == FIFO_DEPTH)
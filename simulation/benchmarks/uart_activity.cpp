@@ -0,0 +1,383 @@
+/*
+ * UART Switching-Activity Report
+ *
+ * Runs uart_top with and without IDLE_GATING through the same scenarios
+ * and reports, per module, how many signal bit toggles Verilator's
+ * toggle coverage counted over the scenario window. Toggle counts are the
+ * simulator's proxy for dynamic power: the gated build should switch far
+ * less while the UART is idle and about the same while frames move.
+ *
+ * Scenarios (BAUD_DIV 4 at 16x, 64 cycles per bit):
+ * - off_idle:      TX_EN = RX_EN = 0, lines idle
+ * - off_rx_noise:  TX_EN = RX_EN = 0, far end sending on uart_rx
+ * - on_idle:       TX_EN | RX_EN, lines idle
+ * - rx_burst:      8 frames on uart_rx, then idle; read back afterwards
+ * - tx_burst:      8 TX_DATA writes, then idle; uart_tx decoded
+ * - rx_timeout:    1 frame with RX_TIMEOUT = 4; INT_STATUS.RX_TIMEOUT set
+ *
+ * Usage:
+ *   uart_activity [--scenario <name>] [--bits <window bit times>]
+ *                 [--json <out.json>] [--check]
+ *
+ * IMPORTANT:
+ * - Counts are zeroed after reset and configuration, so every scenario
+ *   compares the same window of cycles on both builds
+ * - Functional checks (bytes read back, TX decoded, timeout raised) run
+ *   after the window on both builds and always fail the run
+ * - --check also fails unless the gated build switches less in every
+ *   scenario that leaves the UART idle or disabled with line activity,
+ *   and no more in off_idle
+ * - Exit status: 0 pass, 1 failed check, 2 usage error
+ */
+
+#include "Vuart_top.h"
+#include "Vuart_top_gated.h"
+#include <verilated.h>
+#include <verilated_cov.h>
+#include "coverage_db.h"
+#include "dut_driver.h"
+#include "uart_line.h"
+#include "uart_model.h"
+#include <unistd.h>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+DUT_DRIVER_PORTS(Vuart_top, uart_clk, rst_n);
+DUT_DRIVER_PORTS(Vuart_top_gated, uart_clk, rst_n);
+
+namespace {
+
+constexpr unsigned BAUD_DIV = 4;
+constexpr unsigned OVERSAMPLE = 16;
+constexpr unsigned SETTLE_CYCLES = 16;   // Synchronizers after configuration
+
+const uint8_t PATTERN[8] = {0x55, 0x00, 0xFF, 0x3C, 0xA5, 0x81, 0x7E, 0x12};
+
+struct Scenario {
+    const char* name;
+    const char* description;
+    uint32_t ctrl;
+    unsigned rx_bytes;     // Frames on uart_rx, from the window start
+    unsigned tx_bytes;     // TX_DATA writes, from the window start
+    uint8_t rx_timeout;    // RX_TIMEOUT, bit times (0 = off)
+    bool expect_saving;    // --check: gated must switch less
+};
+
+const Scenario SCENARIOS[] = {
+    {"off_idle", "TX_EN = RX_EN = 0, lines idle", 0, 0, 0, 0, false},
+    {"off_rx_noise", "TX_EN = RX_EN = 0, far end sending", 0, 8, 0, 0, true},
+    {"on_idle", "TX_EN | RX_EN, lines idle",
+     uart_reg::CTRL_TX_EN | uart_reg::CTRL_RX_EN, 0, 0, 0, true},
+    {"rx_burst", "8 frames received, then idle",
+     uart_reg::CTRL_TX_EN | uart_reg::CTRL_RX_EN, 8, 0, 0, true},
+    {"tx_burst", "8 frames sent, then idle",
+     uart_reg::CTRL_TX_EN | uart_reg::CTRL_RX_EN, 0, 8, 0, true},
+    {"rx_timeout", "1 frame received, RX_TIMEOUT = 4 bits",
+     uart_reg::CTRL_TX_EN | uart_reg::CTRL_RX_EN, 1, 0, 4, true},
+};
+
+// ========================================
+// Bench (either build)
+// ========================================
+
+template <typename Model>
+class ActivityBench : public DutDriver<Model> {
+public:
+    using DutDriver<Model>::dut;
+    using DutDriver<Model>::tick;
+
+    explicit ActivityBench(VerilatedContext* context) : DutDriver<Model>(context) {
+        dut->uart_rx = 1;
+        dut->uart_cts_n = 0;
+        dut->ext_baud_tick = 0;
+        dut->reg_addr = 0;
+        dut->reg_wdata = 0;
+        dut->reg_wstrb = 0xF;
+        dut->reg_wen = 0;
+        dut->reg_ren = 0;
+        dut->s_axis_tdata = 0;
+        dut->s_axis_tvalid = 0;
+        dut->m_axis_tready = 0;
+    }
+
+    void write_reg(uint8_t addr, uint32_t data) {
+        dut->reg_addr = addr;
+        dut->reg_wdata = data;
+        dut->reg_wen = 1;
+        tick();
+        dut->reg_wen = 0;
+    }
+
+    uint32_t read_reg(uint8_t addr) {
+        dut->reg_addr = addr;
+        dut->reg_ren = 1;
+        tick();
+        dut->reg_ren = 0;
+        tick();
+        return dut->reg_rdata;
+    }
+
+    // RX_DATA as axi_lite_slave_if captures it (on the access cycle)
+    uint32_t read_rx_data() {
+        dut->reg_addr = uart_reg::RX_DATA;
+        dut->reg_ren = 1;
+        dut->eval();
+        uint32_t value = dut->reg_rdata;
+        tick();
+        dut->reg_ren = 0;
+        tick();
+        return value;
+    }
+};
+
+// ========================================
+// Measurement
+// ========================================
+
+struct Activity {
+    std::map<std::string, uint64_t> modules;   // Toggles per module
+    uint64_t total = 0;
+    std::string error;                         // Functional check, empty: pass
+};
+
+// Toggle counts of a live context, via a scratch coverage file
+std::map<std::string, uint64_t> toggles_of(VerilatedContext* context) {
+    const char* tmp = std::getenv("TMPDIR");
+    std::string path = std::string(tmp && *tmp ? tmp : "/tmp") + "/uart_activity.XXXXXX";
+    int fd = mkstemp(&path[0]);
+    if (fd < 0) return {};
+    close(fd);
+    context->coveragep()->write(path.c_str());
+    CoverageDb db;
+    db.merge_file(path);
+    std::remove(path.c_str());
+    return db.toggle_activity();
+}
+
+template <typename Model>
+Activity measure(const Scenario& sc, unsigned window_bits) {
+    const UartLineConfig line{OVERSAMPLE, BAUD_DIV, 1};
+    const uint64_t window = uint64_t(window_bits) * line.bit_cycles();
+
+    std::unique_ptr<VerilatedContext> context(new VerilatedContext);
+    ActivityBench<Model> bench(context.get());
+    Model* dut = bench.dut;
+
+    bench.pulse_reset();
+    bench.write_reg(uart_reg::BAUD_DIV, BAUD_DIV);
+    if (sc.rx_timeout) bench.write_reg(uart_reg::RX_TIMEOUT, sc.rx_timeout);
+    bench.write_reg(uart_reg::CTRL, sc.ctrl);
+    bench.run_cycles(SETTLE_CYCLES);
+
+    std::vector<uint8_t> rx_bytes(PATTERN, PATTERN + sc.rx_bytes);
+    std::vector<uint8_t> tx_bytes(PATTERN, PATTERN + sc.tx_bytes);
+    LineWave rx_wave;
+    rx_wave.append(1, 2 * line.bit_cycles());
+    for (uint8_t b : rx_bytes) uart_line_append_frame(rx_wave, b, line);
+
+    // Window: only the stimulus differs between scenarios
+    context->coveragep()->zero();
+    LineWave tx_wave;
+    tx_wave.reserve(window);
+    for (uint64_t t = 0; t < window; t++) {
+        dut->uart_rx = t < rx_wave.size() ? rx_wave.get(t) : 1;
+        bool write = t < tx_bytes.size();
+        dut->reg_addr = write ? uart_reg::TX_DATA : 0;
+        dut->reg_wdata = write ? tx_bytes[t] : 0;
+        dut->reg_wen = write;
+        bench.tick();
+        tx_wave.push_back(dut->uart_tx != 0);
+    }
+    dut->reg_wen = 0;
+    dut->uart_rx = 1;
+
+    Activity a;
+    a.modules = toggles_of(context.get());
+    for (const auto& kv : a.modules) a.total += kv.second;
+
+    // Functional checks, outside the window
+    if (!tx_bytes.empty() && uart_line_decode(tx_wave, line) != tx_bytes) {
+        a.error = "uart_tx does not decode to the TX_DATA writes";
+    }
+    if (sc.ctrl & uart_reg::CTRL_RX_EN) {
+        if (sc.rx_timeout && !(bench.read_reg(uart_reg::INT_STATUS) & uart_reg::INT_RX_TIMEOUT)) {
+            a.error = "INT_STATUS.RX_TIMEOUT not set";
+        }
+        std::vector<uint8_t> got;
+        while (got.size() <= rx_bytes.size() &&
+               !(bench.read_reg(uart_reg::STATUS) & uart_reg::STATUS_RX_EMPTY)) {
+            got.push_back(static_cast<uint8_t>(bench.read_rx_data()));
+        }
+        if (got != rx_bytes) {
+            a.error = std::to_string(got.size()) + " of " + std::to_string(rx_bytes.size()) +
+                      " RX bytes read back correctly";
+        }
+    }
+    return a;
+}
+
+struct Result {
+    const Scenario* scenario;
+    Activity ungated;
+    Activity gated;
+    bool pass = true;
+    std::string message;
+
+    double saving() const {
+        return ungated.total ? 100.0 * (double(ungated.total) - double(gated.total)) / ungated.total
+                             : 0.0;
+    }
+};
+
+std::set<std::string> module_names(const Result& r) {
+    std::set<std::string> names;
+    for (const auto& kv : r.ungated.modules) names.insert(kv.first);
+    for (const auto& kv : r.gated.modules) names.insert(kv.first);
+    return names;
+}
+
+uint64_t count_of(const Activity& a, const std::string& module) {
+    auto it = a.modules.find(module);
+    return it == a.modules.end() ? 0 : it->second;
+}
+
+// ========================================
+// Output
+// ========================================
+
+std::string modules_json(const Activity& a) {
+    std::ostringstream out;
+    out << "{\"total\": " << a.total << ", \"modules\": {";
+    bool first = true;
+    for (const auto& kv : a.modules) {
+        out << (first ? "" : ", ") << "\"" << kv.first << "\": " << kv.second;
+        first = false;
+    }
+    out << "}}";
+    return out.str();
+}
+
+std::string to_json(const std::vector<Result>& results, unsigned window_bits) {
+    std::ostringstream out;
+    out << "{\n  \"baud_div\": " << BAUD_DIV << ",\n"
+        << "  \"oversample\": " << OVERSAMPLE << ",\n"
+        << "  \"window_bits\": " << window_bits << ",\n"
+        << "  \"scenarios\": [\n";
+    for (size_t i = 0; i < results.size(); i++) {
+        const Result& r = results[i];
+        char saving[32];
+        std::snprintf(saving, sizeof(saving), "%.1f", r.saving());
+        out << "    {\"name\": \"" << r.scenario->name << "\", \"pass\": "
+            << (r.pass ? "true" : "false") << ", \"saving_percent\": " << saving << ",\n"
+            << "     \"ungated\": " << modules_json(r.ungated) << ",\n"
+            << "     \"gated\": " << modules_json(r.gated) << "}"
+            << (i + 1 < results.size() ? ",\n" : "\n");
+    }
+    out << "  ]\n}\n";
+    return out.str();
+}
+
+void print_result(const Result& r) {
+    std::printf("\n%s: %s%s%s\n", r.scenario->name, r.scenario->description,
+                r.pass ? "" : "  FAIL: ", r.message.c_str());
+    std::printf("  %-14s %12s %12s %8s\n", "module", "ungated", "gated", "saving");
+    for (const std::string& m : module_names(r)) {
+        uint64_t u = count_of(r.ungated, m), g = count_of(r.gated, m);
+        if (u == 0 && g == 0) continue;
+        if (u) {
+            std::printf("  %-14s %12llu %12llu %7.1f%%\n", m.c_str(), (unsigned long long)u,
+                        (unsigned long long)g, 100.0 * (double(u) - double(g)) / u);
+        } else {
+            std::printf("  %-14s %12llu %12llu %8s\n", m.c_str(), 0ull, (unsigned long long)g,
+                        "-");
+        }
+    }
+    std::printf("  %-14s %12llu %12llu %7.1f%%\n", "total", (unsigned long long)r.ungated.total,
+                (unsigned long long)r.gated.total, r.saving());
+}
+
+void usage(const char* prog) {
+    std::fprintf(stderr,
+                 "usage: %s [--scenario <name>] [--bits <window bit times>] [--json <out.json>]"
+                 " [--check]\n", prog);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    Verilated::commandArgs(argc, argv);
+
+    std::string only, json_path;
+    unsigned window_bits = 400;
+    bool check = false;
+    for (int i = 1; i < argc; i++) {
+        if (!std::strcmp(argv[i], "--scenario") && i + 1 < argc) {
+            only = argv[++i];
+        } else if (!std::strcmp(argv[i], "--bits") && i + 1 < argc) {
+            window_bits = std::atoi(argv[++i]);
+        } else if (!std::strcmp(argv[i], "--json") && i + 1 < argc) {
+            json_path = argv[++i];
+        } else if (!std::strcmp(argv[i], "--check")) {
+            check = true;
+        } else if (argv[i][0] != '+') {  // +verilator+ options pass through
+            usage(argv[0]);
+            return 2;
+        }
+    }
+    // Every burst must fit: 8 frames of 11 bits after 2 idle bits
+    if (window_bits < 100) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    std::vector<Result> results;
+    for (const Scenario& sc : SCENARIOS) {
+        if (!only.empty() && only != sc.name) continue;
+        Result r;
+        r.scenario = &sc;
+        r.ungated = measure<Vuart_top>(sc, window_bits);
+        r.gated = measure<Vuart_top_gated>(sc, window_bits);
+
+        if (!r.ungated.error.empty() || !r.gated.error.empty()) {
+            r.pass = false;
+            r.message = !r.gated.error.empty() ? "gated: " + r.gated.error
+                                               : "ungated: " + r.ungated.error;
+        } else if (check && (sc.expect_saving ? r.gated.total >= r.ungated.total
+                                              : r.gated.total > r.ungated.total)) {
+            r.pass = false;
+            r.message = sc.expect_saving ? "no activity saved" : "gated build switches more";
+        }
+        results.push_back(r);
+    }
+    if (results.empty()) {
+        std::fprintf(stderr, "%s: unknown scenario '%s'\n", argv[0], only.c_str());
+        return 2;
+    }
+
+    std::printf("uart_top toggle activity, IDLE_GATING 0 vs 1: BAUD_DIV %u at %ux,"
+                " %u bit times per scenario\n", BAUD_DIV, OVERSAMPLE, window_bits);
+    int failed = 0;
+    for (const Result& r : results) {
+        print_result(r);
+        if (!r.pass) failed++;
+    }
+
+    if (!json_path.empty()) {
+        std::ofstream out(json_path);
+        if (!out) {
+            std::fprintf(stderr, "%s: cannot write %s\n", argv[0], json_path.c_str());
+            return 2;
+        }
+        out << to_json(results, window_bits);
+    }
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,481 @@
+/*
+ * UART Cycle Benchmarks
+ *
+ * Cycle-accurate throughput and latency metrics for the integration
+ * models, reported as JSON and checked against a baseline. Simulation is
+ * deterministic, so any change in a metric is a change in the RTL (an
+ * extra FSM state, a lost prefetch slot, ...), not noise.
+ *
+ * Metrics (all in uart_clk cycles, lower is better):
+ * - tx_cycles_per_byte.depth<D>.div<N>: sustained TX line rate with the
+ *   TX FIFO kept non-empty (start-edge to start-edge over 32 frames)
+ * - rx_drain_cycles_per_byte.depth<D>: back-to-back RX_DATA reads on the
+ *   register port to empty a full RX FIFO plus the holding buffer
+ * - axi_tx_latency_max.div<N>: AXI TX_DATA write (awvalid) to the uart_tx
+ *   start edge, worst case over the baud phase
+ * - axi_rx_irq_latency_max.div<N>: start of the stop bit on uart_rx to irq
+ *   (RX_READY), worst case over the baud phase
+ * - axi_rx_drain_cycles_per_byte: AXI-Lite RX_DATA reads per byte
+ * - *_min variants of the latency metrics (best case)
+ *
+ * Usage:
+ *   uart_benchmarks [--json <out.json>] [--baseline <baseline.json>]
+ *                   [--tolerance <fraction>]
+ *
+ *   # Refresh the checked-in baseline after an intended change:
+ *   uart_benchmarks --json ../simulation/benchmarks/uart_benchmarks_baseline.json
+ *
+ * IMPORTANT:
+ * - A metric fails when it exceeds baseline x (1 + tolerance) (default
+ *   0.05); improvements beyond the tolerance are reported so the baseline
+ *   can be tightened, but do not fail
+ * - A metric that could not be measured (bench timeout, NaN) fails, as
+ *   does one missing from the baseline: a new metric lands together with
+ *   its baseline entry
+ * - Exit status: 0 pass, 1 regression, 2 usage or file error
+ * - The baseline reader only understands the flat "name": number pairs
+ *   this tool writes
+ */
+
+#include "Vuart_top.h"
+#include "Vuart_top_deep.h"
+#include "Vuart_axi_top.h"
+#include <verilated.h>
+#include "dut_driver.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+DUT_DRIVER_PORTS(Vuart_top, uart_clk, rst_n);
+DUT_DRIVER_PORTS(Vuart_top_deep, uart_clk, rst_n);
+DUT_DRIVER_PORTS(Vuart_axi_top, clk, rst_n);
+
+namespace {
+
+// Register offsets (word addresses on uart_top, byte addresses on AXI)
+constexpr uint8_t REG_CTRL       = 0x0;
+constexpr uint8_t REG_STATUS     = 0x1;
+constexpr uint8_t REG_TX_DATA    = 0x2;
+constexpr uint8_t REG_RX_DATA    = 0x3;
+constexpr uint8_t REG_BAUD_DIV   = 0x4;
+constexpr uint8_t REG_INT_ENABLE = 0x5;
+
+constexpr uint32_t CTRL_TX_EN      = 1u << 0;
+constexpr uint32_t CTRL_RX_EN      = 1u << 1;
+constexpr uint32_t STATUS_TX_FULL  = 1u << 1;
+constexpr uint32_t INT_RX_READY    = 1u << 1;
+
+constexpr unsigned RX_HOLD_DEPTH = 2;   // uart_regs skid buffer
+constexpr unsigned TX_FRAMES     = 32;  // Frames timed per TX throughput run
+
+const std::vector<unsigned> BAUD_DIVISORS = {1, 4, 16};
+
+using Metrics = std::map<std::string, double>;
+
+// ========================================
+// uart_top Register-Port Bench
+// ========================================
+template <typename Model>
+struct TopBench : DutDriver<Model> {
+    using DutDriver<Model>::dut;
+    using DutDriver<Model>::tick;
+
+    TopBench() {
+        dut->uart_rx = 1;
+        dut->uart_cts_n = 0;
+        dut->ext_baud_tick = 0;
+        dut->reg_addr = 0;
+        dut->reg_wdata = 0;
+        dut->reg_wstrb = 0xF;
+        dut->reg_wen = 0;
+        dut->reg_ren = 0;
+        dut->s_axis_tdata = 0;
+        dut->s_axis_tvalid = 0;
+        dut->m_axis_tready = 0;
+        this->pulse_reset();
+    }
+
+    void write_reg(uint8_t addr, uint32_t data) {
+        dut->reg_addr = addr;
+        dut->reg_wdata = data;
+        dut->reg_wen = 1;
+        step();
+        dut->reg_wen = 0;
+        while (dut->reg_busy) step();
+    }
+
+    // Value captured on the access cycle, as axi_lite_slave_if does
+    uint32_t read_reg(uint8_t addr) {
+        dut->reg_addr = addr;
+        dut->reg_ren = 1;
+        dut->eval();
+        uint32_t value = dut->reg_rdata;
+        step();
+        dut->reg_ren = 0;
+        step();
+        return value;
+    }
+
+    // One clock, recording uart_tx start edges
+    void step() {
+        uint8_t before = dut->uart_tx;
+        tick();
+        if (before && !dut->uart_tx) tx_edges.push_back(this->cycle_count);
+    }
+
+    // 8N1 frame plus an idle guard bit on uart_rx
+    void send_byte(uint8_t data, unsigned bit_cycles) {
+        std::vector<uint8_t> bits = uart_frame_bits(data);
+        bits.push_back(1);
+        for (uint8_t bit : bits) {
+            dut->uart_rx = bit;
+            for (unsigned i = 0; i < bit_cycles; i++) step();
+        }
+    }
+
+    std::vector<uint64_t> tx_edges;
+};
+
+// Sustained TX: keep the FIFO topped up, time TX_FRAMES frame intervals
+template <typename Model>
+double bench_tx_cycles_per_byte(unsigned div) {
+    TopBench<Model> b;
+    b.write_reg(REG_BAUD_DIV, div);
+    b.write_reg(REG_CTRL, CTRL_TX_EN);
+
+    unsigned queued = 0;
+    uint64_t timeout = b.cycle_count + (uint64_t)(TX_FRAMES + 4) * 200 * div;
+    while (b.tx_edges.size() < TX_FRAMES + 1 && b.cycle_count < timeout) {
+        if (queued < TX_FRAMES + 1 && !(b.read_reg(REG_STATUS) & STATUS_TX_FULL)) {
+            b.write_reg(REG_TX_DATA, 0x55 + queued);
+            queued++;
+        } else {
+            b.step();
+        }
+    }
+    if (b.tx_edges.size() < TX_FRAMES + 1) return NAN;
+    return (double)(b.tx_edges[TX_FRAMES] - b.tx_edges[0]) / TX_FRAMES;
+}
+
+// RX drain: fill FIFO + holding buffer, then hold reg_ren on RX_DATA and
+// count cycles until every byte has been returned once (bubbles re-read
+// the previous byte and cost a cycle)
+template <typename Model>
+double bench_rx_drain_cycles_per_byte(unsigned depth) {
+    TopBench<Model> b;
+    b.write_reg(REG_BAUD_DIV, 1);
+    b.write_reg(REG_CTRL, CTRL_RX_EN);
+
+    unsigned count = depth + RX_HOLD_DEPTH;
+    for (unsigned i = 0; i < count; i++) b.send_byte(i & 0xFF, 16);
+    for (int i = 0; i < 16; i++) b.step();   // Last byte through sync + FIFO
+
+    b.dut->reg_addr = REG_RX_DATA;
+    b.dut->reg_ren = 1;
+    unsigned next = 0;
+    uint64_t start = b.cycle_count;
+    while (next < count && b.cycle_count - start < 4ull * count) {
+        b.dut->eval();
+        if ((b.dut->reg_rdata & 0xFF) == (next & 0xFF)) next++;
+        b.step();
+    }
+    b.dut->reg_ren = 0;
+    if (next < count) return NAN;
+    return (double)(b.cycle_count - start) / count;
+}
+
+// ========================================
+// uart_axi_top Bench
+// ========================================
+struct AxiBench : DutDriver<Vuart_axi_top> {
+    AxiBench() {
+        dut->uart_rx = 1;
+        dut->uart_cts_n = 0;
+        dut->awaddr = 0;
+        dut->awvalid = 0;
+        dut->wdata = 0;
+        dut->wstrb = 0xF;
+        dut->wvalid = 0;
+        dut->bready = 1;
+        dut->araddr = 0;
+        dut->arvalid = 0;
+        dut->rready = 1;
+        dut->s_axis_tdata = 0;
+        dut->s_axis_tvalid = 0;
+        dut->m_axis_tready = 0;
+        pulse_reset();
+    }
+
+    void axi_write(uint8_t reg, uint32_t data) {
+        dut->awaddr = reg << 2;
+        dut->awvalid = 1;
+        dut->wdata = data;
+        dut->wvalid = 1;
+        while (!(dut->awready && dut->wready)) tick();
+        dut->awvalid = 0;
+        dut->wvalid = 0;
+        tick();
+        while (!dut->bvalid) tick();
+        tick();
+    }
+
+    uint32_t axi_read(uint8_t reg) {
+        dut->araddr = reg << 2;
+        dut->arvalid = 1;
+        while (!dut->arready) tick();
+        dut->arvalid = 0;
+        tick();
+        while (!dut->rvalid) tick();
+        uint32_t data = dut->rdata;
+        tick();
+        return data;
+    }
+};
+
+// AXI TX_DATA write to start edge, after `phase` idle cycles
+uint64_t axi_tx_latency(unsigned div, unsigned phase) {
+    AxiBench b;
+    b.axi_write(REG_BAUD_DIV, div);
+    b.axi_write(REG_CTRL, CTRL_TX_EN);
+    b.run_cycles(phase);
+
+    uint64_t start = b.cycle_count;
+    b.dut->awaddr = REG_TX_DATA << 2;
+    b.dut->awvalid = 1;
+    b.dut->wdata = 0xA5;
+    b.dut->wvalid = 1;
+    for (uint64_t i = 0; i < 64ull * div + 64; i++) {
+        if (b.dut->awready && b.dut->wready) {
+            b.tick();
+            b.dut->awvalid = 0;
+            b.dut->wvalid = 0;
+        } else {
+            b.tick();
+        }
+        if (!b.dut->uart_tx) return b.cycle_count - start;
+    }
+    return UINT64_MAX;
+}
+
+// Start of the stop bit to irq (RX_READY), after `phase` idle cycles
+uint64_t axi_rx_irq_latency(unsigned div, unsigned phase) {
+    AxiBench b;
+    unsigned bit_cycles = 16 * div;
+    b.axi_write(REG_BAUD_DIV, div);
+    b.axi_write(REG_INT_ENABLE, INT_RX_READY);
+    b.axi_write(REG_CTRL, CTRL_RX_EN);
+    b.run_cycles(phase);
+
+    std::vector<uint8_t> bits = uart_frame_bits(0x3C);
+    bits.pop_back();  // Stop bit timed separately
+    b.drive_bits([&](uint8_t bit) { b.dut->uart_rx = bit; }, bits, bit_cycles);
+
+    b.dut->uart_rx = 1;
+    uint64_t start = b.cycle_count;
+    if (!b.run_until([&] { return b.dut->irq != 0; }, 4ull * bit_cycles)) {
+        return UINT64_MAX;
+    }
+    return b.cycle_count - start;
+}
+
+// AXI-Lite RX_DATA reads per byte, FIFO + holding buffer full
+double axi_rx_drain_cycles_per_byte() {
+    AxiBench b;
+    b.axi_write(REG_BAUD_DIV, 1);
+    b.axi_write(REG_CTRL, CTRL_RX_EN);
+
+    const unsigned count = 8 + RX_HOLD_DEPTH;
+    for (unsigned i = 0; i < count; i++) {
+        std::vector<uint8_t> bits = uart_frame_bits(0x40 + i);
+        bits.push_back(1);
+        b.drive_bits([&](uint8_t bit) { b.dut->uart_rx = bit; }, bits, 16);
+    }
+    b.run_cycles(16);
+
+    uint64_t start = b.cycle_count;
+    for (unsigned i = 0; i < count; i++) {
+        if ((b.axi_read(REG_RX_DATA) & 0xFF) != 0x40 + i) return NAN;
+    }
+    return (double)(b.cycle_count - start) / count;
+}
+
+// Worst and best case over one baud tick period and then some (the start
+// and sample points depend on the baud counter phase)
+template <typename Bench>
+void latency_sweep(Metrics& m, const std::string& name, unsigned div, Bench bench) {
+    uint64_t lo = UINT64_MAX, hi = 0;
+    for (unsigned phase = 0; phase < 2 * div + 2; phase++) {
+        uint64_t cycles = bench(div, phase);
+        lo = std::min(lo, cycles);
+        hi = std::max(hi, cycles);
+    }
+    std::string suffix = ".div" + std::to_string(div);
+    m[name + "_max" + suffix] = (hi == UINT64_MAX) ? NAN : (double)hi;
+    m[name + "_min" + suffix] = (lo == UINT64_MAX) ? NAN : (double)lo;
+}
+
+Metrics run_benchmarks() {
+    Metrics m;
+    for (unsigned div : BAUD_DIVISORS) {
+        std::string suffix = ".div" + std::to_string(div);
+        m["tx_cycles_per_byte.depth8" + suffix] = bench_tx_cycles_per_byte<Vuart_top>(div);
+        m["tx_cycles_per_byte.depth256" + suffix] = bench_tx_cycles_per_byte<Vuart_top_deep>(div);
+        latency_sweep(m, "axi_tx_latency", div, axi_tx_latency);
+        latency_sweep(m, "axi_rx_irq_latency", div, axi_rx_irq_latency);
+    }
+    m["rx_drain_cycles_per_byte.depth8"] = bench_rx_drain_cycles_per_byte<Vuart_top>(8);
+    m["rx_drain_cycles_per_byte.depth256"] = bench_rx_drain_cycles_per_byte<Vuart_top_deep>(256);
+    m["axi_rx_drain_cycles_per_byte"] = axi_rx_drain_cycles_per_byte();
+    return m;
+}
+
+// ========================================
+// JSON Output and Baseline Compare
+// ========================================
+std::string to_json(const Metrics& m) {
+    std::ostringstream out;
+    out << "{\n  \"schema\": 1,\n  \"unit\": \"cycles\",\n  \"metrics\": {\n";
+    size_t i = 0;
+    for (const auto& kv : m) {
+        char value[32];
+        if (std::isnan(kv.second)) {
+            std::snprintf(value, sizeof(value), "null");
+        } else {
+            std::snprintf(value, sizeof(value), "%.2f", kv.second);
+        }
+        out << "    \"" << kv.first << "\": " << value
+            << (++i < m.size() ? ",\n" : "\n");
+    }
+    out << "  }\n}\n";
+    return out.str();
+}
+
+// Every "name": number pair inside "metrics"
+bool read_baseline(const std::string& path, Metrics& m) {
+    std::ifstream in(path);
+    if (!in) return false;
+    std::stringstream buf;
+    buf << in.rdbuf();
+    std::string text = buf.str();
+
+    size_t pos = text.find("\"metrics\"");
+    if (pos == std::string::npos) return false;
+    pos = text.find('{', pos);
+    if (pos == std::string::npos) return false;
+    size_t close = text.find('}', pos);
+
+    while (true) {
+        size_t name_start = text.find('"', pos);
+        if (name_start == std::string::npos || name_start > close) break;
+        size_t name_end = text.find('"', name_start + 1);
+        size_t colon = text.find(':', name_end);
+        if (name_end == std::string::npos || colon == std::string::npos) return false;
+
+        const char* num = text.c_str() + colon + 1;
+        char* num_end = nullptr;
+        double value = std::strtod(num, &num_end);
+        if (num_end != num) {
+            m[text.substr(name_start + 1, name_end - name_start - 1)] = value;
+        }
+        pos = colon + 1;  // null entries are skipped
+    }
+    return true;
+}
+
+int compare(const Metrics& measured, const Metrics& baseline, double tolerance) {
+    int regressions = 0;
+    for (const auto& kv : measured) {
+        // A bench that timed out fails whether or not it has a baseline
+        if (std::isnan(kv.second)) {
+            std::printf("  REGRESSION %-40s %10s (not measured)\n", kv.first.c_str(), "nan");
+            regressions++;
+            continue;
+        }
+        auto it = baseline.find(kv.first);
+        if (it == baseline.end()) {
+            std::printf("  NEW        %-40s %10.2f (not in baseline)\n",
+                        kv.first.c_str(), kv.second);
+            regressions++;
+            continue;
+        }
+        double base = it->second;
+        const char* verdict = "ok";
+        if (kv.second > base * (1.0 + tolerance)) {
+            verdict = "REGRESSION";
+            regressions++;
+        } else if (kv.second < base * (1.0 - tolerance)) {
+            verdict = "improved";
+        }
+        std::printf("  %-10s %-40s %10.2f (baseline %.2f)\n",
+                    verdict, kv.first.c_str(), kv.second, base);
+    }
+    for (const auto& kv : baseline) {
+        if (!measured.count(kv.first)) {
+            std::printf("  MISSING    %-40s (in baseline, not measured)\n", kv.first.c_str());
+            regressions++;
+        }
+    }
+    return regressions;
+}
+
+void usage(const char* prog) {
+    std::fprintf(stderr,
+                 "usage: %s [--json <out.json>] [--baseline <baseline.json>]"
+                 " [--tolerance <fraction>]\n", prog);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    Verilated::commandArgs(argc, argv);
+
+    std::string json_path, baseline_path;
+    double tolerance = 0.05;
+    for (int i = 1; i < argc; i++) {
+        if (!std::strcmp(argv[i], "--json") && i + 1 < argc) {
+            json_path = argv[++i];
+        } else if (!std::strcmp(argv[i], "--baseline") && i + 1 < argc) {
+            baseline_path = argv[++i];
+        } else if (!std::strcmp(argv[i], "--tolerance") && i + 1 < argc) {
+            tolerance = std::atof(argv[++i]);
+        } else if (argv[i][0] != '+') {  // +verilator+ options pass through
+            usage(argv[0]);
+            return 2;
+        }
+    }
+
+    Metrics measured = run_benchmarks();
+    std::string json = to_json(measured);
+
+    if (json_path.empty()) {
+        std::fputs(json.c_str(), stdout);
+    } else {
+        std::ofstream out(json_path);
+        if (!out) {
+            std::fprintf(stderr, "uart_benchmarks: cannot write %s\n", json_path.c_str());
+            return 2;
+        }
+        out << json;
+    }
+
+    if (baseline_path.empty()) return 0;
+
+    Metrics baseline;
+    if (!read_baseline(baseline_path, baseline)) {
+        std::fprintf(stderr, "uart_benchmarks: cannot read baseline %s\n",
+                     baseline_path.c_str());
+        return 2;
+    }
+    std::printf("Baseline %s (tolerance %.0f%%):\n", baseline_path.c_str(), tolerance * 100);
+    int regressions = compare(measured, baseline, tolerance);
+    std::printf("%d regression(s)\n", regressions);
+    return regressions ? 1 : 0;
+}
@@ -0,0 +1,442 @@
+/*
+ * UART Simulation-Speed Benchmark
+ *
+ * Measures how fast each Verilated model simulates (cycles per wall-clock
+ * second) under representative traffic, to choose build flavors for long
+ * soak runs. RTL cycle counts are covered by uart_benchmarks; this tool
+ * only times the simulator.
+ *
+ * Models and traffic:
+ * - Vbit_sync:     pseudo-random data_in every cycle
+ * - Vsync_fifo:    random push/pop, respecting full/empty
+ * - Vbaud_gen:     free-running at divisor 4
+ * - Vuart_tx:      back-to-back frames, baud tick every 4 cycles
+ * - Vuart_rx:      back-to-back frames driven at 64 cycles per bit
+ * - Vuart_top:     stream-mode loopback (uart_tx → uart_rx) at BAUD_DIV=1,
+ *                  plus a STATUS read every 64 cycles
+ * - Vuart_axi_top: AXI-Lite driver loop (STATUS, TX_DATA, RX_DATA) with
+ *                  the serial lines looped back at BAUD_DIV=1
+ *
+ * Build flavors (one executable each, see simulation/CMakeLists.txt):
+ * - uart_simspeed:            COVERAGE + TRACE_FST instrumented models (the
+ *                             module_tests build); --trace also dumps an FST
+ * - uart_simspeed_fast_t<N>:  uninstrumented -O3 models, uart_top and
+ *                             uart_axi_top built with --threads N
+ *
+ * Usage:
+ *   uart_simspeed [--seconds <min wall time per model>] [--model <name>]
+ *                 [--trace <fst dir>] [--json <out.json>]
+ *
+ * IMPORTANT:
+ * - Each model runs in chunks until --seconds (default 1.0) of wall time
+ *   has passed, so short runs are not dominated by timer resolution
+ * - --trace is only accepted by the instrumented flavor (the fast models
+ *   have no trace support compiled in); FST files are large
+ * - Threads are a build-time Verilator setting, so every --threads value
+ *   is its own executable (UART_SIMSPEED_THREADS)
+ */
+
+#include "Vbit_sync.h"
+#include "Vsync_fifo.h"
+#include "Vbaud_gen.h"
+#include "Vuart_tx.h"
+#include "Vuart_rx.h"
+#include "Vuart_top.h"
+#include "Vuart_axi_top.h"
+#include <verilated.h>
+#ifdef UART_SIMSPEED_TRACE
+#include <verilated_fst_c.h>
+#endif
+#include "dut_driver.h"
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifndef UART_SIMSPEED_FLAVOR
+#define UART_SIMSPEED_FLAVOR "unknown"
+#endif
+#ifndef UART_SIMSPEED_THREADS
+#define UART_SIMSPEED_THREADS 1
+#endif
+
+DUT_DRIVER_PORTS(Vbit_sync, clk_dst, rst_n_dst);
+DUT_DRIVER_PORTS(Vsync_fifo, clk, rst_n);
+DUT_DRIVER_PORTS(Vbaud_gen, uart_clk, rst_n);
+DUT_DRIVER_PORTS(Vuart_tx, uart_clk, rst_n);
+DUT_DRIVER_PORTS(Vuart_rx, uart_clk, rst_n);
+DUT_DRIVER_PORTS(Vuart_top, uart_clk, rst_n);
+DUT_DRIVER_PORTS(Vuart_axi_top, clk, rst_n);
+
+namespace {
+
+constexpr uint64_t CHUNK_CYCLES = 10000;
+
+// 16-bit Galois LFSR stimulus (cheap next to eval())
+struct Lfsr {
+    uint16_t state = 0xACE1;
+    uint16_t next() {
+        state = (state >> 1) ^ (-(state & 1u) & 0xB400u);
+        return state;
+    }
+};
+
+// ========================================
+// Timed Harness
+// ========================================
+// Wraps a DutDriver; step() is tick() plus an optional FST dump
+template <typename Model>
+struct SpeedDut : DutDriver<Model> {
+    using DutDriver<Model>::dut;
+
+#ifdef UART_SIMSPEED_TRACE
+    std::unique_ptr<VerilatedFstC> fst;
+
+    void open_trace(const std::string& path) {
+        fst.reset(new VerilatedFstC);
+        dut->trace(fst.get(), 99);
+        fst->open(path.c_str());
+    }
+
+    ~SpeedDut() {
+        if (fst) fst->close();
+    }
+#endif
+
+    inline void step() {
+        this->tick();
+#ifdef UART_SIMSPEED_TRACE
+        if (fst) fst->dump(this->cycle_count);
+#endif
+    }
+};
+
+// ========================================
+// Traffic Generators
+// ========================================
+// Each advances the model by at least n cycles
+
+struct BitSyncTraffic : SpeedDut<Vbit_sync> {
+    Lfsr lfsr;
+    BitSyncTraffic() {
+        dut->data_in = 0;
+        pulse_reset();
+    }
+    void run(uint64_t n) {
+        for (uint64_t i = 0; i < n; i++) {
+            dut->data_in = lfsr.next() & 1;
+            step();
+        }
+    }
+};
+
+struct SyncFifoTraffic : SpeedDut<Vsync_fifo> {
+    Lfsr lfsr;
+    SyncFifoTraffic() {
+        dut->wr_en = 0;
+        dut->wr_data = 0;
+        dut->rd_en = 0;
+        pulse_reset();
+    }
+    void run(uint64_t n) {
+        for (uint64_t i = 0; i < n; i++) {
+            uint16_t r = lfsr.next();
+            dut->wr_en = (r & 1) && !dut->wr_full;
+            dut->wr_data = r >> 8;
+            dut->rd_en = (r & 2) && !dut->rd_empty;
+            step();
+        }
+    }
+};
+
+struct BaudGenTraffic : SpeedDut<Vbaud_gen> {
+    BaudGenTraffic() {
+        dut->baud_divisor = 4;
+        dut->baud_frac = 0;
+        dut->enable = 1;
+        pulse_reset();
+    }
+    void run(uint64_t n) {
+        for (uint64_t i = 0; i < n; i++) step();
+    }
+};
+
+struct UartTxTraffic : SpeedDut<Vuart_tx> {
+    Lfsr lfsr;
+    uint64_t phase = 0;
+    UartTxTraffic() {
+        dut->baud_tick = 0;
+        dut->osr_sel = 0;
+        dut->tx_cts = 1;
+        dut->tx_data = 0;
+        dut->tx_valid = 0;
+        pulse_reset();
+    }
+    void run(uint64_t n) {
+        for (uint64_t i = 0; i < n; i++) {
+            dut->baud_tick = (++phase & 3) == 0;
+            if (!dut->tx_valid || dut->tx_ready) {
+                dut->tx_data = lfsr.next() & 0xFF;
+                dut->tx_valid = 1;
+            }
+            step();
+        }
+    }
+};
+
+struct UartRxTraffic : SpeedDut<Vuart_rx> {
+    Lfsr lfsr;
+    uint64_t phase = 0;
+    std::vector<uint8_t> bits;
+    size_t bit_index = 0;
+    UartRxTraffic() {
+        dut->sample_tick = 0;
+        dut->osr_sel = 0;
+        dut->rx_serial_sync = 1;
+        dut->rx_ready = 1;
+        pulse_reset();
+    }
+    void run(uint64_t n) {
+        for (uint64_t i = 0; i < n; i++) {
+            phase++;
+            dut->sample_tick = (phase & 3) == 0;
+            if ((phase & 63) == 0) {  // Next bit every 64 cycles
+                if (bit_index == bits.size()) {
+                    bits = uart_frame_bits(lfsr.next() & 0xFF);
+                    bit_index = 0;
+                }
+                dut->rx_serial_sync = bits[bit_index++];
+            }
+            step();
+        }
+    }
+};
+
+struct UartTopTraffic : SpeedDut<Vuart_top> {
+    Lfsr lfsr;
+    UartTopTraffic() {
+        dut->uart_rx = 1;
+        dut->uart_cts_n = 0;
+        dut->ext_baud_tick = 0;
+        dut->reg_addr = 0;
+        dut->reg_wdata = 0;
+        dut->reg_wstrb = 0xF;
+        dut->reg_wen = 0;
+        dut->reg_ren = 0;
+        dut->s_axis_tdata = 0;
+        dut->s_axis_tvalid = 1;
+        dut->m_axis_tready = 1;
+        pulse_reset();
+        write_reg(0x4, 1);          // BAUD_DIV = 1
+        write_reg(0x0, 0xB);        // STREAM_EN + RX_EN + TX_EN
+    }
+    void write_reg(uint8_t addr, uint32_t data) {
+        dut->reg_addr = addr;
+        dut->reg_wdata = data;
+        dut->reg_wen = 1;
+        step();
+        dut->reg_wen = 0;
+    }
+    void run(uint64_t n) {
+        for (uint64_t i = 0; i < n; i++) {
+            if (dut->s_axis_tready) dut->s_axis_tdata = lfsr.next() & 0xFF;
+            dut->reg_addr = 0x1;    // STATUS poll
+            dut->reg_ren = (this->cycle_count & 63) == 0;
+            dut->uart_rx = dut->uart_tx;
+            step();
+        }
+    }
+};
+
+struct UartAxiTopTraffic : SpeedDut<Vuart_axi_top> {
+    Lfsr lfsr;
+    UartAxiTopTraffic() {
+        dut->uart_rx = 1;
+        dut->uart_cts_n = 0;
+        dut->awaddr = 0;
+        dut->awvalid = 0;
+        dut->wdata = 0;
+        dut->wstrb = 0xF;
+        dut->wvalid = 0;
+        dut->bready = 1;
+        dut->araddr = 0;
+        dut->arvalid = 0;
+        dut->rready = 1;
+        dut->s_axis_tdata = 0;
+        dut->s_axis_tvalid = 0;
+        dut->m_axis_tready = 0;
+        pulse_reset();
+        axi_write(0x10, 1);         // BAUD_DIV = 1
+        axi_write(0x00, 0x3);       // RX_EN + TX_EN
+    }
+    inline void loop_step() {
+        dut->uart_rx = dut->uart_tx;
+        step();
+    }
+    void axi_write(uint32_t addr, uint32_t data) {
+        dut->awaddr = addr;
+        dut->awvalid = 1;
+        dut->wdata = data;
+        dut->wvalid = 1;
+        while (!(dut->awready && dut->wready)) loop_step();
+        loop_step();
+        dut->awvalid = 0;
+        dut->wvalid = 0;
+        while (!dut->bvalid) loop_step();
+        loop_step();
+    }
+    uint32_t axi_read(uint32_t addr) {
+        dut->araddr = addr;
+        dut->arvalid = 1;
+        while (!dut->arready) loop_step();
+        loop_step();
+        dut->arvalid = 0;
+        while (!dut->rvalid) loop_step();
+        uint32_t data = dut->rdata;
+        loop_step();
+        return data;
+    }
+    // Polling driver: refill TX while not full, drain RX while not empty
+    void run(uint64_t n) {
+        uint64_t end = this->cycle_count + n;
+        while (this->cycle_count < end) {
+            uint32_t status = axi_read(0x04);
+            if (!(status & 0x2)) axi_write(0x08, lfsr.next() & 0xFF);
+            if (!(status & 0x4)) axi_read(0x0C);
+        }
+    }
+};
+
+// ========================================
+// Runner
+// ========================================
+struct Result {
+    std::string model;
+    uint64_t cycles;
+    double seconds;
+};
+
+struct Options {
+    double min_seconds = 1.0;
+    std::string model;       // Empty: all
+    std::string trace_dir;   // Empty: no FST
+    std::string json_path;
+};
+
+template <typename Traffic>
+void measure(const char* name, const Options& opt, std::vector<Result>& results) {
+    if (!opt.model.empty() && opt.model != name) return;
+
+    Traffic t;
+#ifdef UART_SIMSPEED_TRACE
+    if (!opt.trace_dir.empty()) t.open_trace(opt.trace_dir + "/" + name + ".fst");
+#endif
+
+    using clock = std::chrono::steady_clock;
+    uint64_t start_cycles = t.cycle_count;
+    clock::time_point start = clock::now();
+    double seconds = 0.0;
+    do {
+        t.run(CHUNK_CYCLES);
+        seconds = std::chrono::duration<double>(clock::now() - start).count();
+    } while (seconds < opt.min_seconds);
+
+    results.push_back(Result{name, t.cycle_count - start_cycles, seconds});
+}
+
+std::string to_json(const std::vector<Result>& results, bool traced) {
+    std::ostringstream out;
+    out << "{\n  \"flavor\": \"" << UART_SIMSPEED_FLAVOR << "\",\n"
+        << "  \"threads\": " << UART_SIMSPEED_THREADS << ",\n"
+        << "  \"trace\": " << (traced ? "true" : "false") << ",\n"
+        << "  \"results\": [\n";
+    for (size_t i = 0; i < results.size(); i++) {
+        const Result& r = results[i];
+        char line[256];
+        std::snprintf(line, sizeof(line),
+                      "    {\"model\": \"%s\", \"cycles\": %llu, \"seconds\": %.3f, "
+                      "\"cycles_per_second\": %.0f}",
+                      r.model.c_str(), (unsigned long long)r.cycles, r.seconds,
+                      r.cycles / r.seconds);
+        out << line << (i + 1 < results.size() ? ",\n" : "\n");
+    }
+    out << "  ]\n}\n";
+    return out.str();
+}
+
+void usage(const char* prog) {
+    std::fprintf(stderr,
+                 "usage: %s [--seconds <s>] [--model <name>] [--trace <fst dir>]"
+                 " [--json <out.json>]\n", prog);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    Verilated::commandArgs(argc, argv);
+
+    Options opt;
+    for (int i = 1; i < argc; i++) {
+        if (!std::strcmp(argv[i], "--seconds") && i + 1 < argc) {
+            opt.min_seconds = std::atof(argv[++i]);
+        } else if (!std::strcmp(argv[i], "--model") && i + 1 < argc) {
+            opt.model = argv[++i];
+        } else if (!std::strcmp(argv[i], "--trace") && i + 1 < argc) {
+            opt.trace_dir = argv[++i];
+        } else if (!std::strcmp(argv[i], "--json") && i + 1 < argc) {
+            opt.json_path = argv[++i];
+        } else if (argv[i][0] != '+') {  // +verilator+ options pass through
+            usage(argv[0]);
+            return 2;
+        }
+    }
+
+#ifdef UART_SIMSPEED_TRACE
+    if (!opt.trace_dir.empty()) Verilated::traceEverOn(true);
+#else
+    if (!opt.trace_dir.empty()) {
+        std::fprintf(stderr, "%s: --trace needs the instrumented build (uart_simspeed)\n",
+                     argv[0]);
+        return 2;
+    }
+#endif
+
+    std::vector<Result> results;
+    measure<BitSyncTraffic>("bit_sync", opt, results);
+    measure<SyncFifoTraffic>("sync_fifo", opt, results);
+    measure<BaudGenTraffic>("baud_gen", opt, results);
+    measure<UartTxTraffic>("uart_tx", opt, results);
+    measure<UartRxTraffic>("uart_rx", opt, results);
+    measure<UartTopTraffic>("uart_top", opt, results);
+    measure<UartAxiTopTraffic>("uart_axi_top", opt, results);
+
+    if (results.empty()) {
+        std::fprintf(stderr, "%s: unknown model '%s'\n", argv[0], opt.model.c_str());
+        return 2;
+    }
+
+    bool traced = !opt.trace_dir.empty();
+    std::printf("flavor=%s threads=%d trace=%s\n", UART_SIMSPEED_FLAVOR,
+                UART_SIMSPEED_THREADS, traced ? "on" : "off");
+    std::printf("  %-14s %14s %9s %14s\n", "model", "cycles", "seconds", "cycles/s");
+    for (const Result& r : results) {
+        std::printf("  %-14s %14llu %9.3f %14.0f\n", r.model.c_str(),
+                    (unsigned long long)r.cycles, r.seconds, r.cycles / r.seconds);
+    }
+
+    if (!opt.json_path.empty()) {
+        std::ofstream out(opt.json_path);
+        if (!out) {
+            std::fprintf(stderr, "%s: cannot write %s\n", argv[0], opt.json_path.c_str());
+            return 2;
+        }
+        out << to_json(results, traced);
+    }
+    return 0;
+}
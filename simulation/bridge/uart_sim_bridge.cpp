@@ -0,0 +1,853 @@
+/*
+ * UART Simulation Bridge
+ *
+ * Standalone real-time harness around the AXI-Lite integration model
+ * (Vuart_axi_top): host software drives the RTL as it would a real UART,
+ * through a serial endpoint on the line side and a shared-memory mailbox
+ * on the register side, with no stimulus compiled in.
+ *
+ * Serial side (--pty or --tcp):
+ * - Endpoint bytes are read non-blocking into a queue of up to
+ *   --rx-batch bytes. Whenever uart_rx goes idle the whole queue is
+ *   encoded as 8N1 frames at the DUT's bit time into one packed waveform
+ *   (uart_line.h) and shifted out, so a continuous stream has no gaps
+ * - uart_tx is captured into a packed waveform and decoded in bulk after
+ *   every quantum; a frame cut by the quantum carries into the next one.
+ *   Decoded bytes leave through a non-blocking write buffer
+ * - The bit time follows BAUD_DIV, BAUD_FRAC and CTRL.OSR as written
+ *   through the mailbox, or as read back (e.g. after CTRL.AUTOBAUD)
+ * - With CTRL.RTS_EN the far end honours uart_rts_n: frames are encoded
+ *   one at a time, each only once RTS is asserted; the rest waits in the
+ *   queue and the endpoint's kernel buffer
+ *
+ * Register side (--mailbox, sim_mailbox.h):
+ * - Every published request is one AXI-Lite transaction, run in order
+ *   between quanta; the responses of a batch are published together
+ * - irq and the simulated cycle are published after every quantum
+ *
+ * Scheduling:
+ * - Busy (line bytes queued and clear to send, frames in flight, TX FIFO
+ *   not empty, or the RX timeout still able to fire): simulate --quantum
+ *   cycles, then poll() the endpoint and mailbox without blocking
+ * - Quiescent (uart_regs_quiescent, as the fixtures' run_idle: both lines
+ *   high, TX FIFO empty, both FSMs idle, and the RX timeout horizon
+ *   passed): block in poll() on
+ *   the endpoint and the mailbox doorbell for up to --idle-ms. If nothing
+ *   arrives by then, --idle-cycles simulated cycles are skipped with
+ *   DutDriver::fast_forward (not evaluated) and the bridge sleeps again
+ *
+ * Usage:
+ *   uart_sim_bridge --pty [--pty-link /tmp/ttyUART] [--mailbox /uart_sim]
+ *   uart_sim_bridge --tcp 5555 [--quantum 8192] [--idle-ms 5]
+ *   uart_sim_bridge --check     # self-test: socketpair line, host thread
+ *
+ *   picocom /tmp/ttyUART         # or: socat - TCP:localhost:5555
+ *   MailboxClient host; host.open("/uart_sim"); host.write(0x10, 1); ...
+ *
+ * IMPORTANT:
+ * - Linux only (posix_openpt, shm_open, futex)
+ * - The DUT comes out of reset with the register reset values; host
+ *   software configures it (BAUD_DIV, CTRL) through the mailbox
+ * - Simulated time is decoupled from wall time: busy spans run as fast as
+ *   the model allows, idle spans advance --idle-cycles per --idle-ms
+ * - Skipped cycles still count as TX_STALLS with TX_EN set: fast_forward
+ *   advances the model's counter (DUT_DRIVER_UART_REGS)
+ * - RX frames are sent with one idle bit after each (uart_rx rearms a few
+ *   cycles after the stop bit); uart_cts_n is held low (clear to send)
+ * - A TCP endpoint serves one client at a time. TX bytes with no client
+ *   connected, or beyond --tx-buffer, are dropped and counted
+ * - Links UART_AXI_TOP_MODEL: configure with UART_SIM_FAST=ON for the
+ *   -O3 model without coverage/trace instrumentation
+ * - Exit status: 0 on SIGINT/SIGTERM or a passing --check, 1 failing
+ *   --check, 2 usage or endpoint/mailbox setup error
+ */
+
+#include "Vuart_axi_top.h"
+#include "Vuart_axi_top___024root.h"
+#include <verilated.h>
+#include "dut_driver.h"
+#include "sim_mailbox.h"
+#include "uart_line.h"
+#include "uart_model.h"
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <termios.h>
+#include <unistd.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+DUT_DRIVER_PORTS(Vuart_axi_top, clk, rst_n);
+DUT_DRIVER_UART_REGS(Vuart_axi_top, uart_axi_top__DOT__uart_core__DOT__uart_regs_inst);
+
+namespace {
+
+constexpr uint64_t AXI_TIMEOUT   = 1000;   // Cycles per AXI handshake
+constexpr uint32_t AXI_RESP_SLVERR = 0x2;
+
+std::atomic<int> g_stop(0);
+
+void on_signal(int) { g_stop = 1; }
+
+struct BridgeOptions {
+    std::string mailbox = "/uart_sim";
+    uint64_t quantum = 4096;        // Cycles between I/O polls while busy
+    int idle_ms = 10;               // Sleep deadline while quiescent
+    uint64_t idle_cycles = 73728;   // Skipped per deadline (10 ms at 7.3728 MHz)
+    size_t rx_batch = 256;          // Endpoint bytes queued for uart_rx
+    size_t tx_buffer = 65536;       // Decoded TX bytes held for the endpoint
+    bool verbose = false;
+};
+
+struct BridgeStats {
+    uint64_t rx_bytes = 0;         // Endpoint -> uart_rx
+    uint64_t tx_bytes = 0;         // uart_tx -> endpoint
+    uint64_t tx_dropped = 0;       // No client, or buffer full
+    uint64_t tx_frame_errors = 0;  // uart_tx frames with a low stop bit
+    uint64_t mailbox_ops = 0;
+    uint64_t mailbox_batches = 0;
+    uint64_t quanta = 0;
+    uint64_t sleeps = 0;
+    uint64_t idle_deadlines = 0;
+};
+
+// Serial side: a PTY master, a TCP client, or (--check) one end of a
+// socketpair. fd() is -1 while no TCP client is connected.
+class SerialEndpoint {
+public:
+    SerialEndpoint() = default;
+    ~SerialEndpoint() {
+        if (fd_ >= 0) ::close(fd_);
+        if (slave_ >= 0) ::close(slave_);
+        if (listen_ >= 0) ::close(listen_);
+        if (!link_.empty()) unlink(link_.c_str());
+    }
+
+    SerialEndpoint(const SerialEndpoint&) = delete;
+    SerialEndpoint& operator=(const SerialEndpoint&) = delete;
+
+    // Raw PTY pair; the slave stays open here too, so the master never
+    // reports a hang-up while host programs come and go
+    bool open_pty(const std::string& link) {
+        int fd = posix_openpt(O_RDWR | O_NOCTTY | O_NONBLOCK);
+        if (fd < 0 || grantpt(fd) != 0 || unlockpt(fd) != 0) {
+            if (fd >= 0) ::close(fd);
+            return false;
+        }
+        fd_ = fd;
+        name_ = ptsname(fd);
+        slave_ = ::open(name_.c_str(), O_RDWR | O_NOCTTY | O_NONBLOCK);
+        struct termios tio;
+        if (slave_ < 0 || tcgetattr(slave_, &tio) != 0) return false;
+        cfmakeraw(&tio);
+        if (tcsetattr(slave_, TCSANOW, &tio) != 0) return false;
+        if (!link.empty()) {
+            unlink(link.c_str());
+            if (symlink(name_.c_str(), link.c_str()) != 0) return false;
+            link_ = link;
+            name_ = link + " -> " + name_;
+        }
+        return true;
+    }
+
+    // Loopback listener; clients are accepted from poll()
+    bool open_tcp(unsigned port) {
+        listen_ = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0);
+        if (listen_ < 0) return false;
+        int one = 1;
+        setsockopt(listen_, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+        struct sockaddr_in addr;
+        std::memset(&addr, 0, sizeof(addr));
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons((uint16_t)port);
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        if (bind(listen_, (struct sockaddr*)&addr, sizeof(addr)) != 0 || listen(listen_, 1) != 0) {
+            return false;
+        }
+        name_ = "tcp 127.0.0.1:" + std::to_string(port);
+        return true;
+    }
+
+    void adopt(int fd, const std::string& name) {
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+        fd_ = fd;
+        name_ = name;
+    }
+
+    int fd() const { return fd_; }
+    int listen_fd() const { return listen_; }
+    const std::string& name() const { return name_; }
+
+    // New TCP client; a second one is refused while the first is connected
+    void accept_client() {
+        int fd = accept4(listen_, nullptr, nullptr, SOCK_NONBLOCK);
+        if (fd < 0) return;
+        if (fd_ >= 0) {
+            ::close(fd);
+            return;
+        }
+        int one = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        fd_ = fd;
+    }
+
+    // End of stream or error: only a TCP client goes away
+    void hang_up() {
+        if (listen_ < 0) return;
+        ::close(fd_);
+        fd_ = -1;
+    }
+
+private:
+    int fd_ = -1;
+    int slave_ = -1;
+    int listen_ = -1;
+    std::string link_;
+    std::string name_;
+};
+
+class UartBridge : public DutDriver<Vuart_axi_top> {
+public:
+    UartBridge(const BridgeOptions& opt, SerialEndpoint& port, MailboxServer& mbox)
+        : opt_(opt), port_(port), mbox_(mbox) {
+        dut->uart_rx = 1;
+        dut->uart_cts_n = 0;
+        dut->awaddr = 0;
+        dut->awvalid = 0;
+        dut->wdata = 0;
+        dut->wstrb = 0xF;
+        dut->wvalid = 0;
+        dut->bready = 1;
+        dut->araddr = 0;
+        dut->arvalid = 0;
+        dut->rready = 1;
+        dut->s_axis_tdata = 0;
+        dut->s_axis_tvalid = 0;
+        dut->m_axis_tready = 0;
+    }
+
+    void reset() {
+        pulse_reset();
+        ctrl_ = 0;
+        baud_div_ = uart_reg::BAUD_DIV_RESET;
+        baud_frac_ = 0;
+        rx_timeout_ = 0;
+        rx_queue_.clear();
+        rx_wave_.clear();
+        rx_pos_ = 0;
+        tx_wave_.clear();
+        settle_at_ = 0;
+        mbox_.publish(dut->irq, cycle_count);
+    }
+
+    // Until stop is set
+    void run(const std::atomic<int>& stop) {
+        while (!stop) {
+            pull_line();
+            serve_mailbox();
+            if (rx_busy() || !quiescent()) {
+                for (uint64_t i = 0; i < opt_.quantum; i++) step();
+                stats_.quanta++;
+                flush_line();
+                wait_io(0);
+                continue;
+            }
+
+            // Quiescent: sleep until the endpoint or the doorbell wakes us
+            flush_line();
+            if (!mbox_.prepare_sleep()) continue;
+            stats_.sleeps++;
+            bool woken = wait_io(opt_.idle_ms);
+            mbox_.wake();
+            if (!woken && !stop) {
+                fast_forward(opt_.idle_cycles, baud_period(), [this] { return quiescent(); });
+                stats_.idle_deadlines++;
+                mbox_.publish(dut->irq, cycle_count);
+            }
+        }
+        flush_line();
+    }
+
+    const BridgeStats& stats() const { return stats_; }
+
+private:
+    // Bit time of the DUT as last written/read through the mailbox
+    UartLineConfig line() const {
+        uint32_t osr = (ctrl_ & uart_reg::CTRL_OSR_MASK) >> uart_reg::CTRL_OSR_SHIFT;
+        UartLineConfig cfg;
+        cfg.oversample = (osr == 1) ? 8 : (osr == 2) ? 4 : 16;
+        cfg.baud_div = baud_div_ & 0xFFFF;
+        cfg.baud_frac = baud_frac_ & uart_reg::BAUD_FRAC_MASK;
+        cfg.idle_bits = 1;   // Guard bit, uart_rx rearms after the stop bit
+        return cfg;
+    }
+
+    // baud_gen state repeats every divisor (x64 + fraction with BAUD_FRAC)
+    uint64_t baud_period() const {
+        uint64_t div = (baud_div_ & 0xFFFF) ? (baud_div_ & 0xFFFF) : 1;
+        uint32_t frac = baud_frac_ & uart_reg::BAUD_FRAC_MASK;
+        return frac ? 64 * div + frac : div;
+    }
+
+    // Cycles after the last RX frame or RX_DATA read in which the RX
+    // timeout can still fire
+    uint64_t rx_timeout_horizon() const {
+        return (rx_timeout_ & 0xFF) ? line().bit_edge((rx_timeout_ & 0xFF) + 2) : 0;
+    }
+
+    // Queued bytes may go out: always, or with CTRL.RTS_EN once RTS is
+    // asserted (checked before every frame)
+    bool rx_clear() const {
+        return !rx_queue_.empty() && (!(ctrl_ & uart_reg::CTRL_RTS_EN) || !dut->uart_rts_n);
+    }
+
+    bool rx_busy() const { return rx_pos_ < rx_wave_.size() || rx_clear(); }
+
+    // Idle uart_rx: encode the queue, or its first byte under RTS
+    void feed_rx() {
+        UartLineConfig cfg = line();
+        size_t n = (ctrl_ & uart_reg::CTRL_RTS_EN) ? 1 : rx_queue_.size();
+        for (size_t i = 0; i < n; i++) uart_line_append_frame(rx_wave_, (uint8_t)rx_queue_[i], cfg);
+        rx_queue_.erase(0, n);
+    }
+
+    // One clock: drive uart_rx from the queued waveform, capture uart_tx
+    inline void step() {
+        if (rx_pos_ == rx_wave_.size() && rx_clear()) feed_rx();
+        if (rx_pos_ < rx_wave_.size()) {
+            dut->uart_rx = rx_wave_.get(rx_pos_++);
+            if (rx_pos_ == rx_wave_.size()) {
+                rx_wave_.clear();
+                rx_pos_ = 0;
+                settle_at_ = cycle_count + rx_timeout_horizon();
+            }
+        }
+        tick();
+        tx_wave_.push_back(dut->uart_tx != 0);
+    }
+
+    template <typename Pred>
+    bool wait_for(Pred pred) {
+        for (uint64_t i = 0; i < AXI_TIMEOUT; i++) {
+            if (pred()) return true;
+            step();
+        }
+        return pred();
+    }
+
+    // One AXI-Lite transaction; a handshake timeout answers SLVERR
+    MailboxResponse axi_access(const MailboxRequest& req) {
+        MailboxResponse rsp{0, 0, 0};
+        bool ok;
+        if (req.op == MAILBOX_WRITE) {
+            dut->awaddr = req.addr;
+            dut->awvalid = 1;
+            dut->wdata = req.data;
+            dut->wstrb = req.wstrb & 0xF;
+            dut->wvalid = 1;
+            ok = wait_for([this] { return dut->awready && dut->wready; });
+            dut->awvalid = 0;
+            dut->wvalid = 0;
+            step();
+            ok = ok && wait_for([this] { return dut->bvalid != 0; });
+            rsp.resp = ok ? dut->bresp : AXI_RESP_SLVERR;
+            step();
+        } else {
+            dut->araddr = req.addr;
+            dut->arvalid = 1;
+            ok = wait_for([this] { return dut->arready != 0; });
+            dut->arvalid = 0;
+            step();
+            ok = ok && wait_for([this] { return dut->rvalid != 0; });
+            rsp.data = ok ? dut->rdata : 0;
+            rsp.resp = ok ? dut->rresp : AXI_RESP_SLVERR;
+            step();
+        }
+        if (!ok && opt_.verbose) {
+            std::fprintf(stderr, "uart_sim_bridge: AXI %s 0x%02x timed out\n",
+                         req.op == MAILBOX_WRITE ? "write" : "read", req.addr);
+        }
+        rsp.cycle = cycle_count;
+        return rsp;
+    }
+
+    // Keep the line model on the DUT's bit time
+    void track(const MailboxRequest& req, const MailboxResponse& rsp) {
+        if (rsp.resp != 0) return;
+        uint32_t mask = 0xFFFFFFFF;
+        uint32_t value = rsp.data;
+        if (req.op == MAILBOX_WRITE) {
+            mask = 0;
+            for (unsigned lane = 0; lane < 4; lane++) {
+                if (req.wstrb & (1u << lane)) mask |= 0xFFu << (8 * lane);
+            }
+            value = req.data;
+        }
+        uint32_t* reg = nullptr;
+        switch ((req.addr >> 2) & 0xF) {
+            case uart_reg::CTRL:       reg = &ctrl_; break;
+            case uart_reg::BAUD_DIV:   reg = &baud_div_; break;
+            case uart_reg::BAUD_FRAC:  reg = &baud_frac_; break;
+            case uart_reg::RX_TIMEOUT: reg = &rx_timeout_; break;
+            default: return;
+        }
+        uint32_t next = (*reg & ~mask) | (value & mask);
+        if (next == *reg) return;
+        if (reg != &rx_timeout_) decode_tx();   // Frames so far at the old rate
+        *reg = next;
+    }
+
+    void serve_mailbox() {
+        uint32_t n = mbox_.serve([this](const MailboxRequest& req) {
+            MailboxResponse rsp = axi_access(req);
+            track(req, rsp);
+            return rsp;
+        });
+        if (!n) return;
+        stats_.mailbox_ops += n;
+        stats_.mailbox_batches++;
+        // An RX_DATA read (or a new RX_TIMEOUT) restarts the RX timeout
+        settle_at_ = cycle_count + rx_timeout_horizon();
+        mbox_.publish(dut->irq, cycle_count);
+    }
+
+    size_t rx_room() const {
+        return rx_queue_.size() < opt_.rx_batch ? opt_.rx_batch - rx_queue_.size() : 0;
+    }
+
+    // Endpoint -> RX queue
+    void pull_line() {
+        size_t room = rx_room();
+        if (!room || port_.fd() < 0) return;
+        char buf[4096];
+        ssize_t n = ::read(port_.fd(), buf, room < sizeof(buf) ? room : sizeof(buf));
+        if (n == 0 || (n < 0 && errno != EAGAIN && errno != EINTR)) {
+            port_.hang_up();
+            return;
+        }
+        if (n < 0) return;
+        rx_queue_.append(buf, (size_t)n);
+        stats_.rx_bytes += n;
+    }
+
+    // uart_tx waveform -> write buffer; the unfinished frame is kept
+    void decode_tx() {
+        UartLineConfig cfg = line();
+        std::vector<UartLineFrame> frames = uart_line_decode_frames(tx_wave_, cfg);
+        for (const UartLineFrame& f : frames) {
+            if (f.frame_error) stats_.tx_frame_errors++;
+            if (port_.fd() < 0 || tx_out_.size() >= opt_.tx_buffer) {
+                stats_.tx_dropped++;
+                continue;
+            }
+            tx_out_.push_back((char)f.data);
+            stats_.tx_bytes++;
+        }
+
+        // Keep from one (high) cycle before the next start edge, so it is
+        // still seen as an edge; glitches are skipped as the decoder does.
+        // No edge: only idle line (or the low stop bit of a bad frame,
+        // never sent by uart_tx) is left.
+        size_t resume = frames.empty() ? 0 : frames.back().start + cfg.bit_centre(9);
+        size_t start = tx_wave_.find_fall(resume);
+        while (start != LineWave::npos && start + cfg.bit_centre(0) < tx_wave_.size() &&
+               tx_wave_.get(start + cfg.bit_centre(0))) {
+            start = tx_wave_.find_fall(start + cfg.bit_centre(0));
+        }
+        if (start == 0) return;
+        LineWave rest;
+        if (start != LineWave::npos) rest.append(tx_wave_, start - 1);
+        tx_wave_ = std::move(rest);
+    }
+
+    // Write buffer -> endpoint, as much as it takes without blocking
+    void push_line() {
+        if (tx_out_.empty() || port_.fd() < 0) return;
+        ssize_t n = ::write(port_.fd(), tx_out_.data(), tx_out_.size());
+        if (n > 0) tx_out_.erase(0, (size_t)n);
+    }
+
+    void flush_line() {
+        decode_tx();
+        push_line();
+        mbox_.publish(dut->irq, cycle_count);
+    }
+
+    // Both lines idle, no AXI traffic, and uart_regs_quiescent(). The RX
+    // timeout has run out once settle_at_ has passed, bytes left unread
+    // or not, so the ISR_SNAPSHOT count is not probed
+    bool quiescent() {
+        if (rx_busy() || cycle_count < settle_at_) return false;
+        if (dut->awvalid || dut->wvalid || dut->arvalid) return false;
+        if (!dut->uart_rx || !dut->uart_tx) return false;
+        return uart_regs_quiescent([this](uint8_t reg) {
+            return axi_access({MAILBOX_READ, (uint32_t)reg << 2, 0, 0}).data;
+        }, true);
+    }
+
+    // poll() the endpoint, listener and doorbell; true on any event
+    bool wait_io(int timeout_ms) {
+        struct pollfd fds[3];
+        nfds_t count = 0;
+        int port_slot = -1, listen_slot = -1;
+        if (port_.fd() >= 0) {
+            short events = 0;
+            if (rx_room()) events |= POLLIN;
+            if (!tx_out_.empty()) events |= POLLOUT;
+            port_slot = (int)count;
+            fds[count++] = {port_.fd(), events, 0};
+        }
+        if (port_.listen_fd() >= 0) {
+            listen_slot = (int)count;
+            fds[count++] = {port_.listen_fd(), POLLIN, 0};
+        }
+        fds[count++] = {mbox_.doorbell_fd(), POLLIN, 0};
+
+        int n = poll(fds, count, timeout_ms);
+        if (n <= 0) return false;
+        if (listen_slot >= 0 && (fds[listen_slot].revents & POLLIN)) port_.accept_client();
+        if (port_slot >= 0 && (fds[port_slot].revents & POLLOUT)) push_line();
+        return true;
+    }
+
+    const BridgeOptions& opt_;
+    SerialEndpoint& port_;
+    MailboxServer& mbox_;
+    BridgeStats stats_;
+
+    // Registers shadowed for the line model
+    uint32_t ctrl_ = 0;
+    uint32_t baud_div_ = uart_reg::BAUD_DIV_RESET;
+    uint32_t baud_frac_ = 0;
+    uint32_t rx_timeout_ = 0;
+
+    std::string rx_queue_;          // Endpoint bytes not yet encoded
+    LineWave rx_wave_;              // uart_rx levels being shifted out
+    size_t rx_pos_ = 0;             // Next level to drive
+    LineWave tx_wave_;              // Captured uart_tx, from before the next frame
+    std::string tx_out_;            // Decoded bytes for the endpoint
+    uint64_t settle_at_ = 0;        // Not quiescent before this cycle
+};
+
+void print_stats(const UartBridge& bridge) {
+    const BridgeStats& s = bridge.stats();
+    std::printf("uart_sim_bridge: %llu cycles (%llu skipped), rx %llu bytes, tx %llu bytes"
+                " (%llu dropped, %llu frame errors), %llu mailbox ops in %llu batches,"
+                " %llu quanta, %llu sleeps, %llu idle deadlines\n",
+                (unsigned long long)bridge.cycle_count, (unsigned long long)bridge.skipped_cycles,
+                (unsigned long long)s.rx_bytes, (unsigned long long)s.tx_bytes,
+                (unsigned long long)s.tx_dropped, (unsigned long long)s.tx_frame_errors,
+                (unsigned long long)s.mailbox_ops, (unsigned long long)s.mailbox_batches,
+                (unsigned long long)s.quanta, (unsigned long long)s.sleeps,
+                (unsigned long long)s.idle_deadlines);
+}
+
+//=====================================================================
+// --check: a host thread drives the bridge through a socketpair line and
+// its own mailbox, as host software would
+//=====================================================================
+
+class CheckHost {
+public:
+    CheckHost(const std::string& mailbox, int line) : line_(line) {
+        ok_ = host_.open(mailbox);
+        if (!ok_) message_ = "cannot open mailbox " + mailbox;
+    }
+
+    bool ok() const { return ok_; }
+    const std::string& message() const { return message_; }
+
+    void run() {
+        if (!ok_) return;
+        // RTS flow control throughout: the host drains RX_DATA far slower
+        // than the line fills the RX FIFO
+        const uint32_t ctrl = uart_reg::CTRL_TX_EN | uart_reg::CTRL_RX_EN | uart_reg::CTRL_RTS_EN;
+        write(uart_reg::BAUD_DIV, 1);
+        write(uart_reg::CTRL, ctrl);
+        round_trip("div 1, 16x", 200);
+
+        // Line model follows a rate change (8x, BAUD_DIV 3)
+        write(uart_reg::BAUD_DIV, 3);
+        write(uart_reg::CTRL, ctrl | (1u << uart_reg::CTRL_OSR_SHIFT));
+        round_trip("div 3, 8x", 40);
+
+        // Fractional divisor
+        write(uart_reg::BAUD_DIV, 2);
+        write(uart_reg::BAUD_FRAC, 24);
+        write(uart_reg::CTRL, ctrl);
+        round_trip("div 2 + 24/64, 16x", 40);
+        write(uart_reg::BAUD_FRAC, 0);
+        write(uart_reg::BAUD_DIV, 1);
+
+        // irq over the mailbox: RX_READY on one byte
+        write(uart_reg::INT_ENABLE, uart_reg::INT_RX_READY);
+        send({0x42});
+        if (ok_ && !host_.wait_irq(true, 5000)) fail("irq not raised by an RX byte");
+        expect_rx("irq byte", {0x42});
+        write(uart_reg::INT_STATUS, uart_reg::INT_MASK);
+        if (ok_ && !host_.wait_irq(false, 5000)) fail("irq not cleared");
+        write(uart_reg::INT_ENABLE, 0);
+
+        // Idle long enough for deadlines; time must move on while asleep.
+        // TX_EN is set throughout, so TX_STALLS counts the whole span
+        // between CLEAR and SNAPSHOT, skipped cycles included
+        uint64_t cleared = write_at(uart_reg::PERF_CTRL, uart_reg::PERF_CLEAR);
+        uint64_t before = host_.cycle();
+        std::this_thread::sleep_for(std::chrono::milliseconds(60));
+        if (ok_ && host_.cycle() <= before) fail("simulated time stood still while idle");
+        uint64_t span = write_at(uart_reg::PERF_CTRL, uart_reg::PERF_SNAPSHOT | uart_reg::PERF_TX_STALLS) -
+                        cleared;
+        uint64_t stalls = read(uart_reg::PERF_DATA);
+        if (ok_ && (stalls > span || stalls + 8 < span)) {
+            fail("TX_STALLS " + std::to_string(stalls) + " over an idle span of " +
+                 std::to_string(span) + " cycles");
+        }
+
+        if (ok_ && (read(uart_reg::STATUS) & uart_reg::STATUS_OVERRUN)) fail("overrun under RTS flow control");
+    }
+
+private:
+    void fail(const std::string& what) {
+        if (ok_) message_ = what;
+        ok_ = false;
+    }
+
+    void write(uint8_t reg, uint32_t data) {
+        if (ok_ && !host_.write((uint32_t)reg << 2, data, 0xF, 5000)) {
+            fail("mailbox write to register " + std::to_string(reg) + " failed");
+        }
+    }
+
+    // Write, returning the simulated cycle it completed on
+    uint64_t write_at(uint8_t reg, uint32_t data) {
+        MailboxResponse rsp{0, 0, 0};
+        if (ok_ && (!host_.post_write((uint32_t)reg << 2, data) || !host_.next(rsp, 5000) || rsp.resp)) {
+            fail("mailbox write to register " + std::to_string(reg) + " failed");
+        }
+        return rsp.cycle;
+    }
+
+    uint32_t read(uint8_t reg) {
+        uint32_t data = 0;
+        if (ok_ && !host_.read((uint32_t)reg << 2, data, 5000)) {
+            fail("mailbox read of register " + std::to_string(reg) + " failed");
+        }
+        return data;
+    }
+
+    void send(const std::vector<uint8_t>& bytes) {
+        size_t done = 0;
+        while (ok_ && done < bytes.size()) {
+            ssize_t n = ::write(line_, bytes.data() + done, bytes.size() - done);
+            if (n > 0) {
+                done += n;
+            } else {
+                struct pollfd pfd = {line_, POLLOUT, 0};
+                if (poll(&pfd, 1, 5000) <= 0) fail("line write stalled");
+            }
+        }
+    }
+
+    // TX: bytes written through TX_DATA (a batch per free FIFO space)
+    // must come out of the line in order
+    void expect_tx(const char* what, const std::vector<uint8_t>& bytes) {
+        size_t posted = 0;
+        std::vector<uint8_t> got;
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (ok_ && got.size() < bytes.size()) {
+            if (posted < bytes.size() && (read(uart_reg::STATUS) & uart_reg::STATUS_TX_EMPTY)) {
+                for (unsigned i = 0; i < 8 && posted < bytes.size(); i++) {
+                    host_.post_write(uart_reg::TX_DATA << 2, bytes[posted++]);
+                }
+                MailboxResponse rsp;
+                while (ok_ && host_.outstanding()) {
+                    if (!host_.next(rsp, 5000) || rsp.resp) fail("TX_DATA batch failed");
+                }
+            }
+            struct pollfd pfd = {line_, POLLIN, 0};
+            if (poll(&pfd, 1, 5) > 0) {
+                uint8_t buf[256];
+                ssize_t n = ::read(line_, buf, sizeof(buf));
+                if (n > 0) got.insert(got.end(), buf, buf + n);
+            }
+            if (std::chrono::steady_clock::now() > deadline) {
+                fail(std::string(what) + ": TX timed out after " + std::to_string(got.size()) + " bytes");
+            }
+        }
+        if (ok_ && got != bytes) fail(std::string(what) + ": TX bytes differ");
+    }
+
+    // RX: bytes sent on the line must be read back from RX_DATA, in
+    // batches of ISR_SNAPSHOT.RX_COUNT reads
+    void expect_rx(const char* what, const std::vector<uint8_t>& bytes) {
+        std::vector<uint8_t> got;
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (ok_ && got.size() < bytes.size()) {
+            unsigned count = (read(uart_reg::ISR_SNAPSHOT) >> 16) & 0xFF;
+            for (unsigned i = 0; i < count; i++) host_.post_read(uart_reg::RX_DATA << 2);
+            MailboxResponse rsp;
+            while (ok_ && host_.outstanding()) {
+                if (!host_.next(rsp, 5000) || rsp.resp) fail("RX_DATA batch failed");
+                got.push_back(rsp.data & 0xFF);
+            }
+            if (!count) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            if (std::chrono::steady_clock::now() > deadline) {
+                fail(std::string(what) + ": RX timed out after " + std::to_string(got.size()) + " bytes");
+            }
+        }
+        if (ok_ && got != bytes) fail(std::string(what) + ": RX bytes differ");
+    }
+
+    void round_trip(const char* what, unsigned count) {
+        std::vector<uint8_t> tx, rx;
+        for (unsigned i = 0; i < count; i++) {
+            tx.push_back((uint8_t)(i * 151 + 17));
+            rx.push_back((uint8_t)(i * 73 + 5));
+        }
+        send(rx);
+        expect_rx(what, rx);
+        expect_tx(what, tx);
+    }
+
+    MailboxClient host_;
+    int line_;
+    bool ok_ = true;
+    std::string message_;
+};
+
+int run_check(BridgeOptions opt) {
+    opt.mailbox = "/uart_sim_check_" + std::to_string(getpid());
+    opt.idle_ms = 2;
+    int sv[2];
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, sv) != 0) {
+        std::perror("uart_sim_bridge: socketpair");
+        return 2;
+    }
+    SerialEndpoint port;
+    port.adopt(sv[0], "socketpair");
+    MailboxServer mbox;
+    if (!mbox.create(opt.mailbox)) {
+        std::perror("uart_sim_bridge: mailbox");
+        return 2;
+    }
+
+    UartBridge bridge(opt, port, mbox);
+    bridge.reset();
+
+    std::atomic<int> stop(0);
+    std::string message;
+    bool pass = false;
+    std::thread host([&] {
+        CheckHost check(opt.mailbox, sv[1]);
+        check.run();
+        pass = check.ok();
+        message = check.message();
+        stop = 1;
+    });
+    bridge.run(stop);
+    host.join();
+    ::close(sv[1]);
+
+    print_stats(bridge);
+    const BridgeStats& s = bridge.stats();
+    if (pass && (s.sleeps == 0 || s.idle_deadlines == 0 || bridge.skipped_cycles == 0)) {
+        pass = false;
+        message = "bridge never slept or fast-forwarded while idle";
+    }
+    std::printf("uart_sim_bridge --check: %s%s%s\n", pass ? "PASS" : "FAIL",
+                pass ? "" : ": ", message.c_str());
+    return pass ? 0 : 1;
+}
+
+void usage(const char* prog) {
+    std::fprintf(stderr,
+                 "usage: %s (--pty [--pty-link <path>] | --tcp <port> | --check)"
+                 " [--mailbox <name>] [--quantum <cycles>] [--idle-ms <ms>]"
+                 " [--idle-cycles <n>] [--rx-batch <bytes>] [--tx-buffer <bytes>] [--verbose]\n",
+                 prog);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    Verilated::commandArgs(argc, argv);
+
+    BridgeOptions opt;
+    bool pty = false, check = false;
+    std::string pty_link;
+    unsigned tcp_port = 0;
+    for (int i = 1; i < argc; i++) {
+        if (!std::strcmp(argv[i], "--pty")) {
+            pty = true;
+        } else if (!std::strcmp(argv[i], "--pty-link") && i + 1 < argc) {
+            pty = true;
+            pty_link = argv[++i];
+        } else if (!std::strcmp(argv[i], "--tcp") && i + 1 < argc) {
+            tcp_port = std::atoi(argv[++i]);
+        } else if (!std::strcmp(argv[i], "--check")) {
+            check = true;
+        } else if (!std::strcmp(argv[i], "--mailbox") && i + 1 < argc) {
+            opt.mailbox = argv[++i];
+        } else if (!std::strcmp(argv[i], "--quantum") && i + 1 < argc) {
+            opt.quantum = std::strtoull(argv[++i], nullptr, 0);
+        } else if (!std::strcmp(argv[i], "--idle-ms") && i + 1 < argc) {
+            opt.idle_ms = std::atoi(argv[++i]);
+        } else if (!std::strcmp(argv[i], "--idle-cycles") && i + 1 < argc) {
+            opt.idle_cycles = std::strtoull(argv[++i], nullptr, 0);
+        } else if (!std::strcmp(argv[i], "--rx-batch") && i + 1 < argc) {
+            opt.rx_batch = std::strtoull(argv[++i], nullptr, 0);
+        } else if (!std::strcmp(argv[i], "--tx-buffer") && i + 1 < argc) {
+            opt.tx_buffer = std::strtoull(argv[++i], nullptr, 0);
+        } else if (!std::strcmp(argv[i], "--verbose")) {
+            opt.verbose = true;
+        } else if (argv[i][0] != '+') {  // +verilator+ options pass through
+            usage(argv[0]);
+            return 2;
+        }
+    }
+    if ((int)pty + (tcp_port != 0) + (int)check != 1 || opt.quantum == 0 || opt.rx_batch == 0 ||
+        opt.idle_ms < 0 || opt.mailbox.empty() || opt.mailbox[0] != '/') {
+        usage(argv[0]);
+        return 2;
+    }
+
+    if (check) return run_check(opt);
+
+    SerialEndpoint port;
+    if (pty ? !port.open_pty(pty_link) : !port.open_tcp(tcp_port)) {
+        std::perror(pty ? "uart_sim_bridge: pty" : "uart_sim_bridge: tcp");
+        return 2;
+    }
+    MailboxServer mbox;
+    if (!mbox.create(opt.mailbox)) {
+        std::perror("uart_sim_bridge: mailbox");
+        return 2;
+    }
+
+    struct sigaction sa;
+    std::memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = on_signal;   // No SA_RESTART: poll() returns on a signal
+    sigaction(SIGINT, &sa, nullptr);
+    sigaction(SIGTERM, &sa, nullptr);
+    signal(SIGPIPE, SIG_IGN);    // Client gone: write() fails instead
+
+    UartBridge bridge(opt, port, mbox);
+    bridge.reset();
+    std::printf("uart_sim_bridge: line %s, mailbox %s (doorbell %s)\n", port.name().c_str(),
+                opt.mailbox.c_str(), mailbox_doorbell_path(opt.mailbox).c_str());
+    std::fflush(stdout);
+    bridge.run(g_stop);
+    print_stats(bridge);
+    return 0;
+}
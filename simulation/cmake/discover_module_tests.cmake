@@ -0,0 +1,95 @@
+######################################################################
+#
+# DESCRIPTION: Boost.Test case discovery for CTest sharding
+#
+# Included by ctest at test time (TEST_INCLUDE_FILE). Enumerates the
+# test tree of TEST_EXECUTABLE with --list_content and registers one
+# CTest entry per test case, labelled with its suite name, so that
+# `ctest -j N` spreads the regression over N worker processes and
+# reports per-case wall time.
+#
+# Inputs:
+#   TEST_EXECUTABLE - path to the Boost.Test binary
+#   TEST_ARGS       - extra arguments passed to every test case
+#
+######################################################################
+
+if(NOT EXISTS "${TEST_EXECUTABLE}")
+  # Keep a visible failure instead of silently reporting zero tests
+  add_test(module_tests_NOT_BUILT "${TEST_EXECUTABLE}")
+  return()
+endif()
+
+execute_process(
+  COMMAND "${TEST_EXECUTABLE}" --list_content
+  OUTPUT_VARIABLE list_out
+  ERROR_VARIABLE  list_err
+  RESULT_VARIABLE list_rc
+)
+
+if(NOT list_rc EQUAL 0)
+  add_test(module_tests_DISCOVERY_FAILED "${TEST_EXECUTABLE}" --list_content)
+  return()
+endif()
+
+# Boost.Test prints the tree on stderr (4-space indent per level,
+# trailing '*' on enabled units), master suite omitted:
+#   UartTop_ModuleTests*
+#       uart_top_reset_state*
+string(REPLACE "\n" ";" list_lines "${list_err}${list_out}")
+
+set(unit_depths "")
+set(unit_names "")
+foreach(line IN LISTS list_lines)
+  if(line MATCHES "^( *)([A-Za-z0-9_]+)\\*? *$")
+    string(LENGTH "${CMAKE_MATCH_1}" indent)
+    math(EXPR depth "${indent} / 4")
+    list(APPEND unit_depths ${depth})
+    list(APPEND unit_names "${CMAKE_MATCH_2}")
+  endif()
+endforeach()
+
+list(LENGTH unit_names unit_count)
+if(unit_count EQUAL 0)
+  add_test(module_tests_DISCOVERY_FAILED "${TEST_EXECUTABLE}" --list_content)
+  return()
+endif()
+
+# A unit is a test case (leaf) when the next unit is not deeper
+set(path_stack "")
+math(EXPR last "${unit_count} - 1")
+foreach(i RANGE ${last})
+  list(GET unit_depths ${i} depth)
+  list(GET unit_names ${i} name)
+
+  # Trim the suite path back to this unit's parent
+  list(LENGTH path_stack stack_len)
+  while(stack_len GREATER depth)
+    list(REMOVE_AT path_stack -1)
+    list(LENGTH path_stack stack_len)
+  endwhile()
+
+  set(is_leaf TRUE)
+  if(i LESS last)
+    math(EXPR next "${i} + 1")
+    list(GET unit_depths ${next} next_depth)
+    if(next_depth GREATER depth)
+      set(is_leaf FALSE)
+    endif()
+  endif()
+
+  if(is_leaf)
+    string(REPLACE ";" "/" suite_path "${path_stack}")
+    if(suite_path STREQUAL "")
+      set(test_id "${name}")
+      set(suite_label "default")
+    else()
+      set(test_id "${suite_path}/${name}")
+      list(GET path_stack 0 suite_label)
+    endif()
+    add_test("${test_id}" "${TEST_EXECUTABLE}" "--run_test=${test_id}" ${TEST_ARGS})
+    set_tests_properties("${test_id}" PROPERTIES LABELS "${suite_label}")
+  else()
+    list(APPEND path_stack "${name}")
+  endif()
+endforeach()
@@ -0,0 +1,257 @@
+/*
+ * UART Coverage Merge
+ *
+ * Merges Verilator coverage shards (module_tests, uart_random_regress,
+ * see tests/common/coverage_collect.h) into one database and prints
+ * per-module line/branch/toggle summaries.
+ *
+ * Features:
+ * - Inputs: shard files, or directories (every *.dat inside except the
+ *   --into file)
+ * - Incremental: --into <merged.dat> is read first and rewritten, and
+ *   --consume deletes each shard once the merged file is on disk, so a
+ *   repeated run only parses the shards written since the last one
+ * - Parallel: shards are parsed on --jobs threads into private DBs and
+ *   reduced at the end, so thousands of seed shards merge in one pass
+ * - Summary for uart_rx, uart_tx, sync_fifo and axi_lite_slave_if by
+ *   default, or --modules <a,b,...> / --modules all; --json for a
+ *   machine-readable copy
+ * - --min <percent>: fail if a reported line or toggle figure is below
+ *
+ * Usage:
+ *   uart_cov_merge --into coverage/merged.dat --consume coverage/shards
+ *   uart_cov_merge --modules all coverage/merged.dat
+ *
+ * IMPORTANT:
+ * - The merged file is ordinary Verilator coverage data, so
+ *   verilator_coverage --annotate works on it
+ * - A shard that cannot be read fails the run and is never consumed
+ * - Exit status: 0 ok, 1 below --min, 2 usage or file error
+ */
+
+#include "coverage_db.h"
+#include <dirent.h>
+#include <sys/stat.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+const char* const DEFAULT_MODULES[] = {"uart_rx", "uart_tx", "sync_fifo", "axi_lite_slave_if"};
+const char* const SUMMARY_KINDS[] = {"line", "branch", "toggle"};
+
+bool is_dir(const std::string& path) {
+    struct stat st;
+    return stat(path.c_str(), &st) == 0 && S_ISDIR(st.st_mode);
+}
+
+bool same_file(const std::string& a, const std::string& b) {
+    struct stat sa, sb;
+    return stat(a.c_str(), &sa) == 0 && stat(b.c_str(), &sb) == 0 &&
+           sa.st_dev == sb.st_dev && sa.st_ino == sb.st_ino;
+}
+
+// *.dat directly inside dir (not hidden scratch files), sorted
+std::vector<std::string> list_shards(const std::string& dir) {
+    std::vector<std::string> out;
+    DIR* d = opendir(dir.c_str());
+    if (!d) return out;
+    while (struct dirent* e = readdir(d)) {
+        std::string name = e->d_name;
+        if (name[0] == '.' || name.size() < 5 || name.compare(name.size() - 4, 4, ".dat") != 0) {
+            continue;
+        }
+        out.push_back(dir + "/" + name);
+    }
+    closedir(d);
+    std::sort(out.begin(), out.end());
+    return out;
+}
+
+// Parses shards on `jobs` threads; failed paths are appended to `bad`
+CoverageDb merge_parallel(const std::vector<std::string>& shards, unsigned jobs,
+                          std::vector<std::string>& bad) {
+    jobs = std::max(1u, std::min<unsigned>(jobs, shards.size()));
+    std::vector<CoverageDb> partial(jobs);
+    std::vector<std::vector<std::string>> failed(jobs);
+    std::atomic<size_t> next(0);
+    auto worker = [&](unsigned j) {
+        for (size_t i = next++; i < shards.size(); i = next++) {
+            if (!partial[j].merge_file(shards[i])) failed[j].push_back(shards[i]);
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (unsigned j = 1; j < jobs; j++) pool.emplace_back(worker, j);
+    worker(0);
+    for (std::thread& t : pool) t.join();
+
+    for (unsigned j = 1; j < jobs; j++) {
+        partial[0].merge(partial[j]);
+        partial[j].clear();
+    }
+    for (const auto& f : failed) bad.insert(bad.end(), f.begin(), f.end());
+    return std::move(partial[0]);
+}
+
+std::vector<std::string> split(const std::string& list) {
+    std::vector<std::string> out;
+    std::stringstream ss(list);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        if (!item.empty()) out.push_back(item);
+    }
+    return out;
+}
+
+std::string to_json(const CoverageReport& report, const std::vector<std::string>& modules) {
+    std::ostringstream os;
+    os << "{\n";
+    for (size_t m = 0; m < modules.size(); m++) {
+        auto it = report.find(modules[m]);
+        os << "  \"" << modules[m] << "\": {";
+        bool first = true;
+        if (it != report.end()) {
+            for (const auto& kv : it->second) {
+                os << (first ? "" : ", ") << "\"" << kv.first << "\": {\"points\": "
+                   << kv.second.points << ", \"covered\": " << kv.second.covered << "}";
+                first = false;
+            }
+        }
+        os << "}" << (m + 1 < modules.size() ? "," : "") << "\n";
+    }
+    os << "}\n";
+    return os.str();
+}
+
+void usage(const char* prog) {
+    std::fprintf(stderr,
+                 "usage: %s [--into <merged.dat>] [--consume] [--jobs <j>]"
+                 " [--modules <a,b,...>|all] [--json <out.json>] [--min <percent>]"
+                 " <shard.dat|dir>...\n", prog);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    std::string into, json_path;
+    std::vector<std::string> inputs, modules;
+    bool consume = false, all_modules = false;
+    unsigned jobs = std::thread::hardware_concurrency();
+    double min_percent = -1;
+    for (int i = 1; i < argc; i++) {
+        if (!std::strcmp(argv[i], "--into") && i + 1 < argc) {
+            into = argv[++i];
+        } else if (!std::strcmp(argv[i], "--consume")) {
+            consume = true;
+        } else if (!std::strcmp(argv[i], "--jobs") && i + 1 < argc) {
+            jobs = std::atoi(argv[++i]);
+        } else if (!std::strcmp(argv[i], "--modules") && i + 1 < argc) {
+            std::string list = argv[++i];
+            all_modules = list == "all";
+            if (!all_modules) modules = split(list);
+        } else if (!std::strcmp(argv[i], "--json") && i + 1 < argc) {
+            json_path = argv[++i];
+        } else if (!std::strcmp(argv[i], "--min") && i + 1 < argc) {
+            min_percent = std::atof(argv[++i]);
+        } else if (argv[i][0] == '-') {
+            usage(argv[0]);
+            return 2;
+        } else {
+            inputs.push_back(argv[i]);
+        }
+    }
+    if (inputs.empty() && into.empty()) {
+        usage(argv[0]);
+        return 2;
+    }
+    if (modules.empty() && !all_modules) {
+        modules.assign(std::begin(DEFAULT_MODULES), std::end(DEFAULT_MODULES));
+    }
+
+    std::vector<std::string> shards;
+    for (const std::string& in : inputs) {
+        if (is_dir(in)) {
+            for (const std::string& s : list_shards(in)) {
+                if (into.empty() || !same_file(s, into)) shards.push_back(s);
+            }
+        } else {
+            shards.push_back(in);
+        }
+    }
+
+    std::vector<std::string> bad;
+    CoverageDb db = merge_parallel(shards, jobs, bad);
+    for (const std::string& b : bad) std::fprintf(stderr, "uart_cov_merge: cannot read %s\n", b.c_str());
+    if (!bad.empty()) return 2;
+
+    if (!into.empty()) {
+        std::ifstream probe(into);
+        if (probe && !db.merge_file(into)) {
+            std::fprintf(stderr, "uart_cov_merge: %s is not coverage data\n", into.c_str());
+            return 2;
+        }
+        probe.close();
+        if (!db.write(into)) {
+            std::fprintf(stderr, "uart_cov_merge: cannot write %s\n", into.c_str());
+            return 2;
+        }
+        if (consume) {
+            for (const std::string& s : shards) std::remove(s.c_str());
+        }
+    }
+    std::printf("Merged %zu shard(s), %zu points%s%s\n", shards.size(), db.size(),
+                into.empty() ? "" : " into ", into.c_str());
+
+    CoverageReport report = db.summarize();
+    if (all_modules) {
+        for (const auto& kv : report) modules.push_back(kv.first);
+    }
+
+    int low = 0;
+    std::printf("  %-22s", "module");
+    for (const char* kind : SUMMARY_KINDS) std::printf(" %22s", kind);
+    std::printf("\n");
+    for (const std::string& m : modules) {
+        std::printf("  %-22s", m.c_str());
+        auto it = report.find(m);
+        for (const char* kind : SUMMARY_KINDS) {
+            CoverageSummary s;
+            if (it != report.end() && it->second.count(kind)) s = it->second.at(kind);
+            if (!s.points) {
+                std::printf(" %22s", "-");
+                continue;
+            }
+            char cell[32];
+            std::snprintf(cell, sizeof(cell), "%llu/%llu %5.1f%%",
+                          (unsigned long long)s.covered, (unsigned long long)s.points, s.percent());
+            std::printf(" %22s", cell);
+            if (std::strcmp(kind, "branch") != 0 && s.percent() < min_percent) low++;
+        }
+        if (it == report.end()) std::printf("  (no points)");
+        std::printf("\n");
+    }
+
+    if (!json_path.empty()) {
+        std::ofstream out(json_path);
+        if (!out) {
+            std::fprintf(stderr, "uart_cov_merge: cannot write %s\n", json_path.c_str());
+            return 2;
+        }
+        out << to_json(report, modules);
+    }
+
+    if (low) {
+        std::printf("%d figure(s) below %.1f%%\n", low, min_percent);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,291 @@
+/*
+ * UART Batched Stream Regression
+ *
+ * Seed sweep on uart_top with many model instances per thread
+ * (batch_runner.h): each seed is one short full-duplex AXI-Stream
+ * scenario, and every worker advances a batch of them in lockstep
+ * quanta instead of paying process and test-framework start-up per seed.
+ *
+ * Stimulus (per seed, one PRNG stream):
+ * - BAUD_DIV 1-3, CTRL.OSR 16x or 8x, CTRL.STREAM_EN with TX and RX on
+ * - TX: random bytes offered on s_axis back to back
+ * - RX: random frames on uart_rx with 0-3 idle bits between them, while
+ *   m_axis_tready is dropped on random cycles
+ *
+ * Scoreboard:
+ * - uart_tx, decoded from the whole captured waveform (uart_line.h),
+ *   must equal the accepted s_axis bytes
+ * - m_axis must deliver exactly the frames sent on uart_rx
+ * - Both directions must finish within a line-rate cycle budget
+ *
+ * Usage:
+ *   uart_batch_regress [--seeds <n>] [--first-seed <s>] [--jobs <j>]
+ *                      [--width <instances per thread>] [--quantum <cycles>]
+ *                      [--bytes <n>]
+ *   uart_batch_regress --first-seed 1234 --seeds 1   # replay one seed
+ *
+ * IMPORTANT:
+ * - Results depend on the seed only, never on --jobs/--width/--quantum
+ * - RTL assertions stay fatal: a context's error flag is shared by every
+ *   instance in the batch, so it cannot name the failing seed
+ * - Links UART_TOP_MODEL; reset and setup are warm-started per
+ *   configuration when the model is savable (DUT_DRIVER_SAVABLE)
+ * - Exit status: 0 pass, 1 failing seed, 2 usage error
+ */
+
+#include "Vuart_top.h"
+#include <verilated.h>
+#include "batch_runner.h"
+#include "dut_driver.h"
+#include "uart_line.h"
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+DUT_DRIVER_PORTS(Vuart_top, uart_clk, rst_n);
+
+namespace {
+
+constexpr uint8_t REG_CTRL     = 0x0;
+constexpr uint8_t REG_BAUD_DIV = 0x4;
+
+constexpr uint32_t CTRL_TX_EN     = 1u << 0;
+constexpr uint32_t CTRL_RX_EN     = 1u << 1;
+constexpr uint32_t CTRL_STREAM_EN = 1u << 3;
+constexpr uint32_t CTRL_OSR_8X    = 1u << 4;
+
+constexpr uint64_t SLACK_CYCLES = 5000;   // Budget beyond the line time
+
+struct SeedResult {
+    uint64_t seed = 0;
+    bool pass = false;
+    std::string message;
+    uint64_t cycles = 0;
+};
+
+class StreamJob : public DutDriver<Vuart_top> {
+public:
+    StreamJob(VerilatedContext* context, uint64_t seed, unsigned bytes)
+        : DutDriver<Vuart_top>(context), rng_(seed) {
+        result_.seed = seed;
+        dut->uart_rx = 1;
+        dut->uart_cts_n = 0;
+        dut->ext_baud_tick = 0;
+        dut->reg_addr = 0;
+        dut->reg_wdata = 0;
+        dut->reg_wstrb = 0xF;
+        dut->reg_wen = 0;
+        dut->reg_ren = 0;
+        dut->s_axis_tdata = 0;
+        dut->s_axis_tvalid = 0;
+        dut->m_axis_tready = 0;
+
+        line_.baud_div = 1 + pick(3);
+        line_.oversample = chance(0.3) ? 8 : 16;
+        for (unsigned i = 0; i < bytes; i++) tx_bytes_.push_back(pick(256));
+        for (unsigned i = 0; i < bytes; i++) {
+            rx_bytes_.push_back(pick(256));
+            UartLineConfig gap = line_;
+            gap.idle_bits = pick(4);
+            uart_line_append_frame(rx_wave_, rx_bytes_.back(), gap);
+        }
+        budget_ = (rx_wave_.size() > uint64_t(bytes) * 10 * line_.bit_cycles()
+                       ? rx_wave_.size() : uint64_t(bytes) * 10 * line_.bit_cycles()) +
+                  SLACK_CYCLES;
+        tx_wave_.reserve(budget_);
+
+        uint32_t ctrl = CTRL_TX_EN | CTRL_RX_EN | CTRL_STREAM_EN |
+                        (line_.oversample == 8 ? CTRL_OSR_8X : 0);
+        warm_start("batch.div" + std::to_string(line_.baud_div) + ".osr" +
+                       std::to_string(line_.oversample),
+                   [&] {
+                       pulse_reset();
+                       write_reg(REG_BAUD_DIV, line_.baud_div);
+                       write_reg(REG_CTRL, ctrl);
+                   });
+        start_ = cycle_count;
+    }
+
+    // Batch runner hook: false once the seed is scored
+    bool advance(uint64_t cycles) {
+        for (uint64_t i = 0; i < cycles && !finished_; i++) cycle();
+        return !finished_;
+    }
+
+    const SeedResult& result() const { return result_; }
+
+private:
+    unsigned pick(unsigned n) { return std::uniform_int_distribution<unsigned>(0, n - 1)(rng_); }
+    bool chance(double p) { return std::bernoulli_distribution(p)(rng_); }
+
+    void write_reg(uint8_t addr, uint32_t data) {
+        dut->reg_addr = addr;
+        dut->reg_wdata = data;
+        dut->reg_wen = 1;
+        tick();
+        dut->reg_wen = 0;
+    }
+
+    // Outputs settled after the last edge are what the next edge samples
+    // (no ready/valid path is combinational through the DUT)
+    void cycle() {
+        uint64_t t = cycle_count - start_;
+        dut->uart_rx = t < rx_wave_.size() ? rx_wave_.get(t) : 1;
+
+        bool offer = tx_next_ < tx_bytes_.size();
+        dut->s_axis_tvalid = offer;
+        dut->s_axis_tdata = offer ? tx_bytes_[tx_next_] : 0;
+        bool tx_take = offer && dut->s_axis_tready;
+
+        if (!ready_bits_) ready_bits_ = rng_() | 1ull << 63;
+        dut->m_axis_tready = ready_bits_ & 1;
+        ready_bits_ >>= 1;
+        bool rx_take = dut->m_axis_tready && dut->m_axis_tvalid;
+        uint8_t rx_data = dut->m_axis_tdata;
+
+        tick();
+        tx_wave_.push_back(dut->uart_tx != 0);
+        tx_high_ = dut->uart_tx ? tx_high_ + 1 : 0;
+        if (tx_take) tx_next_++;
+        if (rx_take) rx_got_.push_back(rx_data);
+
+        bool tx_done = tx_next_ == tx_bytes_.size() && tx_high_ > 11 * line_.bit_cycles();
+        bool rx_done = t >= rx_wave_.size() && rx_got_.size() >= rx_bytes_.size();
+        if (tx_done && rx_done) {
+            score();
+        } else if (t >= budget_) {
+            fail("timeout: " + std::to_string(tx_next_) + "/" + std::to_string(tx_bytes_.size()) +
+                 " TX accepted, " + std::to_string(rx_got_.size()) + "/" +
+                 std::to_string(rx_bytes_.size()) + " RX delivered");
+        }
+    }
+
+    void score() {
+        std::vector<uint8_t> sent = uart_line_decode(tx_wave_, line_);
+        if (sent != tx_bytes_) {
+            fail("uart_tx: " + std::to_string(sent.size()) + " bytes decoded, " +
+                 std::to_string(tx_bytes_.size()) + " accepted" + first_diff(sent, tx_bytes_));
+        } else if (rx_got_ != rx_bytes_) {
+            fail("m_axis: " + std::to_string(rx_got_.size()) + " bytes, " +
+                 std::to_string(rx_bytes_.size()) + " sent" + first_diff(rx_got_, rx_bytes_));
+        } else {
+            result_.pass = true;
+        }
+        finish();
+    }
+
+    void fail(const std::string& message) {
+        result_.message = "cycle " + std::to_string(cycle_count - start_) + ": " + message;
+        finish();
+    }
+
+    void finish() {
+        finished_ = true;
+        result_.cycles = cycle_count;
+    }
+
+    static std::string first_diff(const std::vector<uint8_t>& got,
+                                  const std::vector<uint8_t>& want) {
+        for (size_t i = 0; i < got.size() && i < want.size(); i++) {
+            if (got[i] != want[i]) {
+                char buf[48];
+                std::snprintf(buf, sizeof(buf), " (byte %zu: 0x%02x, expected 0x%02x)", i,
+                              got[i], want[i]);
+                return buf;
+            }
+        }
+        return "";
+    }
+
+    std::mt19937_64 rng_;
+    SeedResult result_;
+    UartLineConfig line_;
+    uint64_t start_ = 0;
+    uint64_t budget_ = 0;
+    bool finished_ = false;
+
+    // TX: s_axis source and captured line
+    std::vector<uint8_t> tx_bytes_;
+    size_t tx_next_ = 0;
+    LineWave tx_wave_;
+    uint64_t tx_high_ = 0;
+
+    // RX: line waveform and m_axis sink
+    std::vector<uint8_t> rx_bytes_;
+    LineWave rx_wave_;
+    std::vector<uint8_t> rx_got_;
+    uint64_t ready_bits_ = 0;   // m_axis_tready pattern, one bit per cycle
+};
+
+void usage(const char* prog) {
+    std::fprintf(stderr,
+                 "usage: %s [--seeds <n>] [--first-seed <s>] [--jobs <j>] [--width <n>]"
+                 " [--quantum <cycles>] [--bytes <n>]\n", prog);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    Verilated::commandArgs(argc, argv);
+
+    uint64_t seeds = 1000, first_seed = 1;
+    unsigned bytes = 24;
+    BatchOptions opt;
+    for (int i = 1; i < argc; i++) {
+        if (!std::strcmp(argv[i], "--seeds") && i + 1 < argc) {
+            seeds = std::strtoull(argv[++i], nullptr, 0);
+        } else if (!std::strcmp(argv[i], "--first-seed") && i + 1 < argc) {
+            first_seed = std::strtoull(argv[++i], nullptr, 0);
+        } else if (!std::strcmp(argv[i], "--jobs") && i + 1 < argc) {
+            opt.jobs = std::atoi(argv[++i]);
+        } else if (!std::strcmp(argv[i], "--width") && i + 1 < argc) {
+            opt.width = std::atoi(argv[++i]);
+        } else if (!std::strcmp(argv[i], "--quantum") && i + 1 < argc) {
+            opt.quantum = std::strtoull(argv[++i], nullptr, 0);
+        } else if (!std::strcmp(argv[i], "--bytes") && i + 1 < argc) {
+            bytes = std::atoi(argv[++i]);
+        } else if (argv[i][0] != '+') {  // +verilator+ options pass through
+            usage(argv[0]);
+            return 2;
+        }
+    }
+    if (seeds == 0 || bytes == 0 || opt.width == 0) {
+        usage(argv[0]);
+        return 2;
+    }
+    opt.context_setup = [](VerilatedContext& context) { context.randReset(2); };
+
+    std::vector<SeedResult> results(seeds);
+    auto start = std::chrono::steady_clock::now();
+    BatchStats stats = batch_run(
+        seeds, opt,
+        [&](uint64_t i, VerilatedContext* context) {
+            return std::unique_ptr<StreamJob>(new StreamJob(context, first_seed + i, bytes));
+        },
+        [&](uint64_t i, StreamJob& job) { results[i] = job.result(); });
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    uint64_t cycles = 0;
+    int failed = 0;
+    for (const SeedResult& r : results) {
+        cycles += r.cycles;
+        if (!r.pass && failed++ < 20) {
+            std::printf("FAIL seed %llu: %s\n", (unsigned long long)r.seed, r.message.c_str());
+            std::printf("     replay: %s --first-seed %llu --seeds 1 --bytes %u\n", argv[0],
+                        (unsigned long long)r.seed, bytes);
+        }
+    }
+    std::printf("%zu seeds, %d failed, %.2f s (%.1f seeds/s, %.2f Mcycles/s, %u threads x %u"
+                " instances, %llu turns)\n",
+                results.size(), failed, seconds, seconds > 0 ? results.size() / seconds : 0.0,
+                seconds > 0 ? cycles / seconds / 1e6 : 0.0, stats.threads, opt.width,
+                (unsigned long long)stats.turns);
+    return failed ? 1 : 0;
+}
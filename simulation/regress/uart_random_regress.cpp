@@ -0,0 +1,967 @@
+/*
+ * UART Constrained-Random Regression
+ *
+ * Randomized traffic on the AXI-Lite integration model, checked by a
+ * scoreboard and repeated over many seeds in parallel. Every seed draws
+ * its whole stimulus from one PRNG stream, so a failing seed replays
+ * exactly with --seed.
+ *
+ * Stimulus (per seed):
+ * - Profile: balanced, tx_burst, rx_flood, errors or reconfig, which
+ *   biases the action weights below
+ * - TX bursts of random bytes written while STATUS.TX_FULL is clear
+ * - RX frames of random bytes with 1-4 idle bits between frames and
+ *   injected bad stop bits (frame errors)
+ * - RX drains of ISR_SNAPSHOT.RX_COUNT bytes at random intervals, so a
+ *   slow reader overruns the RX FIFO
+ * - BAUD_DIV and CTRL.OSR (16x / 8x) changes once both lines are idle
+ * - FIFO_CTRL TX resets mid-traffic and RX resets between frames
+ *
+ * Scoreboard:
+ * - uart_tx frames are decoded at bit centres and must match the
+ *   accepted TX_DATA bytes in order; nothing may be left over
+ * - RX_DATA bytes must equal the frames sent on uart_rx, or be an ordered
+ *   subsequence of them once an overrun or an RX FIFO reset dropped data
+ * - STATUS.FRAME_ERR is seen if and only if a bad stop bit was sent, and
+ *   STATUS.OVERRUN only if bytes really went missing
+ * - RTL assertions ($error) fail the seed instead of the process
+ *
+ * Coverage bins (seeds that hit each bin, summed over the run):
+ * tx_fifo_full, tx_fifo_wrap, rx_fifo_full, rx_fifo_wrap, rx_overrun,
+ * frame_error, baud_change, osr_8x, tx_reset_busy, rx_reset_nonempty
+ *
+ * Checkpoints (models verilated with --savable, DUT_DRIVER_SAVABLE):
+ * - Warm start: reset plus the initial BAUD_DIV/CTRL setup is simulated
+ *   once per configuration and restored from an image for every later
+ *   seed with the same divisor and OSR (see tests/common/checkpoint.h)
+ * - --checkpoint-every <ops>: every n ops a seed saves model and bench
+ *   state (scoreboard, line BFM and monitor, PRNG) to
+ *   <checkpoint-dir>/seed<s>.ckpt, replacing the previous one; the file
+ *   is deleted when the seed passes, so a failing seed leaves the image
+ *   nearest before its failure
+ * - --resume <file>: continues that seed from the image, verbose
+ *
+ * Usage:
+ *   uart_random_regress [--seeds <n>] [--first-seed <s>] [--jobs <j>]
+ *                       [--ops <n>] [--json <out.json>] [--require-coverage]
+ *                       [--coverage-dir <dir>]
+ *                       [--checkpoint-every <ops>] [--checkpoint-dir <dir>]
+ *   uart_random_regress --seed 1234        # replay one seed, verbose
+ *   uart_random_regress --resume ckpt/seed1234.ckpt
+ *
+ * IMPORTANT:
+ * - Each worker thread owns a VerilatedContext and builds a fresh model
+ *   per seed, so results depend on the seed only, never on --jobs or on
+ *   whether a seed was warm-started or resumed
+ * - Links UART_AXI_TOP_MODEL: configure with UART_SIM_FAST=ON (and
+ *   UART_SIM_THREADS=1) for thousands of seeds
+ * - Verilator coverage (instrumented build only, DUT_DRIVER_COVERAGE):
+ *   with --coverage-dir or UART_COVERAGE_DIR, every seed's points are
+ *   merged in memory and the run writes a single shard at exit (warm
+ *   starts are off while collecting)
+ * - Multithreaded models (UART_SIM_THREADS > 1) are not savable: every
+ *   seed then simulates its own reset and checkpoint options fail
+ * - Exit status: 0 pass, 1 failing seed or (with --require-coverage) an
+ *   unhit bin, 2 usage or file error
+ */
+
+#include "Vuart_axi_top.h"
+#include <verilated.h>
+#include "dut_driver.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdarg>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+DUT_DRIVER_PORTS(Vuart_axi_top, clk, rst_n);
+
+namespace {
+
+// Register offsets (word addresses; AXI byte address is reg << 2)
+constexpr uint8_t REG_CTRL         = 0x0;
+constexpr uint8_t REG_STATUS       = 0x1;
+constexpr uint8_t REG_TX_DATA      = 0x2;
+constexpr uint8_t REG_RX_DATA      = 0x3;
+constexpr uint8_t REG_BAUD_DIV     = 0x4;
+constexpr uint8_t REG_INT_STATUS   = 0x6;
+constexpr uint8_t REG_FIFO_CTRL    = 0x7;
+constexpr uint8_t REG_ISR_SNAPSHOT = 0xC;
+
+constexpr uint32_t CTRL_TX_EN       = 1u << 0;
+constexpr uint32_t CTRL_RX_EN       = 1u << 1;
+constexpr uint32_t CTRL_OSR_8X      = 1u << 4;
+constexpr uint32_t STATUS_TX_EMPTY  = 1u << 0;
+constexpr uint32_t STATUS_TX_FULL   = 1u << 1;
+constexpr uint32_t STATUS_RX_EMPTY  = 1u << 2;
+constexpr uint32_t STATUS_RX_FULL   = 1u << 3;
+constexpr uint32_t STATUS_TX_ACTIVE = 1u << 4;
+constexpr uint32_t STATUS_RX_ACTIVE = 1u << 5;
+constexpr uint32_t STATUS_FRAME_ERR = 1u << 6;
+constexpr uint32_t STATUS_OVERRUN   = 1u << 7;
+constexpr uint32_t INT_FRAME_ERR    = 1u << 2;
+constexpr uint32_t INT_OVERRUN      = 1u << 3;
+constexpr uint32_t FIFO_TX_RESET    = 1u << 0;
+constexpr uint32_t FIFO_RX_RESET    = 1u << 1;
+
+constexpr unsigned FIFO_DEPTH   = 8;       // uart_axi_top default
+constexpr uint64_t AXI_TIMEOUT  = 1000;    // Cycles per AXI handshake
+constexpr uint64_t IDLE_TIMEOUT = 2000000; // Cycles to drain all traffic
+
+const unsigned BAUD_DIVISORS[] = {1, 2, 3, 4};
+
+constexpr uint32_t HOST_BLOB_VERSION = 1;   // RandomBench checkpoint layout
+
+enum CoverBin {
+    COV_TX_FULL, COV_TX_WRAP, COV_RX_FULL, COV_RX_WRAP, COV_OVERRUN,
+    COV_FRAME_ERR, COV_BAUD_CHANGE, COV_OSR_8X, COV_TX_RESET_BUSY,
+    COV_RX_RESET_DATA, COV_NUM
+};
+
+const char* const COVER_NAMES[COV_NUM] = {
+    "tx_fifo_full", "tx_fifo_wrap", "rx_fifo_full", "rx_fifo_wrap", "rx_overrun",
+    "frame_error", "baud_change", "osr_8x", "tx_reset_busy", "rx_reset_nonempty"
+};
+
+enum Action { ACT_TX, ACT_RX_FRAMES, ACT_RX_DRAIN, ACT_IDLE, ACT_BAUD, ACT_TX_RESET, ACT_RX_RESET, ACT_NUM };
+
+struct ProfileDef {
+    const char* name;
+    unsigned weights[ACT_NUM];   // Indexed by Action
+    double bad_stop;             // Probability a queued RX frame has a bad stop bit
+};
+
+const ProfileDef PROFILES[] = {
+    {"balanced", {4, 4, 4, 2, 1, 1, 1}, 0.03},
+    {"tx_burst", {8, 1, 2, 2, 0, 1, 0}, 0.0},
+    {"rx_flood", {1, 8, 1, 3, 0, 0, 1}, 0.0},
+    {"errors",   {2, 6, 4, 2, 0, 0, 1}, 0.25},
+    {"reconfig", {3, 3, 3, 1, 4, 2, 2}, 0.03},
+};
+
+constexpr unsigned NUM_PROFILES = sizeof(PROFILES) / sizeof(PROFILES[0]);
+
+struct SeedResult {
+    uint64_t seed = 0;
+    bool pass = false;
+    std::string message;   // First failure
+    const char* profile = "";
+    uint64_t cycles = 0;
+    uint32_t coverage = 0; // Bit per CoverBin
+    std::string checkpoint;   // Last mid-soak image of a failing seed
+    unsigned checkpoint_op = 0;
+};
+
+struct RxFrame {
+    uint8_t data;
+    bool bad_stop;
+    unsigned idle_bits;
+};
+
+// Flat copy of bench state for a checkpoint's host blob
+class HostBlob {
+public:
+    HostBlob() = default;
+    explicit HostBlob(std::string data) : data_(std::move(data)) {}
+
+    const std::string& data() const { return data_; }
+
+    template <typename T>
+    void put(const T& v) {
+        static_assert(std::is_trivially_copyable<T>::value, "flat fields only");
+        data_.append(reinterpret_cast<const char*>(&v), sizeof(v));
+    }
+    template <typename Seq>
+    void put_seq(const Seq& seq) {
+        put<uint64_t>(seq.size());
+        for (const auto& e : seq) put(e);
+    }
+    void put_str(const std::string& str) {
+        put<uint64_t>(str.size());
+        data_ += str;
+    }
+
+    // Each get fails (and leaves v alone) past the end of the blob
+    template <typename T>
+    bool get(T& v) {
+        if (data_.size() - pos_ < sizeof(v)) return false;
+        std::memcpy(&v, data_.data() + pos_, sizeof(v));
+        pos_ += sizeof(v);
+        return true;
+    }
+    template <typename Seq>
+    bool get_seq(Seq& seq) {
+        uint64_t n;
+        if (!get(n)) return false;
+        seq.clear();
+        for (uint64_t i = 0; i < n; i++) {
+            typename Seq::value_type e;
+            if (!get(e)) return false;
+            seq.push_back(e);
+        }
+        return true;
+    }
+    bool get_str(std::string& str) {
+        uint64_t n;
+        if (!get(n) || data_.size() - pos_ < n) return false;
+        str = data_.substr(pos_, n);
+        pos_ += n;
+        return true;
+    }
+
+private:
+    std::string data_;
+    size_t pos_ = 0;
+};
+
+class RandomBench : public DutDriver<Vuart_axi_top> {
+public:
+    RandomBench(VerilatedContext* context, uint64_t seed, bool verbose)
+        : DutDriver<Vuart_axi_top>(context), context_(context), rng_(seed), verbose_(verbose) {
+        result_.seed = seed;
+        dut->uart_rx = 1;
+        dut->uart_cts_n = 0;
+        dut->awaddr = 0;
+        dut->awvalid = 0;
+        dut->wdata = 0;
+        dut->wstrb = 0xF;
+        dut->wvalid = 0;
+        dut->bready = 1;
+        dut->araddr = 0;
+        dut->arvalid = 0;
+        dut->rready = 1;
+        dut->s_axis_tdata = 0;
+        dut->s_axis_tvalid = 0;
+        dut->m_axis_tready = 0;
+    }
+
+    // Mid-soak images every `every` ops to <dir>/seed<s>.ckpt
+    void checkpoint_to(const std::string& dir, unsigned every) {
+        checkpoint_dir_ = dir;
+        checkpoint_every_ = every;
+    }
+
+    SeedResult run(unsigned ops) {
+        profile_ = pick(NUM_PROFILES);
+        result_.profile = PROFILES[profile_].name;
+        unsigned div = BAUD_DIVISORS[pick(4)];
+        bool osr8 = chance(0.25);
+
+        // Reset and initial setup draw no random numbers, so every seed
+        // with this configuration shares one image
+        warm_start("regress.div" + std::to_string(div) + (osr8 ? ".osr8" : ".osr16"), [&] {
+            pulse_reset();
+            configure(div, osr8);
+        });
+        div_ = div;
+        osr8_ = osr8;
+        if (osr8) cover(COV_OSR_8X);
+        log("profile %s, div %u, %ux\n", result_.profile, div_, osr8_ ? 8 : 16);
+        return soak(0, ops);
+    }
+
+#ifdef DUT_DRIVER_SAVABLE
+    // Continues a seed from a mid-soak image (the bench is then that seed)
+    bool resume(const std::string& path, SeedResult& result) {
+        std::string host;
+        if (!restore_checkpoint(path, &host) || !unpack(HostBlob(host))) return false;
+        log("resumed %s at op %u/%u: profile %s, div %u, %ux\n", path.c_str(), op_, ops_,
+            result_.profile, div_, osr8_ ? 8 : 16);
+        result = soak(op_, ops_);
+        return true;
+    }
+#endif
+
+private:
+    SeedResult soak(unsigned first_op, unsigned ops) {
+        const ProfileDef& profile = PROFILES[profile_];
+        std::discrete_distribution<unsigned> action(std::begin(profile.weights),
+                                                    std::end(profile.weights));
+        ops_ = ops;
+        for (op_ = first_op; op_ < ops && ok(); op_++) {
+            if (checkpoint_every_ && op_ != first_op && op_ % checkpoint_every_ == 0) {
+                save_soak();
+            }
+            switch (action(rng_)) {
+                case ACT_TX:        do_tx_burst(1 + pick(12)); break;
+                case ACT_RX_FRAMES: do_rx_frames(1 + pick(6), profile.bad_stop); break;
+                case ACT_RX_DRAIN:  do_rx_drain(1 + pick(12)); break;
+                case ACT_IDLE:      idle(1 + pick(20 * bit_cycles())); break;
+                case ACT_BAUD:      do_baud_change(); break;
+                case ACT_TX_RESET:  do_tx_reset(); break;
+                case ACT_RX_RESET:  do_rx_reset(); break;
+            }
+        }
+
+        if (ok()) quiesce();
+        if (ok()) check_totals();
+        result_.pass = ok();
+        result_.cycles = cycle_count;
+        if (!checkpoint_path_.empty()) {
+            if (result_.pass) {
+                std::remove(checkpoint_path_.c_str());
+            } else {
+                result_.checkpoint = checkpoint_path_;
+                result_.checkpoint_op = checkpoint_op_;
+            }
+        }
+        return result_;
+    }
+
+    // ========================================================================
+    // Mid-soak checkpoints
+    // ========================================================================
+
+#ifdef DUT_DRIVER_SAVABLE
+    void save_soak() {
+        std::string path = checkpoint_dir_ + "/seed" + std::to_string(result_.seed) + ".ckpt";
+        if (!save_checkpoint(path, pack().data())) {
+            fail("cannot write checkpoint " + path);
+            return;
+        }
+        checkpoint_path_ = path;
+        checkpoint_op_ = op_;
+        log("checkpoint %s at op %u\n", path.c_str(), op_);
+    }
+
+    HostBlob pack() const {
+        HostBlob b;
+        std::ostringstream rng;
+        rng << rng_;
+        b.put(HOST_BLOB_VERSION);
+        b.put(result_.seed);
+        b.put(result_.coverage);
+        b.put(profile_);
+        b.put(op_);
+        b.put(ops_);
+        b.put_str(rng.str());
+        b.put(div_);
+        b.put(osr8_);
+        b.put_seq(rx_queue_);
+        b.put_seq(rx_bits_);
+        b.put(rx_bit_);
+        b.put(rx_bit_left_);
+        b.put(mon_state_);
+        b.put(tx_prev_);
+        b.put(mon_start_);
+        b.put(mon_high_);
+        b.put(mon_bit_);
+        b.put(mon_data_);
+        b.put_seq(tx_expected_);
+        b.put(tx_checked_);
+        b.put_seq(rx_sent_);
+        b.put_seq(rx_received_);
+        b.put(bad_frames_);
+        b.put(frame_err_seen_);
+        b.put(overrun_seen_);
+        b.put(rx_lossy_);
+        return b;
+    }
+
+    bool unpack(HostBlob b) {
+        uint32_t version = 0;
+        std::string rng;
+        bool good = b.get(version) && version == HOST_BLOB_VERSION && b.get(result_.seed) &&
+                  b.get(result_.coverage) && b.get(profile_) && profile_ < NUM_PROFILES &&
+                  b.get(op_) && b.get(ops_) && b.get_str(rng) && b.get(div_) && b.get(osr8_) &&
+                  b.get_seq(rx_queue_) && b.get_seq(rx_bits_) && b.get(rx_bit_) &&
+                  b.get(rx_bit_left_) && b.get(mon_state_) && b.get(tx_prev_) &&
+                  b.get(mon_start_) && b.get(mon_high_) && b.get(mon_bit_) && b.get(mon_data_) &&
+                  b.get_seq(tx_expected_) && b.get(tx_checked_) && b.get_seq(rx_sent_) &&
+                  b.get_seq(rx_received_) && b.get(bad_frames_) && b.get(frame_err_seen_) &&
+                  b.get(overrun_seen_) && b.get(rx_lossy_);
+        if (!good) return false;
+        std::istringstream(rng) >> rng_;
+        result_.profile = PROFILES[profile_].name;
+        return true;
+    }
+#else
+    void save_soak() {}
+#endif
+
+    // ========================================================================
+    // Random helpers
+    // ========================================================================
+
+    unsigned pick(unsigned n) { return std::uniform_int_distribution<unsigned>(0, n - 1)(rng_); }
+    bool chance(double p) { return std::bernoulli_distribution(p)(rng_); }
+
+    void log(const char* fmt, ...) {
+        if (!verbose_) return;
+        va_list args;
+        va_start(args, fmt);
+        std::printf("[%8llu] ", (unsigned long long)cycle_count);
+        std::vprintf(fmt, args);
+        va_end(args);
+    }
+
+    bool ok() const { return result_.message.empty(); }
+
+    void fail(const std::string& message) {
+        if (!ok()) return;
+        std::ostringstream os;
+        os << "cycle " << cycle_count << ": " << message;
+        result_.message = os.str();
+        log("FAIL %s\n", message.c_str());
+    }
+
+    void cover(CoverBin bin) { result_.coverage |= 1u << bin; }
+
+    unsigned bit_cycles() const { return (osr8_ ? 8 : 16) * div_; }
+
+    // ========================================================================
+    // Clocking: RX line BFM, TX line monitor, AXI-Lite master
+    // ========================================================================
+
+    // One cycle with the line BFM and monitor attached
+    void step() {
+        drive_rx();
+        tick();
+        monitor_tx();
+        if (context_->gotError()) {
+            context_->gotError(false);
+            fail("RTL assertion failed");
+        }
+    }
+
+    void idle(uint64_t cycles) {
+        for (uint64_t i = 0; i < cycles && ok(); i++) step();
+    }
+
+    template <typename Pred>
+    bool wait_for(Pred pred, uint64_t timeout, const char* what) {
+        for (uint64_t i = 0; i < timeout && ok(); i++) {
+            if (pred()) return true;
+            step();
+        }
+        if (ok() && !pred()) fail(std::string("timeout waiting for ") + what);
+        return ok();
+    }
+
+    void axi_write(uint8_t reg, uint32_t data) {
+        dut->awaddr = reg << 2;
+        dut->awvalid = 1;
+        dut->wdata = data;
+        dut->wvalid = 1;
+        wait_for([this] { return dut->awready && dut->wready; }, AXI_TIMEOUT, "awready/wready");
+        dut->awvalid = 0;
+        dut->wvalid = 0;
+        step();
+        wait_for([this] { return dut->bvalid != 0; }, AXI_TIMEOUT, "bvalid");
+        step();
+    }
+
+    uint32_t axi_read(uint8_t reg) {
+        dut->araddr = reg << 2;
+        dut->arvalid = 1;
+        wait_for([this] { return dut->arready != 0; }, AXI_TIMEOUT, "arready");
+        dut->arvalid = 0;
+        step();
+        wait_for([this] { return dut->rvalid != 0; }, AXI_TIMEOUT, "rvalid");
+        uint32_t data = dut->rdata;
+        step();
+        return data;
+    }
+
+    // Serializes queued frames onto uart_rx at the current bit time
+    void drive_rx() {
+        if (rx_bit_ == rx_bits_.size()) {
+            if (rx_queue_.empty()) {
+                dut->uart_rx = 1;
+                return;
+            }
+            RxFrame frame = rx_queue_.front();
+            rx_queue_.pop_front();
+            rx_bits_ = uart_frame_bits(frame.data);
+            if (frame.bad_stop) rx_bits_.back() = 0;
+            rx_bits_.insert(rx_bits_.end(), frame.idle_bits, 1);
+            rx_bit_ = 0;
+            rx_bit_left_ = bit_cycles();
+            rx_sent_.push_back(frame.data);
+            if (frame.bad_stop) bad_frames_++;
+        }
+        dut->uart_rx = rx_bits_[rx_bit_];
+        if (--rx_bit_left_ == 0) {
+            rx_bit_++;
+            rx_bit_left_ = bit_cycles();
+        }
+    }
+
+    bool rx_line_idle() const { return rx_queue_.empty() && rx_bit_ == rx_bits_.size(); }
+
+    // Decodes uart_tx at bit centres and scores each byte
+    void monitor_tx() {
+        uint8_t line = dut->uart_tx;
+        switch (mon_state_) {
+            case MON_RESYNC:
+                // After a TX reset: wait for a full idle frame time
+                mon_high_ = line ? mon_high_ + 1 : 0;
+                if (mon_high_ >= 11 * bit_cycles()) mon_state_ = MON_IDLE;
+                break;
+            case MON_IDLE:
+                if (tx_prev_ && !line) {
+                    mon_state_ = MON_FRAME;
+                    mon_start_ = cycle_count;
+                    mon_bit_ = 0;
+                    mon_data_ = 0;
+                }
+                break;
+            case MON_FRAME:
+                if (cycle_count == mon_start_ + mon_bit_ * bit_cycles() + bit_cycles() / 2) {
+                    if (mon_bit_ == 0 && line) {
+                        fail("uart_tx: start bit not low at its centre");
+                    } else if (mon_bit_ >= 1 && mon_bit_ <= 8) {
+                        mon_data_ |= line << (mon_bit_ - 1);
+                    } else if (mon_bit_ == 9) {
+                        if (!line) fail("uart_tx: stop bit low");
+                        score_tx(mon_data_);
+                        mon_state_ = MON_IDLE;
+                    }
+                    mon_bit_++;
+                }
+                break;
+        }
+        tx_prev_ = line;
+    }
+
+    void score_tx(uint8_t data) {
+        if (tx_expected_.empty()) {
+            fail("uart_tx: unexpected byte 0x" + hex(data));
+            return;
+        }
+        if (data != tx_expected_.front()) {
+            fail("uart_tx: byte 0x" + hex(data) + ", expected 0x" + hex(tx_expected_.front()));
+        }
+        tx_expected_.pop_front();
+        if (++tx_checked_ >= 2 * FIFO_DEPTH) cover(COV_TX_WRAP);
+    }
+
+    static std::string hex(uint8_t v) {
+        char buf[3];
+        std::snprintf(buf, sizeof(buf), "%02x", v);
+        return buf;
+    }
+
+    // ========================================================================
+    // Actions
+    // ========================================================================
+
+    void configure(unsigned div, bool osr8) {
+        div_ = div;
+        osr8_ = osr8;
+        axi_write(REG_BAUD_DIV, div);
+        axi_write(REG_CTRL, CTRL_TX_EN | CTRL_RX_EN | (osr8 ? CTRL_OSR_8X : 0));
+        if (osr8) cover(COV_OSR_8X);
+    }
+
+    // Records sticky errors and clears them (W1C)
+    uint32_t read_status() {
+        uint32_t status = axi_read(REG_STATUS);
+        if (status & STATUS_TX_FULL) cover(COV_TX_FULL);
+        if (status & STATUS_RX_FULL) cover(COV_RX_FULL);
+        if (status & (STATUS_FRAME_ERR | STATUS_OVERRUN)) {
+            if (status & STATUS_FRAME_ERR) frame_err_seen_ = true;
+            if (status & STATUS_OVERRUN) overrun_seen_ = true;
+            axi_write(REG_INT_STATUS, INT_FRAME_ERR | INT_OVERRUN);
+        }
+        return status;
+    }
+
+    void do_tx_burst(unsigned n) {
+        if (mon_state_ == MON_RESYNC) return;   // Monitor still discarding a reset frame
+        unsigned written = 0;
+        while (written < n && ok() && !(read_status() & STATUS_TX_FULL)) {
+            uint8_t data = pick(256);
+            axi_write(REG_TX_DATA, data);
+            tx_expected_.push_back(data);
+            written++;
+        }
+        log("tx burst %u/%u\n", written, n);
+    }
+
+    void do_rx_frames(unsigned n, double bad_stop) {
+        for (unsigned i = 0; i < n; i++) {
+            rx_queue_.push_back({static_cast<uint8_t>(pick(256)), chance(bad_stop), 1 + pick(4)});
+        }
+        log("rx queue +%u (%zu pending)\n", n, rx_queue_.size());
+    }
+
+    void do_rx_drain(unsigned max) {
+        unsigned read = 0;
+        read_status();
+        while (read < max && ok()) {
+            unsigned count = (axi_read(REG_ISR_SNAPSHOT) >> 16) & 0xFF;
+            if (count == 0) break;
+            for (unsigned i = 0; i < count && read < max && ok(); i++, read++) {
+                rx_received_.push_back(axi_read(REG_RX_DATA) & 0xFF);
+            }
+        }
+        if (rx_received_.size() >= 2 * FIFO_DEPTH) cover(COV_RX_WRAP);
+        log("rx drain %u\n", read);
+    }
+
+    // Both lines idle, TX FIFO empty; RX is drained on the way
+    void wait_idle() {
+        for (uint64_t start = cycle_count; ok(); ) {
+            if (cycle_count - start > IDLE_TIMEOUT) {
+                fail("timeout waiting for idle lines");
+                return;
+            }
+            if (rx_line_idle() && tx_expected_.empty() && mon_state_ == MON_IDLE) {
+                uint32_t status = read_status();
+                if ((status & STATUS_TX_EMPTY) &&
+                    !(status & (STATUS_TX_ACTIVE | STATUS_RX_ACTIVE))) return;
+            }
+            do_rx_drain(FIFO_DEPTH);
+            idle(bit_cycles());
+        }
+    }
+
+    void do_baud_change() {
+        wait_idle();
+        if (!ok()) return;
+        unsigned div = BAUD_DIVISORS[pick(4)];
+        bool osr8 = chance(0.3);
+        if (div != div_ || osr8 != osr8_) cover(COV_BAUD_CHANGE);
+        configure(div, osr8);
+        log("baud div %u, %ux\n", div_, osr8_ ? 8 : 16);
+    }
+
+    // Flushes the TX FIFO and the byte on the line
+    void do_tx_reset() {
+        if (mon_state_ == MON_RESYNC) return;
+        uint32_t status = read_status();
+        if (!(status & STATUS_TX_EMPTY) || (status & STATUS_TX_ACTIVE)) cover(COV_TX_RESET_BUSY);
+        mon_state_ = MON_RESYNC;
+        mon_high_ = 0;
+        tx_expected_.clear();
+        axi_write(REG_FIFO_CTRL, FIFO_TX_RESET);
+        log("tx reset\n");
+    }
+
+    // Between frames only: a reset mid-frame has no defined outcome
+    void do_rx_reset() {
+        if (!rx_line_idle()) return;
+        uint32_t status = read_status();
+        if (status & STATUS_RX_ACTIVE) return;
+        if (!(status & STATUS_RX_EMPTY)) cover(COV_RX_RESET_DATA);
+        axi_write(REG_FIFO_CTRL, FIFO_RX_RESET);
+        rx_lossy_ = true;
+        log("rx reset\n");
+    }
+
+    // ========================================================================
+    // End of seed
+    // ========================================================================
+
+    void quiesce() {
+        wait_idle();
+        idle(2 * bit_cycles());
+        do_rx_drain(UINT32_MAX);
+        read_status();
+    }
+
+    void check_totals() {
+        if (overrun_seen_) cover(COV_OVERRUN);
+        if (frame_err_seen_) cover(COV_FRAME_ERR);
+
+        if (!tx_expected_.empty()) {
+            fail(std::to_string(tx_expected_.size()) + " TX bytes never sent");
+            return;
+        }
+        if (bad_frames_ && !frame_err_seen_) {
+            fail(std::to_string(bad_frames_) + " bad stop bits, no STATUS.FRAME_ERR");
+            return;
+        }
+        if (!bad_frames_ && frame_err_seen_) {
+            fail("STATUS.FRAME_ERR without a bad stop bit");
+            return;
+        }
+
+        // RX_DATA must be an ordered subsequence of what was sent
+        size_t j = 0;
+        for (size_t i = 0; i < rx_received_.size(); i++, j++) {
+            while (j < rx_sent_.size() && rx_sent_[j] != rx_received_[i]) j++;
+            if (j == rx_sent_.size()) {
+                fail("RX_DATA byte " + std::to_string(i) + " (0x" + hex(rx_received_[i]) +
+                     ") out of order or never sent");
+                return;
+            }
+        }
+        bool missing = rx_received_.size() != rx_sent_.size();
+        if (missing && !overrun_seen_ && !rx_lossy_) {
+            fail(std::to_string(rx_sent_.size() - rx_received_.size()) +
+                 " RX bytes lost without overrun or RX reset");
+        } else if (overrun_seen_ && !missing) {
+            fail("STATUS.OVERRUN but every RX byte arrived");
+        }
+    }
+
+    enum MonState { MON_IDLE, MON_FRAME, MON_RESYNC };
+
+    VerilatedContext* context_;
+    std::mt19937_64 rng_;
+    bool verbose_;
+    SeedResult result_;
+    unsigned profile_ = 0;
+    unsigned op_ = 0;
+    unsigned ops_ = 0;
+
+    // Mid-soak checkpoints
+    std::string checkpoint_dir_;
+    unsigned checkpoint_every_ = 0;
+    std::string checkpoint_path_;   // Last image written
+    unsigned checkpoint_op_ = 0;
+
+    unsigned div_ = 4;
+    bool osr8_ = false;
+
+    // RX line BFM
+    std::deque<RxFrame> rx_queue_;
+    std::vector<uint8_t> rx_bits_;
+    size_t rx_bit_ = 0;
+    uint64_t rx_bit_left_ = 0;
+
+    // TX line monitor
+    MonState mon_state_ = MON_IDLE;
+    uint8_t tx_prev_ = 1;
+    uint64_t mon_start_ = 0;
+    uint64_t mon_high_ = 0;
+    unsigned mon_bit_ = 0;
+    uint8_t mon_data_ = 0;
+
+    // Scoreboard
+    std::deque<uint8_t> tx_expected_;
+    uint64_t tx_checked_ = 0;
+    std::vector<uint8_t> rx_sent_;
+    std::vector<uint8_t> rx_received_;
+    unsigned bad_frames_ = 0;
+    bool frame_err_seen_ = false;
+    bool overrun_seen_ = false;
+    bool rx_lossy_ = false;
+};
+
+// ============================================================================
+// Seed-parallel runner
+// ============================================================================
+
+struct RunOptions {
+    uint64_t first_seed = 1;
+    uint64_t seeds = 1000;
+    unsigned jobs = 0;
+    unsigned ops = 60;
+    bool verbose = false;
+    unsigned checkpoint_every = 0;   // Ops between mid-soak images, 0: none
+    std::string checkpoint_dir = "checkpoints";
+};
+
+unsigned job_count(const RunOptions& opt) {
+    return static_cast<unsigned>(std::max<uint64_t>(1, std::min<uint64_t>(opt.jobs, opt.seeds)));
+}
+
+std::vector<SeedResult> run_seeds(const RunOptions& opt) {
+    std::vector<SeedResult> results(opt.seeds);
+    std::atomic<uint64_t> next(0);
+    auto worker = [&] {
+        std::unique_ptr<VerilatedContext> context(new VerilatedContext);
+        context->fatalOnError(false);
+        context->randReset(2);
+        for (uint64_t i = next++; i < opt.seeds; i = next++) {
+            RandomBench bench(context.get(), opt.first_seed + i, opt.verbose);
+            if (opt.checkpoint_every) bench.checkpoint_to(opt.checkpoint_dir, opt.checkpoint_every);
+            results[i] = bench.run(opt.ops);
+        }
+    };
+
+    unsigned jobs = job_count(opt);
+    std::vector<std::thread> pool;
+    for (unsigned j = 1; j < jobs; j++) pool.emplace_back(worker);
+    worker();
+    for (std::thread& t : pool) t.join();
+    return results;
+}
+
+std::string to_json(const std::vector<SeedResult>& results, const unsigned* hits,
+                    uint64_t cycles, double seconds) {
+    std::ostringstream os;
+    size_t failed = 0;
+    for (const SeedResult& r : results) failed += !r.pass;
+    os << "{\n";
+    os << "  \"seeds\": " << results.size() << ",\n";
+    os << "  \"failed\": " << failed << ",\n";
+    os << "  \"cycles\": " << cycles << ",\n";
+    os << "  \"seconds\": " << seconds << ",\n";
+    os << "  \"seeds_per_second\": " << (seconds > 0 ? results.size() / seconds : 0) << ",\n";
+    os << "  \"coverage\": {";
+    for (unsigned b = 0; b < COV_NUM; b++) {
+        os << (b ? ", " : "") << "\"" << COVER_NAMES[b] << "\": " << hits[b];
+    }
+    os << "},\n";
+    os << "  \"failing_seeds\": [";
+    bool first = true;
+    for (const SeedResult& r : results) {
+        if (r.pass) continue;
+        os << (first ? "" : ", ") << r.seed;
+        first = false;
+    }
+    os << "]\n}\n";
+    return os.str();
+}
+
+void usage(const char* prog) {
+    std::fprintf(stderr,
+                 "usage: %s [--seeds <n>] [--first-seed <s>] [--seed <s>] [--jobs <j>]"
+                 " [--ops <n>] [--json <out.json>] [--require-coverage] [--verbose]"
+                 " [--coverage-dir <dir>] [--checkpoint-every <ops>] [--checkpoint-dir <dir>]"
+                 " [--resume <file>]\n", prog);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    Verilated::commandArgs(argc, argv);
+
+    RunOptions opt;
+    opt.jobs = std::thread::hardware_concurrency();
+    std::string json_path, resume_path;
+    bool require_coverage = false;
+    const char* env_dir = std::getenv("UART_COVERAGE_DIR");
+    std::string coverage_dir = env_dir ? env_dir : "";
+    for (int i = 1; i < argc; i++) {
+        if (!std::strcmp(argv[i], "--seeds") && i + 1 < argc) {
+            opt.seeds = std::strtoull(argv[++i], nullptr, 0);
+        } else if (!std::strcmp(argv[i], "--first-seed") && i + 1 < argc) {
+            opt.first_seed = std::strtoull(argv[++i], nullptr, 0);
+        } else if (!std::strcmp(argv[i], "--seed") && i + 1 < argc) {
+            opt.first_seed = std::strtoull(argv[++i], nullptr, 0);
+            opt.seeds = 1;
+            opt.verbose = true;
+        } else if (!std::strcmp(argv[i], "--jobs") && i + 1 < argc) {
+            opt.jobs = std::atoi(argv[++i]);
+        } else if (!std::strcmp(argv[i], "--ops") && i + 1 < argc) {
+            opt.ops = std::atoi(argv[++i]);
+        } else if (!std::strcmp(argv[i], "--json") && i + 1 < argc) {
+            json_path = argv[++i];
+        } else if (!std::strcmp(argv[i], "--require-coverage")) {
+            require_coverage = true;
+        } else if (!std::strcmp(argv[i], "--verbose")) {
+            opt.verbose = true;
+        } else if (!std::strcmp(argv[i], "--coverage-dir") && i + 1 < argc) {
+            coverage_dir = argv[++i];
+        } else if (!std::strcmp(argv[i], "--checkpoint-every") && i + 1 < argc) {
+            opt.checkpoint_every = std::atoi(argv[++i]);
+        } else if (!std::strcmp(argv[i], "--checkpoint-dir") && i + 1 < argc) {
+            opt.checkpoint_dir = argv[++i];
+        } else if (!std::strcmp(argv[i], "--resume") && i + 1 < argc) {
+            resume_path = argv[++i];
+            opt.seeds = 1;
+            opt.verbose = true;
+        } else if (argv[i][0] != '+') {  // +verilator+ options pass through
+            usage(argv[0]);
+            return 2;
+        }
+    }
+    if (opt.seeds == 0 || opt.ops == 0) {
+        usage(argv[0]);
+        return 2;
+    }
+    if (opt.verbose) opt.jobs = 1;   // Keep the log in seed order
+#ifdef DUT_DRIVER_COVERAGE
+    CoverageCollector::instance().dir = coverage_dir;
+    if (!coverage_dir.empty()) Verilated::mkdir(coverage_dir.c_str());
+#else
+    if (!coverage_dir.empty()) {
+        std::fprintf(stderr, "uart_random_regress: built without coverage, ignoring %s\n",
+                     coverage_dir.c_str());
+    }
+#endif
+#ifdef DUT_DRIVER_SAVABLE
+    if (opt.checkpoint_every) Verilated::mkdir(opt.checkpoint_dir.c_str());
+#else
+    if (opt.checkpoint_every || !resume_path.empty()) {
+        std::fprintf(stderr, "uart_random_regress: model not savable (UART_SIM_THREADS > 1?),"
+                             " no checkpoints\n");
+        return 2;
+    }
+#endif
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<SeedResult> results;
+#ifdef DUT_DRIVER_SAVABLE
+    if (!resume_path.empty()) {
+        VerilatedContext context;
+        context.fatalOnError(false);
+        context.randReset(2);
+        RandomBench bench(&context, 0, true);
+        if (opt.checkpoint_every) bench.checkpoint_to(opt.checkpoint_dir, opt.checkpoint_every);
+        results.resize(1);
+        if (!bench.resume(resume_path, results[0])) {
+            std::fprintf(stderr, "uart_random_regress: cannot resume from %s\n",
+                         resume_path.c_str());
+            return 2;
+        }
+    }
+#endif
+    if (resume_path.empty()) results = run_seeds(opt);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    unsigned hits[COV_NUM] = {};
+    uint64_t cycles = 0;
+    int failed = 0;
+    for (const SeedResult& r : results) {
+        cycles += r.cycles;
+        for (unsigned b = 0; b < COV_NUM; b++) hits[b] += (r.coverage >> b) & 1;
+        if (!r.pass) {
+            if (failed++ < 20) {
+                std::printf("FAIL seed %llu (%s): %s\n", (unsigned long long)r.seed,
+                            r.profile, r.message.c_str());
+                std::printf("     replay: %s --seed %llu --ops %u\n", argv[0],
+                            (unsigned long long)r.seed, opt.ops);
+                if (!r.checkpoint.empty()) {
+                    std::printf("     resume: %s --resume %s   # from op %u\n", argv[0],
+                                r.checkpoint.c_str(), r.checkpoint_op);
+                }
+            }
+        }
+    }
+
+    std::printf("%zu seeds, %d failed, %.1f s (%.1f seeds/s, %.2f Mcycles/s, %u jobs)\n",
+                results.size(), failed, seconds, seconds > 0 ? results.size() / seconds : 0.0,
+                seconds > 0 ? cycles / seconds / 1e6 : 0.0,
+                job_count(opt));
+    int unhit = 0;
+    std::printf("Coverage (seeds hitting each bin):\n");
+    for (unsigned b = 0; b < COV_NUM; b++) {
+        std::printf("  %-20s %8u%s\n", COVER_NAMES[b], hits[b], hits[b] ? "" : "  UNHIT");
+        unhit += !hits[b];
+    }
+
+#ifdef DUT_DRIVER_COVERAGE
+    std::string shard = CoverageCollector::instance().write_shard("uart_random_regress");
+    if (!shard.empty()) std::printf("Coverage shard: %s\n", shard.c_str());
+#endif
+
+    if (!json_path.empty()) {
+        std::ofstream out(json_path);
+        if (!out) {
+            std::fprintf(stderr, "uart_random_regress: cannot write %s\n", json_path.c_str());
+            return 2;
+        }
+        out << to_json(results, hits, cycles, seconds);
+    }
+
+    if (failed) return 1;
+    return (require_coverage && unhit) ? 1 : 0;
+}
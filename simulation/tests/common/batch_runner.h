@@ -0,0 +1,119 @@
+/*
+ * Batch Runner - Many Models per Thread, Advanced in Lockstep
+ *
+ * Runs `count` independent jobs (typically one DutDriver each) on a pool
+ * of worker threads. Every worker owns one VerilatedContext and keeps up
+ * to `width` jobs live in it, advancing each by `quantum` cycles in turn,
+ * so a single process per machine sweeps thousands of short scenarios
+ * without a process, model library load or Boost.Test start-up per seed.
+ *
+ * Features:
+ * - Job: any class with bool advance(uint64_t cycles), false once the job
+ *   is finished; stimulus and scoreboard live in the job
+ * - make(index, context) builds job `index` in the worker's context and
+ *   returns a std::unique_ptr<Job>; done(index, job) collects its result
+ *   just before it is destroyed
+ * - Dynamic scheduling: a worker refills free batch slots from a shared
+ *   job index, so a thread whose jobs finish early takes more of the rest
+ * - BatchOptions::context_setup configures each worker's context
+ *   (fatalOnError, randReset, ...)
+ *
+ * Usage:
+ *   std::vector<Result> results(seeds);
+ *   batch_run(seeds, BatchOptions(),
+ *             [](uint64_t i, VerilatedContext* ctx) {
+ *                 return std::unique_ptr<SeedJob>(new SeedJob(ctx, i));
+ *             },
+ *             [&](uint64_t i, SeedJob& job) { results[i] = job.result(); });
+ *
+ * IMPORTANT:
+ * - The interleaving of jobs within a batch is unspecified: jobs must not
+ *   share mutable state, so results depend on the index only, never on
+ *   jobs/width/quantum
+ * - done() runs on the worker thread: write to a per-index slot or lock
+ * - A context's gotError() flag is shared by the whole batch; benches that
+ *   turn RTL assertions into per-seed failures need width 1 (or keep
+ *   fatalOnError on)
+ */
+
+#ifndef BATCH_RUNNER_H
+#define BATCH_RUNNER_H
+
+#include <verilated.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+struct BatchOptions {
+    unsigned jobs = 0;            // Worker threads, 0: one per core
+    unsigned width = 16;          // Live jobs per worker
+    uint64_t quantum = 1024;      // Cycles per job per turn
+    std::function<void(VerilatedContext&)> context_setup;
+};
+
+struct BatchStats {
+    unsigned threads = 0;
+    uint64_t jobs = 0;            // Jobs finished
+    uint64_t turns = 0;           // advance() calls
+};
+
+template <typename Make, typename Done>
+BatchStats batch_run(uint64_t count, const BatchOptions& opt, Make make, Done done) {
+    using JobPtr = decltype(make(uint64_t(0), static_cast<VerilatedContext*>(nullptr)));
+
+    BatchStats stats;
+    unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+    stats.threads = static_cast<unsigned>(
+        std::max<uint64_t>(1, std::min<uint64_t>(opt.jobs ? opt.jobs : cores, count)));
+    const size_t width = std::max(1u, opt.width);
+    const uint64_t quantum = std::max<uint64_t>(1, opt.quantum);
+
+    std::atomic<uint64_t> next(0), finished(0), turns(0);
+    auto worker = [&] {
+        std::unique_ptr<VerilatedContext> context(new VerilatedContext);
+        if (opt.context_setup) opt.context_setup(*context);
+
+        std::vector<std::pair<uint64_t, JobPtr>> live;
+        live.reserve(width);
+        uint64_t my_turns = 0, my_jobs = 0;
+        for (;;) {
+            while (live.size() < width) {
+                uint64_t i = next++;
+                if (i >= count) break;
+                live.emplace_back(i, make(i, context.get()));
+            }
+            if (live.empty()) break;
+
+            // One turn for every live job; finished ones leave the batch
+            for (size_t s = 0; s < live.size();) {
+                my_turns++;
+                if (live[s].second->advance(quantum)) {
+                    s++;
+                    continue;
+                }
+                done(live[s].first, *live[s].second);
+                my_jobs++;
+                if (s + 1 != live.size()) std::swap(live[s], live.back());
+                live.pop_back();
+            }
+        }
+        turns += my_turns;
+        finished += my_jobs;
+    };
+
+    std::vector<std::thread> pool;
+    for (unsigned t = 1; t < stats.threads; t++) pool.emplace_back(worker);
+    worker();
+    for (std::thread& t : pool) t.join();
+
+    stats.jobs = finished;
+    stats.turns = turns;
+    return stats;
+}
+
+#endif // BATCH_RUNNER_H
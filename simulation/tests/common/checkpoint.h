@@ -0,0 +1,164 @@
+/*
+ * Checkpoint - Saved Model Images for Warm Starts
+ *
+ * Verilator --savable images of a reset and configured model, so a
+ * random seed restores that state instead of simulating the same reset
+ * pulse and register writes again. DutDriver (with
+ * DUT_DRIVER_SAVABLE) writes and reads the images; this file holds the
+ * on-disk header and the per-process image cache behind warm_start().
+ *
+ * Image layout:
+ * - CheckpointHeader: magic, format version, model identity (type name
+ *   hash and size), DutDriver cycle counters, host blob length
+ * - Host blob: opaque bytes owned by the caller (bench state that is not
+ *   in the model: scoreboard, line BFM, PRNG)
+ * - The Verilated model (operator<< from the --savable model)
+ *
+ * Features:
+ * - CheckpointCache: key -> image path, one image per key per process,
+ *   written to <path>.tmp and renamed; thread safe (one context per
+ *   thread in uart_random_regress)
+ * - Images go to UART_CHECKPOINT_DIR if set, else to a private mkdtemp
+ *   directory; either way they are removed at exit
+ *
+ * Usage:
+ *   warm_start("regress.div4.osr16", [this] {
+ *       pulse_reset();
+ *       configure(4, false);
+ *   });
+ *   save_checkpoint("seed42.ckpt", host_state);   // Explicit image
+ *   restore_checkpoint("seed42.ckpt", &host_state);
+ *
+ * IMPORTANT:
+ * - Only compiled into DutDriver when DUT_DRIVER_SAVABLE is defined; the
+ *   model must be verilated with --savable (single-threaded only).
+ *   Without it warm_start() just runs the setup
+ * - Setup must leave nothing behind outside the model except what the
+ *   caller sets again after warm_start(): a restore skips the lambda
+ * - While coverage is collected (DUT_DRIVER_COVERAGE with a directory
+ *   set) warm_start() always runs the setup, so restored counters never
+ *   replace points the model had already hit
+ * - Images are only valid for the build that wrote them; the header
+ *   rejects another model, Verilator rejects another revision of it
+ * - The cache is per process, so warm starts only pay off where one
+ *   process runs a setup many times: uart_random_regress and
+ *   uart_batch_regress sweeps. Module test fixtures do not use it, since
+ *   ctest runs each test case in its own process
+ */
+
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <string>
+#include <typeinfo>
+
+struct CheckpointHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t model_size;         // sizeof(Model)
+    uint64_t model_id;           // Hash of typeid(Model).name()
+    uint64_t cycle_count;
+    uint64_t skipped_cycles;
+    uint64_t host_size;          // Host blob bytes that follow
+
+    static constexpr uint32_t VERSION = 1;
+
+    template <typename Model>
+    static CheckpointHeader make() {
+        CheckpointHeader h;
+        std::memset(&h, 0, sizeof(h));
+        std::memcpy(h.magic, "DUTCKPT", 8);
+        h.version = VERSION;
+        h.model_size = sizeof(Model);
+        h.model_id = model_hash(typeid(Model).name());
+        return h;
+    }
+
+    // Same format and model (counters and host size are not compared)
+    bool matches(const CheckpointHeader& other) const {
+        return std::memcmp(magic, other.magic, sizeof(magic)) == 0 && version == other.version &&
+               model_size == other.model_size && model_id == other.model_id;
+    }
+
+    // FNV-1a
+    static uint64_t model_hash(const char* name) {
+        uint64_t h = 1469598103934665603ull;
+        for (; *name; name++) h = (h ^ static_cast<uint8_t>(*name)) * 1099511628211ull;
+        return h;
+    }
+};
+
+class CheckpointCache {
+public:
+    static CheckpointCache& instance() {
+        static CheckpointCache cache;
+        return cache;
+    }
+
+    // Published image for key, "" if none yet
+    std::string find(const std::string& key) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = images_.find(key);
+        return it == images_.end() ? "" : it->second;
+    }
+
+    // Fresh path to save an image for key to ("" if no directory)
+    std::string reserve(const std::string& key) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!open_dir()) return "";
+        return dir_ + "/" + key + "." + std::to_string(next_id_++) + ".ckpt";
+    }
+
+    // Makes the image at path the one for key; another thread's image for
+    // the same key may have won the race, then path is removed
+    void publish(const std::string& key, const std::string& path) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!images_.emplace(key, path).second) std::remove(path.c_str());
+    }
+
+    ~CheckpointCache() {
+        for (const auto& kv : images_) std::remove(kv.second.c_str());
+        if (own_dir_) rmdir(dir_.c_str());
+    }
+
+private:
+    bool open_dir() {
+        if (!dir_.empty()) return true;
+        if (failed_) return false;
+        const char* value = std::getenv("UART_CHECKPOINT_DIR");
+        if (value && *value) {
+            dir_ = std::string(value) + "/ckpt." + std::to_string(getpid());
+            own_dir_ = mkdir(dir_.c_str(), 0700) == 0;
+            if (own_dir_) return true;
+        } else {
+            const char* tmp = std::getenv("TMPDIR");
+            std::string templ = std::string(tmp && *tmp ? tmp : "/tmp") + "/uart_ckpt.XXXXXX";
+            if (mkdtemp(&templ[0])) {
+                dir_ = templ;
+                own_dir_ = true;
+                return true;
+            }
+        }
+        std::fprintf(stderr, "checkpoint: no image directory, warm starts disabled\n");
+        dir_.clear();
+        failed_ = true;
+        return false;
+    }
+
+    std::mutex mutex_;
+    std::map<std::string, std::string> images_;
+    std::string dir_;
+    bool own_dir_ = false;
+    bool failed_ = false;
+    unsigned next_id_ = 0;
+};
+
+#endif // CHECKPOINT_H
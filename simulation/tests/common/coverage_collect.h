@@ -0,0 +1,122 @@
+/*
+ * Coverage Collect - Per-Process Coverage Shards
+ *
+ * Gathers the Verilator coverage of every model a process builds and
+ * writes it as one shard file per process, for uart_cov_merge (or
+ * verilator_coverage) to combine.
+ *
+ * Verilator coverage points point into the model, so they have to be read
+ * before the model is deleted. DutDriver (with DUT_DRIVER_COVERAGE)
+ * attaches each model to its VerilatedContext here; when the last model
+ * of a context goes away, the context's points are written to a scratch
+ * file, merged into the process CoverageDb (coverage_db.h) and cleared.
+ *
+ * Features:
+ * - Off unless a directory is set: UART_COVERAGE_DIR=<dir> or
+ *   --coverage-dir=<dir> (module_tests after "--")
+ * - Shard names are unique per process: <dir>/<stem>.<pid>.<usec>.dat
+ * - Thread safe: one context per thread (uart_random_regress) snapshots
+ *   independently and merges under a lock
+ *
+ * Usage:
+ *   UART_COVERAGE_DIR=cov ctest -j8
+ *   uart_cov_merge --into cov/merged.dat --consume cov
+ *
+ * IMPORTANT:
+ * - Only compiled into DutDriver when DUT_DRIVER_COVERAGE is defined;
+ *   executables linking only the uninstrumented (UART_SIM_FAST) models
+ *   must not define it (no coverage runtime to link)
+ * - Every model of a context must be owned by a DutDriver: a snapshot
+ *   clears all points of the context
+ */
+
+#ifndef COVERAGE_COLLECT_H
+#define COVERAGE_COLLECT_H
+
+#include <verilated.h>
+#include <verilated_cov.h>
+#include <unistd.h>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <mutex>
+#include <string>
+#include "coverage_db.h"
+
+class CoverageCollector {
+public:
+    static CoverageCollector& instance() {
+        static CoverageCollector collector;
+        return collector;
+    }
+
+    std::string dir;   // Empty: collection off
+
+    bool enabled() const { return !dir.empty(); }
+
+    void from_env() {
+        const char* value = std::getenv("UART_COVERAGE_DIR");
+        if (value && *value) dir = value;
+    }
+
+    // "--coverage-dir=<dir>"; returns false if not ours
+    bool parse_arg(const std::string& arg) {
+        static const std::string opt = "--coverage-dir=";
+        if (arg.compare(0, opt.size(), opt) != 0) return false;
+        dir = arg.substr(opt.size());
+        return true;
+    }
+
+    void attach(VerilatedContext* context) {
+        if (!enabled()) return;
+        std::lock_guard<std::mutex> lock(mutex_);
+        live_[context]++;
+    }
+
+    // Call before the model is deleted
+    void detach(VerilatedContext* context) {
+        if (!enabled()) return;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = live_.find(context);
+            if (it == live_.end() || --it->second) return;
+            live_.erase(it);
+        }
+        std::string scratch = dir + "/.scratch." + std::to_string(getpid()) + "." +
+                              std::to_string(scratch_id_++) + ".dat";
+        context->coveragep()->write(scratch.c_str());
+        context->coveragep()->clear();
+        CoverageDb snapshot;
+        snapshot.merge_file(scratch);
+        std::remove(scratch.c_str());
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        db_.merge(snapshot);
+    }
+
+    // Writes everything collected so far; returns the path ("" if nothing)
+    std::string write_shard(const std::string& stem) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!enabled() || db_.empty()) return "";
+        auto usec = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        std::string path = dir + "/" + stem + "." + std::to_string(getpid()) + "." +
+                           std::to_string(usec) + ".dat";
+        if (!db_.write(path)) {
+            std::fprintf(stderr, "coverage: cannot write %s\n", path.c_str());
+            return "";
+        }
+        db_.clear();
+        return path;
+    }
+
+private:
+    std::mutex mutex_;
+    std::map<VerilatedContext*, unsigned> live_;   // Attached models per context
+    std::atomic<unsigned> scratch_id_{0};
+    CoverageDb db_;
+};
+
+#endif // COVERAGE_COLLECT_H
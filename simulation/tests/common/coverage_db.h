@@ -0,0 +1,168 @@
+/*
+ * Coverage DB - Verilator Coverage Merge and Summary
+ *
+ * In-process reader, merger and writer for Verilator coverage data
+ * ("# SystemC::Coverage-3" header, then one "C '<key>' <count>" line per
+ * point), so shards from many processes or seeds are summed without a
+ * verilator_coverage run per file.
+ *
+ * Features:
+ * - merge_file(path) / merge(db): counts summed per point key
+ * - write(path): same format (verilator_coverage can annotate from it),
+ *   written to <path>.tmp and renamed so readers never see a partial file
+ * - summarize(): covered/total points per module and kind (line, branch,
+ *   toggle, ...), with the instances of one module folded together
+ * - toggle_activity(): toggle counts summed per module, i.e. how often its
+ *   signals switched, for comparing builds or scenarios (uart_activity)
+ *
+ * Usage:
+ *   CoverageDb db;
+ *   db.merge_file("shard0.dat");
+ *   db.merge_file("shard1.dat");
+ *   db.write("merged.dat");
+ *   CoverageReport report = db.summarize();
+ *   report["uart_rx"]["toggle"].percent();
+ *   db.toggle_activity()["baud_gen"];     // Bit toggles, all instances
+ *
+ * IMPORTANT:
+ * - Keys are kept verbatim (fields separated by \001/\002); a point only
+ *   merges with the identical point, so shards from different RTL
+ *   revisions accumulate side by side instead of summing
+ * - In the summary a point is covered if any instance of the module hit
+ *   it (the key minus its hierarchy field)
+ * - Verilator counts every change of a toggle point's bit, so activity is
+ *   only comparable over the same cycles (zero the context first)
+ * - Plain C++: no Verilator runtime needed (see coverage_collect.h for
+ *   reading a live VerilatedContext)
+ */
+
+#ifndef COVERAGE_DB_H
+#define COVERAGE_DB_H
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <string>
+#include <unordered_map>
+
+struct CoverageSummary {
+    uint64_t points = 0;
+    uint64_t covered = 0;
+
+    double percent() const { return points ? 100.0 * covered / points : 0.0; }
+};
+
+// module -> kind ("line", "branch", "toggle", ...) -> summary
+using CoverageReport = std::map<std::string, std::map<std::string, CoverageSummary>>;
+
+class CoverageDb {
+public:
+    // Returns false if the file is missing or not coverage data
+    bool merge_file(const std::string& path) {
+        std::ifstream in(path, std::ios::binary);
+        std::string line;
+        if (!in || !std::getline(in, line) || line.compare(0, 11, "# SystemC::") != 0) return false;
+        while (std::getline(in, line)) {
+            if (line.size() < 4 || line[0] != 'C') continue;
+            size_t open = line.find('\'');
+            size_t close = line.rfind('\'');
+            if (open == std::string::npos || close <= open) continue;
+            counts_[line.substr(open + 1, close - open - 1)] +=
+                std::strtoull(line.c_str() + close + 1, nullptr, 10);
+        }
+        return true;
+    }
+
+    void merge(const CoverageDb& other) {
+        if (counts_.empty()) {
+            counts_ = other.counts_;
+            return;
+        }
+        for (const auto& kv : other.counts_) counts_[kv.first] += kv.second;
+    }
+
+    bool write(const std::string& path) const {
+        std::string tmp = path + ".tmp";
+        {
+            std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+            if (!out) return false;
+            out << "# SystemC::Coverage-3\n";
+            for (const auto& kv : counts_) out << "C '" << kv.first << "' " << kv.second << "\n";
+            if (!out.flush()) return false;
+        }
+        return std::rename(tmp.c_str(), path.c_str()) == 0;
+    }
+
+    size_t size() const { return counts_.size(); }
+    bool empty() const { return counts_.empty(); }
+    void clear() { counts_.clear(); }
+
+    CoverageReport summarize() const {
+        struct Point {
+            std::string module, kind;
+            bool covered;
+        };
+        std::unordered_map<std::string, Point> folded;
+        for (const auto& kv : counts_) {
+            // page is "v_<kind>/<module>"
+            std::string page = field(kv.first, "page");
+            size_t slash = page.find('/');
+            if (page.compare(0, 2, "v_") != 0 || slash == std::string::npos) continue;
+            Point& p = folded.emplace(strip_field(kv.first, "h"),
+                                      Point{page.substr(slash + 1), page.substr(2, slash - 2), false})
+                           .first->second;
+            p.covered = p.covered || kv.second > 0;
+        }
+
+        CoverageReport report;
+        for (const auto& kv : folded) {
+            CoverageSummary& s = report[kv.second.module][kv.second.kind];
+            s.points++;
+            s.covered += kv.second.covered;
+        }
+        return report;
+    }
+
+    // module -> sum of its toggle point counts
+    std::map<std::string, uint64_t> toggle_activity() const {
+        static const std::string prefix = "v_toggle/";
+        std::map<std::string, uint64_t> activity;
+        for (const auto& kv : counts_) {
+            std::string page = field(kv.first, "page");
+            if (page.compare(0, prefix.size(), prefix) != 0) continue;
+            activity[page.substr(prefix.size())] += kv.second;
+        }
+        return activity;
+    }
+
+    // Value of one key field ("page", "h", "f", "l", ...), "" if absent
+    static std::string field(const std::string& key, const std::string& name) {
+        size_t begin, end;
+        if (!find_field(key, name, begin, end)) return "";
+        size_t value = begin + name.size() + 2;
+        return key.substr(value, end - value);
+    }
+
+private:
+    // [begin, end) spans "\001<name>\002<value>"
+    static bool find_field(const std::string& key, const std::string& name,
+                           size_t& begin, size_t& end) {
+        begin = key.find("\001" + name + "\002");
+        if (begin == std::string::npos) return false;
+        end = key.find('\001', begin + 1);
+        if (end == std::string::npos) end = key.size();
+        return true;
+    }
+
+    static std::string strip_field(const std::string& key, const std::string& name) {
+        size_t begin, end;
+        if (!find_field(key, name, begin, end)) return key;
+        return key.substr(0, begin) + key.substr(end);
+    }
+
+    std::unordered_map<std::string, uint64_t> counts_;
+};
+
+#endif // COVERAGE_DB_H
@@ -0,0 +1,454 @@
+/*
+ * DUT Driver - Shared Verilated Model Harness
+ *
+ * Header-only clock/reset driver reused by every module test fixture.
+ * Replaces the hand-rolled tick()/reset() loops that each suite used to
+ * carry, so harness speedups apply to all suites at once.
+ *
+ * Features:
+ * - Templated on the Verilated model type (Vuart_top, Vuart_axi_top, ...)
+ * - Compile-time clock/reset port binding via DutPorts<Model>
+ * - run_cycles(n) / run_until(pred, timeout) stepping
+ * - Bulk bit-stream drive and sample helpers, and packed per-cycle
+ *   waveforms (drive_wave / capture_wave / drive_capture, uart_line.h)
+ * - Idle fast-forward (fast_forward) for quiescent, periodic-state models;
+ *   uart_regs_quiescent() is the idle probe for models with a uart_regs,
+ *   DUT_DRIVER_UART_REGS keeps their PERF TX_STALLS exact across a skip
+ * - Owns the model instance (allocated in ctor, released in dtor), in the
+ *   default or a caller-supplied VerilatedContext
+ * - Optional per-test FST tracing (DUT_DRIVER_TRACE, see trace_control.h)
+ *   with named triggers registered by the fixture (trace_trigger)
+ * - Optional coverage collection (DUT_DRIVER_COVERAGE, see
+ *   coverage_collect.h): points are saved before the model is deleted
+ * - Optional checkpoints (DUT_DRIVER_SAVABLE, see checkpoint.h):
+ *   save_checkpoint / restore_checkpoint, and warm_start() to restore a
+ *   cached reset/configuration image instead of simulating it again
+ *
+ * Usage:
+ *   DUT_DRIVER_PORTS(Vuart_top, uart_clk, rst_n);
+ *
+ *   struct UartTopFixture : DutDriver<Vuart_top> {
+ *       UartTopFixture() {
+ *           dut->uart_rx = 1;
+ *           trace_trigger("irq", [this] { return dut->irq != 0; });
+ *       }
+ *       void reset() { pulse_reset(); }
+ *   };
+ *
+ * IMPORTANT:
+ * - DUT_DRIVER_PORTS must appear once per model, before the fixture
+ * - Verilated ports are reference members, so binding is done through
+ *   static accessors rather than pointers-to-member
+ * - tick() is one full clock cycle: falling edge eval + rising edge eval
+ *   (both are needed for Verilator to see the posedge)
+ * - fast_forward() skips evaluation entirely; it is only exact when the
+ *   caller's quiescent() check proves every register is static except
+ *   free-running counters whose period divides the skipped span, and
+ *   those DutSkip<Model> advances by hand
+ * - Without DUT_DRIVER_TRACE (or with tracing not requested for the
+ *   running test) trace_trigger() is a no-op and tick() carries no dump
+ * - Without DUT_DRIVER_SAVABLE warm_start() runs its setup every time;
+ *   the checkpoint calls need a model verilated with --savable
+ * - warm_start() images live as long as the process: it pays off in one
+ *   process running the same setup many times (the seed sweeps), not in
+ *   test fixtures, which ctest runs one case per process
+ */
+
+#ifndef DUT_DRIVER_H
+#define DUT_DRIVER_H
+
+#include <verilated.h>
+#include <cstdint>
+#include <vector>
+#include "uart_line.h"
+#include "uart_model.h"
+#ifdef DUT_DRIVER_TRACE
+#include <memory>
+#include "trace_control.h"
+#endif
+#ifdef DUT_DRIVER_COVERAGE
+#include "coverage_collect.h"
+#endif
+#ifdef DUT_DRIVER_SAVABLE
+#include <verilated_save.h>
+#include <cstdio>
+#include <string>
+#include "checkpoint.h"
+#endif
+
+// Clock/reset binding for a Verilated model (specialize per model)
+template <typename Model>
+struct DutPorts;
+
+#define DUT_DRIVER_PORTS(MODEL, CLK, RST_N)                       \
+    template <>                                                   \
+    struct DutPorts<MODEL> {                                      \
+        static CData& clk(MODEL& m)   { return m.CLK; }           \
+        static CData& rst_n(MODEL& m) { return m.RST_N; }         \
+    }
+
+// State fast_forward advances by hand over a skipped span: counters
+// that move every idle cycle rather than with the span's period
+// (specialize per model, e.g. DUT_DRIVER_UART_REGS)
+template <typename Model>
+struct DutSkip {
+    static void advance(Model&, uint64_t) {}
+};
+
+template <typename Model, typename Ports = DutPorts<Model>>
+struct DutDriver {
+    Model* dut;
+    uint64_t cycle_count;
+    uint64_t skipped_cycles;   // Cycles jumped by fast_forward (not evaluated)
+
+    DutDriver() : DutDriver(new Model) {}
+
+    // Model in its own context (one per thread for parallel runs)
+    explicit DutDriver(VerilatedContext* context) : DutDriver(new Model(context)) {}
+
+    // Takes ownership of model
+    explicit DutDriver(Model* model) : dut(model), cycle_count(0), skipped_cycles(0) {
+        Ports::clk(*dut) = 0;
+        Ports::rst_n(*dut) = 0;
+#ifdef DUT_DRIVER_TRACE
+        TraceSession& session = TraceSession::instance();
+        if (session.active()) {
+            trace.reset(new ModelTrace<Model>(dut, session.config, session.next_stem()));
+        }
+#endif
+#ifdef DUT_DRIVER_COVERAGE
+        CoverageCollector::instance().attach(dut->contextp());
+#endif
+    }
+
+    ~DutDriver() {
+#ifdef DUT_DRIVER_TRACE
+        trace.reset();   // Close the dump before the model goes away
+#endif
+#ifdef DUT_DRIVER_COVERAGE
+        CoverageCollector::instance().detach(dut->contextp());
+#endif
+        delete dut;
+    }
+
+    DutDriver(const DutDriver&) = delete;
+    DutDriver& operator=(const DutDriver&) = delete;
+
+    // One full clock cycle
+    inline void tick() {
+        CData& clk = Ports::clk(*dut);
+        clk = 0;
+        dut->eval();
+        trace_sample(cycle_count, 0);
+        clk = 1;
+        dut->eval();
+        trace_sample(cycle_count, 1);
+        cycle_count++;
+    }
+
+    // Advance n clock cycles
+    inline void run_cycles(uint64_t n) {
+        CData& clk = Ports::clk(*dut);
+        for (uint64_t i = 0; i < n; i++) {
+            clk = 0;
+            dut->eval();
+            trace_sample(cycle_count + i, 0);
+            clk = 1;
+            dut->eval();
+            trace_sample(cycle_count + i, 1);
+        }
+        cycle_count += n;
+    }
+
+    // Tick until pred() holds, at most timeout cycles.
+    // pred is checked before each tick; returns true if it was satisfied.
+    template <typename Pred>
+    bool run_until(Pred pred, uint64_t timeout) {
+        for (uint64_t i = 0; i < timeout; i++) {
+            if (pred()) return true;
+            tick();
+        }
+        return pred();
+    }
+
+    // Idle for n cycles with inputs held static. After `settle` evaluated
+    // cycles, quiescent() is consulted (it may itself tick, e.g. to read a
+    // status register); if it holds, the largest multiple of `period` that
+    // fits in the remaining span is skipped without evaluation (applying
+    // DutSkip<Model>) and the remainder is simulated normally. If not (a
+    // frame still going out, ...), it is consulted again every min_span
+    // cycles while twice that remains. Spans shorter than min_span are
+    // simply simulated.
+    template <typename Pred>
+    void fast_forward(uint64_t n, uint64_t period, Pred quiescent,
+                      uint64_t settle = 8, uint64_t min_span = 64) {
+        if (n < min_span || period == 0) {
+            run_cycles(n);
+            return;
+        }
+
+        uint64_t start = cycle_count;
+        run_cycles(settle);
+        for (;;) {
+            bool idle = quiescent();
+
+            uint64_t used = cycle_count - start;
+            if (used >= n) return;
+            uint64_t remaining = n - used;
+
+            if (idle) {
+                uint64_t skip = (remaining / period) * period;
+                DutSkip<Model>::advance(*dut, skip);
+                cycle_count += skip;
+                skipped_cycles += skip;
+                run_cycles(remaining - skip);
+                return;
+            }
+            if (remaining < 2 * min_span) {
+                run_cycles(remaining);
+                return;
+            }
+            run_cycles(min_span);
+        }
+    }
+
+    // Assert reset (active low) for `cycles`, release, settle one cycle.
+    // cycle_count restarts from 0 after reset.
+    void pulse_reset(unsigned cycles = 5) {
+        Ports::rst_n(*dut) = 0;
+        run_cycles(cycles);
+        Ports::rst_n(*dut) = 1;
+        tick();
+#ifdef DUT_DRIVER_TRACE
+        trace_epoch += cycle_count;
+#endif
+        cycle_count = 0;
+    }
+
+    // Drive a bit stream: set(bit) then hold it for cycles_per_bit cycles
+    template <typename Setter>
+    void drive_bits(Setter set, const std::vector<uint8_t>& bits,
+                    unsigned cycles_per_bit) {
+        for (uint8_t bit : bits) {
+            set(bit);
+            run_cycles(cycles_per_bit);
+        }
+    }
+
+    // Sample a bit stream: wait first_offset cycles, sample, then sample
+    // every cycles_per_bit cycles until `count` bits are collected.
+    template <typename Getter>
+    std::vector<uint8_t> sample_bits(Getter get, unsigned count,
+                                     unsigned cycles_per_bit,
+                                     unsigned first_offset) {
+        std::vector<uint8_t> bits;
+        bits.reserve(count);
+        for (unsigned i = 0; i < count; i++) {
+            run_cycles(i == 0 ? first_offset : cycles_per_bit);
+            bits.push_back(get() ? 1 : 0);
+        }
+        return bits;
+    }
+
+    // Drive a packed waveform, one level per cycle; each run of equal
+    // levels is a single set() and run_cycles()
+    template <typename Setter>
+    void drive_wave(Setter set, const LineWave& wave) {
+        for (size_t i = 0; i < wave.size();) {
+            bool level = wave.get(i);
+            size_t end = wave.find_level(i, !level);
+            if (end == LineWave::npos) end = wave.size();
+            set(level);
+            run_cycles(end - i);
+            i = end;
+        }
+    }
+
+    // Record get() after each of `cycles` ticks
+    template <typename Getter>
+    LineWave capture_wave(Getter get, uint64_t cycles) {
+        LineWave wave;
+        wave.reserve(cycles);
+        for (uint64_t i = 0; i < cycles; i++) {
+            tick();
+            wave.push_back(get());
+        }
+        return wave;
+    }
+
+    // drive_wave and capture_wave on the same cycles (e.g. RX in, TX out)
+    template <typename Setter, typename Getter>
+    LineWave drive_capture(Setter set, const LineWave& drive, Getter get) {
+        LineWave wave;
+        wave.reserve(drive.size());
+        for (size_t i = 0; i < drive.size(); i++) {
+            set(drive.get(i));
+            tick();
+            wave.push_back(get());
+        }
+        return wave;
+    }
+
+    // Named condition for UART_TRACE_TRIGGER, checked after each rising
+    // edge while tracing; ignored when the name is not selected
+    template <typename Pred>
+    void trace_trigger(const char* name, Pred pred) {
+#ifdef DUT_DRIVER_TRACE
+        if (trace) trace->add_trigger(name, pred);
+#else
+        (void)name;
+        (void)pred;
+#endif
+    }
+
+    // Reset/configuration through a cached image: the first call for a key
+    // runs setup() and saves the model, later calls (any instance in the
+    // process) restore it. Host-side state set by setup() must be set
+    // again by the caller.
+    template <typename Setup>
+    void warm_start(const std::string& key, Setup setup) {
+#ifdef DUT_DRIVER_SAVABLE
+#ifdef DUT_DRIVER_COVERAGE
+        if (CoverageCollector::instance().enabled()) {
+            setup();
+            return;
+        }
+#endif
+        CheckpointCache& cache = CheckpointCache::instance();
+        std::string image = cache.find(key);
+        if (!image.empty() && restore_checkpoint(image)) return;
+        setup();
+        image = cache.reserve(key);
+        if (!image.empty() && save_checkpoint(image)) cache.publish(key, image);
+#else
+        (void)key;
+        setup();
+#endif
+    }
+
+#ifdef DUT_DRIVER_SAVABLE
+    // Model, cycle counters and an opaque host blob to path (written as
+    // <path>.tmp and renamed). Returns false if the file cannot be written.
+    bool save_checkpoint(const std::string& path, const std::string& host = std::string()) {
+        std::string tmp = path + ".tmp";
+        CheckpointHeader header = CheckpointHeader::make<Model>();
+        header.cycle_count = cycle_count;
+        header.skipped_cycles = skipped_cycles;
+        header.host_size = host.size();
+        {
+            VerilatedSave os;
+            os.open(tmp.c_str());
+            if (!os.isOpen()) return false;
+            os.write(&header, sizeof(header));
+            os.write(host.data(), host.size());
+            os << *dut;
+            os.close();
+        }
+        return std::rename(tmp.c_str(), path.c_str()) == 0;
+    }
+
+    // Replaces the model state with an image from save_checkpoint. Returns
+    // false, with the model untouched, if the file is missing or was
+    // written for another model.
+    bool restore_checkpoint(const std::string& path, std::string* host = nullptr) {
+        VerilatedRestore os;
+        os.open(path.c_str());
+        if (!os.isOpen()) return false;
+        CheckpointHeader header;
+        os.read(&header, sizeof(header));
+        if (!header.matches(CheckpointHeader::make<Model>())) {
+            std::fprintf(stderr, "checkpoint: %s is not an image of this model\n", path.c_str());
+            os.close();
+            return false;
+        }
+        std::string blob(header.host_size, '\0');
+        if (!blob.empty()) os.read(&blob[0], blob.size());
+        os >> *dut;
+        os.close();
+        if (host) host->swap(blob);
+#ifdef DUT_DRIVER_TRACE
+        trace_epoch += cycle_count;   // Keep file time monotonic, as for pulse_reset
+#endif
+        cycle_count = header.cycle_count;
+        skipped_cycles = header.skipped_cycles;
+        return true;
+    }
+#endif
+
+private:
+#ifdef DUT_DRIVER_TRACE
+    std::unique_ptr<ModelTrace<Model>> trace;
+    uint64_t trace_epoch = 0;   // Cycles before the last pulse_reset
+
+    // File time stays monotonic across resets; the window uses cycle_count
+    inline void trace_sample(uint64_t cycle, unsigned edge) {
+        if (trace) trace->sample(2 * (trace_epoch + cycle) + edge, cycle);
+    }
+#else
+    inline void trace_sample(uint64_t, unsigned) {}
+#endif
+};
+
+// Skipped cycles of a model with a uart_regs at SCOPE, its flattened
+// Verilator name (e.g. uart_top__DOT__uart_regs_inst; include the model's
+// ___024root.h first). While quiescent, TX_STALLS is the one counter that
+// moves: with TX_EN set it counts every cycle, saturating. Once per model,
+// next to DUT_DRIVER_PORTS, in every file that fast-forwards it.
+#define DUT_DRIVER_UART_REGS(MODEL, SCOPE)                                         \
+    template <>                                                                    \
+    struct DutSkip<MODEL> {                                                        \
+        static void advance(MODEL& m, uint64_t cycles) {                           \
+            if (!(m.rootp->SCOPE##__DOT__ctrl_reg & uart_reg::CTRL_TX_EN)) return; \
+            EData& stalls =                                                        \
+                m.rootp->SCOPE##__DOT__perf_count[uart_reg::PERF_TX_STALLS];       \
+            uint64_t sum = (uint64_t)stalls + cycles;                              \
+            stalls = (sum > 0xFFFFFFFFu) ? 0xFFFFFFFFu : (EData)sum;               \
+        }                                                                          \
+    }
+
+// Idle probe for fast_forward over a uart_regs register file; read(word)
+// returns a register (it may tick). Idle when the TX FIFO is empty, both
+// FSMs are in IDLE and the RX idle timer is stopped: it counts baud ticks
+// while RX_TIMEOUT is set and bytes are readable (FIFO or RX_DATA holding
+// buffer, the ISR_SNAPSHOT count), up to the timeout. rx_timer_expired:
+// the caller knows the timeout has run out since the last RX byte or
+// read. Only baud_gen then moves, with period = divisor (BAUD_FRAC 0),
+// and TX_STALLS (DUT_DRIVER_UART_REGS). Serial lines and bus are the
+// caller's to check.
+template <typename Read>
+bool uart_regs_quiescent(Read read, bool rx_timer_expired = false) {
+    uint32_t status = read(uart_reg::STATUS);
+    if (!(status & uart_reg::STATUS_TX_EMPTY) ||
+        (status & (uart_reg::STATUS_TX_ACTIVE | uart_reg::STATUS_RX_ACTIVE))) {
+        return false;
+    }
+    if (rx_timer_expired) return true;
+    uint32_t ctrl = read(uart_reg::CTRL);
+    if (!(ctrl & uart_reg::CTRL_RX_EN) || !read(uart_reg::RX_TIMEOUT)) return true;
+    // Under INT_RTC an ISR_SNAPSHOT read clears interrupts: not probed
+    if (ctrl & uart_reg::CTRL_INT_RTC) return false;
+    return !((read(uart_reg::ISR_SNAPSHOT) >> 16) & 0xFF);
+}
+
+// 8N1 frame bits (start, 8 data bits LSB first, stop)
+inline std::vector<uint8_t> uart_frame_bits(uint8_t data) {
+    std::vector<uint8_t> bits;
+    bits.reserve(10);
+    bits.push_back(0);
+    for (int bit = 0; bit < 8; bit++) {
+        bits.push_back((data >> bit) & 1);
+    }
+    bits.push_back(1);
+    return bits;
+}
+
+// Pack LSB-first sampled bits into a byte
+inline uint8_t bits_to_byte(const std::vector<uint8_t>& bits) {
+    uint8_t data = 0;
+    for (size_t i = 0; i < bits.size() && i < 8; i++) {
+        if (bits[i]) data |= (1 << i);
+    }
+    return data;
+}
+
+#endif // DUT_DRIVER_H
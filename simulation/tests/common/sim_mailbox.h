@@ -0,0 +1,389 @@
+/*
+ * Sim Mailbox - Shared-Memory Register Access to a Running Simulation
+ *
+ * Lets a host process drive the AXI-Lite side of a Verilated model that
+ * runs in another process (uart_sim_bridge). Register accesses go through
+ * a POSIX shared-memory segment holding two single-producer rings:
+ * requests (host -> simulator) and responses (simulator -> host), one
+ * response per request, in order. The host posts any number of accesses
+ * and publishes them together, so a batch costs one wake-up each way
+ * however long it is.
+ *
+ * Features:
+ * - MailboxServer (simulator side): creates the segment and its doorbell
+ *   FIFO; serve() runs every pending request through a callback and
+ *   publishes the responses with a single futex wake
+ * - MailboxClient (host side): post_read / post_write queue requests,
+ *   flush() publishes them, next() blocks for the following response;
+ *   read() / write() are one-access shorthands
+ * - Doorbell: the simulator sleeps in poll() on a named FIFO alongside
+ *   its serial endpoint; flush() writes to it only after the simulator has
+ *   announced it is going to sleep (prepare_sleep), so a busy simulator
+ *   sees no syscalls from the host
+ * - irq level and simulated cycle published in the segment; wait_irq()
+ *   blocks until the level changes
+ *
+ * Usage:
+ *   // Simulator
+ *   MailboxServer mbox;
+ *   mbox.create("/uart_sim");
+ *   mbox.serve([&](const MailboxRequest& r) { return axi_access(r); });
+ *
+ *   // Host
+ *   MailboxClient host;
+ *   host.open("/uart_sim");
+ *   host.write(0x10, 1);                        // BAUD_DIV
+ *   host.post_read(0x04);                       // STATUS
+ *   host.post_read(0x18);                       // INT_STATUS
+ *   host.flush();
+ *   MailboxResponse status, ints;
+ *   host.next(status);
+ *   host.next(ints);
+ *
+ * IMPORTANT:
+ * - Linux only (shm_open, futex). The ring indices are lock-free
+ *   std::atomic words, which are address-free, so each process may map
+ *   the segment anywhere
+ * - One host (one producer) per segment; at most MAILBOX_SLOTS requests
+ *   may be outstanding, post_*() returns false beyond that
+ * - Addresses are AXI byte addresses (register offset << 2)
+ * - The segment and FIFO are removed when the server closes; a server
+ *   killed with SIGKILL leaves them behind, and the next create() with the
+ *   same name replaces them
+ */
+
+#ifndef SIM_MAILBOX_H
+#define SIM_MAILBOX_H
+
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <new>
+#include <string>
+
+constexpr uint32_t MAILBOX_MAGIC   = 0x55415254;   // "UART"
+constexpr uint32_t MAILBOX_VERSION = 1;
+constexpr uint32_t MAILBOX_SLOTS   = 256;          // Ring size, power of two
+
+enum MailboxOp : uint32_t { MAILBOX_READ = 0, MAILBOX_WRITE = 1 };
+
+struct MailboxRequest {
+    uint32_t op;      // MailboxOp
+    uint32_t addr;    // AXI byte address
+    uint32_t data;    // Write data
+    uint32_t wstrb;   // Write byte lanes
+};
+
+struct MailboxResponse {
+    uint32_t data;    // Read data (0 for writes)
+    uint32_t resp;    // AXI RRESP/BRESP
+    uint64_t cycle;   // Simulated cycle the access completed on
+};
+
+// Segment layout. Indices are free-running; slot = index % MAILBOX_SLOTS.
+struct MailboxShared {
+    uint32_t magic;
+    uint32_t version;
+    std::atomic<uint32_t> live;       // Cleared when the server closes
+    std::atomic<uint32_t> sleeping;   // Simulator parked in poll()
+    alignas(64) std::atomic<uint32_t> req_head;   // Host: requests published
+    alignas(64) std::atomic<uint32_t> req_tail;   // Simulator: requests consumed
+    alignas(64) std::atomic<uint32_t> rsp_head;   // Simulator: responses published (futex)
+    alignas(64) std::atomic<uint32_t> rsp_tail;   // Host: responses consumed
+    alignas(64) std::atomic<uint32_t> irq;        // irq level (futex)
+    std::atomic<uint64_t> cycle;                  // Simulated cycles so far
+    MailboxRequest req[MAILBOX_SLOTS];
+    MailboxResponse rsp[MAILBOX_SLOTS];
+};
+
+static_assert((MAILBOX_SLOTS & (MAILBOX_SLOTS - 1)) == 0, "MAILBOX_SLOTS must be a power of two");
+static_assert(std::atomic<uint32_t>::is_always_lock_free, "mailbox needs lock-free 32-bit atomics");
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "mailbox needs lock-free 64-bit atomics");
+
+// Doorbell FIFO next to the segment: "/uart_sim" -> "/tmp/uart_sim.bell"
+inline std::string mailbox_doorbell_path(const std::string& name) {
+    return "/tmp/" + name.substr(name.find_first_not_of('/')) + ".bell";
+}
+
+// Shared (not FUTEX_PRIVATE) futex ops: the word lives in both processes
+inline void mailbox_futex_wait(std::atomic<uint32_t>& word, uint32_t expected, int timeout_ms) {
+    struct timespec ts;
+    ts.tv_sec = timeout_ms / 1000;
+    ts.tv_nsec = (long)(timeout_ms % 1000) * 1000000;
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT, expected,
+            timeout_ms < 0 ? nullptr : &ts, nullptr, 0);
+}
+
+inline void mailbox_futex_wake(std::atomic<uint32_t>& word) {
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+}
+
+class MailboxServer {
+public:
+    MailboxServer() = default;
+    ~MailboxServer() { close(); }
+
+    MailboxServer(const MailboxServer&) = delete;
+    MailboxServer& operator=(const MailboxServer&) = delete;
+
+    // Creates (or replaces) the segment and the doorbell FIFO. Returns
+    // false, with errno set, if either cannot be made.
+    bool create(const std::string& name) {
+        close();
+        name_ = name;
+        bell_path_ = mailbox_doorbell_path(name);
+
+        shm_unlink(name.c_str());
+        int fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+        if (fd < 0) return false;
+        void* p = MAP_FAILED;
+        if (ftruncate(fd, sizeof(MailboxShared)) == 0) {
+            p = mmap(nullptr, sizeof(MailboxShared), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        }
+        ::close(fd);
+        if (p == MAP_FAILED) {
+            shm_unlink(name.c_str());
+            return false;
+        }
+        shm_ = new (p) MailboxShared;   // Zero-filled by ftruncate
+        shm_->magic = MAILBOX_MAGIC;
+        shm_->version = MAILBOX_VERSION;
+
+        // Our own writer keeps the FIFO from reporting POLLHUP between hosts
+        unlink(bell_path_.c_str());
+        if (mkfifo(bell_path_.c_str(), 0600) != 0 ||
+            (bell_rd_ = ::open(bell_path_.c_str(), O_RDONLY | O_NONBLOCK)) < 0 ||
+            (bell_wr_ = ::open(bell_path_.c_str(), O_WRONLY | O_NONBLOCK)) < 0) {
+            int err = errno;
+            close();
+            errno = err;
+            return false;
+        }
+        shm_->live.store(1, std::memory_order_release);
+        return true;
+    }
+
+    // Unmaps and removes the segment and FIFO; blocked hosts see it closed
+    void close() {
+        if (shm_) {
+            shm_->live.store(0, std::memory_order_release);
+            mailbox_futex_wake(shm_->rsp_head);
+            mailbox_futex_wake(shm_->irq);
+            munmap(shm_, sizeof(MailboxShared));
+            shm_unlink(name_.c_str());
+            shm_ = nullptr;
+        }
+        if (bell_rd_ >= 0) ::close(bell_rd_);
+        if (bell_wr_ >= 0) ::close(bell_wr_);
+        if (!bell_path_.empty()) unlink(bell_path_.c_str());
+        bell_rd_ = bell_wr_ = -1;
+        bell_path_.clear();
+    }
+
+    // Readable when a host rang while the simulator was asleep
+    int doorbell_fd() const { return bell_rd_; }
+
+    const std::string& name() const { return name_; }
+
+    uint32_t pending() const {
+        return shm_->req_head.load(std::memory_order_seq_cst) -
+               shm_->req_tail.load(std::memory_order_relaxed);
+    }
+
+    // Runs exec(request) -> MailboxResponse for every published request in
+    // order, then publishes all responses at once. Returns the count.
+    template <typename Exec>
+    uint32_t serve(Exec exec) {
+        uint32_t head = shm_->req_head.load(std::memory_order_acquire);
+        uint32_t tail = shm_->req_tail.load(std::memory_order_relaxed);
+        uint32_t out = shm_->rsp_head.load(std::memory_order_relaxed);
+        uint32_t n = head - tail;
+        if (n == 0) return 0;
+        for (; tail != head; tail++, out++) {
+            MailboxRequest req = shm_->req[tail % MAILBOX_SLOTS];
+            shm_->rsp[out % MAILBOX_SLOTS] = exec(req);
+        }
+        shm_->req_tail.store(tail, std::memory_order_release);
+        shm_->rsp_head.store(out, std::memory_order_release);
+        mailbox_futex_wake(shm_->rsp_head);
+        return n;
+    }
+
+    // Announce that the simulator will block on doorbell_fd(). Returns
+    // false (and stays awake) if a request was published meanwhile.
+    bool prepare_sleep() {
+        shm_->sleeping.store(1, std::memory_order_seq_cst);
+        if (pending() == 0) return true;
+        shm_->sleeping.store(0, std::memory_order_relaxed);
+        return false;
+    }
+
+    // Back from poll(): drop doorbell bytes, hosts stop ringing
+    void wake() {
+        shm_->sleeping.store(0, std::memory_order_relaxed);
+        char buf[64];
+        while (::read(bell_rd_, buf, sizeof(buf)) > 0) {}
+    }
+
+    // Publish simulator state; hosts in wait_irq() wake on a level change
+    void publish(bool irq, uint64_t cycle) {
+        shm_->cycle.store(cycle, std::memory_order_relaxed);
+        if (shm_->irq.load(std::memory_order_relaxed) != (uint32_t)irq) {
+            shm_->irq.store(irq, std::memory_order_release);
+            mailbox_futex_wake(shm_->irq);
+        }
+    }
+
+private:
+    MailboxShared* shm_ = nullptr;
+    std::string name_;
+    std::string bell_path_;
+    int bell_rd_ = -1;
+    int bell_wr_ = -1;
+};
+
+class MailboxClient {
+public:
+    MailboxClient() = default;
+    ~MailboxClient() { close(); }
+
+    MailboxClient(const MailboxClient&) = delete;
+    MailboxClient& operator=(const MailboxClient&) = delete;
+
+    // Maps a segment made by MailboxServer::create. Returns false if it
+    // does not exist, is not a mailbox of this version or is closed.
+    bool open(const std::string& name) {
+        close();
+        int fd = shm_open(name.c_str(), O_RDWR, 0);
+        if (fd < 0) return false;
+        struct stat st;
+        void* p = MAP_FAILED;
+        if (fstat(fd, &st) == 0 && (size_t)st.st_size == sizeof(MailboxShared)) {
+            p = mmap(nullptr, sizeof(MailboxShared), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        }
+        ::close(fd);
+        if (p == MAP_FAILED) return false;
+        shm_ = static_cast<MailboxShared*>(p);
+        if (shm_->magic != MAILBOX_MAGIC || shm_->version != MAILBOX_VERSION || !connected()) {
+            close();
+            return false;
+        }
+        bell_ = ::open(mailbox_doorbell_path(name).c_str(), O_WRONLY | O_NONBLOCK);
+        head_ = shm_->req_head.load(std::memory_order_relaxed);
+        return true;
+    }
+
+    void close() {
+        if (shm_) munmap(shm_, sizeof(MailboxShared));
+        if (bell_ >= 0) ::close(bell_);
+        shm_ = nullptr;
+        bell_ = -1;
+    }
+
+    bool connected() const { return shm_ && shm_->live.load(std::memory_order_acquire); }
+
+    // Posted but unanswered requests (published or not)
+    uint32_t outstanding() const { return head_ - shm_->rsp_tail.load(std::memory_order_relaxed); }
+
+    bool post_read(uint32_t addr) { return post({MAILBOX_READ, addr, 0, 0}); }
+
+    bool post_write(uint32_t addr, uint32_t data, uint32_t wstrb = 0xF) {
+        return post({MAILBOX_WRITE, addr, data, wstrb});
+    }
+
+    // Publish posted requests; rings the doorbell if the simulator sleeps
+    void flush() {
+        if (shm_->req_head.load(std::memory_order_relaxed) == head_) return;
+        shm_->req_head.store(head_, std::memory_order_seq_cst);
+        if (shm_->sleeping.load(std::memory_order_seq_cst) && bell_ >= 0) {
+            char one = 1;
+            ssize_t n = ::write(bell_, &one, 1);   // EAGAIN: a wake-up is already pending
+            (void)n;
+        }
+    }
+
+    // Next response in request order (flushes first). timeout_ms < 0
+    // waits forever; false on timeout, server closed or nothing posted.
+    bool next(MailboxResponse& rsp, int timeout_ms = -1) {
+        flush();
+        uint32_t tail = shm_->rsp_tail.load(std::memory_order_relaxed);
+        if (tail == head_) return false;
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+        for (;;) {
+            uint32_t avail = shm_->rsp_head.load(std::memory_order_acquire);
+            if (avail != tail) break;
+            if (!connected()) return false;
+            int wait_ms = 100;   // Re-check open regularly
+            if (timeout_ms >= 0) {
+                auto left = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    deadline - std::chrono::steady_clock::now()).count();
+                if (left <= 0) return false;
+                if (left < wait_ms) wait_ms = (int)left;
+            }
+            mailbox_futex_wait(shm_->rsp_head, avail, wait_ms);
+        }
+        rsp = shm_->rsp[tail % MAILBOX_SLOTS];
+        shm_->rsp_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Single blocking accesses, only with nothing else outstanding; false
+    // on an error response or no answer
+    bool read(uint32_t addr, uint32_t& data, int timeout_ms = -1) {
+        MailboxResponse rsp;
+        if (outstanding() || !post_read(addr) || !next(rsp, timeout_ms)) return false;
+        data = rsp.data;
+        return rsp.resp == 0;
+    }
+
+    bool write(uint32_t addr, uint32_t data, uint32_t wstrb = 0xF, int timeout_ms = -1) {
+        MailboxResponse rsp;
+        return !outstanding() && post_write(addr, data, wstrb) && next(rsp, timeout_ms) &&
+               rsp.resp == 0;
+    }
+
+    bool irq() const { return shm_->irq.load(std::memory_order_acquire) != 0; }
+
+    // Wait until irq() == level; false on timeout or server closed
+    bool wait_irq(bool level, int timeout_ms = -1) {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+        for (;;) {
+            uint32_t now = shm_->irq.load(std::memory_order_acquire);
+            if ((now != 0) == level) return true;
+            if (!connected()) return false;
+            int wait_ms = 100;
+            if (timeout_ms >= 0) {
+                auto left = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    deadline - std::chrono::steady_clock::now()).count();
+                if (left <= 0) return false;
+                if (left < wait_ms) wait_ms = (int)left;
+            }
+            mailbox_futex_wait(shm_->irq, now, wait_ms);
+        }
+    }
+
+    uint64_t cycle() const { return shm_->cycle.load(std::memory_order_relaxed); }
+
+private:
+    bool post(const MailboxRequest& req) {
+        if (!shm_ || outstanding() >= MAILBOX_SLOTS) return false;
+        shm_->req[head_ % MAILBOX_SLOTS] = req;
+        head_++;
+        return true;
+    }
+
+    MailboxShared* shm_ = nullptr;
+    int bell_ = -1;
+    uint32_t head_ = 0;   // Next request slot (published up to req_head)
+};
+
+#endif // SIM_MAILBOX_H
@@ -0,0 +1,286 @@
+/*
+ * Trace Control - On-Demand Windowed Waveform Tracing
+ *
+ * FST waveform dumps for selected test cases only. Tracing is off unless
+ * requested, and then limited to a cycle window, to the cycles after a
+ * trigger, or to a ring of the last N cycles kept only if the test fails.
+ *
+ * Features:
+ * - Per-test enable: UART_TRACE=<name>[,<name>...] (substring of the
+ *   Boost.Test case name, or "all")
+ * - Cycle window: UART_TRACE_WINDOW=<start>:<stop> (either side may be
+ *   empty); dumping stops for good at <stop>
+ * - Triggers: UART_TRACE_TRIGGER=<name>[,...] holds the dump until one of
+ *   the named conditions a fixture registered (see
+ *   DutDriver::trace_trigger: frame_error, overrun, irq, ...) first holds
+ * - Ring buffer: UART_TRACE_RING=<N> dumps into rolling N-cycle segments,
+ *   keeping the last two; they are deleted when the test passes (and no
+ *   trigger fired), so a failure leaves the N..2N cycles before it
+ * - Output: UART_TRACE_DIR (default "traces"), one file per model
+ *   instance: <test>.<k>.fst, or <test>.<k>.seg<j>.fst in ring mode
+ * - The same options are accepted on the module_tests command line after
+ *   "--": --trace=, --trace-window=, --trace-trigger=, --trace-ring=,
+ *   --trace-dir= (command line overrides the environment)
+ *
+ * Usage:
+ *   UART_TRACE=uart_top_loopback UART_TRACE_WINDOW=1000:5000 ./module_tests
+ *   UART_TRACE=all UART_TRACE_RING=20000 ctest -R UartRX
+ *   ./module_tests -t UartRX_ModuleTests -- --trace=all --trace-trigger=frame_error
+ *
+ * IMPORTANT:
+ * - Only compiled into DutDriver when DUT_DRIVER_TRACE is defined
+ *   (module_tests); other executables carry no trace code
+ * - Models must be Verilated with TRACE_FST; the fast integration flavor
+ *   (UART_SIM_FAST) is not traceable
+ * - The window is in DutDriver cycle_count (restarts at pulse_reset);
+ *   file times are half cycles counted across resets (falling edge 2n,
+ *   rising edge 2n+1), and fast_forward spans show up as time gaps
+ * - Pass/fail comes from the Boost.Test observer in test_main.cpp: an
+ *   assertion that failed before the fixture is destroyed keeps the ring
+ */
+
+#ifndef TRACE_CONTROL_H
+#define TRACE_CONTROL_H
+
+#include <verilated.h>
+#include <verilated_fst_c.h>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+struct TraceConfig {
+    std::vector<std::string> tests;     // Empty: tracing off
+    std::string dir = "traces";
+    uint64_t start = 0;
+    uint64_t stop = UINT64_MAX;
+    std::vector<std::string> triggers;  // Empty: no trigger gating
+    uint64_t ring = 0;                  // 0: no ring buffer
+
+    bool enabled() const { return !tests.empty(); }
+
+    bool matches(const std::string& test) const {
+        for (const std::string& t : tests) {
+            if (t == "all" || test.find(t) != std::string::npos) return true;
+        }
+        return false;
+    }
+
+    // Apply one option by name ("trace", "trace-window", ...)
+    bool set(const std::string& key, const std::string& value) {
+        if (key == "trace") {
+            tests = split(value);
+        } else if (key == "trace-dir") {
+            dir = value;
+        } else if (key == "trace-window") {
+            size_t colon = value.find(':');
+            if (colon == std::string::npos) return false;
+            std::string lo = value.substr(0, colon), hi = value.substr(colon + 1);
+            start = lo.empty() ? 0 : std::strtoull(lo.c_str(), nullptr, 0);
+            stop = hi.empty() ? UINT64_MAX : std::strtoull(hi.c_str(), nullptr, 0);
+        } else if (key == "trace-trigger") {
+            triggers = split(value);
+        } else if (key == "trace-ring") {
+            ring = std::strtoull(value.c_str(), nullptr, 0);
+        } else {
+            return false;
+        }
+        return true;
+    }
+
+    void from_env() {
+        static const char* const keys[][2] = {
+            {"UART_TRACE", "trace"},
+            {"UART_TRACE_DIR", "trace-dir"},
+            {"UART_TRACE_WINDOW", "trace-window"},
+            {"UART_TRACE_TRIGGER", "trace-trigger"},
+            {"UART_TRACE_RING", "trace-ring"},
+        };
+        for (const auto& k : keys) {
+            const char* value = std::getenv(k[0]);
+            if (value && *value) set(k[1], value);
+        }
+    }
+
+    // "--trace-window=100:200" style arguments; returns false if unknown
+    bool parse_arg(const std::string& arg) {
+        if (arg.compare(0, 2, "--") != 0) return false;
+        size_t eq = arg.find('=');
+        if (eq == std::string::npos) return false;
+        return set(arg.substr(2, eq - 2), arg.substr(eq + 1));
+    }
+
+    static std::vector<std::string> split(const std::string& list) {
+        std::vector<std::string> out;
+        size_t pos = 0;
+        while (pos <= list.size()) {
+            size_t comma = list.find(',', pos);
+            if (comma == std::string::npos) comma = list.size();
+            if (comma > pos) out.push_back(list.substr(pos, comma - pos));
+            pos = comma + 1;
+        }
+        return out;
+    }
+};
+
+// Process-wide state: configuration and the running test case
+class TraceSession {
+public:
+    static TraceSession& instance() {
+        static TraceSession session;
+        return session;
+    }
+
+    TraceConfig config;
+
+    void begin_test(const std::string& name) {
+        test_ = name;
+        active_ = config.matches(name);
+        failed_ = false;
+        instances_ = 0;
+    }
+
+    void end_test() { active_ = false; }
+    void fail() { failed_ = true; }
+
+    bool active() const { return active_; }
+    bool failed() const { return failed_; }
+
+    // Output path stem for the next traced model of this test
+    std::string next_stem() {
+        std::string name = test_;
+        for (char& c : name) {
+            if (c == '/' || c == ' ' || c == ':') c = '_';
+        }
+        return config.dir + "/" + name + "." + std::to_string(instances_++);
+    }
+
+private:
+    std::string test_;
+    bool active_ = false;
+    bool failed_ = false;
+    unsigned instances_ = 0;
+};
+
+// Models Verilated with TRACE_FST have trace(VerilatedFstC*, int)
+template <typename Model, typename = void>
+struct HasFstTrace : std::false_type {};
+
+template <typename Model>
+struct HasFstTrace<Model, decltype(std::declval<Model&>().trace(
+                               static_cast<VerilatedFstC*>(nullptr), 0), void())>
+    : std::true_type {};
+
+// One model's FST writer: window, trigger and ring handling
+template <typename Model>
+class ModelTrace {
+public:
+    ModelTrace(Model* dut, const TraceConfig& config, const std::string& stem)
+        : dut_(dut), config_(config), stem_(stem),
+          armed_(!config.triggers.empty()), triggered_(false), done_(false),
+          attached_(false), segment_(0), segment_start_(0) {}
+
+    ~ModelTrace() {
+        if (fst_.isOpen()) fst_.close();
+        bool keep = !config_.ring || triggered_ || TraceSession::instance().failed();
+        for (const std::string& path : files_) {
+            if (keep) {
+                std::fprintf(stderr, "trace: %s\n", path.c_str());
+            } else {
+                std::remove(path.c_str());
+            }
+        }
+    }
+
+    ModelTrace(const ModelTrace&) = delete;
+    ModelTrace& operator=(const ModelTrace&) = delete;
+
+    // Registered only if named in the trigger list
+    void add_trigger(const std::string& name, std::function<bool()> pred) {
+        for (const std::string& t : config_.triggers) {
+            if (t == name) triggers_.emplace_back(name, std::move(pred));
+        }
+    }
+
+    // Called after every DutDriver eval (time in half cycles)
+    void sample(uint64_t time, uint64_t cycle) {
+        if (done_ || cycle < config_.start) return;
+        if (cycle >= config_.stop) {
+            if (fst_.isOpen()) fst_.close();
+            done_ = true;
+            return;
+        }
+
+        if (armed_ && (time & 1)) {
+            for (const auto& t : triggers_) {
+                if (t.second()) {
+                    std::fprintf(stderr, "trace: %s fired at cycle %llu\n",
+                                 t.first.c_str(), (unsigned long long)cycle);
+                    armed_ = false;
+                    triggered_ = true;
+                    break;
+                }
+            }
+        }
+        if (armed_ && !config_.ring) return;  // Nothing before the trigger
+
+        if (!fst_.isOpen()) {
+            if (!open(time >> 1)) return;
+        } else if (config_.ring && !triggered_ && (time >> 1) - segment_start_ >= config_.ring) {
+            // Roll: keep this segment and the next, drop the older one
+            fst_.close();
+            if (files_.size() >= 2) {
+                std::remove(files_.front().c_str());
+                files_.erase(files_.begin());
+            }
+            if (!open(time >> 1)) return;
+        }
+        fst_.dump(time);
+    }
+
+private:
+    bool open(uint64_t now) {
+        if (!attached_ && !attach(HasFstTrace<Model>())) {
+            done_ = true;
+            return false;
+        }
+        std::string path = config_.ring
+            ? stem_ + ".seg" + std::to_string(segment_++) + ".fst"
+            : stem_ + ".fst";
+        fst_.open(path.c_str());
+        files_.push_back(path);
+        segment_start_ = now;
+        return true;
+    }
+
+    bool attach(std::true_type) {
+        dut_->trace(&fst_, 99);
+        attached_ = true;
+        return true;
+    }
+
+    bool attach(std::false_type) {
+        std::fprintf(stderr, "trace: model built without TRACE_FST, %s not traced\n",
+                     stem_.c_str());
+        return false;
+    }
+
+    Model* dut_;
+    const TraceConfig& config_;
+    std::string stem_;
+    VerilatedFstC fst_;
+    std::vector<std::pair<std::string, std::function<bool()>>> triggers_;
+    std::vector<std::string> files_;
+    bool armed_;          // Waiting for a trigger
+    bool triggered_;
+    bool done_;           // Window over, or not traceable
+    bool attached_;
+    unsigned segment_;
+    uint64_t segment_start_;  // In file time / 2
+};
+
+#endif // TRACE_CONTROL_H
@@ -0,0 +1,204 @@
+/*
+ * UART Line - Packed Serial Waveforms for the Testbench
+ *
+ * Line levels stored one bit per uart_clk cycle in 64-bit words. Frames
+ * for a whole byte buffer are encoded up front with word-wide run fills,
+ * and captured TX waveforms are decoded in bulk by locating start edges
+ * a word at a time, so long streams spend their time in eval() rather
+ * than in per-cycle harness branches.
+ *
+ * Features:
+ * - UartLineConfig: oversample (16/8/4), baud divisor and fraction
+ *   (BAUD_FRAC, 1/64), idle bits after each frame
+ * - LineWave: packed bit array with run append (levels or a slice of
+ *   another wave), level and falling-edge search
+ *   (ctz over ~w & (w << 1 | carry))
+ * - uart_line_append_frame / uart_line_encode: 8N1 frames, optionally
+ *   with a bad (low) stop bit
+ * - uart_line_decode_frames / uart_line_decode: bytes sampled at bit
+ *   centres from each start edge, with the stop-bit check
+ * - DutDriver::drive_wave / capture_wave / drive_capture (dut_driver.h)
+ *
+ * Usage:
+ *   UartLineConfig line{16, 1, 0};
+ *   LineWave rx = uart_line_encode(bytes, line);
+ *   LineWave tx = drive_capture([this](bool b) { dut->uart_rx = b; }, rx,
+ *                               [this] { return dut->uart_tx != 0; });
+ *   std::vector<uint8_t> sent = uart_line_decode(tx, line);
+ *
+ * IMPORTANT:
+ * - With baud_frac set, bit boundaries and sample points are placed in
+ *   1/64 cycle steps from each start edge and rounded down, so no error
+ *   builds up over a frame; the RTL's fractional tick jitter (one cycle)
+ *   is not modelled
+ * - The capture is treated as following an idle-high line, so a start
+ *   edge on cycle 0 is found
+ * - A start bit that is high at its centre is skipped as a glitch, like
+ *   uart_rx; a frame cut off by the end of the capture is not reported
+ */
+
+#ifndef UART_LINE_H
+#define UART_LINE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct UartLineConfig {
+    unsigned oversample = 16;   // Baud ticks per bit (CTRL.OSR)
+    unsigned baud_div = 1;      // Clocks per baud tick (BAUD_DIV)
+    unsigned idle_bits = 0;     // Extra stop-level bit times after each frame
+    unsigned baud_frac = 0;     // BAUD_FRAC, 1/64 of a baud tick
+
+    // Whole clocks per bit (the fraction is dropped)
+    unsigned bit_cycles() const { return oversample * (baud_div ? baud_div : 1); }
+
+    // Clocks per bit in 1/64 cycle units: OSR x (BAUD_DIV + BAUD_FRAC/64)
+    uint64_t bit_cycles64() const {
+        return (uint64_t)oversample * (((uint64_t)(baud_div ? baud_div : 1) << 6) + baud_frac);
+    }
+
+    // Cycle of bit boundary k (k = 0: start edge) within a frame
+    size_t bit_edge(unsigned k) const { return (size_t)((k * bit_cycles64()) >> 6); }
+
+    // Cycle of the centre of bit k (0 = start, 1..8 = data, 9 = stop)
+    size_t bit_centre(unsigned k) const {
+        uint64_t bit64 = bit_cycles64();
+        return (size_t)((k * bit64 + bit64 / 2) >> 6);
+    }
+};
+
+class LineWave {
+public:
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    void clear() { words_.clear(); size_ = 0; }
+    void reserve(size_t cycles) { words_.reserve((cycles + 63) / 64); }
+
+    bool get(size_t i) const { return (words_[i >> 6] >> (i & 63)) & 1; }
+
+    void push_back(bool level) {
+        if ((size_ & 63) == 0) words_.push_back(0);
+        uint64_t bit = 1ull << (size_ & 63);
+        words_.back() = level ? (words_.back() | bit) : (words_.back() & ~bit);
+        size_++;
+    }
+
+    // Append `cycles` copies of level: masked partial word, then whole words
+    void append(bool level, size_t cycles) {
+        if (!cycles) return;
+        size_t offset = size_ & 63;
+        if (offset) {
+            size_t n = cycles < 64 - offset ? cycles : 64 - offset;
+            uint64_t mask = (n == 64 ? ~0ull : ((1ull << n) - 1)) << offset;
+            words_.back() = level ? (words_.back() | mask) : (words_.back() & ~mask);
+            size_ += n;
+            cycles -= n;
+        }
+        // Bits past size_ in the last word are don't-care
+        words_.resize((size_ + cycles + 63) / 64, level ? ~0ull : 0);
+        size_ += cycles;
+    }
+
+    // Append src[from, src.size()), one run fill per level change
+    void append(const LineWave& src, size_t from = 0) {
+        while (from < src.size()) {
+            bool level = src.get(from);
+            size_t end = src.find_level(from, !level);
+            if (end == npos) end = src.size();
+            append(level, end - from);
+            from = end;
+        }
+    }
+
+    // First index >= from at the given level, or npos
+    size_t find_level(size_t from, bool level) const {
+        for (size_t w = from >> 6; w < words_.size(); w++) {
+            uint64_t hits = level ? words_[w] : ~words_[w];
+            if (w == (from >> 6)) hits &= ~0ull << (from & 63);
+            if (hits) return clip(w * 64 + ctz(hits));
+        }
+        return npos;
+    }
+
+    // First index >= from that is low after a high cycle, or npos
+    size_t find_fall(size_t from) const {
+        for (size_t w = from >> 6; w < words_.size(); w++) {
+            uint64_t carry = w ? words_[w - 1] >> 63 : 1;   // Idle before cycle 0
+            uint64_t edges = ~words_[w] & ((words_[w] << 1) | carry);
+            if (w == (from >> 6)) edges &= ~0ull << (from & 63);
+            if (edges) return clip(w * 64 + ctz(edges));
+        }
+        return npos;
+    }
+
+private:
+    size_t clip(size_t i) const { return i < size_ ? i : npos; }
+
+    static unsigned ctz(uint64_t x) { return __builtin_ctzll(x); }
+
+    std::vector<uint64_t> words_;
+    size_t size_ = 0;
+};
+
+struct UartLineFrame {
+    size_t start;       // Cycle of the start edge
+    uint8_t data;
+    bool frame_error;   // Stop bit low at its centre
+};
+
+// One 8N1 frame (start, 8 data bits LSB first, stop) plus cfg.idle_bits
+inline void uart_line_append_frame(LineWave& wave, uint8_t data, const UartLineConfig& cfg,
+                                   bool stop_bit = true) {
+    wave.append(0, cfg.bit_edge(1));
+    for (unsigned i = 0; i < 8;) {
+        // Equal neighbouring bits go out as one run
+        bool level = (data >> i) & 1;
+        unsigned run = 1;
+        while (i + run < 8 && (((data >> (i + run)) & 1) == level)) run++;
+        wave.append(level, cfg.bit_edge(i + 1 + run) - cfg.bit_edge(i + 1));
+        i += run;
+    }
+    wave.append(stop_bit, cfg.bit_edge(10) - cfg.bit_edge(9));
+    wave.append(1, cfg.bit_edge(10 + cfg.idle_bits) - cfg.bit_edge(10));
+}
+
+inline LineWave uart_line_encode(const std::vector<uint8_t>& bytes, const UartLineConfig& cfg) {
+    LineWave wave;
+    wave.reserve(bytes.size() * cfg.bit_edge(10 + cfg.idle_bits));
+    for (uint8_t b : bytes) uart_line_append_frame(wave, b, cfg);
+    return wave;
+}
+
+inline std::vector<UartLineFrame> uart_line_decode_frames(const LineWave& wave,
+                                                          const UartLineConfig& cfg) {
+    std::vector<UartLineFrame> frames;
+    size_t centre[10];
+    for (unsigned i = 0; i < 10; i++) centre[i] = cfg.bit_centre(i);
+    size_t pos = 0;
+    for (size_t start; (start = wave.find_fall(pos)) != LineWave::npos;) {
+        size_t stop_mid = start + centre[9];
+        if (stop_mid >= wave.size()) break;
+        if (wave.get(start + centre[0])) {
+            pos = start + centre[0];   // Glitch: line back high by mid start bit
+            continue;
+        }
+        uint8_t data = 0;
+        for (unsigned i = 0; i < 8; i++) {
+            data |= (uint8_t)(wave.get(start + centre[i + 1]) << i);
+        }
+        frames.push_back({start, data, !wave.get(stop_mid)});
+        pos = stop_mid;   // Next start edge may follow the stop bit centre
+    }
+    return frames;
+}
+
+inline std::vector<uint8_t> uart_line_decode(const LineWave& wave, const UartLineConfig& cfg) {
+    std::vector<uint8_t> bytes;
+    for (const UartLineFrame& f : uart_line_decode_frames(wave, cfg)) bytes.push_back(f.data);
+    return bytes;
+}
+
+#endif // UART_LINE_H
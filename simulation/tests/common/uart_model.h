@@ -0,0 +1,342 @@
+/*
+ * UART Model Interface
+ *
+ * Register- and byte-level view of a uart_top instance, shared by the
+ * Verilated RTL (UartRtlModel) and the transaction-level model (UartTlm)
+ * so that driver code and tests can run unchanged against either one.
+ *
+ * Features:
+ * - Register access on the uart_regs word-address map (CTRL ... PERF_DATA)
+ * - Byte-granularity serial side: send_byte() feeds uart_rx,
+ *   recv_byte() returns bytes seen on uart_tx
+ * - Common cycle base: a write costs 1 cycle, a read 2 cycles, on both
+ *   implementations (a packed TX_DATA write adds 1 cycle per byte lane)
+ * - Packed mode (CTRL.PACK_EN): write_reg() takes the AXI wstrb byte lanes
+ * - UartLockstep: drives two models with the same stimulus and checks the
+ *   model against the golden (RTL) one
+ *
+ * Usage:
+ *   UartRtlModel rtl;
+ *   UartTlm tlm;
+ *   UartLockstep ls(rtl, tlm);
+ *   ls.reset();
+ *   ls.write_reg(uart_reg::CTRL, 0x3);
+ *   ...
+ *   BOOST_CHECK(ls.in_sync());
+ *
+ * IMPORTANT:
+ * - Register addresses are word addresses (byte address >> 2), as seen on
+ *   uart_top's reg_addr port
+ * - Read data is the value captured on the access cycle, as
+ *   axi_lite_slave_if does (RX_DATA returns the byte being popped)
+ * - STATUS, INT_STATUS, ISR_SNAPSHOT, PERF_DATA and irq are timing-sensitive:
+ *   the TLM places frame edges to within a few baud ticks, so lockstep only
+ *   reports a difference on them once it outlives the grace window (default
+ *   2 bit times)
+ */
+
+#ifndef UART_MODEL_H
+#define UART_MODEL_H
+
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <map>
+#include <string>
+#include <vector>
+
+// uart_regs register map (word addresses) and STATUS bits
+namespace uart_reg {
+    constexpr uint8_t CTRL       = 0x0;
+    constexpr uint8_t STATUS     = 0x1;
+    constexpr uint8_t TX_DATA    = 0x2;
+    constexpr uint8_t RX_DATA    = 0x3;
+    constexpr uint8_t BAUD_DIV   = 0x4;
+    constexpr uint8_t INT_ENABLE = 0x5;
+    constexpr uint8_t INT_STATUS = 0x6;
+    constexpr uint8_t FIFO_CTRL  = 0x7;
+    constexpr uint8_t FIFO_THRESH = 0x8;
+    constexpr uint8_t RX_TIMEOUT  = 0x9;
+    constexpr uint8_t BAUD_FRAC   = 0xA;
+    constexpr uint8_t FLOW_CTRL   = 0xB;
+    constexpr uint8_t ISR_SNAPSHOT = 0xC;
+    constexpr uint8_t PERF_CTRL   = 0xD;
+    constexpr uint8_t PERF_DATA   = 0xE;
+
+    constexpr uint32_t CTRL_TX_EN   = 1u << 0;
+    constexpr uint32_t CTRL_RX_EN   = 1u << 1;
+    constexpr uint32_t CTRL_PACK_EN = 1u << 2;
+    constexpr uint32_t CTRL_STREAM_EN = 1u << 3;
+    constexpr uint32_t CTRL_OSR_SHIFT = 4;           // [5:4]: 0=16x, 1=8x, 2=4x
+    constexpr uint32_t CTRL_OSR_MASK  = 0x3u << CTRL_OSR_SHIFT;
+    constexpr uint32_t CTRL_RTS_EN  = 1u << 6;
+    constexpr uint32_t CTRL_CTS_EN  = 1u << 7;
+    constexpr uint32_t CTRL_INT_RTC = 1u << 8;           // INT_STATUS read-to-clear
+    constexpr uint32_t CTRL_LOOPBACK = 1u << 9;          // TX into RX inside uart_top
+    constexpr uint32_t CTRL_PRBS_EN = 1u << 10;          // PRBS-15 generator/checker
+    constexpr uint32_t CTRL_TX_EARLY = 1u << 11;         // Idle-line writes bypass the TX FIFO
+    constexpr uint32_t CTRL_AUTOBAUD = 1u << 12;         // Measure a 0x55, load BAUD_DIV/FRAC
+    constexpr uint32_t CTRL_MASK    = 0x1FFF;
+
+    constexpr uint32_t STATUS_TX_EMPTY  = 1u << 0;
+    constexpr uint32_t STATUS_TX_FULL   = 1u << 1;
+    constexpr uint32_t STATUS_RX_EMPTY  = 1u << 2;
+    constexpr uint32_t STATUS_RX_FULL   = 1u << 3;
+    constexpr uint32_t STATUS_TX_ACTIVE = 1u << 4;
+    constexpr uint32_t STATUS_RX_ACTIVE = 1u << 5;
+    constexpr uint32_t STATUS_FRAME_ERR = 1u << 6;
+    constexpr uint32_t STATUS_OVERRUN   = 1u << 7;
+    constexpr uint32_t STATUS_PRBS_LOCK = 1u << 24;   // Last checked byte error-free
+    constexpr uint32_t STATUS_TX_OVERRUN = 1u << 25;  // TX byte dropped (sticky)
+
+    constexpr uint32_t INT_TX_READY   = 1u << 0;
+    constexpr uint32_t INT_RX_READY   = 1u << 1;
+    constexpr uint32_t INT_FRAME_ERR  = 1u << 2;
+    constexpr uint32_t INT_OVERRUN    = 1u << 3;
+    constexpr uint32_t INT_TX_LOW_WM  = 1u << 4;
+    constexpr uint32_t INT_RX_HIGH_WM = 1u << 5;
+    constexpr uint32_t INT_RX_TIMEOUT = 1u << 6;
+    constexpr uint32_t INT_AUTOBAUD   = 1u << 7;
+    constexpr uint32_t INT_MASK       = 0xFF;
+
+    // ISR_SNAPSHOT: [7:0] pending, [15:8] TX level, [23:16] RX readable
+    constexpr uint32_t ISR_FRAME_ERR  = 1u << 24;
+    constexpr uint32_t ISR_OVERRUN    = 1u << 25;
+
+    // PERF_CTRL: [2:0] SEL (PERF_DATA counter), SNAPSHOT / CLEAR strobes
+    constexpr uint32_t PERF_SEL_MASK  = 0x7;
+    constexpr uint32_t PERF_SNAPSHOT  = 1u << 8;
+    constexpr uint32_t PERF_CLEAR     = 1u << 9;
+    constexpr uint32_t PERF_PRESENT   = 1u << 31;
+
+    // PERF_SEL counter indices
+    constexpr unsigned PERF_TX_BYTES   = 0;
+    constexpr unsigned PERF_RX_BYTES   = 1;
+    constexpr unsigned PERF_FRAME_ERRS = 2;
+    constexpr unsigned PERF_OVERRUNS   = 3;
+    constexpr unsigned PERF_TX_STALLS  = 4;   // TX_EN, idle, TX FIFO empty
+    constexpr unsigned PERF_RX_HWM     = 5;   // RX FIFO high-water mark
+    constexpr unsigned PERF_PRBS_BITS  = 6;   // Bits checked (+8 per byte)
+    constexpr unsigned PERF_PRBS_ERRS  = 7;   // PRBS bit errors
+    constexpr unsigned PERF_NUM        = 8;
+
+    // RX prefetch holding buffer depth (skid buffer)
+    constexpr unsigned RX_HOLD_DEPTH = 2;
+
+    // Packed RX_DATA: up to 3 bytes in [23:0], byte count in [25:24]
+    constexpr unsigned RX_PACK_MAX   = 3;
+    constexpr unsigned RX_PACK_SHIFT = 24;
+
+    constexpr uint16_t BAUD_DIV_RESET = 0x0004;
+    constexpr uint32_t BAUD_FRAC_MASK = 0x3F;   // 1/64 cycle steps
+    constexpr uint32_t FIFO_THRESH_RESET = 0x00010000;  // TX_LOW_WM=0, RX_HIGH_WM=1
+
+    constexpr uint16_t PRBS_SEED = 0x7FFF;
+
+    // Next CTRL.PRBS_EN byte: 8 steps of x^15 + x^14 + 1, bit 0 first
+    inline uint8_t prbs15_byte(uint16_t& state) {
+        uint8_t byte = 0;
+        for (unsigned i = 0; i < 8; i++) {
+            unsigned bit = ((state >> 14) ^ (state >> 13)) & 1;
+            state = (uint16_t)(((state << 1) | bit) & 0x7FFF);
+            byte |= (uint8_t)(bit << i);
+        }
+        return byte;
+    }
+}
+
+class UartModel {
+public:
+    virtual ~UartModel() {}
+
+    // Hardware reset (register defaults, FIFOs and lines cleared)
+    virtual void reset() = 0;
+
+    // Register access (1 cycle per write, 2 cycles per read). wstrb selects
+    // the byte lanes of a packed TX_DATA write; other writes ignore it.
+    virtual void write_reg(uint8_t addr, uint32_t data, uint8_t wstrb = 0xF) = 0;
+    virtual uint32_t read_reg(uint8_t addr) = 0;
+
+    // Advance n clock cycles
+    virtual void run_cycles(uint64_t n) = 0;
+
+    // Queue an 8N1 frame on uart_rx at the programmed baud rate.
+    // bad_stop drives the stop bit low (frame error).
+    virtual void send_byte(uint8_t data, bool bad_stop = false) = 0;
+
+    // Pop the next byte transmitted on uart_tx; false if none yet
+    virtual bool recv_byte(uint8_t& data) = 0;
+
+    virtual bool irq() = 0;
+    virtual uint64_t cycles() const = 0;
+};
+
+// Lockstep comparison: every operation is applied to both models and the
+// results of `model` are checked against `golden`. Returns golden's values.
+class UartLockstep : public UartModel {
+public:
+    UartLockstep(UartModel& golden, UartModel& model)
+        : golden_(golden), model_(model) {
+        clear();
+    }
+
+    void reset() override {
+        golden_.reset();
+        model_.reset();
+        clear();
+    }
+
+    void write_reg(uint8_t addr, uint32_t data, uint8_t wstrb = 0xF) override {
+        golden_.write_reg(addr, data, wstrb);
+        model_.write_reg(addr, data, wstrb);
+        if (addr == uart_reg::BAUD_DIV) {
+            uint32_t div = data & 0xFFFF;
+            grace_cycles_ = 32 * (div ? div : 1);
+        }
+        sync();
+    }
+
+    uint32_t read_reg(uint8_t addr) override {
+        uint32_t g = golden_.read_reg(addr);
+        uint32_t m = model_.read_reg(addr);
+        compare(addr, g, m);
+        sync();
+        return g;
+    }
+
+    void run_cycles(uint64_t n) override {
+        golden_.run_cycles(n);
+        model_.run_cycles(n);
+        sync();
+    }
+
+    void send_byte(uint8_t data, bool bad_stop = false) override {
+        golden_.send_byte(data, bad_stop);
+        model_.send_byte(data, bad_stop);
+    }
+
+    bool recv_byte(uint8_t& data) override {
+        if (tx_out_.empty()) return false;
+        data = tx_out_.front();
+        tx_out_.pop_front();
+        return true;
+    }
+
+    bool irq() override {
+        bool g = golden_.irq();
+        compare(IRQ_KEY, g, model_.irq());
+        return g;
+    }
+
+    uint64_t cycles() const override { return golden_.cycles(); }
+
+    // Grace window for timing-sensitive registers (cycles)
+    void set_grace_cycles(uint64_t cycles) { grace_cycles_ = cycles; }
+
+    // Reported mismatches, plus timing-sensitive differences that have
+    // not been resolved by a later matching read within the grace window
+    std::vector<std::string> mismatches() const {
+        std::vector<std::string> all = errors_;
+        for (const auto& diff : pending_) {
+            if (cycles() - diff.second.cycle >= grace_cycles_) {
+                all.push_back(diff.second.message);
+            }
+        }
+        if (!golden_tx_.empty() || !model_tx_.empty()) {
+            all.push_back("uart_tx stream: " +
+                          std::to_string(golden_tx_.size()) +
+                          " unmatched golden byte(s), " +
+                          std::to_string(model_tx_.size()) +
+                          " unmatched model byte(s)");
+        }
+        return all;
+    }
+
+    bool in_sync() const { return mismatches().empty(); }
+
+private:
+    static constexpr unsigned IRQ_KEY = 0x100;
+
+    struct PendingDiff {
+        uint64_t cycle;
+        std::string message;
+    };
+
+    void clear() {
+        grace_cycles_ = 32 * uart_reg::BAUD_DIV_RESET;
+        errors_.clear();
+        pending_.clear();
+        golden_tx_.clear();
+        model_tx_.clear();
+        tx_out_.clear();
+    }
+
+    static bool timing_sensitive(unsigned key) {
+        return key == uart_reg::STATUS || key == uart_reg::INT_STATUS ||
+               key == uart_reg::ISR_SNAPSHOT || key == uart_reg::PERF_DATA ||
+               key == IRQ_KEY;
+    }
+
+    std::string describe(unsigned key, uint32_t g, uint32_t m) const {
+        char buf[96];
+        if (key == IRQ_KEY) {
+            std::snprintf(buf, sizeof(buf), "cycle %llu: irq golden=%u model=%u",
+                          (unsigned long long)cycles(), g, m);
+        } else {
+            std::snprintf(buf, sizeof(buf),
+                          "cycle %llu: reg 0x%X golden=0x%08X model=0x%08X",
+                          (unsigned long long)cycles(), key, g, m);
+        }
+        return buf;
+    }
+
+    void compare(unsigned key, uint32_t g, uint32_t m) {
+        if (g == m) {
+            pending_.erase(key);
+            return;
+        }
+        if (!timing_sensitive(key)) {
+            errors_.push_back(describe(key, g, m));
+            return;
+        }
+        auto it = pending_.find(key);
+        if (it == pending_.end()) {
+            pending_[key] = PendingDiff{cycles(), describe(key, g, m)};
+        } else if (cycles() - it->second.cycle >= grace_cycles_) {
+            errors_.push_back(it->second.message);
+            pending_.erase(it);
+        }
+    }
+
+    // Match transmitted bytes in order as both sides produce them
+    void sync() {
+        uint8_t byte;
+        while (golden_.recv_byte(byte)) golden_tx_.push_back(byte);
+        while (model_.recv_byte(byte)) model_tx_.push_back(byte);
+        while (!golden_tx_.empty() && !model_tx_.empty()) {
+            uint8_t g = golden_tx_.front();
+            uint8_t m = model_tx_.front();
+            if (g != m) {
+                char buf[80];
+                std::snprintf(buf, sizeof(buf),
+                              "cycle %llu: uart_tx golden=0x%02X model=0x%02X",
+                              (unsigned long long)cycles(), g, m);
+                errors_.push_back(buf);
+            }
+            tx_out_.push_back(g);
+            golden_tx_.pop_front();
+            model_tx_.pop_front();
+        }
+    }
+
+    UartModel& golden_;
+    UartModel& model_;
+    uint64_t grace_cycles_;
+    std::vector<std::string> errors_;
+    std::map<unsigned, PendingDiff> pending_;
+    std::deque<uint8_t> golden_tx_;
+    std::deque<uint8_t> model_tx_;
+    std::deque<uint8_t> tx_out_;
+};
+
+#endif // UART_MODEL_H
@@ -0,0 +1,218 @@
+/*
+ * UART RTL Model Adapter
+ *
+ * Wraps the Verilated uart_top (Vuart_top) behind the UartModel interface,
+ * so the same driver code runs against the RTL or the transaction-level
+ * model (UartTlm), and UartLockstep can use it as the golden reference.
+ *
+ * Features:
+ * - Register access on uart_top's reg_* port (1-cycle write, 2-cycle read;
+ *   writes also wait out reg_busy)
+ * - Serial line driver: queued send_byte() frames are shifted onto uart_rx
+ *   at OSR x (BAUD_DIV + BAUD_FRAC/64) cycles per bit (OSR = 16/8/4 from
+ *   CTRL.OSR), one idle bit between frames
+ * - Serial line monitor: decodes uart_tx frames (mid-bit sampling) into
+ *   the recv_byte() queue
+ *
+ * Usage:
+ *   UartRtlModel rtl;
+ *   rtl.reset();
+ *   rtl.write_reg(uart_reg::BAUD_DIV, 1);
+ *
+ * IMPORTANT:
+ * - Defines the DutPorts<Vuart_top> binding; do not combine with another
+ *   DUT_DRIVER_PORTS(Vuart_top, ...) in the same translation unit
+ * - Read data is captured on the access cycle, before the clock edge (as
+ *   axi_lite_slave_if does), so RX_DATA returns the bytes being popped
+ * - Line bit time follows the last BAUD_DIV/BAUD_FRAC/CTRL written through
+ *   this adapter; fractional bit times are carried from bit to bit in 1/64
+ *   cycle steps, so the line does not drift
+ * - uart_rx rearms a few cycles after the end of the stop bit, so strictly
+ *   back-to-back frames drift; the idle guard bit keeps it aligned
+ */
+
+#ifndef UART_RTL_MODEL_H
+#define UART_RTL_MODEL_H
+
+#include "Vuart_top.h"
+#include "dut_driver.h"
+#include "uart_model.h"
+#include <cstdint>
+#include <deque>
+
+DUT_DRIVER_PORTS(Vuart_top, uart_clk, rst_n);
+
+class UartRtlModel : public UartModel {
+public:
+    UartRtlModel() {
+        drv_.dut->uart_rx = 1;  // Idle high
+        drv_.dut->uart_cts_n = 0;  // Clear to send
+        drv_.dut->ext_baud_tick = 0;  // Internal baud_gen
+        drv_.dut->reg_addr = 0;
+        drv_.dut->reg_wdata = 0;
+        drv_.dut->reg_wstrb = 0xF;
+        drv_.dut->reg_wen = 0;
+        drv_.dut->reg_ren = 0;
+        drv_.dut->s_axis_tdata = 0;   // Stream ports unused
+        drv_.dut->s_axis_tvalid = 0;
+        drv_.dut->m_axis_tready = 0;
+        clear_lines();
+    }
+
+    void reset() override {
+        drv_.dut->reg_wen = 0;
+        drv_.dut->reg_ren = 0;
+        drv_.dut->uart_rx = 1;
+        drv_.pulse_reset();
+        clear_lines();
+    }
+
+    void write_reg(uint8_t addr, uint32_t data, uint8_t wstrb = 0xF) override {
+        drv_.dut->reg_addr = addr;
+        drv_.dut->reg_wdata = data;
+        drv_.dut->reg_wstrb = wstrb;
+        drv_.dut->reg_wen = 1;
+        step();
+        drv_.dut->reg_wen = 0;
+        drv_.dut->reg_wstrb = 0xF;
+
+        // Packed TX_DATA: one cycle per staged byte lane
+        while (drv_.dut->reg_busy) step();
+
+        if (addr == uart_reg::BAUD_DIV) baud_div_ = data & 0xFFFF;
+        if (addr == uart_reg::BAUD_FRAC) baud_frac_ = data & uart_reg::BAUD_FRAC_MASK;
+        if (addr == uart_reg::CTRL) {
+            uint32_t osr = (data & uart_reg::CTRL_OSR_MASK) >> uart_reg::CTRL_OSR_SHIFT;
+            ticks_per_bit_ = (osr == 1) ? 8 : (osr == 2) ? 4 : 16;
+        }
+    }
+
+    uint32_t read_reg(uint8_t addr) override {
+        drv_.dut->reg_addr = addr;
+        drv_.dut->reg_ren = 1;
+        drv_.dut->eval();  // Combinational read mux, before the edge
+        uint32_t value = drv_.dut->reg_rdata;
+        step();
+        drv_.dut->reg_ren = 0;
+        step();
+        return value;
+    }
+
+    void run_cycles(uint64_t n) override {
+        for (uint64_t i = 0; i < n; i++) {
+            step();
+        }
+    }
+
+    void send_byte(uint8_t data, bool bad_stop = false) override {
+        std::vector<uint8_t> bits = uart_frame_bits(data);
+        if (bad_stop) bits.back() = 0;
+        bits.push_back(1);  // Idle guard bit
+        rx_bits_.insert(rx_bits_.end(), bits.begin(), bits.end());
+    }
+
+    bool recv_byte(uint8_t& data) override {
+        if (tx_out_.empty()) return false;
+        data = tx_out_.front();
+        tx_out_.pop_front();
+        return true;
+    }
+
+    bool irq() override { return drv_.dut->irq; }
+
+    uint64_t cycles() const override { return drv_.cycle_count; }
+
+    // Direct access for pin-level checks
+    Vuart_top* dut() { return drv_.dut; }
+
+private:
+    // Bit time in 1/64 cycle units: OSR x (BAUD_DIV + BAUD_FRAC/64)
+    uint64_t bit_cycles64() const {
+        return ticks_per_bit_ * (((uint64_t)(baud_div_ ? baud_div_ : 1) << 6) + baud_frac_);
+    }
+
+    void clear_lines() {
+        baud_div_ = uart_reg::BAUD_DIV_RESET;
+        baud_frac_ = 0;
+        ticks_per_bit_ = 16;
+        rx_bits_.clear();
+        rx_level_ = 1;
+        rx_left_ = 0;
+        rx_phase_ = 0;
+        mon_busy_ = false;
+        mon_count_ = 0;
+        mon_index_ = 0;
+        mon_shift_ = 0;
+        tx_out_.clear();
+    }
+
+    // One clock: drive uart_rx, tick, decode uart_tx
+    void step() {
+        if (rx_left_ == 0) {
+            if (!rx_bits_.empty()) {
+                rx_level_ = rx_bits_.front();
+                rx_bits_.pop_front();
+                rx_phase_ += bit_cycles64();
+                rx_left_ = rx_phase_ >> 6;
+                rx_phase_ &= 63;
+            } else {
+                rx_level_ = 1;
+                rx_phase_ = 0;
+            }
+        }
+        drv_.dut->uart_rx = rx_level_;
+
+        drv_.tick();
+        if (rx_left_) rx_left_--;
+
+        monitor_tx();
+    }
+
+    void monitor_tx() {
+        uint8_t line = drv_.dut->uart_tx;
+        if (!mon_busy_) {
+            if (!line) {
+                mon_busy_ = true;
+                mon_count_ = 0;
+                mon_index_ = 0;
+                mon_shift_ = 0;
+            }
+            return;
+        }
+
+        mon_count_++;
+        uint64_t bit64 = bit_cycles64();
+        if (mon_count_ != (bit64 / 2 + mon_index_ * bit64) >> 6) return;
+
+        // Mid-bit sample: 0 = start, 1..8 = data (LSB first), 9 = stop
+        uint64_t index = mon_index_++;
+        if (index == 0) {
+            if (line) mon_busy_ = false;  // Glitch, not a start bit
+        } else if (index <= 8) {
+            if (line) mon_shift_ |= (uint8_t)(1u << (index - 1));
+        } else {
+            tx_out_.push_back(mon_shift_);
+            mon_busy_ = false;
+        }
+    }
+
+    DutDriver<Vuart_top> drv_;
+    uint32_t baud_div_;
+    uint32_t baud_frac_;
+    uint32_t ticks_per_bit_;  // CTRL.OSR
+
+    // uart_rx driver
+    std::deque<uint8_t> rx_bits_;
+    uint8_t  rx_level_;
+    uint64_t rx_left_;      // Cycles left in the current bit
+    uint64_t rx_phase_;     // Carried fraction of a cycle, 1/64 units
+
+    // uart_tx monitor
+    bool     mon_busy_;
+    uint64_t mon_count_;    // Cycles since start-bit edge
+    uint64_t mon_index_;    // Next bit to sample (0 = start)
+    uint8_t  mon_shift_;
+    std::deque<uint8_t> tx_out_;
+};
+
+#endif // UART_RTL_MODEL_H
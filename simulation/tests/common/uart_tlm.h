@@ -0,0 +1,599 @@
+/*
+ * UART Transaction-Level Model
+ *
+ * C++ behavioral model of uart_top at byte granularity. Implements the
+ * uart_regs register map with the same side effects as the RTL, but
+ * advances time from frame event to frame event instead of clock by clock,
+ * so idle and in-frame cycles cost nothing to simulate.
+ *
+ * Features:
+ * - CTRL, STATUS, TX_DATA, RX_DATA, BAUD_DIV, INT_ENABLE, INT_STATUS (W1C,
+ *   or read-to-clear with CTRL.INT_RTC), FIFO_CTRL (self-clearing),
+ *   FIFO_THRESH, RX_TIMEOUT, BAUD_FRAC, FLOW_CTRL, ISR_SNAPSHOT with RTL
+ *   reset values and reserved-bit masks
+ * - PERF_CTRL/PERF_DATA counters: byte, error and overrun counts per
+ *   frame; TX stall cycles and the RX high-water mark follow the model's
+ *   frame timing, so they match the RTL to within a few baud ticks
+ * - TX/RX FIFO depths as uart_top parameters (default 8), full/empty and
+ *   saturating 8-bit level reporting
+ * - RX holding buffer (uart_regs prefetch): the first two bytes wait
+ *   outside the RX FIFO, so STATUS levels match the RTL; in packed mode
+ *   three bytes are held, refilled one per cycle as in the RTL
+ * - Packed TX_DATA/RX_DATA access (CTRL.PACK_EN) with wstrb byte lanes
+ * - CTRL.STREAM_EN register side effects (TX_DATA writes dropped, RX_DATA
+ *   reads 0 without popping); the stream ports themselves are not modelled
+ * - CTRL.LOOPBACK: TX frames come back through the RX path, timed as the
+ *   frame goes out, and send_byte() frames are ignored (uart_rx is not
+ *   sampled)
+ * - CTRL.PRBS_EN: generator bytes keep the TX FIFO full and every byte
+ *   reaching the holding buffer is checked, with the PRBS_BITS/PRBS_ERRS
+ *   counters and STATUS.PRBS_LOCK as in uart_regs
+ * - Frame timing in baud ticks: 160 ticks per 8N1 frame (80 / 40 with
+ *   CTRL.OSR = 8x / 4x), frozen while the
+ *   baud generator is disabled (CTRL[1:0] == 0 or BAUD_DIV == 0); a tick
+ *   lasts BAUD_DIV + BAUD_FRAC/64 cycles on average
+ * - Interrupt sources and sticky errors as in uart_regs, including the
+ *   TX-low / RX-high watermarks, the RX character timeout, the RX path
+ *   flags that persist until an RX FIFO reset and STATUS.TX_OVERRUN, which
+ *   persists until a TX FIFO reset
+ *
+ * Usage:
+ *   UartTlm uart;
+ *   uart.reset();
+ *   uart.write_reg(uart_reg::CTRL, 0x3);
+ *   uart.write_reg(uart_reg::TX_DATA, 0x55);
+ *   uart.run_cycles(1000);
+ *   uart.recv_byte(byte);
+ *
+ * IMPORTANT:
+ * - Frame edges are placed to within a few baud ticks of the RTL (the RTL
+ *   start point depends on the baud counter phase); back-to-back streams
+ *   do not drift
+ * - A BAUD_DIV/BAUD_FRAC change takes effect at the next frame, not
+ *   mid-frame
+ * - With BAUD_FRAC != 0 the RTL stretches individual ticks; the model uses
+ *   the average tick length, so edges may differ by a baud tick
+ * - Bytes whose reception completes while the baud generator is disabled
+ *   are lost, as in the RTL
+ * - RTS/CTS pins are not modelled: CTS is taken as asserted (as the RTL
+ *   adapter ties it), so CTRL.RTS_EN/CTS_EN and FLOW_CTRL are storage only
+ * - PRBS bytes are checked as soon as they are prefetched rather than one
+ *   per cycle, so the PRBS counters lead the RTL by a cycle or two
+ * - A CTRL.LOOPBACK change applies from the next TX frame; the RTL
+ *   switches the lines immediately
+ * - CTRL.TX_EARLY is storage only: the RTL's shorter first-byte latency
+ *   and restarted baud phase are within the frame edge tolerance above
+ * - Autobaud is not modelled: CTRL.AUTOBAUD is storage only (it never
+ *   clears and INT_STATUS.AUTOBAUD never sets), and the RTL ignores
+ *   uart_rx while it is set
+ */
+
+#ifndef UART_TLM_H
+#define UART_TLM_H
+
+#include "uart_model.h"
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+
+class UartTlm : public UartModel {
+public:
+    static constexpr uint64_t FRAME_BITS = 10;  // Start + 8 data + stop
+
+    // Depths as uart_top TX_FIFO_DEPTH / RX_FIFO_DEPTH (powers of 2)
+    explicit UartTlm(unsigned tx_fifo_depth = 8, unsigned rx_fifo_depth = 8)
+        : tx_depth_(tx_fifo_depth), rx_depth_(rx_fifo_depth) {
+        // uart_regs keeps log2(max depth) + 1 bits per FIFO_THRESH field
+        unsigned depth = std::max(tx_depth_, rx_depth_);
+        unsigned level_width = 1;
+        while ((1u << (level_width - 1)) < depth) level_width++;
+        level_mask_ = (1u << level_width) - 1;
+        reset();
+    }
+
+    void reset() override {
+        now_ = 0;
+        ctrl_ = 0;
+        baud_div_ = uart_reg::BAUD_DIV_RESET;
+        baud_frac_ = 0;
+        int_enable_ = 0;
+        int_status_ = 0;
+        tx_low_wm_ = uart_reg::FIFO_THRESH_RESET & level_mask_;
+        rx_high_wm_ = (uart_reg::FIFO_THRESH_RESET >> 16) & level_mask_;
+        rx_timeout_ = 0;
+        rts_thresh_ = (level_mask_ + 1) >> 2;  // Half the largest FIFO
+        rx_idle_start_ = 0;
+        frame_error_sticky_ = false;
+        overrun_error_sticky_ = false;
+        tx_overrun_sticky_ = false;
+        perf_sel_ = 0;
+        std::fill(perf_count_, perf_count_ + uart_reg::PERF_NUM, 0u);
+        std::fill(perf_shadow_, perf_shadow_ + uart_reg::PERF_NUM, 0u);
+        reset_prbs();
+
+        tx_fifo_.clear();
+        tx_busy_ = false;
+        tx_shift_ = 0;
+        tx_remaining_ = 0;
+        tx_looped_ = false;
+        tx_out_.clear();
+
+        rx_fifo_.clear();
+        rx_hold_.clear();
+        rx_lane0_ = 0;
+        rx_fetch_next_ = 0;
+        rx_frame_error_ = false;
+        rx_overrun_error_ = false;
+        rx_line_.clear();
+        rx_line_free_ = 0;
+    }
+
+    void write_reg(uint8_t addr, uint32_t data, uint8_t wstrb = 0xF) override {
+        uint64_t cost = 1;
+        switch (addr) {
+            case uart_reg::CTRL:
+                ctrl_ = data & uart_reg::CTRL_MASK;
+                if (!(ctrl_ & uart_reg::CTRL_PRBS_EN)) reset_prbs();
+                break;
+            case uart_reg::BAUD_DIV:   baud_div_ = data & 0xFFFF; break;
+            case uart_reg::BAUD_FRAC:  baud_frac_ = data & uart_reg::BAUD_FRAC_MASK; break;
+            case uart_reg::INT_ENABLE: int_enable_ = data & uart_reg::INT_MASK; break;
+            case uart_reg::INT_STATUS: clear_int(data & uart_reg::INT_MASK); break;
+            case uart_reg::TX_DATA:
+                if (ctrl_ & (uart_reg::CTRL_STREAM_EN | uart_reg::CTRL_PRBS_EN)) {
+                    break;  // Stream or PRBS generator owns the FIFO
+                }
+                if (!(ctrl_ & uart_reg::CTRL_PACK_EN)) {
+                    wstrb = 0x1;
+                    data &= 0xFF;
+                } else {
+                    // Lanes drain one per cycle behind reg_busy
+                    for (unsigned lane = 0; lane < 4; lane++) {
+                        if (wstrb & (1u << lane)) cost++;
+                    }
+                }
+                for (unsigned lane = 0; lane < 4; lane++) {
+                    if (!(wstrb & (1u << lane))) continue;
+                    if (tx_fifo_.size() < tx_depth_) {
+                        tx_fifo_.push_back((data >> (8 * lane)) & 0xFF);
+                    } else {
+                        tx_overrun_sticky_ = true;
+                    }
+                }
+                start_tx(false);
+                break;
+            case uart_reg::FIFO_CTRL:
+                if (data & 0x1) reset_tx_path();
+                if (data & 0x2) reset_rx_path();
+                break;
+            case uart_reg::FIFO_THRESH:
+                tx_low_wm_ = data & level_mask_;
+                rx_high_wm_ = (data >> 16) & level_mask_;
+                break;
+            case uart_reg::RX_TIMEOUT: rx_timeout_ = data & 0xFF; break;
+            case uart_reg::FLOW_CTRL:  rts_thresh_ = data & level_mask_; break;
+            case uart_reg::PERF_CTRL:
+                perf_sel_ = data & uart_reg::PERF_SEL_MASK;
+                if (data & uart_reg::PERF_SNAPSHOT) {
+                    std::copy(perf_count_, perf_count_ + uart_reg::PERF_NUM, perf_shadow_);
+                }
+                if (data & uart_reg::PERF_CLEAR) {
+                    std::fill(perf_count_, perf_count_ + uart_reg::PERF_NUM, 0u);
+                    perf_count_[uart_reg::PERF_RX_HWM] = (uint32_t)rx_fifo_.size();
+                }
+                break;
+            default:
+                break;
+        }
+        refresh();
+        run_cycles(cost);
+    }
+
+    // Value captured on the access cycle, then the RX_DATA pop side effect
+    uint32_t read_reg(uint8_t addr) override {
+        uint32_t value = peek(addr);
+        if (ctrl_ & uart_reg::CTRL_INT_RTC) {
+            if (addr == uart_reg::INT_STATUS) clear_int(value);
+            if (addr == uart_reg::ISR_SNAPSHOT) clear_int(value & uart_reg::INT_MASK);
+            refresh();  // Level-sensitive sources set again
+        }
+        if (addr == uart_reg::RX_DATA) {
+            rx_idle_start_ = now_ + 1;  // Idle timer restarts after the read
+            if (!(ctrl_ & (uart_reg::CTRL_STREAM_EN | uart_reg::CTRL_PRBS_EN))) consume_rx();
+            refresh();
+        }
+        run_cycles(2);
+        return value;
+    }
+
+    // Event-driven advance: jump straight to the next frame completion
+    void run_cycles(uint64_t n) override {
+        uint64_t end = now_ + n;
+        while (now_ < end) {
+            bool running = baud_running();
+            uint64_t next = end;
+            if (tx_busy_ && running) {
+                next = std::min(next, now_ + tx_remaining_);
+            }
+            if (!rx_line_.empty()) {
+                next = std::min(next, std::max(now_, rx_line_.front().done));
+            }
+            if (rx_hold_.size() < rx_hold_limit() && !rx_fifo_.empty()) {
+                next = std::min(next, std::max(now_, rx_fetch_next_));
+            }
+            if (rx_timeout_armed() && !(int_status_ & uart_reg::INT_RX_TIMEOUT)) {
+                next = std::min(next, std::max(now_, rx_timeout_deadline()));
+            }
+
+            if (tx_busy_ && running) tx_remaining_ -= next - now_;
+            if ((ctrl_ & 0x1) && !tx_busy_ && tx_fifo_.empty()) {
+                perf_add(uart_reg::PERF_TX_STALLS, next - now_);
+            }
+            now_ = next;
+
+            if (tx_busy_ && tx_remaining_ == 0) finish_tx();
+            while (!rx_line_.empty() && rx_line_.front().done <= now_) {
+                finish_rx();
+            }
+            refresh();
+        }
+    }
+
+    void send_byte(uint8_t data, bool bad_stop = false) override {
+        if (ctrl_ & uart_reg::CTRL_LOOPBACK) return;  // uart_rx not sampled
+        uint64_t div = line_divisor();
+        RxFrame frame;
+        frame.data = data;
+        frame.bad_stop = bad_stop;
+        frame.start = std::max(now_, rx_line_free_);
+        // Sync (2) + FIFO write (1), then ~half a tick of baud phase
+        frame.done = frame.start + tick_cycles(frame_ticks()) + 3 + div / 2;
+        // Peer leaves one idle bit between frames (see UartRtlModel)
+        rx_line_free_ = frame.start + tick_cycles(frame_ticks() + ticks_per_bit());
+        rx_line_.push_back(frame);
+    }
+
+    bool recv_byte(uint8_t& data) override {
+        if (tx_out_.empty()) return false;
+        data = tx_out_.front();
+        tx_out_.pop_front();
+        return true;
+    }
+
+    bool irq() override {
+        return (int_status_ & int_enable_) != 0;
+    }
+
+    uint64_t cycles() const override { return now_; }
+
+private:
+    struct RxFrame {
+        uint8_t  data;
+        bool     bad_stop;
+        uint64_t start;   // Start bit on the line
+        uint64_t done;    // Byte written to the RX FIFO
+    };
+
+    bool baud_running() const {
+        return (ctrl_ & 0x3) && baud_div_ != 0;
+    }
+
+    uint64_t line_divisor() const {
+        return baud_div_ ? baud_div_ : 1;
+    }
+
+    // CTRL.OSR: baud ticks per bit (reserved 11 behaves as 16x)
+    uint64_t ticks_per_bit() const {
+        switch ((ctrl_ & uart_reg::CTRL_OSR_MASK) >> uart_reg::CTRL_OSR_SHIFT) {
+            case 1:  return 8;
+            case 2:  return 4;
+            default: return 16;
+        }
+    }
+
+    uint64_t frame_ticks() const { return FRAME_BITS * ticks_per_bit(); }
+
+    // Cycles taken by n baud ticks: BAUD_DIV + BAUD_FRAC/64 each, rounded
+    uint64_t tick_cycles(uint64_t n) const {
+        uint64_t scaled = (line_divisor() << 6) + baud_frac_;
+        return (n * scaled + 32) >> 6;
+    }
+
+    bool rx_active() const {
+        return !rx_line_.empty() && rx_line_.front().start + 3 <= now_;
+    }
+
+    // uart_regs idle timer: bytes waiting, line idle, RX enabled
+    bool rx_timeout_armed() const {
+        size_t rx_count = rx_fifo_.size() + rx_hold_.size();
+        return (ctrl_ & 0x2) && rx_timeout_ != 0 && rx_count != 0 && !rx_active();
+    }
+
+    // Timer counts CTRL.OSR baud ticks per bit from the last restart
+    uint64_t rx_timeout_deadline() const {
+        return rx_idle_start_ + tick_cycles(ticks_per_bit() * rx_timeout_);
+    }
+
+    // uart_regs prefetch depth: two bytes, three in packed mode
+    size_t rx_hold_limit() const {
+        return (ctrl_ & uart_reg::CTRL_PACK_EN) ? uart_reg::RX_PACK_MAX
+                                                : uart_reg::RX_HOLD_DEPTH;
+    }
+
+    uint32_t rx_data() const {
+        if (ctrl_ & (uart_reg::CTRL_STREAM_EN | uart_reg::CTRL_PRBS_EN)) return 0;
+        if (!(ctrl_ & uart_reg::CTRL_PACK_EN)) return rx_lane0_;
+        uint32_t value = (uint32_t)rx_hold_.size() << uart_reg::RX_PACK_SHIFT;
+        for (size_t i = 0; i < rx_hold_.size(); i++) {
+            value |= (uint32_t)rx_hold_[i] << (8 * i);
+        }
+        return value;
+    }
+
+    // RX_DATA read: oldest byte, or every held byte in packed mode. The
+    // refill lands 2 cycles later unless a fetch is already in flight.
+    void consume_rx() {
+        if (rx_hold_.empty()) return;
+        if (ctrl_ & uart_reg::CTRL_PACK_EN) {
+            rx_hold_.clear();
+        } else {
+            rx_hold_.pop_front();
+        }
+        if (!rx_hold_.empty()) rx_lane0_ = rx_hold_.front();
+        if (rx_fetch_next_ <= now_) rx_fetch_next_ = now_ + 2;
+    }
+
+    static uint32_t saturate_level(size_t level) {
+        return level > 255 ? 255 : (uint32_t)level;
+    }
+
+    uint32_t status() const {
+        uint32_t value = 0;
+        if (tx_overrun_sticky_)               value |= uart_reg::STATUS_TX_OVERRUN;
+        if (prbs_lock_)                       value |= uart_reg::STATUS_PRBS_LOCK;
+        value |= saturate_level(rx_fifo_.size()) << 16;
+        value |= saturate_level(tx_fifo_.size()) << 8;
+        if (overrun_error_sticky_)            value |= uart_reg::STATUS_OVERRUN;
+        if (frame_error_sticky_)              value |= uart_reg::STATUS_FRAME_ERR;
+        if (rx_active())                      value |= uart_reg::STATUS_RX_ACTIVE;
+        if (tx_busy_)                         value |= uart_reg::STATUS_TX_ACTIVE;
+        if (rx_fifo_.size() == rx_depth_)     value |= uart_reg::STATUS_RX_FULL;
+        if (rx_fifo_.empty())                 value |= uart_reg::STATUS_RX_EMPTY;
+        if (tx_fifo_.size() == tx_depth_)     value |= uart_reg::STATUS_TX_FULL;
+        if (tx_fifo_.empty())                 value |= uart_reg::STATUS_TX_EMPTY;
+        return value;
+    }
+
+    // Pending interrupts, TX level, readable RX bytes and sticky errors
+    uint32_t isr_snapshot() const {
+        uint32_t value = int_status_ & int_enable_;
+        value |= saturate_level(tx_fifo_.size()) << 8;
+        value |= saturate_level(rx_fifo_.size() + rx_hold_.size()) << 16;
+        if (frame_error_sticky_)   value |= uart_reg::ISR_FRAME_ERR;
+        if (overrun_error_sticky_) value |= uart_reg::ISR_OVERRUN;
+        return value;
+    }
+
+    // INT_STATUS clear (W1C or read-to-clear), with the sticky errors
+    void clear_int(uint32_t mask) {
+        int_status_ &= ~mask;
+        if (mask & uart_reg::INT_FRAME_ERR) frame_error_sticky_ = false;
+        if (mask & uart_reg::INT_OVERRUN) overrun_error_sticky_ = false;
+    }
+
+    uint32_t peek(uint8_t addr) const {
+        switch (addr) {
+            case uart_reg::CTRL:       return ctrl_;
+            case uart_reg::STATUS:     return status();
+            case uart_reg::RX_DATA:    return rx_data();
+            case uart_reg::BAUD_DIV:   return baud_div_;
+            case uart_reg::INT_ENABLE: return int_enable_;
+            case uart_reg::INT_STATUS: return int_status_;
+            case uart_reg::FIFO_THRESH: return (rx_high_wm_ << 16) | tx_low_wm_;
+            case uart_reg::RX_TIMEOUT: return rx_timeout_;
+            case uart_reg::BAUD_FRAC:  return baud_frac_;
+            case uart_reg::FLOW_CTRL:  return rts_thresh_;
+            case uart_reg::ISR_SNAPSHOT: return isr_snapshot();
+            case uart_reg::PERF_CTRL:  return uart_reg::PERF_PRESENT | perf_sel_;
+            case uart_reg::PERF_DATA:  return perf_shadow_[perf_sel_];
+            default:                   return 0;  // TX_DATA (WO), FIFO_CTRL (self-clearing)
+        }
+    }
+
+    // Level-sensitive state: RX prefetch, interrupt sources, sticky errors
+    void refresh() {
+        if (rx_hold_.size() < rx_hold_limit() && !rx_fifo_.empty() &&
+            now_ >= rx_fetch_next_) {
+            rx_hold_.push_back(rx_fifo_.front());
+            rx_fifo_.pop_front();
+            rx_lane0_ = rx_hold_.front();
+            rx_fetch_next_ = now_ + 1;  // One fetch per cycle
+        }
+        if (ctrl_ & uart_reg::CTRL_PRBS_EN) {
+            while (!rx_hold_.empty()) {
+                check_prbs(rx_hold_.front());
+                rx_hold_.pop_front();
+            }
+            while (tx_fifo_.size() < tx_depth_) {
+                tx_fifo_.push_back(uart_reg::prbs15_byte(prbs_tx_state_));
+            }
+            start_tx(false);
+        }
+        size_t rx_count = rx_fifo_.size() + rx_hold_.size();
+        if ((ctrl_ & 0x1) && tx_fifo_.size() < tx_depth_)   int_status_ |= uart_reg::INT_TX_READY;
+        if ((ctrl_ & 0x2) && !rx_fifo_.empty())             int_status_ |= uart_reg::INT_RX_READY;
+        if ((ctrl_ & 0x1) && tx_fifo_.size() <= tx_low_wm_) int_status_ |= uart_reg::INT_TX_LOW_WM;
+        if ((ctrl_ & 0x2) && rx_high_wm_ != 0 && rx_count >= rx_high_wm_) {
+            int_status_ |= uart_reg::INT_RX_HIGH_WM;
+        }
+        if (!rx_timeout_armed()) {
+            rx_idle_start_ = now_;
+        } else if (now_ >= rx_timeout_deadline()) {
+            int_status_ |= uart_reg::INT_RX_TIMEOUT;
+        }
+        if (rx_frame_error_) {
+            int_status_ |= uart_reg::INT_FRAME_ERR;
+            frame_error_sticky_ = true;
+        }
+        if (rx_overrun_error_) {
+            int_status_ |= uart_reg::INT_OVERRUN;
+            overrun_error_sticky_ = true;
+        }
+    }
+
+    // Pull the next byte into the serializer. From idle the FIFO read and
+    // tx_valid handshake add 2 cycles and the first tick lands on average
+    // half a tick late; back-to-back frames are exactly 10 bits apart
+    // (plus the 2-cycle handshake when it exceeds one tick, BAUD_DIV <= 2).
+    void start_tx(bool back_to_back) {
+        if (tx_busy_ || tx_fifo_.empty()) return;
+        uint64_t div = line_divisor();
+        tx_shift_ = tx_fifo_.front();
+        tx_fifo_.pop_front();
+        tx_busy_ = true;
+        if (back_to_back) {
+            tx_remaining_ = tick_cycles(frame_ticks()) + (div <= 2 ? 2 : 0);
+        } else {
+            tx_remaining_ = 2 + tick_cycles(frame_ticks()) - div / 2;
+        }
+        tx_looped_ = (ctrl_ & uart_reg::CTRL_LOOPBACK) != 0;
+        if (tx_looped_) {
+            // The RX path samples the frame as it goes out; the byte lands
+            // after the sync (2) and FIFO write (1)
+            uint64_t end = now_ + tx_remaining_;
+            RxFrame frame;
+            frame.data = tx_shift_;
+            frame.bad_stop = false;
+            frame.start = end - std::min(end, tick_cycles(frame_ticks()));
+            frame.done = end + 3;
+            rx_line_.push_back(frame);
+        }
+    }
+
+    // Saturating 32-bit counter, as in uart_regs
+    void perf_add(unsigned counter, uint64_t n) {
+        uint64_t sum = perf_count_[counter] + n;
+        perf_count_[counter] = sum > 0xFFFFFFFFu ? 0xFFFFFFFFu : (uint32_t)sum;
+    }
+
+    void finish_tx() {
+        perf_add(uart_reg::PERF_TX_BYTES, 1);
+        if (!tx_looped_) tx_out_.push_back(tx_shift_);
+        tx_busy_ = false;
+        start_tx(true);
+    }
+
+    // Self-synchronizing check: each bit predicted from the 15 before it
+    void check_prbs(uint8_t data) {
+        unsigned errors = 0;
+        for (unsigned i = 0; i < 8; i++) {
+            unsigned bit = (data >> i) & 1;
+            errors += bit != (((prbs_rx_hist_ >> 14) ^ (prbs_rx_hist_ >> 13)) & 1);
+            prbs_rx_hist_ = (uint16_t)(((prbs_rx_hist_ << 1) | bit) & 0x7FFF);
+        }
+        if (prbs_rx_fill_ < 2) {
+            prbs_rx_fill_++;
+            return;
+        }
+        perf_add(uart_reg::PERF_PRBS_BITS, 8);
+        perf_add(uart_reg::PERF_PRBS_ERRS, errors);
+        prbs_lock_ = errors == 0;
+    }
+
+    // CTRL.PRBS_EN clear: generator back to the seed, checker unlocked
+    void reset_prbs() {
+        prbs_tx_state_ = uart_reg::PRBS_SEED;
+        prbs_rx_hist_ = 0;
+        prbs_rx_fill_ = 0;
+        prbs_lock_ = false;
+    }
+
+    void finish_rx() {
+        RxFrame frame = rx_line_.front();
+        rx_line_.pop_front();
+        if (!baud_running()) return;  // Receiver never sampled it
+        if (frame.bad_stop) perf_add(uart_reg::PERF_FRAME_ERRS, 1);
+
+        if (rx_fifo_.size() >= rx_depth_) {
+            rx_overrun_error_ = true;
+            perf_add(uart_reg::PERF_OVERRUNS, 1);
+            return;
+        }
+        rx_fifo_.push_back(frame.data);
+        perf_add(uart_reg::PERF_RX_BYTES, 1);
+        uint32_t& hwm = perf_count_[uart_reg::PERF_RX_HWM];
+        hwm = std::max(hwm, (uint32_t)rx_fifo_.size());
+        rx_idle_start_ = now_;
+        if (frame.bad_stop) rx_frame_error_ = true;
+        // RX_READY fires even if the prefetch empties the FIFO right away
+        if (ctrl_ & 0x2) int_status_ |= uart_reg::INT_RX_READY;
+    }
+
+    // FIFO_CTRL[0]: uart_tx_path held in reset (FIFO flushed, frame aborted)
+    void reset_tx_path() {
+        tx_fifo_.clear();
+        tx_overrun_sticky_ = false;
+        if (tx_busy_ && tx_looped_ && !rx_line_.empty()) rx_line_.pop_back();  // Aborted
+        tx_busy_ = false;
+        tx_remaining_ = 0;
+    }
+
+    // FIFO_CTRL[1]: uart_rx_path held in reset (FIFO and path error flags
+    // cleared, frame in progress lost). The holding register is in
+    // uart_regs and survives.
+    void reset_rx_path() {
+        rx_fifo_.clear();
+        rx_frame_error_ = false;
+        rx_overrun_error_ = false;
+        while (!rx_line_.empty() && rx_line_.front().start <= now_) {
+            rx_line_.pop_front();
+        }
+    }
+
+    unsigned tx_depth_;
+    unsigned rx_depth_;
+    uint32_t level_mask_;          // FIFO_THRESH / FLOW_CTRL field width
+    uint64_t now_;
+
+    // uart_regs state
+    uint32_t ctrl_;
+    uint32_t baud_div_;
+    uint32_t baud_frac_;
+    uint32_t int_enable_;
+    uint32_t int_status_;
+    uint32_t tx_low_wm_;
+    uint32_t rx_high_wm_;
+    uint32_t rx_timeout_;
+    uint32_t rts_thresh_;          // FLOW_CTRL.RTS_THRESH
+    uint64_t rx_idle_start_;       // Last idle timer restart
+    bool     frame_error_sticky_;
+    bool     overrun_error_sticky_;
+    bool     tx_overrun_sticky_;   // STATUS.TX_OVERRUN
+    uint32_t perf_sel_;            // PERF_CTRL.SEL
+    uint32_t perf_count_[uart_reg::PERF_NUM];   // Live counters
+    uint32_t perf_shadow_[uart_reg::PERF_NUM];  // PERF_DATA snapshot
+    uint16_t prbs_tx_state_;       // PRBS generator LFSR
+    uint16_t prbs_rx_hist_;        // Last 15 checked bits, newest in bit 0
+    unsigned prbs_rx_fill_;        // History bytes (checking starts at 2)
+    bool     prbs_lock_;           // STATUS.PRBS_LOCK
+
+    // TX path
+    std::deque<uint8_t> tx_fifo_;
+    bool     tx_busy_;
+    uint8_t  tx_shift_;
+    uint64_t tx_remaining_;        // Cycles of baud activity left in frame
+    bool     tx_looped_;           // Frame started under CTRL.LOOPBACK
+    std::deque<uint8_t> tx_out_;   // Completed frames on uart_tx
+
+    // RX path
+    std::deque<uint8_t> rx_fifo_;
+    std::deque<uint8_t> rx_hold_;  // uart_regs holding buffer, oldest first
+    uint8_t  rx_lane0_;            // RX_DATA[7:0] (keeps the last byte)
+    uint64_t rx_fetch_next_;       // Earliest cycle for the next prefetch
+    bool     rx_frame_error_;      // uart_rx_path sticky flags
+    bool     rx_overrun_error_;
+    std::deque<RxFrame> rx_line_;  // Frames queued/in flight on uart_rx
+    uint64_t rx_line_free_;
+};
+
+#endif // UART_TLM_H
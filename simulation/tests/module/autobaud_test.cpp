@@ -0,0 +1,190 @@
+/*
+ * autobaud Module Tests
+ *
+ * Tests the sync character (0x55) rate detector on a synchronized line
+ *
+ * Test Coverage:
+ * - Disabled: no busy, no result
+ * - Divisor sweep at 16x: exact BAUD_DIV, no fraction, lock 9 bit periods
+ *   after the start edge (at the stop bit)
+ * - 8x / 4x oversampling and fractional bit times (BAUD_FRAC)
+ * - Glitches and other characters rejected, a later 0x55 still locks
+ * - Result held until enable drops, new search after re-enable
+ */
+
+#include "Vautobaud.h"
+#include <boost/test/unit_test.hpp>
+#include <verilated.h>
+#include "dut_driver.h"
+#include "uart_line.h"
+#include <cmath>
+#include <vector>
+
+DUT_DRIVER_PORTS(Vautobaud, uart_clk, rst_n);
+
+BOOST_AUTO_TEST_SUITE(Autobaud_ModuleTests)
+
+struct AutobaudFixture : DutDriver<Vautobaud> {
+    int osr;  // Ticks per bit (osr_sel)
+
+    AutobaudFixture() {
+        osr = 16;
+
+        // Initialize inputs
+        dut->enable = 0;
+        dut->osr_sel = 0;
+        dut->rx_sync = 1;  // Idle high
+    }
+
+    void reset() {
+        dut->enable = 0;
+        dut->rx_sync = 1;
+        set_oversample(16);
+        pulse_reset();
+    }
+
+    // Helper: Select 16x, 8x or 4x oversampling (osr_sel 00 / 01 / 10)
+    void set_oversample(int rate) {
+        osr = rate;
+        dut->osr_sel = (rate == 8) ? 1 : (rate == 4) ? 2 : 0;
+    }
+
+    // Helper: One frame with a bit time of bit_x64 / 64 cycles (edges
+    // rounded down), `idle` high cycles before it, 3 bit times after it
+    static void append_frame(LineWave& wave, uint8_t data, uint64_t bit_x64, size_t idle) {
+        wave.append(1, idle);
+        std::vector<uint8_t> bits = uart_frame_bits(data);
+        for (size_t i = 0; i < bits.size(); i++) {
+            wave.append(bits[i], (i + 1) * bit_x64 / 64 - i * bit_x64 / 64);
+        }
+        wave.append(1, 3 * bit_x64 / 64);
+    }
+
+    // Helper: Drive the wave on rx_sync, one level per cycle; index of the
+    // cycle whose edge raised done, -1 if done never rose
+    long drive(const LineWave& wave) {
+        long locked = -1;
+        for (size_t t = 0; t < wave.size(); t++) {
+            dut->rx_sync = wave.get(t);
+            tick();
+            if (dut->done) {
+                BOOST_CHECK_EQUAL(locked, -1);   // One pulse per search
+                locked = static_cast<long>(t);
+            }
+        }
+        dut->rx_sync = 1;
+        return locked;
+    }
+
+    // Helper: Result as divisor × 64 + frac
+    uint32_t result_x64() const { return dut->divisor * 64u + dut->frac; }
+};
+
+// Test 1: Disabled, the detector ignores the line
+BOOST_FIXTURE_TEST_CASE(autobaud_disabled, AutobaudFixture) {
+    reset();
+
+    LineWave wave;
+    append_frame(wave, 0x55, 16 * 64, 32);
+    BOOST_CHECK_EQUAL(drive(wave), -1);
+    BOOST_CHECK_EQUAL(dut->busy, 0);
+    BOOST_CHECK_EQUAL(dut->divisor, 0);
+}
+
+// Test 2: Divisor sweep at 16x, exact result and lock time in bit periods
+BOOST_FIXTURE_TEST_CASE(autobaud_divisor_sweep, AutobaudFixture) {
+    for (unsigned div : {1u, 2u, 3u, 4u, 5u, 7u, 8u, 12u, 24u, 48u, 255u, 1000u}) {
+        reset();
+        dut->enable = 1;
+        tick();
+        tick();
+        BOOST_CHECK_EQUAL(dut->busy, 1);
+
+        const unsigned bit = 16 * div;
+        const size_t idle = 3 * bit;
+        LineWave wave;
+        append_frame(wave, 0x55, uint64_t(bit) * 64, idle);
+        long locked = drive(wave);
+        BOOST_REQUIRE_NE(locked, -1);
+
+        BOOST_CHECK_EQUAL(dut->divisor, div);
+        BOOST_CHECK_EQUAL(dut->frac, 0);
+        BOOST_CHECK_EQUAL(dut->busy, 0);
+
+        // Start edge to stop bit: 9 bit periods
+        double periods = double(locked - long(idle)) / bit;
+        BOOST_TEST_MESSAGE("BAUD_DIV " << div << ": locked after " << periods
+                           << " bit periods");
+        BOOST_CHECK_EQUAL(locked - long(idle), long(9 * bit));
+    }
+}
+
+// Test 3: 8x / 4x and fractional bit times
+BOOST_FIXTURE_TEST_CASE(autobaud_fractional_and_osr, AutobaudFixture) {
+    struct Case {
+        int osr;
+        uint64_t bit_x64;   // Bit time, 1/64 cycles
+        uint32_t expect_x64;
+    };
+    const std::vector<Case> cases = {
+        {16, 40 * 64, 2 * 64 + 32},      // 2.5
+        {16, 37 * 64, 2 * 64 + 20},      // 2.3125
+        {16, 100 * 64 + 32, 6 * 64 + 18}, // 6.28125: edges rounded down
+        {8, 20 * 64, 2 * 64 + 32},
+        {8, 9 * 64, 1 * 64 + 8},
+        {4, 10 * 64, 2 * 64 + 32},
+        {4, 7 * 64, 1 * 64 + 48},
+    };
+
+    for (const Case& c : cases) {
+        reset();
+        set_oversample(c.osr);
+        dut->enable = 1;
+
+        LineWave wave;
+        append_frame(wave, 0x55, c.bit_x64, 3 * c.bit_x64 / 64);
+        BOOST_REQUIRE_NE(drive(wave), -1);
+        BOOST_CHECK_EQUAL(result_x64(), c.expect_x64);
+
+        // Within a counted cycle of the true rate
+        double bit_ticks = double(c.bit_x64) / 64 / c.osr;
+        BOOST_CHECK_LE(std::fabs(result_x64() / 64.0 - bit_ticks), 1.0 / (8 * c.osr) + 1.0 / 64);
+    }
+}
+
+// Test 4: Glitches and other characters do not lock; a later 0x55 does
+BOOST_FIXTURE_TEST_CASE(autobaud_rejects_noise, AutobaudFixture) {
+    reset();
+    dut->enable = 1;
+
+    const unsigned bit = 16 * 6;
+    LineWave wave;
+    wave.append(1, 2 * bit);
+    wave.append(0, 3);                     // Glitch
+    append_frame(wave, 0x41, uint64_t(bit) * 64, 2 * bit);   // 'A': edges 2 and 6 bits apart
+    append_frame(wave, 0x00, uint64_t(bit) * 64, 2 * bit);   // Break-like: one long low
+    size_t sync_start = wave.size() + 2 * bit;
+    append_frame(wave, 0x55, uint64_t(bit) * 64, 2 * bit);
+
+    long locked = drive(wave);
+    BOOST_REQUIRE_NE(locked, -1);
+    BOOST_CHECK_EQUAL(locked - long(sync_start), long(9 * bit));
+    BOOST_CHECK_EQUAL(dut->divisor, 6);
+    BOOST_CHECK_EQUAL(dut->frac, 0);
+
+    // Held while enabled, even with more traffic
+    LineWave more;
+    append_frame(more, 0x55, 16 * 2 * 64, bit);
+    BOOST_CHECK_EQUAL(drive(more), -1);
+    BOOST_CHECK_EQUAL(dut->divisor, 6);
+
+    // Re-enabled: a new search at another rate
+    dut->enable = 0;
+    tick();
+    BOOST_CHECK_EQUAL(dut->busy, 0);
+    dut->enable = 1;
+    BOOST_CHECK_NE(drive(more), -1);
+    BOOST_CHECK_EQUAL(dut->divisor, 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
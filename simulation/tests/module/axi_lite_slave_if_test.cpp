@@ -13,11 +13,19 @@
  * - Invalid address handling
  * - Write response handling
  * - Address decoding
+ * - Byte enables to the register file, write response held while reg_busy
+ * - Pipelined build (PIPELINED=1): one access per cycle, response
+ *   back-pressure, read/write alternation, reg_busy hold-off
  */
 
 #include "Vaxi_lite_slave_if.h"
+#include "Vaxi_lite_slave_if_pipelined.h"
 #include <boost/test/unit_test.hpp>
 #include <verilated.h>
+#include "dut_driver.h"
+
+DUT_DRIVER_PORTS(Vaxi_lite_slave_if, clk, rst_n);
+DUT_DRIVER_PORTS(Vaxi_lite_slave_if_pipelined, clk, rst_n);
 
 BOOST_AUTO_TEST_SUITE(AXILiteSlave_ModuleTests)
 
@@ -25,18 +33,9 @@ BOOST_AUTO_TEST_SUITE(AXILiteSlave_ModuleTests)
 constexpr uint8_t AXI_RESP_OKAY   = 0b00;
 constexpr uint8_t AXI_RESP_SLVERR = 0b10;
 
-struct AXILiteSlaveFixture {
-    Vaxi_lite_slave_if* dut;
-    int cycle_count;
-
+struct AXILiteSlaveFixture : DutDriver<Vaxi_lite_slave_if> {
     AXILiteSlaveFixture() {
-        dut = new Vaxi_lite_slave_if;
-        cycle_count = 0;
-
         // Initialize inputs
-        dut->clk = 0;
-        dut->rst_n = 0;
-
         // AW channel
         dut->awaddr = 0;
         dut->awvalid = 0;
@@ -59,31 +58,16 @@ struct AXILiteSlaveFixture {
         // Register interface
         dut->reg_rdata = 0;
         dut->reg_error = 0;
-    }
-
-    ~AXILiteSlaveFixture() {
-        delete dut;
-    }
-
-    void tick() {
-        dut->clk = 0;
-        dut->eval();
-        dut->clk = 1;
-        dut->eval();
-        cycle_count++;
+        dut->reg_busy = 0;
     }
 
     void reset() {
-        dut->rst_n = 0;
         dut->awvalid = 0;
         dut->wvalid = 0;
         dut->arvalid = 0;
         dut->bready = 1;
         dut->rready = 1;
-        for (int i = 0; i < 5; i++) tick();
-        dut->rst_n = 1;
-        tick();
-        cycle_count = 0;
+        pulse_reset();
     }
 
     // Helper: Single AXI write transaction
@@ -365,4 +349,246 @@ BOOST_FIXTURE_TEST_CASE(axi_slave_concurrent_channels, AXILiteSlaveFixture) {
     BOOST_CHECK_EQUAL(dut->reg_wen, 1);
 }
 
+// Test 11: wstrb reaches the register file, bvalid waits for !reg_busy
+BOOST_FIXTURE_TEST_CASE(axi_slave_busy_holds_response, AXILiteSlaveFixture) {
+    reset();
+
+    dut->awaddr = 0x08;
+    dut->awvalid = 1;
+    dut->wdata = 0x44332211;
+    dut->wstrb = 0x05;
+    dut->wvalid = 1;
+    tick();
+    dut->awvalid = 0;
+    dut->wvalid = 0;
+    dut->wstrb = 0xF;
+
+    // Write cycle: latched byte enables presented with reg_wen
+    BOOST_CHECK_EQUAL(dut->reg_wen, 1);
+    BOOST_CHECK_EQUAL(dut->reg_wstrb, 0x05);
+
+    // Register file busy for 3 cycles: no response yet
+    dut->reg_busy = 1;
+    for (int i = 0; i < 3; i++) {
+        tick();
+        BOOST_CHECK_EQUAL(dut->bvalid, 0);
+    }
+
+    dut->reg_busy = 0;
+    tick();
+    BOOST_CHECK_EQUAL(dut->bvalid, 1);
+    BOOST_CHECK_EQUAL(dut->bresp, AXI_RESP_OKAY);
+    tick();
+    BOOST_CHECK_EQUAL(dut->bvalid, 0);
+}
+
+// Pipelined build: requests are accepted combinationally, so the
+// handshakes are sampled before the edge rather than after it
+struct AXILiteSlavePipelinedFixture : DutDriver<Vaxi_lite_slave_if_pipelined> {
+    // Zero-wait register file model: reg_rdata = pattern | word address
+    static constexpr uint32_t REG_PATTERN = 0xA5000000;
+
+    // What the slave presented on one accept cycle
+    struct Cycle {
+        bool aw;
+        bool ar;
+        bool wen;
+        bool ren;
+        uint8_t addr;
+        uint32_t wdata;
+    };
+
+    AXILiteSlavePipelinedFixture() {
+        dut->awaddr = 0;
+        dut->awvalid = 0;
+        dut->wdata = 0;
+        dut->wstrb = 0xF;
+        dut->wvalid = 0;
+        dut->bready = 1;
+        dut->araddr = 0;
+        dut->arvalid = 0;
+        dut->rready = 1;
+        dut->reg_rdata = 0;
+        dut->reg_error = 0;
+        dut->reg_busy = 0;
+    }
+
+    void reset() {
+        dut->awvalid = 0;
+        dut->wvalid = 0;
+        dut->arvalid = 0;
+        dut->bready = 1;
+        dut->rready = 1;
+        pulse_reset();
+    }
+
+    // Settle the current inputs, record the accept cycle, then clock
+    Cycle step() {
+        dut->eval();
+        dut->reg_rdata = REG_PATTERN | dut->reg_addr;
+        dut->eval();
+        Cycle c{dut->awready && dut->wready, (bool)dut->arready,
+                (bool)dut->reg_wen, (bool)dut->reg_ren,
+                dut->reg_addr, dut->reg_wdata};
+        tick();
+        return c;
+    }
+};
+
+// Test 12: Pipelined back-to-back reads, one per cycle
+BOOST_FIXTURE_TEST_CASE(axi_slave_pipelined_read_burst, AXILiteSlavePipelinedFixture) {
+    reset();
+
+    dut->arvalid = 1;
+    for (uint32_t i = 0; i < 8; i++) {
+        dut->araddr = i * 4;
+        Cycle c = step();
+
+        // Accepted on the cycle it is presented, rvalid on the next edge
+        BOOST_CHECK(c.ar);
+        BOOST_CHECK(c.ren);
+        BOOST_CHECK_EQUAL(c.addr, i);
+        BOOST_CHECK_EQUAL(dut->rvalid, 1);
+        BOOST_CHECK_EQUAL(dut->rdata, REG_PATTERN | i);
+        BOOST_CHECK_EQUAL(dut->rresp, AXI_RESP_OKAY);
+    }
+
+    dut->arvalid = 0;
+    step();
+    BOOST_CHECK_EQUAL(dut->rvalid, 0);
+}
+
+// Test 13: Pipelined back-to-back writes, one per cycle
+BOOST_FIXTURE_TEST_CASE(axi_slave_pipelined_write_burst, AXILiteSlavePipelinedFixture) {
+    reset();
+
+    dut->awvalid = 1;
+    dut->wvalid = 1;
+    for (uint32_t i = 0; i < 8; i++) {
+        dut->awaddr = i * 4;
+        dut->wdata = 0x1000 + i;
+        Cycle c = step();
+
+        BOOST_CHECK(c.aw);
+        BOOST_CHECK(c.wen);
+        BOOST_CHECK(!c.ren);
+        BOOST_CHECK_EQUAL(c.addr, i);
+        BOOST_CHECK_EQUAL(c.wdata, 0x1000 + i);
+        BOOST_CHECK_EQUAL(dut->bvalid, 1);
+        BOOST_CHECK_EQUAL(dut->bresp, AXI_RESP_OKAY);
+    }
+
+    dut->awvalid = 0;
+    dut->wvalid = 0;
+    step();
+    BOOST_CHECK_EQUAL(dut->bvalid, 0);
+}
+
+// Test 14: Response back-pressure stalls accept; the next request goes in
+// on the same cycle the held response is handshaked
+BOOST_FIXTURE_TEST_CASE(axi_slave_pipelined_backpressure, AXILiteSlavePipelinedFixture) {
+    reset();
+
+    dut->rready = 0;
+    dut->arvalid = 1;
+    dut->araddr = 0x00;
+    BOOST_CHECK(step().ar);
+    BOOST_CHECK_EQUAL(dut->rvalid, 1);
+
+    // R slot occupied: second read waits, first response held
+    dut->araddr = 0x04;
+    for (int i = 0; i < 3; i++) {
+        BOOST_CHECK(!step().ar);
+        BOOST_CHECK_EQUAL(dut->rvalid, 1);
+        BOOST_CHECK_EQUAL(dut->rdata, REG_PATTERN | 0x0);
+    }
+
+    // Handshake and accept in one cycle
+    dut->rready = 1;
+    BOOST_CHECK(step().ar);
+    BOOST_CHECK_EQUAL(dut->rvalid, 1);
+    BOOST_CHECK_EQUAL(dut->rdata, REG_PATTERN | 0x1);
+    dut->arvalid = 0;
+
+    // Same for the B channel
+    dut->bready = 0;
+    dut->awvalid = 1;
+    dut->wvalid = 1;
+    dut->awaddr = 0x08;
+    BOOST_CHECK(step().aw);
+    dut->awaddr = 0x0C;
+    BOOST_CHECK(!step().aw);
+    BOOST_CHECK_EQUAL(dut->bvalid, 1);
+    dut->bready = 1;
+    Cycle c = step();
+    BOOST_CHECK(c.aw);
+    BOOST_CHECK_EQUAL(c.addr, 0x3);
+    BOOST_CHECK_EQUAL(dut->bvalid, 1);
+}
+
+// Test 15: Concurrent read and write requests alternate on reg_addr
+BOOST_FIXTURE_TEST_CASE(axi_slave_pipelined_rw_alternate, AXILiteSlavePipelinedFixture) {
+    reset();
+
+    dut->awaddr = 0x08;
+    dut->wdata = 0x12345678;
+    dut->awvalid = 1;
+    dut->wvalid = 1;
+    dut->araddr = 0x04;
+    dut->arvalid = 1;
+
+    int writes = 0;
+    int reads = 0;
+    bool last_was_write = true;  // Reads win the first contended cycle
+    for (int i = 0; i < 8; i++) {
+        Cycle c = step();
+
+        // Exactly one access per cycle, never both
+        BOOST_CHECK(c.wen != c.ren);
+        BOOST_CHECK(c.wen != last_was_write);
+        BOOST_CHECK_EQUAL(c.addr, c.wen ? 0x2 : 0x1);
+        last_was_write = c.wen;
+        writes += c.wen;
+        reads += c.ren;
+    }
+
+    BOOST_CHECK_EQUAL(writes, 4);
+    BOOST_CHECK_EQUAL(reads, 4);
+}
+
+// Test 16: Write during reg_busy holds bvalid and later writes, reads flow
+BOOST_FIXTURE_TEST_CASE(axi_slave_pipelined_busy, AXILiteSlavePipelinedFixture) {
+    reset();
+
+    dut->awaddr = 0x08;
+    dut->wdata = 0x44332211;
+    dut->wstrb = 0x07;
+    dut->awvalid = 1;
+    dut->wvalid = 1;
+    dut->reg_busy = 1;   // Register file starts unpacking on this write
+    BOOST_CHECK(step().aw);
+    BOOST_CHECK_EQUAL(dut->bvalid, 0);
+
+    // Next write waits; a read goes through meanwhile
+    dut->awaddr = 0x0C;
+    dut->araddr = 0x04;
+    dut->arvalid = 1;
+    Cycle c = step();
+    BOOST_CHECK(!c.aw);
+    BOOST_CHECK(c.ar);
+    BOOST_CHECK_EQUAL(dut->rvalid, 1);
+    dut->arvalid = 0;
+    BOOST_CHECK(!step().aw);
+    BOOST_CHECK_EQUAL(dut->bvalid, 0);
+
+    // Busy drops: response for the first write, then the second is accepted
+    dut->reg_busy = 0;
+    BOOST_CHECK(!step().aw);
+    BOOST_CHECK_EQUAL(dut->bvalid, 1);
+    c = step();
+    BOOST_CHECK(c.aw);
+    BOOST_CHECK_EQUAL(c.addr, 0x3);
+    BOOST_CHECK_EQUAL(dut->bvalid, 1);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
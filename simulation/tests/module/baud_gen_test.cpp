@@ -12,50 +12,39 @@
  * - Tick frequency accuracy
  * - Timing characteristics (pulse width, period)
  * - Standard baud rate divisors (115200, 9600, etc.)
+ * - Fractional divisor (baud_frac): period stretching and accumulator
+ * - Rate sweep: achieved rate and error %, integer vs fractional divisor
+ * - Phase restart: next tick one period after the restart, fraction
+ *   sequence as after enable
  */
 
 #include "Vbaud_gen.h"
 #include <boost/test/unit_test.hpp>
 #include <verilated.h>
+#include "dut_driver.h"
+#include <cmath>
+#include <cstdio>
 #include <vector>
 
-BOOST_AUTO_TEST_SUITE(BaudGen_ModuleTests)
+DUT_DRIVER_PORTS(Vbaud_gen, uart_clk, rst_n);
 
-struct BaudGenFixture {
-    Vbaud_gen* dut;
-    int cycle_count;
+BOOST_AUTO_TEST_SUITE(BaudGen_ModuleTests)
 
+struct BaudGenFixture : DutDriver<Vbaud_gen> {
     BaudGenFixture() {
-        dut = new Vbaud_gen;
-        cycle_count = 0;
-
         // Initialize inputs
-        dut->uart_clk = 0;
-        dut->rst_n = 0;
         dut->baud_divisor = 0;
+        dut->baud_frac = 0;
         dut->enable = 0;
-    }
-
-    ~BaudGenFixture() {
-        delete dut;
-    }
-
-    void tick() {
-        dut->uart_clk = 0;
-        dut->eval();
-        dut->uart_clk = 1;
-        dut->eval();
-        cycle_count++;
+        dut->restart = 0;
     }
 
     void reset() {
-        dut->rst_n = 0;
         dut->enable = 0;
+        dut->restart = 0;
         dut->baud_divisor = 0;
-        for (int i = 0; i < 5; i++) tick();
-        dut->rst_n = 1;
-        tick();
-        cycle_count = 0;  // Reset cycle counter after reset
+        dut->baud_frac = 0;
+        pulse_reset();
     }
 
     // Helper: Count ticks over N cycles
@@ -79,6 +68,17 @@ struct BaudGenFixture {
         } while (!dut->baud_tick && cycles < 1000);
         return cycles;
     }
+
+    // Helper: Cycles taken by the next n ticks (divisor/fraction already set)
+    uint64_t cycles_for_ticks(int n) {
+        uint64_t cycles = 0;
+        for (int ticks = 0; ticks < n; ) {
+            tick();
+            cycles++;
+            if (dut->baud_tick) ticks++;
+        }
+        return cycles;
+    }
 };
 
 // Test 1: Reset state
@@ -350,4 +350,115 @@ BOOST_FIXTURE_TEST_CASE(baud_gen_reset_during_operation, BaudGenFixture) {
     BOOST_CHECK_EQUAL(dut->baud_tick, 1);
 }
 
+// Test 15: Fractional divisor stretches one period per accumulator carry
+BOOST_FIXTURE_TEST_CASE(baud_gen_fractional_period, BaudGenFixture) {
+    reset();
+
+    // 2 + 32/64: periods alternate 2, 3 (carry on every second tick)
+    dut->baud_divisor = 2;
+    dut->baud_frac = 32;
+    dut->enable = 1;
+
+    std::vector<int> periods;
+    for (int i = 0; i < 6; i++) {
+        periods.push_back(cycles_until_tick());
+    }
+    std::vector<int> expected = {2, 3, 2, 3, 2, 3};
+    BOOST_CHECK_EQUAL_COLLECTIONS(periods.begin(), periods.end(),
+                                  expected.begin(), expected.end());
+
+    // 4 + 16/64: one stretched period in four, 64 ticks take 4*64 + 16
+    reset();
+    dut->baud_divisor = 4;
+    dut->baud_frac = 16;
+    dut->enable = 1;
+    BOOST_CHECK_EQUAL(cycles_for_ticks(64), 4u * 64 + 16);
+
+    // Full fraction at divisor=1: 1 + 63/64, 64 ticks take 127 cycles
+    reset();
+    dut->baud_divisor = 1;
+    dut->baud_frac = 63;
+    dut->enable = 1;
+    BOOST_CHECK_EQUAL(cycles_for_ticks(64), 127u);
+
+    // Disabling clears the accumulator: pattern restarts from the top
+    reset();
+    dut->baud_divisor = 2;
+    dut->baud_frac = 32;
+    dut->enable = 1;
+    BOOST_CHECK_EQUAL(cycles_until_tick(), 2);  // acc 0 -> 32
+    dut->enable = 0;
+    tick();
+    dut->enable = 1;
+    BOOST_CHECK_EQUAL(cycles_until_tick(), 2);  // acc 0 again, no carry
+    BOOST_CHECK_EQUAL(cycles_until_tick(), 3);
+}
+
+// Test 16: Rate sweep - achieved baud rate and error, integer vs fractional
+// Reports each setting at a 48 MHz uart_clk, a clock that does not divide
+// the standard rates; the fractional divisor must stay within 1%
+BOOST_FIXTURE_TEST_CASE(baud_gen_fractional_rate_sweep, BaudGenFixture) {
+    const double clk_hz = 48e6;
+    const double bauds[] = {115200, 230400, 460800, 921600, 1000000,
+                            1500000, 2000000, 3000000};
+    const int TICKS = 64 * 16;  // Whole accumulator cycles, 64 bit times
+
+    for (double baud : bauds) {
+        double ideal = clk_hz / (16.0 * baud);                  // Cycles per tick
+        unsigned div_int = (unsigned)std::lround(ideal);
+        unsigned scaled = (unsigned)std::lround(ideal * 64.0);  // div*64 + frac
+        unsigned div = scaled >> 6;
+        unsigned frac = scaled & 0x3F;
+
+        double achieved[2];
+        const unsigned settings[2][2] = {{div_int, 0}, {div, frac}};
+        for (int k = 0; k < 2; k++) {
+            reset();
+            dut->baud_divisor = settings[k][0];
+            dut->baud_frac = settings[k][1];
+            dut->enable = 1;
+            uint64_t cycles = cycles_for_ticks(TICKS);
+            achieved[k] = clk_hz * TICKS / (16.0 * cycles);
+        }
+
+        double err_int = 100.0 * (achieved[0] - baud) / baud;
+        double err_frac = 100.0 * (achieved[1] - baud) / baud;
+        char line[160];
+        std::snprintf(line, sizeof(line),
+                      "%8.0f baud: int div=%-3u %9.0f (%+7.3f%%)  "
+                      "frac div=%u+%2u/64 %9.0f (%+7.3f%%)",
+                      baud, div_int, achieved[0], err_int,
+                      div, frac, achieved[1], err_frac);
+        BOOST_TEST_MESSAGE(line);
+
+        BOOST_CHECK_LT(std::fabs(err_frac), 1.0);
+        BOOST_CHECK_LE(std::fabs(err_frac), std::fabs(err_int) + 1e-9);
+    }
+}
+
+
+// Test 17: Restart starts a fresh period mid-count, fraction included
+BOOST_FIXTURE_TEST_CASE(baud_gen_restart_phase, BaudGenFixture) {
+    // Reference: periods right after enable (divisor 5 + 21/64)
+    reset();
+    dut->baud_divisor = 5;
+    dut->baud_frac = 21;
+    dut->enable = 1;
+    std::vector<int> ref;
+    for (int i = 0; i < 8; i++) ref.push_back(cycles_until_tick());
+
+    // Restart part way through a period: the restart cycle is the first of
+    // the new one, then the same sequence as after enable
+    for (int offset : {1, 3, 4}) {
+        for (int i = 0; i < offset; i++) tick();
+        dut->restart = 1;
+        tick();
+        dut->restart = 0;
+        BOOST_CHECK_EQUAL(1 + cycles_until_tick(), ref[0]);
+        for (int i = 1; i < 8; i++) {
+            BOOST_CHECK_EQUAL(cycles_until_tick(), ref[i]);
+        }
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
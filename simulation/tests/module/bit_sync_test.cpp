@@ -13,42 +13,21 @@
 #include "Vbit_sync.h"
 #include <boost/test/unit_test.hpp>
 #include <verilated.h>
+#include "dut_driver.h"
 
-BOOST_AUTO_TEST_SUITE(BitSync_ModuleTests)
+DUT_DRIVER_PORTS(Vbit_sync, clk_dst, rst_n_dst);
 
-struct BitSyncFixture {
-    Vbit_sync* dut;
-    int cycle_count;
+BOOST_AUTO_TEST_SUITE(BitSync_ModuleTests)
 
+struct BitSyncFixture : DutDriver<Vbit_sync> {
     BitSyncFixture() {
-        dut = new Vbit_sync;
-        cycle_count = 0;
-
         // Initialize inputs
-        dut->clk_dst = 0;
-        dut->rst_n_dst = 0;
         dut->data_in = 0;
     }
 
-    ~BitSyncFixture() {
-        delete dut;
-    }
-
-    void tick() {
-        dut->clk_dst = 0;
-        dut->eval();
-        dut->clk_dst = 1;
-        dut->eval();
-        cycle_count++;
-    }
-
     void reset() {
-        dut->rst_n_dst = 0;
         dut->data_in = 0;
-        for (int i = 0; i < 5; i++) tick();
-        dut->rst_n_dst = 1;
-        tick();
-        cycle_count = 0;  // Reset cycle counter after reset
+        pulse_reset();
     }
 };
 
@@ -0,0 +1,187 @@
+/*
+ * Sim Mailbox Tests
+ *
+ * Checks the shared-memory register mailbox (sim_mailbox.h) with a
+ * register array standing in for the simulator, server and host in one
+ * process on two threads
+ *
+ * Test Coverage:
+ * - Requests answered in order across ring wrap, batches larger than the
+ *   ring refused past MAILBOX_SLOTS outstanding
+ * - Doorbell only rung while the server announced sleep
+ * - irq level published to wait_irq(); a closed server releases a
+ *   blocked host
+ */
+
+#include <boost/test/unit_test.hpp>
+#include "sim_mailbox.h"
+#include <poll.h>
+#include <unistd.h>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+std::string test_mailbox_name(const char* tag) {
+    return "/uart_mbox_" + std::string(tag) + "_" + std::to_string(getpid());
+}
+
+// 16 registers; reads of 0x3C answer SLVERR
+MailboxResponse fake_access(std::vector<uint32_t>& regs, const MailboxRequest& req, uint64_t cycle) {
+    MailboxResponse rsp{0, 0, cycle};
+    if (req.addr >= 0x3C) {
+        rsp.resp = 2;
+    } else if (req.op == MAILBOX_WRITE) {
+        regs[req.addr >> 2] = req.data;
+    } else {
+        rsp.data = regs[req.addr >> 2];
+    }
+    return rsp;
+}
+
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(SimMailbox_ModuleTests)
+
+// Test 1: Batches in order, ring wrap and the outstanding limit
+BOOST_AUTO_TEST_CASE(sim_mailbox_batches) {
+    std::string name = test_mailbox_name("batch");
+    MailboxServer server;
+    BOOST_REQUIRE(server.create(name));
+
+    std::atomic<bool> stop(false);
+    std::atomic<uint64_t> served(0);
+    std::thread sim([&] {
+        std::vector<uint32_t> regs(16, 0);
+        uint64_t cycle = 0;
+        while (!stop) {
+            served += server.serve([&](const MailboxRequest& r) { return fake_access(regs, r, ++cycle); });
+        }
+    });
+
+    MailboxClient host;
+    BOOST_REQUIRE(host.open(name));
+
+    // Fill the ring unpublished: the slot past MAILBOX_SLOTS is refused
+    for (uint32_t i = 0; i < MAILBOX_SLOTS; i++) {
+        BOOST_REQUIRE(host.post_write((i % 8) << 2, i));
+    }
+    BOOST_CHECK(!host.post_read(0));
+    uint64_t last_cycle = 0;
+    for (uint32_t i = 0; i < MAILBOX_SLOTS; i++) {
+        MailboxResponse rsp;
+        BOOST_REQUIRE(host.next(rsp, 2000));
+        BOOST_CHECK_EQUAL(rsp.resp, 0u);
+        BOOST_CHECK_GT(rsp.cycle, last_cycle);
+        last_cycle = rsp.cycle;
+    }
+    BOOST_CHECK_EQUAL(host.outstanding(), 0u);
+
+    // Mixed batches wrapping the ring several times
+    for (uint32_t round = 0; round < 7; round++) {
+        for (uint32_t i = 0; i < 100; i++) {
+            BOOST_REQUIRE(host.post_write(0x20, round * 1000 + i));
+            BOOST_REQUIRE(host.post_read(0x20));
+        }
+        BOOST_REQUIRE(host.post_read(0x3C));
+        host.flush();
+        for (uint32_t i = 0; i < 100; i++) {
+            MailboxResponse wr, rd;
+            BOOST_REQUIRE(host.next(wr, 2000));
+            BOOST_REQUIRE(host.next(rd, 2000));
+            BOOST_CHECK_EQUAL(rd.data, round * 1000 + i);
+        }
+        MailboxResponse err;
+        BOOST_REQUIRE(host.next(err, 2000));
+        BOOST_CHECK_EQUAL(err.resp, 2u);
+    }
+
+    uint32_t value = 0;
+    BOOST_CHECK(host.write(0x04, 0xCAFEF00D));
+    BOOST_CHECK(host.read(0x04, value));
+    BOOST_CHECK_EQUAL(value, 0xCAFEF00Du);
+    BOOST_CHECK(!host.read(0x3C, value));
+
+    // Nothing posted: next() does not block
+    MailboxResponse none;
+    BOOST_CHECK(!host.next(none, 1000));
+
+    stop = true;
+    sim.join();
+    BOOST_CHECK_EQUAL(served.load(), MAILBOX_SLOTS + 7u * 201u + 3u);
+}
+
+// Test 2: The doorbell rings only for a sleeping server
+BOOST_AUTO_TEST_CASE(sim_mailbox_doorbell) {
+    std::string name = test_mailbox_name("bell");
+    MailboxServer server;
+    BOOST_REQUIRE(server.create(name));
+    MailboxClient host;
+    BOOST_REQUIRE(host.open(name));
+
+    struct pollfd pfd = {server.doorbell_fd(), POLLIN, 0};
+
+    // Awake: publishing leaves the FIFO empty
+    BOOST_REQUIRE(host.post_read(0));
+    host.flush();
+    BOOST_CHECK_EQUAL(poll(&pfd, 1, 0), 0);
+    BOOST_CHECK_EQUAL(server.pending(), 1u);
+
+    // Request already pending: the server must not go to sleep
+    BOOST_CHECK(!server.prepare_sleep());
+    std::vector<uint32_t> regs(16, 0);
+    BOOST_CHECK_EQUAL(server.serve([&](const MailboxRequest& r) { return fake_access(regs, r, 1); }), 1u);
+    MailboxResponse rsp;
+    BOOST_REQUIRE(host.next(rsp, 0));
+
+    // Asleep: the flush wakes poll(), wake() drains the FIFO
+    BOOST_REQUIRE(server.prepare_sleep());
+    BOOST_REQUIRE(host.post_write(0x08, 5));
+    host.flush();
+    BOOST_CHECK_EQUAL(poll(&pfd, 1, 1000), 1);
+    server.wake();
+    BOOST_CHECK_EQUAL(poll(&pfd, 1, 0), 0);
+    BOOST_CHECK_EQUAL(server.serve([&](const MailboxRequest& r) { return fake_access(regs, r, 2); }), 1u);
+    BOOST_REQUIRE(host.next(rsp, 0));
+    BOOST_CHECK_EQUAL(regs[2], 5u);
+}
+
+// Test 3: irq level and cycle, and close() releasing a waiting host
+BOOST_AUTO_TEST_CASE(sim_mailbox_irq_and_close) {
+    std::string name = test_mailbox_name("irq");
+    MailboxServer server;
+    BOOST_REQUIRE(server.create(name));
+    MailboxClient host;
+    BOOST_REQUIRE(host.open(name));
+    BOOST_CHECK(!host.irq());
+    BOOST_CHECK(!host.wait_irq(true, 20));
+
+    std::thread sim([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        server.publish(true, 1234);
+    });
+    BOOST_CHECK(host.wait_irq(true, 2000));
+    sim.join();
+    BOOST_CHECK(host.irq());
+    BOOST_CHECK_EQUAL(host.cycle(), 1234u);
+
+    // A request nobody serves: close() ends the wait
+    BOOST_REQUIRE(host.post_read(0));
+    std::thread closer([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        server.close();
+    });
+    MailboxResponse rsp;
+    BOOST_CHECK(!host.next(rsp, 5000));
+    closer.join();
+    BOOST_CHECK(!host.connected());
+
+    // Gone for new hosts too
+    MailboxClient late;
+    BOOST_CHECK(!late.open(name));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
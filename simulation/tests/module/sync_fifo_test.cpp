@@ -19,42 +19,27 @@
 #include "Vsync_fifo.h"
 #include <boost/test/unit_test.hpp>
 #include <verilated.h>
+#include "dut_driver.h"
 #include <vector>
 #include <random>
 
+DUT_DRIVER_PORTS(Vsync_fifo, clk, rst_n);
+
 BOOST_AUTO_TEST_SUITE(SyncFIFO_ModuleTests)
 
-struct SyncFIFOFixture {
-    Vsync_fifo* dut;
+struct SyncFIFOFixture : DutDriver<Vsync_fifo> {
     static const int DEPTH = 8;  // Default FIFO depth
 
     SyncFIFOFixture() {
-        dut = new Vsync_fifo;
-        dut->clk = 0;
-        dut->rst_n = 0;
         dut->wr_en = 0;
         dut->wr_data = 0;
         dut->rd_en = 0;
     }
 
-    ~SyncFIFOFixture() {
-        delete dut;
-    }
-
-    void tick() {
-        dut->clk = 0;
-        dut->eval();
-        dut->clk = 1;
-        dut->eval();
-    }
-
     void reset() {
-        dut->rst_n = 0;
         dut->wr_en = 0;
         dut->rd_en = 0;
-        for (int i = 0; i < 5; i++) tick();
-        dut->rst_n = 1;
-        tick();
+        pulse_reset();
     }
 
     // Helper: Write single byte to FIFO
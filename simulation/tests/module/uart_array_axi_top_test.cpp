@@ -0,0 +1,332 @@
+/*
+ * uart_array_axi_top Module Tests
+ *
+ * Tests the multi-channel UART array behind one AXI-Lite slave
+ * (built with NUM_CHANNELS=4, NUM_BAUD_GENS=2)
+ *
+ * Test Coverage:
+ * - Reset state and INFO register
+ * - Channel page decode (per-channel register files)
+ * - Unmapped pages (SLVERR)
+ * - Per-channel TX and RX on the packed pin vectors
+ * - Shared baud generators (channel c follows channel c % NUM_BAUD_GENS),
+ *   read-only BAUD_DIV/BAUD_FRAC on the non-leader channels
+ * - IRQ_STATUS aggregation and IRQ_MASK gating
+ */
+
+#include "Vuart_array_axi_top.h"
+#include <boost/test/unit_test.hpp>
+#include <verilated.h>
+#include "dut_driver.h"
+#include <vector>
+
+DUT_DRIVER_PORTS(Vuart_array_axi_top, clk, rst_n);
+
+BOOST_AUTO_TEST_SUITE(UartArrayAXITop_ModuleTests)
+
+// Build configuration (simulation/CMakeLists.txt)
+constexpr unsigned NUM_CHANNELS  = 4;
+constexpr unsigned NUM_BAUD_GENS = 2;
+constexpr uint32_t ALL_CHANNELS  = (1u << NUM_CHANNELS) - 1;
+
+// Channel register offsets (byte-addressed, within a channel page)
+constexpr uint32_t ADDR_CTRL       = 0x00;
+constexpr uint32_t ADDR_STATUS     = 0x04;
+constexpr uint32_t ADDR_TX_DATA    = 0x08;
+constexpr uint32_t ADDR_RX_DATA    = 0x0C;
+constexpr uint32_t ADDR_BAUD_DIV   = 0x10;
+constexpr uint32_t ADDR_INT_ENABLE = 0x14;
+constexpr uint32_t ADDR_BAUD_FRAC  = 0x28;
+
+// Array registers (page NUM_CHANNELS)
+constexpr uint32_t PAGE_SIZE       = 0x40;
+constexpr uint32_t ARRAY_BASE      = PAGE_SIZE * NUM_CHANNELS;
+constexpr uint32_t ADDR_IRQ_STATUS = ARRAY_BASE + 0x0;
+constexpr uint32_t ADDR_IRQ_MASK   = ARRAY_BASE + 0x4;
+constexpr uint32_t ADDR_INFO       = ARRAY_BASE + 0x8;
+
+// Status bits
+constexpr uint32_t STATUS_RX_EMPTY = 1u << 2;
+
+// AXI response codes
+constexpr uint8_t AXI_RESP_OKAY   = 0b00;
+constexpr uint8_t AXI_RESP_SLVERR = 0b10;
+
+// Byte address of register `reg` in channel `ch`
+constexpr uint32_t ch_addr(unsigned ch, uint32_t reg) {
+    return PAGE_SIZE * ch + reg;
+}
+
+struct UartArrayFixture : DutDriver<Vuart_array_axi_top> {
+    uint8_t last_bresp;
+    uint8_t last_rresp;
+
+    UartArrayFixture() {
+        last_bresp = AXI_RESP_OKAY;
+        last_rresp = AXI_RESP_OKAY;
+
+        // Serial inputs idle high, clear to send
+        dut->uart_rx = ALL_CHANNELS;
+        dut->uart_cts_n = 0;
+
+        // AXI-Lite channels idle, responses always accepted
+        dut->awaddr = 0;
+        dut->awvalid = 0;
+        dut->wdata = 0;
+        dut->wstrb = 0xF;
+        dut->wvalid = 0;
+        dut->bready = 1;
+        dut->araddr = 0;
+        dut->arvalid = 0;
+        dut->rready = 1;
+
+        // AXI-Stream ports idle (register access only)
+        dut->s_axis_tdata = 0;
+        dut->s_axis_tvalid = 0;
+        dut->m_axis_tready = 0;
+    }
+
+    void reset() {
+        dut->awvalid = 0;
+        dut->wvalid = 0;
+        dut->arvalid = 0;
+        dut->uart_rx = ALL_CHANNELS;
+        pulse_reset();
+    }
+
+    // Helper: AXI write transaction (response kept in last_bresp)
+    void axi_write(uint32_t addr, uint32_t data) {
+        dut->awaddr = addr;
+        dut->awvalid = 1;
+        dut->wdata = data;
+        dut->wvalid = 1;
+
+        while (!(dut->awready && dut->wready)) tick();
+
+        dut->awvalid = 0;
+        dut->wvalid = 0;
+        tick();
+
+        while (!dut->bvalid) tick();
+        last_bresp = dut->bresp;
+        tick();
+    }
+
+    // Helper: AXI read transaction (response kept in last_rresp)
+    uint32_t axi_read(uint32_t addr) {
+        dut->araddr = addr;
+        dut->arvalid = 1;
+
+        while (!dut->arready) tick();
+
+        dut->arvalid = 0;
+        tick();
+
+        while (!dut->rvalid) tick();
+        uint32_t data = dut->rdata;
+        last_rresp = dut->rresp;
+        tick();
+
+        return data;
+    }
+
+    bool tx_line(unsigned ch) { return (dut->uart_tx >> ch) & 1; }
+
+    void set_rx_line(unsigned ch, uint8_t bit) {
+        if (bit) dut->uart_rx |= (1u << ch);
+        else     dut->uart_rx &= ~(1u << ch);
+    }
+
+    // Helper: Length of the next low pulse on channel ch's uart_tx
+    unsigned measure_low_pulse(unsigned ch, unsigned timeout) {
+        BOOST_REQUIRE(run_until([&] { return !tx_line(ch); }, timeout));
+        unsigned cycles = 0;
+        while (!tx_line(ch) && cycles < timeout) {
+            tick();
+            cycles++;
+        }
+        return cycles;
+    }
+};
+
+// Test 1: Reset state
+BOOST_FIXTURE_TEST_CASE(uart_array_reset_state, UartArrayFixture) {
+    reset();
+
+    BOOST_CHECK_EQUAL(dut->uart_tx, ALL_CHANNELS);  // All lines idle high
+    BOOST_CHECK_EQUAL(dut->irq, 0);
+    BOOST_CHECK_EQUAL(dut->ch_irq, 0);
+
+    BOOST_CHECK_EQUAL(axi_read(ADDR_INFO), (NUM_BAUD_GENS << 8) | NUM_CHANNELS);
+    BOOST_CHECK_EQUAL(axi_read(ADDR_IRQ_MASK), ALL_CHANNELS);
+    BOOST_CHECK_EQUAL(axi_read(ADDR_IRQ_STATUS), 0u);
+
+    for (unsigned ch = 0; ch < NUM_CHANNELS; ch++) {
+        BOOST_CHECK_EQUAL(axi_read(ch_addr(ch, ADDR_BAUD_DIV)), 0x0004u);
+        BOOST_CHECK_EQUAL(axi_read(ch_addr(ch, ADDR_CTRL)), 0u);
+        BOOST_CHECK_EQUAL(last_rresp, AXI_RESP_OKAY);
+    }
+}
+
+// Test 2: Each page reaches its own channel's register file
+BOOST_FIXTURE_TEST_CASE(uart_array_channel_decode, UartArrayFixture) {
+    reset();
+
+    for (unsigned ch = 0; ch < NUM_CHANNELS; ch++) {
+        axi_write(ch_addr(ch, ADDR_BAUD_DIV), 0x100 + ch);
+        BOOST_CHECK_EQUAL(last_bresp, AXI_RESP_OKAY);
+    }
+    // Non-leaders read their group leader's divisor
+    for (unsigned ch = 0; ch < NUM_CHANNELS; ch++) {
+        BOOST_CHECK_EQUAL(axi_read(ch_addr(ch, ADDR_BAUD_DIV)), 0x100u + ch % NUM_BAUD_GENS);
+    }
+
+    // A CTRL write lands on one channel only
+    axi_write(ch_addr(2, ADDR_CTRL), 0x3);
+    for (unsigned ch = 0; ch < NUM_CHANNELS; ch++) {
+        BOOST_CHECK_EQUAL(axi_read(ch_addr(ch, ADDR_CTRL)), ch == 2 ? 0x3u : 0u);
+    }
+}
+
+// Test 3: Pages above the array page respond SLVERR
+BOOST_FIXTURE_TEST_CASE(uart_array_unmapped_page, UartArrayFixture) {
+    reset();
+
+    uint32_t unmapped = ARRAY_BASE + PAGE_SIZE;
+
+    axi_write(unmapped, 0xFFFFFFFF);
+    BOOST_CHECK_EQUAL(last_bresp, AXI_RESP_SLVERR);
+
+    BOOST_CHECK_EQUAL(axi_read(unmapped), 0u);
+    BOOST_CHECK_EQUAL(last_rresp, AXI_RESP_SLVERR);
+
+    // No channel was touched
+    for (unsigned ch = 0; ch < NUM_CHANNELS; ch++) {
+        BOOST_CHECK_EQUAL(axi_read(ch_addr(ch, ADDR_CTRL)), 0u);
+    }
+
+    // Array page itself is mapped
+    axi_read(ADDR_INFO);
+    BOOST_CHECK_EQUAL(last_rresp, AXI_RESP_OKAY);
+}
+
+// Test 4: TX on one channel, the other lines stay idle
+BOOST_FIXTURE_TEST_CASE(uart_array_channel_tx, UartArrayFixture) {
+    reset();
+
+    // Channel 3 ticks from generator 1, set by channel 1's divisor
+    axi_write(ch_addr(1, ADDR_BAUD_DIV), 1);
+    axi_write(ch_addr(3, ADDR_CTRL), 0x1);  // TX_EN
+    axi_write(ch_addr(3, ADDR_TX_DATA), 0xA5);
+
+    const unsigned bit_cycles = 16;
+    BOOST_REQUIRE(run_until([&] { return !tx_line(3); }, 1000));
+
+    bool others_idle = true;
+    std::vector<uint8_t> bits = sample_bits(
+        [&] {
+            if ((dut->uart_tx & 0x7) != 0x7) others_idle = false;
+            return tx_line(3);
+        }, 10, bit_cycles, bit_cycles / 2);
+
+    BOOST_CHECK_EQUAL(bits[0], 0);  // Start
+    BOOST_CHECK_EQUAL(bits_to_byte({bits.begin() + 1, bits.begin() + 9}), 0xA5);
+    BOOST_CHECK_EQUAL(bits[9], 1);  // Stop
+    BOOST_CHECK(others_idle);
+}
+
+// Test 5: Channels share the group leader's baud generator
+BOOST_FIXTURE_TEST_CASE(uart_array_shared_baud, UartArrayFixture) {
+    reset();
+
+    axi_write(ch_addr(0, ADDR_BAUD_DIV), 1);  // Generator 0: channels 0, 2
+    axi_write(ch_addr(1, ADDR_BAUD_DIV), 2);  // Generator 1: channels 1, 3
+    axi_write(ch_addr(2, ADDR_BAUD_DIV), 8);  // Not a leader: ignored
+
+    // 0x00: start + 8 data bits low = 9 bit times
+    axi_write(ch_addr(2, ADDR_CTRL), 0x1);
+    axi_write(ch_addr(2, ADDR_TX_DATA), 0x00);
+    unsigned low = measure_low_pulse(2, 5000);
+    BOOST_CHECK_MESSAGE(low >= 9 * 16 - 2 && low <= 9 * 16 + 2,
+                        "channel 2 low pulse " << low << " cycles, expected ~144");
+
+    axi_write(ch_addr(3, ADDR_CTRL), 0x1);
+    axi_write(ch_addr(3, ADDR_TX_DATA), 0x00);
+    low = measure_low_pulse(3, 5000);
+    BOOST_CHECK_MESSAGE(low >= 9 * 32 - 4 && low <= 9 * 32 + 4,
+                        "channel 3 low pulse " << low << " cycles, expected ~288");
+}
+
+// Test 6: IRQ_STATUS aggregates per-channel interrupts, IRQ_MASK gates irq
+BOOST_FIXTURE_TEST_CASE(uart_array_irq_aggregation, UartArrayFixture) {
+    reset();
+
+    // TX_READY on channels 1 and 3 (TX enabled, FIFO not full)
+    for (unsigned ch : {1u, 3u}) {
+        axi_write(ch_addr(ch, ADDR_INT_ENABLE), 0x1);
+        axi_write(ch_addr(ch, ADDR_CTRL), 0x1);
+    }
+    run_cycles(4);
+
+    BOOST_CHECK_EQUAL(dut->ch_irq, 0xAu);
+    BOOST_CHECK_EQUAL(axi_read(ADDR_IRQ_STATUS), 0xAu);
+    BOOST_CHECK_EQUAL(dut->irq, 1);
+
+    // Mask channel 1: channel 3 still interrupts
+    axi_write(ADDR_IRQ_MASK, ALL_CHANNELS & ~0x2u);
+    BOOST_CHECK_EQUAL(axi_read(ADDR_IRQ_MASK), ALL_CHANNELS & ~0x2u);
+    BOOST_CHECK_EQUAL(dut->irq, 1);
+
+    // Mask both: irq drops, IRQ_STATUS is unmasked
+    axi_write(ADDR_IRQ_MASK, 0x5);
+    BOOST_CHECK_EQUAL(dut->irq, 0);
+    BOOST_CHECK_EQUAL(axi_read(ADDR_IRQ_STATUS), 0xAu);
+}
+
+// Test 7: RX on one channel's pin reaches only that channel
+BOOST_FIXTURE_TEST_CASE(uart_array_channel_rx, UartArrayFixture) {
+    reset();
+
+    axi_write(ch_addr(0, ADDR_BAUD_DIV), 1);  // Generator 0 (channel 2)
+    axi_write(ch_addr(2, ADDR_CTRL), 0x2);    // RX_EN
+
+    std::vector<uint8_t> bits = uart_frame_bits(0x3C);
+    bits.push_back(1);  // Idle guard bit
+    drive_bits([&](uint8_t bit) { set_rx_line(2, bit); }, bits, 16);
+
+    BOOST_CHECK_EQUAL(axi_read(ch_addr(2, ADDR_STATUS)) & STATUS_RX_EMPTY, 0u);
+    BOOST_CHECK_EQUAL(axi_read(ch_addr(2, ADDR_RX_DATA)) & 0xFF, 0x3Cu);
+
+    for (unsigned ch : {0u, 1u, 3u}) {
+        BOOST_CHECK(axi_read(ch_addr(ch, ADDR_STATUS)) & STATUS_RX_EMPTY);
+    }
+}
+
+// Test 8: Non-leader BAUD_DIV/BAUD_FRAC are read-only and show the leader's
+// Channel 3 follows generator 1: its own writes are ignored, reads track
+// channel 1, and its line runs at channel 1's rate.
+BOOST_FIXTURE_TEST_CASE(uart_array_non_leader_baud, UartArrayFixture) {
+    reset();
+
+    axi_write(ch_addr(1, ADDR_BAUD_DIV), 2);
+    axi_write(ch_addr(3, ADDR_BAUD_DIV), 8);
+    BOOST_CHECK_EQUAL(last_bresp, AXI_RESP_OKAY);
+    axi_write(ch_addr(3, ADDR_BAUD_FRAC), 0x20);
+    BOOST_CHECK_EQUAL(axi_read(ch_addr(3, ADDR_BAUD_DIV)), 2u);
+    BOOST_CHECK_EQUAL(axi_read(ch_addr(3, ADDR_BAUD_FRAC)), 0u);
+    BOOST_CHECK_EQUAL(last_rresp, AXI_RESP_OKAY);
+
+    // Leader writes show through
+    axi_write(ch_addr(1, ADDR_BAUD_FRAC), 0x10);
+    BOOST_CHECK_EQUAL(axi_read(ch_addr(3, ADDR_BAUD_FRAC)), 0x10u);
+    axi_write(ch_addr(1, ADDR_BAUD_FRAC), 0);
+
+    // 0x00: start + 8 data bits low = 9 bit times at divisor 2
+    axi_write(ch_addr(3, ADDR_CTRL), 0x1);
+    axi_write(ch_addr(3, ADDR_TX_DATA), 0x00);
+    unsigned low = measure_low_pulse(3, 5000);
+    BOOST_CHECK_MESSAGE(low >= 9 * 32 - 4 && low <= 9 * 32 + 4,
+                        "channel 3 low pulse " << low << " cycles, expected ~288");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
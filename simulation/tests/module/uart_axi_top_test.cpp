@@ -11,13 +11,24 @@
  * - Loopback test via AXI interface
  * - Interrupt generation
  * - Error handling
+ * - Idle fast-forward equivalence (PERF counters, pending RX timeout)
+ * - Packed TX_DATA/RX_DATA (several bytes per AXI transaction)
+ * - AXI-Stream TX/RX (CTRL.STREAM_EN): sustained throughput at line rate
+ * - Warm start and mid-traffic checkpoint equivalence (DutDriver images)
  */
 
 #include "Vuart_axi_top.h"
+#include "Vuart_axi_top___024root.h"
 #include <boost/test/unit_test.hpp>
 #include <verilated.h>
+#include "dut_driver.h"
+#include <cstdio>
+#include <string>
 #include <vector>
 
+DUT_DRIVER_PORTS(Vuart_axi_top, clk, rst_n);
+DUT_DRIVER_UART_REGS(Vuart_axi_top, uart_axi_top__DOT__uart_core__DOT__uart_regs_inst);
+
 BOOST_AUTO_TEST_SUITE(UartAXITop_ModuleTests)
 
 // Register offsets (byte-addressed for AXI)
@@ -28,23 +39,24 @@ constexpr uint32_t ADDR_RX_DATA    = 0x0C;
 constexpr uint32_t ADDR_BAUD_DIV   = 0x10;
 constexpr uint32_t ADDR_INT_ENABLE = 0x14;
 constexpr uint32_t ADDR_INT_STATUS = 0x18;
+constexpr uint32_t ADDR_PERF_CTRL  = 0x34;
+constexpr uint32_t ADDR_PERF_DATA  = 0x38;
 
 // AXI response codes
 constexpr uint8_t AXI_RESP_OKAY   = 0b00;
 constexpr uint8_t AXI_RESP_SLVERR = 0b10;
 
-struct UartAXITopFixture {
-    Vuart_axi_top* dut;
-    int cycle_count;
+struct UartAXITopFixture : DutDriver<Vuart_axi_top> {
+    uint32_t baud_divisor;  // Last value written to BAUD_DIV
+    uint32_t ticks_per_bit; // CTRL.OSR: 16, 8 or 4
 
     UartAXITopFixture() {
-        dut = new Vuart_axi_top;
-        cycle_count = 0;
+        baud_divisor = 4;  // BAUD_DIV reset value
+        ticks_per_bit = 16;
 
         // Initialize inputs
-        dut->clk = 0;
-        dut->rst_n = 0;
         dut->uart_rx = 1;  // Idle high
+        dut->uart_cts_n = 0;  // Clear to send (CTS_EN off by default)
 
         // AXI Write Address Channel
         dut->awaddr = 0;
@@ -64,32 +76,33 @@ struct UartAXITopFixture {
 
         // AXI Read Data Channel
         dut->rready = 1;  // Always ready
-    }
 
-    ~UartAXITopFixture() {
-        delete dut;
-    }
+        // AXI-Stream ports idle (register access only)
+        dut->s_axis_tdata = 0;
+        dut->s_axis_tvalid = 0;
+        dut->m_axis_tready = 0;
 
-    void tick() {
-        dut->clk = 0;
-        dut->eval();
-        dut->clk = 1;
-        dut->eval();
-        cycle_count++;
+        // Trace triggers (UART_TRACE_TRIGGER)
+        trace_trigger("irq", [this] { return dut->irq != 0; });
     }
 
     void reset() {
-        dut->rst_n = 0;
         dut->awvalid = 0;
         dut->wvalid = 0;
         dut->arvalid = 0;
         dut->bready = 1;
         dut->rready = 1;
         dut->uart_rx = 1;
-        for (int i = 0; i < 5; i++) tick();
-        dut->rst_n = 1;
-        tick();
-        cycle_count = 0;
+        cold_reset();
+    }
+
+    // Reset pulse and baud setup. Simulated, not warm-started: it is a few
+    // dozen cycles, and under ctest every case is its own process, so a
+    // per-process image would be written for one use
+    void cold_reset() {
+        pulse_reset();
+        baud_divisor = 4;
+        ticks_per_bit = 16;
 
         // Set baud divisor to 1 for simplified timing (16 clocks per bit)
         axi_write(ADDR_BAUD_DIV, 0x00000001);
@@ -121,6 +134,17 @@ struct UartAXITopFixture {
 
         // bready already asserted, response complete
         tick();
+
+        if (addr == ADDR_BAUD_DIV) baud_divisor = data & 0xFFFF;
+        if (addr == ADDR_CTRL) {
+            uint32_t osr = (data >> 4) & 0x3;
+            ticks_per_bit = (osr == 1) ? 8 : (osr == 2) ? 4 : 16;
+        }
+    }
+
+    // Helper: Clocks per bit on the serial lines (OSR x BAUD_DIV)
+    unsigned bit_cycles() const {
+        return ticks_per_bit * (baud_divisor ? baud_divisor : 1);
     }
 
     // Helper: AXI read transaction
@@ -150,46 +174,80 @@ struct UartAXITopFixture {
         return data;
     }
 
-    // Helper: Send UART frame on RX line
-    void send_uart_frame(uint8_t data) {
-        // Start bit
-        dut->uart_rx = 0;
-        for (int i = 0; i < 16; i++) tick();
-
-        // Data bits (LSB first)
-        for (int bit = 0; bit < 8; bit++) {
-            dut->uart_rx = (data >> bit) & 1;
-            for (int i = 0; i < 16; i++) tick();
+    // Helper: Packed TX (CTRL.PACK_EN set): up to 4 bytes per TX_DATA
+    // write, wstrb marking the valid lanes. Returns transactions used.
+    int axi_write_tx_packed(const std::vector<uint8_t>& data) {
+        int transactions = 0;
+        for (size_t i = 0; i < data.size(); i += 4) {
+            uint32_t word = 0;
+            uint8_t strb = 0;
+            for (size_t lane = 0; lane < 4 && i + lane < data.size(); lane++) {
+                word |= (uint32_t)data[i + lane] << (8 * lane);
+                strb |= 1u << lane;
+            }
+            axi_write(ADDR_TX_DATA, word, strb);
+            transactions++;
         }
+        return transactions;
+    }
 
-        // Stop bit
-        dut->uart_rx = 1;
-        for (int i = 0; i < 16; i++) tick();
+    // Helper: Packed RX (CTRL.PACK_EN set): one RX_DATA read, appends the
+    // returned bytes (count in [25:24]) and returns how many there were
+    unsigned axi_read_rx_packed(std::vector<uint8_t>& out) {
+        uint32_t word = axi_read(ADDR_RX_DATA);
+        unsigned count = (word >> 24) & 0x3;
+        for (unsigned i = 0; i < count; i++) {
+            out.push_back((word >> (8 * i)) & 0xFF);
+        }
+        return count;
+    }
+
+    // Helper: Quiescence probe for fast-forward: no AXI channel active,
+    // both serial lines high and uart_regs_quiescent()
+    bool uart_quiescent() {
+        if (dut->awvalid || dut->wvalid || dut->arvalid) return false;
+        if (dut->bvalid || dut->rvalid) return false;
+        if (!dut->uart_rx || !dut->uart_tx) return false;
+        return uart_regs_quiescent([this](uint8_t reg) { return axi_read((uint32_t)reg << 2); });
+    }
+
+    // Helper: Idle for n cycles (inputs static), skipping evaluation while
+    // quiescent. Cycle-exact with respect to simulating every clock.
+    void run_idle(uint64_t n) {
+        fast_forward(n, baud_divisor ? baud_divisor : 1,
+                     [this] { return uart_quiescent(); });
+    }
+
+    // Helper: Send UART frame on RX line
+    void send_uart_frame(uint8_t data) {
+        // Start bit, data bits (LSB first), stop bit: one bit time each
+        // (16 clocks at BAUD_DIV=1, 16x)
+        drive_bits([this](uint8_t bit) { dut->uart_rx = bit; },
+                   uart_frame_bits(data), bit_cycles());
 
         // Extra time for processing
-        for (int i = 0; i < 20; i++) tick();
+        run_cycles(20);
     }
 
     // Helper: Receive UART frame from TX line
     uint8_t receive_uart_frame() {
-        uint8_t data = 0;
-
         // Wait for start bit (falling edge)
-        int timeout = 1000;
-        while (dut->uart_tx && timeout-- > 0) tick();
-        if (timeout <= 0) return 0xFF;  // Timeout
+        if (!run_until([this] { return !dut->uart_tx; }, 1000)) {
+            return 0xFF;  // Timeout
+        }
 
         // Sample data bits at middle of each bit period
-        for (int bit = 0; bit < 8; bit++) {
-            int advance = (bit == 0) ? 24 : 16;
-            for (int i = 0; i < advance; i++) tick();
-            if (dut->uart_tx) data |= (1 << bit);
-        }
+        // With baud_divisor=1, each bit is 16 clocks (16 baud_ticks)
+        // Bit timing: Start[0-15], Bit0[16-31], Bit1[32-47], ...
+        // First sample 24 clocks in (middle of bit 0), then every 16
+        unsigned bit = bit_cycles();
+        std::vector<uint8_t> bits =
+            sample_bits([this] { return dut->uart_tx; }, 8, bit, bit + bit / 2);
 
         // Stop bit
-        for (int i = 0; i < 16; i++) tick();
+        run_cycles(bit);
 
-        return data;
+        return bits_to_byte(bits);
     }
 };
 
@@ -324,7 +382,7 @@ BOOST_FIXTURE_TEST_CASE(uart_axi_top_status_flags, UartAXITopFixture) {
     BOOST_CHECK_EQUAL((status >> 4) & 1, 1);  // TX_ACTIVE
 
     // Wait for transmission to complete
-    for (int i = 0; i < 200; i++) tick();
+    run_idle(200);
 
     // After transmission completes, TX should be idle and FIFO empty
     status = axi_read(ADDR_STATUS);
@@ -396,4 +454,267 @@ BOOST_FIXTURE_TEST_CASE(uart_axi_top_axi_responses, UartAXITopFixture) {
     tick();
 }
 
+// Test 11: Idle fast-forward is cycle-exact, PERF counters included
+BOOST_FIXTURE_TEST_CASE(uart_axi_top_idle_fast_forward, UartAXITopFixture) {
+    reset();
+    UartAXITopFixture ref;
+    ref.reset();
+
+    // Realistic divisor so the baud phase matters; RX only at first
+    auto configure = [](UartAXITopFixture& f) {
+        f.axi_write(ADDR_BAUD_DIV, 0x00000004);
+        f.axi_write(ADDR_CTRL, 0x00000002);
+    };
+    configure(*this);
+    configure(ref);
+
+    // Long idle gap: fast-forwarded here, fully simulated on ref
+    run_idle(10001);
+    ref.run_cycles(10001);
+    BOOST_CHECK_GT(skipped_cycles, 0u);
+    BOOST_CHECK_EQUAL(cycle_count, ref.cycle_count);
+
+    // TX_EN set: TX_STALLS counts every idle cycle, skipped ones included
+    axi_write(ADDR_CTRL, 0x00000003);
+    ref.axi_write(ADDR_CTRL, 0x00000003);
+    uint64_t skipped = skipped_cycles;
+    run_idle(5001);
+    ref.run_cycles(5001);
+    BOOST_CHECK_GT(skipped_cycles, skipped);
+    BOOST_CHECK_EQUAL(cycle_count, ref.cycle_count);
+
+    // Every counter (SEL 0-7) matches the fully simulated reference
+    auto perf = [](UartAXITopFixture& f) {
+        std::vector<uint32_t> counts;
+        f.axi_write(ADDR_PERF_CTRL, 0x00000100);  // SNAPSHOT
+        for (uint32_t sel = 0; sel < 8; sel++) {
+            f.axi_write(ADDR_PERF_CTRL, sel);
+            counts.push_back(f.axi_read(ADDR_PERF_DATA));
+        }
+        return counts;
+    };
+    std::vector<uint32_t> counts = perf(*this);
+    std::vector<uint32_t> ref_counts = perf(ref);
+    BOOST_CHECK_EQUAL_COLLECTIONS(counts.begin(), counts.end(),
+                                  ref_counts.begin(), ref_counts.end());
+    BOOST_CHECK_GT(counts[4], 5000u);  // TX_STALLS
+
+    // Start bit must leave on exactly the same cycle on both
+    auto start_tx = [](UartAXITopFixture& f) {
+        f.axi_write(ADDR_TX_DATA, 0x0000005A);
+        return f.run_until([&f] { return !f.dut->uart_tx; }, 1000);
+    };
+    BOOST_CHECK(start_tx(*this));
+    BOOST_CHECK(start_tx(ref));
+    BOOST_CHECK_EQUAL(cycle_count, ref.cycle_count);
+}
+
+// Test 12: Packed TX, 4 bytes per AXI write (partial last word via wstrb)
+BOOST_FIXTURE_TEST_CASE(uart_axi_top_packed_tx, UartAXITopFixture) {
+    reset();
+
+    axi_write(ADDR_CTRL, 0x00000005);  // TX_EN + PACK_EN
+
+    std::vector<uint8_t> data = {0x10, 0x21, 0x32, 0x43, 0x54, 0x65};
+    BOOST_CHECK_EQUAL(axi_write_tx_packed(data), 2);
+
+    for (uint8_t expected : data) {
+        uint8_t received = receive_uart_frame();
+        BOOST_CHECK_EQUAL(received, expected);
+    }
+    BOOST_CHECK_EQUAL(axi_read(ADDR_STATUS) & 0x1, 0x1);  // TX_EMPTY
+}
+
+// Test 13: Packed RX, up to 3 bytes plus count per AXI read
+BOOST_FIXTURE_TEST_CASE(uart_axi_top_packed_rx, UartAXITopFixture) {
+    reset();
+
+    axi_write(ADDR_CTRL, 0x00000006);  // RX_EN + PACK_EN
+    run_cycles(10);
+
+    std::vector<uint8_t> sent = {0xC1, 0xC2, 0xC3, 0xC4, 0xC5};
+    for (uint8_t byte : sent) {
+        send_uart_frame(byte);
+    }
+    run_cycles(10);
+
+    std::vector<uint8_t> received;
+    BOOST_CHECK_EQUAL(axi_read_rx_packed(received), 3u);
+    BOOST_CHECK_EQUAL(axi_read_rx_packed(received), 2u);
+    BOOST_CHECK_EQUAL(axi_read_rx_packed(received), 0u);  // Drained
+    BOOST_CHECK_EQUAL_COLLECTIONS(received.begin(), received.end(),
+                                  sent.begin(), sent.end());
+}
+
+// Test 14: Stream TX keeps uart_tx busy back to back at line rate
+BOOST_FIXTURE_TEST_CASE(uart_axi_top_stream_tx_line_rate, UartAXITopFixture) {
+    reset();
+    axi_write(ADDR_CTRL, 0x00000009);  // STREAM_EN + TX_EN
+
+    std::vector<uint8_t> sent;
+    for (int i = 0; i < 32; i++) sent.push_back((uint8_t)(i * 37 + 5));
+
+    // Source: s_axis always valid until every byte is accepted.
+    // Monitor: decode uart_tx frames (mid-bit sampling, 16 clocks per bit)
+    std::vector<uint8_t> received;
+    std::vector<uint64_t> starts;
+    size_t accepted = 0;
+    bool mon_busy = false;
+    unsigned mon_count = 0;
+    uint8_t mon_shift = 0;
+    uint64_t limit = cycle_count + sent.size() * 200 + 1000;
+    while (received.size() < sent.size() && cycle_count < limit) {
+        dut->s_axis_tvalid = accepted < sent.size();
+        dut->s_axis_tdata = dut->s_axis_tvalid ? sent[accepted] : 0;
+        dut->eval();
+        bool handshake = dut->s_axis_tvalid && dut->s_axis_tready;
+        tick();
+        if (handshake) accepted++;
+
+        if (!mon_busy) {
+            if (!dut->uart_tx) {
+                mon_busy = true;
+                mon_count = 0;
+                mon_shift = 0;
+                starts.push_back(cycle_count);
+            }
+            continue;
+        }
+        mon_count++;
+        if (mon_count < 24 || (mon_count - 8) % 16 != 0) continue;
+        unsigned index = (mon_count - 8) / 16;  // 1..8 data, 9 stop
+        if (index <= 8) {
+            if (dut->uart_tx) mon_shift |= (uint8_t)(1u << (index - 1));
+        } else {
+            BOOST_CHECK_EQUAL(dut->uart_tx, 1);  // Stop bit
+            received.push_back(mon_shift);
+            mon_busy = false;
+        }
+    }
+    dut->s_axis_tvalid = 0;
+
+    BOOST_REQUIRE_EQUAL(received.size(), sent.size());
+    BOOST_CHECK_EQUAL_COLLECTIONS(received.begin(), received.end(),
+                                  sent.begin(), sent.end());
+
+    // 160 clocks per frame at BAUD_DIV=1; uart_tx_path re-arms in 2 cycles
+    double per_byte = (double)(starts.back() - starts.front()) / (starts.size() - 1);
+    BOOST_TEST_MESSAGE("Stream TX: " << per_byte << " cycles/byte (line 160)");
+    BOOST_CHECK_GE(per_byte, 160.0);
+    BOOST_CHECK_LE(per_byte, 163.0);
+}
+
+// Test 15: Stream RX drains every frame at line rate, no overrun
+BOOST_FIXTURE_TEST_CASE(uart_axi_top_stream_rx_line_rate, UartAXITopFixture) {
+    reset();
+    axi_write(ADDR_CTRL, 0x0000000A);  // STREAM_EN + RX_EN
+
+    // Peer leaves one idle bit between frames (uart_rx re-arms after the
+    // full stop bit), 11 bits x 16 clocks per byte
+    std::vector<uint8_t> sent;
+    std::vector<uint8_t> line;
+    for (int i = 0; i < 32; i++) {
+        sent.push_back((uint8_t)(0xF0 - i * 7));
+        std::vector<uint8_t> bits = uart_frame_bits(sent.back());
+        line.insert(line.end(), bits.begin(), bits.end());
+        line.push_back(1);
+    }
+
+    // Sink always ready; more bytes than the FIFO holds, so the stream has
+    // to keep up for the transfer to complete without overrun
+    std::vector<uint8_t> received;
+    dut->m_axis_tready = 1;
+    uint64_t start = cycle_count;
+    for (uint8_t bit : line) {
+        dut->uart_rx = bit;
+        for (int c = 0; c < 16; c++) {
+            dut->eval();
+            if (dut->m_axis_tvalid) received.push_back(dut->m_axis_tdata);
+            tick();
+        }
+    }
+    dut->uart_rx = 1;
+    for (int c = 0; c < 200; c++) {
+        dut->eval();
+        if (dut->m_axis_tvalid) received.push_back(dut->m_axis_tdata);
+        tick();
+    }
+    dut->m_axis_tready = 0;
+    uint64_t cycles = cycle_count - start;
+
+    BOOST_CHECK_EQUAL_COLLECTIONS(received.begin(), received.end(),
+                                  sent.begin(), sent.end());
+    BOOST_TEST_MESSAGE("Stream RX: " << received.size() << " bytes in "
+                       << cycles << " cycles (line " << line.size() * 16 << ")");
+
+    uint32_t status = axi_read(ADDR_STATUS);
+    BOOST_CHECK_EQUAL((status >> 7) & 1, 0);  // No OVERRUN
+    BOOST_CHECK_EQUAL((status >> 2) & 1, 1);  // RX_EMPTY
+}
+
+// Test 16: Warm start (as the regressions use it) matches a cold reset
+// cycle for cycle; with --savable models a mid-traffic image resumes
+// identically
+BOOST_FIXTURE_TEST_CASE(uart_axi_top_warm_start, UartAXITopFixture) {
+    reset();
+    warm_start("uart_axi_top.reset", [this] { cold_reset(); });   // Saves
+    axi_write(ADDR_CTRL, 0x00000003);
+    warm_start("uart_axi_top.reset", [this] { cold_reset(); });   // Restores over a used model
+    baud_divisor = 1;
+    ticks_per_bit = 16;
+    UartAXITopFixture cold;
+    cold.cold_reset();
+    BOOST_CHECK_EQUAL(cycle_count, cold.cycle_count);
+    BOOST_CHECK_EQUAL(bit_cycles(), cold.bit_cycles());
+
+    auto traffic = [](UartAXITopFixture& f) {
+        f.axi_write(ADDR_CTRL, 0x00000003);
+        f.axi_write(ADDR_TX_DATA, 0x000000C3);
+        f.axi_write(ADDR_TX_DATA, 0x0000003C);
+    };
+    traffic(*this);
+    traffic(cold);
+    BOOST_CHECK_EQUAL(axi_read(ADDR_STATUS), cold.axi_read(ADDR_STATUS));
+
+    // Same line, cycle for cycle, halfway into the second frame
+    std::vector<uint8_t> line = uart_frame_bits(0xA6);
+    uint64_t span = 15 * bit_cycles();
+    for (uint64_t i = 0; i < span; i++) {
+        uint8_t rx = i / bit_cycles() < line.size() ? line[i / bit_cycles()] : 1;
+        dut->uart_rx = rx;
+        cold.dut->uart_rx = rx;
+        tick();
+        cold.tick();
+        BOOST_REQUIRE_EQUAL(dut->uart_tx, cold.dut->uart_tx);
+        BOOST_REQUIRE_EQUAL(dut->irq, cold.dut->irq);
+    }
+    BOOST_CHECK_EQUAL(cycle_count, cold.cycle_count);
+
+#ifdef DUT_DRIVER_SAVABLE
+    // Image mid-frame, resumed in a fresh fixture next to the original
+    std::string image = CheckpointCache::instance().reserve("uart_axi_top.test16");
+    BOOST_REQUIRE(!image.empty());
+    BOOST_REQUIRE(save_checkpoint(image, "host"));
+    UartAXITopFixture resumed;
+    std::string host;
+    BOOST_REQUIRE(resumed.restore_checkpoint(image, &host));
+    std::remove(image.c_str());
+    resumed.baud_divisor = baud_divisor;
+    resumed.ticks_per_bit = ticks_per_bit;
+    BOOST_CHECK_EQUAL(host, "host");
+    BOOST_CHECK_EQUAL(resumed.cycle_count, cycle_count);
+
+    for (uint64_t i = 0; i < 10 * bit_cycles(); i++) {
+        tick();
+        resumed.tick();
+        BOOST_REQUIRE_EQUAL(dut->uart_tx, resumed.dut->uart_tx);
+    }
+    BOOST_CHECK_EQUAL(axi_read(ADDR_RX_DATA) & 0xFF, 0xA6u);
+    BOOST_CHECK_EQUAL(resumed.axi_read(ADDR_RX_DATA) & 0xFF, 0xA6u);
+    BOOST_CHECK_EQUAL(axi_read(ADDR_STATUS), resumed.axi_read(ADDR_STATUS));
+#else
+    BOOST_TEST_MESSAGE("uart_axi_top not savable: checkpoint resume not checked");
+#endif
+}
+
 BOOST_AUTO_TEST_SUITE_END()
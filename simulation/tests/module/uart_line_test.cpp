@@ -0,0 +1,179 @@
+/*
+ * UART Line Model Tests
+ *
+ * Checks the packed testbench waveform encoder/decoder (uart_line.h)
+ * without a Verilated model
+ *
+ * Test Coverage:
+ * - Run append across 64-bit word boundaries
+ * - Level and falling-edge search, including cycle 0 and the tail word
+ * - Frame encoding timing for 16x / 8x / 4x and baud divisors
+ * - Decode round trip with idle gaps, glitches and bad stop bits
+ * - Fractional bit times (BAUD_FRAC): boundaries, no drift over a frame
+ * - Slice append (tail of a capture carried into the next one)
+ */
+
+#include <boost/test/unit_test.hpp>
+#include "uart_line.h"
+#include "dut_driver.h"
+#include <cstdint>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(UartLine_ModuleTests)
+
+// Test 1: Runs straddling word boundaries read back per cycle
+BOOST_AUTO_TEST_CASE(uart_line_append_runs) {
+    LineWave wave;
+    std::vector<bool> ref;
+    const size_t runs[] = {1, 62, 3, 64, 0, 129, 7, 200, 1};
+    bool level = false;
+    for (size_t n : runs) {
+        wave.append(level, n);
+        ref.insert(ref.end(), n, level);
+        level = !level;
+    }
+    for (int i = 0; i < 70; i++) {
+        wave.push_back(i % 3 == 0);
+        ref.push_back(i % 3 == 0);
+    }
+
+    BOOST_REQUIRE_EQUAL(wave.size(), ref.size());
+    for (size_t i = 0; i < ref.size(); i++) {
+        BOOST_REQUIRE_EQUAL(wave.get(i), ref[i]);
+    }
+}
+
+// Test 2: Level and edge search
+BOOST_AUTO_TEST_CASE(uart_line_find_edges) {
+    LineWave wave;
+    wave.append(0, 5);      // Low from cycle 0: an edge after the idle line
+    wave.append(1, 120);
+    wave.append(0, 10);     // Edge at 125, in the second word
+    wave.append(1, 3);      // Tail word; bits past size() are ignored
+
+    BOOST_CHECK_EQUAL(wave.find_fall(0), 0u);
+    BOOST_CHECK_EQUAL(wave.find_fall(1), 125u);
+    BOOST_CHECK_EQUAL(wave.find_fall(126), LineWave::npos);
+    BOOST_CHECK_EQUAL(wave.find_level(0, true), 5u);
+    BOOST_CHECK_EQUAL(wave.find_level(5, false), 125u);
+    BOOST_CHECK_EQUAL(wave.find_level(135, false), LineWave::npos);
+    BOOST_CHECK_EQUAL(wave.find_level(125, true), 135u);
+}
+
+// Test 3: Frame layout matches uart_frame_bits at every bit time
+BOOST_AUTO_TEST_CASE(uart_line_encode_timing) {
+    for (UartLineConfig cfg : {UartLineConfig{16, 1, 0}, UartLineConfig{8, 3, 2},
+                               UartLineConfig{4, 2, 1}}) {
+        LineWave wave = uart_line_encode({0xA5, 0x00, 0xFF}, cfg);
+        unsigned bit = cfg.bit_cycles();
+        BOOST_REQUIRE_EQUAL(wave.size(), 3u * (10 + cfg.idle_bits) * bit);
+
+        size_t t = 0;
+        for (uint8_t data : {0xA5, 0x00, 0xFF}) {
+            std::vector<uint8_t> bits = uart_frame_bits(data);
+            bits.insert(bits.end(), cfg.idle_bits, 1);
+            for (uint8_t b : bits) {
+                for (unsigned c = 0; c < bit; c++, t++) {
+                    BOOST_REQUIRE_EQUAL(wave.get(t), b != 0);
+                }
+            }
+        }
+    }
+}
+
+// Test 4: Decode round trip, glitch rejection and frame errors
+BOOST_AUTO_TEST_CASE(uart_line_decode_round_trip) {
+    UartLineConfig cfg{16, 2, 0};
+    unsigned bit = cfg.bit_cycles();
+    std::vector<uint8_t> bytes;
+    for (unsigned i = 0; i < 300; i++) bytes.push_back((uint8_t)(i * 151 + 17));
+
+    // Back to back, then with random-ish idle gaps and a leading glitch
+    LineWave wave = uart_line_encode(bytes, cfg);
+    std::vector<uint8_t> decoded = uart_line_decode(wave, cfg);
+    BOOST_CHECK_EQUAL_COLLECTIONS(decoded.begin(), decoded.end(), bytes.begin(), bytes.end());
+
+    LineWave gappy;
+    gappy.append(1, 13);
+    gappy.append(0, bit / 4);   // Too short to reach the start bit centre
+    gappy.append(1, 3 * bit);
+    for (size_t i = 0; i < bytes.size(); i++) {
+        uart_line_append_frame(gappy, bytes[i], cfg, i != 7);
+        gappy.append(1, (i * 37) % (2 * bit));
+    }
+    std::vector<UartLineFrame> frames = uart_line_decode_frames(gappy, cfg);
+    BOOST_REQUIRE_EQUAL(frames.size(), bytes.size());
+    for (size_t i = 0; i < bytes.size(); i++) {
+        BOOST_CHECK_EQUAL(frames[i].data, bytes[i]);
+        BOOST_CHECK_EQUAL(frames[i].frame_error, i == 7);
+    }
+
+    // A frame cut short by the end of the capture is dropped
+    LineWave cut = uart_line_encode({0x3C}, cfg);
+    LineWave partial;
+    for (size_t i = 0; i + bit < cut.size(); i++) partial.push_back(cut.get(i));
+    BOOST_CHECK(uart_line_decode(partial, cfg).empty());
+}
+
+// Test 5: BAUD_FRAC bit times, boundaries from the start edge in 1/64 steps
+BOOST_AUTO_TEST_CASE(uart_line_fractional_bits) {
+    for (UartLineConfig cfg : {UartLineConfig{16, 1, 0, 32}, UartLineConfig{8, 3, 1, 21},
+                               UartLineConfig{4, 1, 0, 63}}) {
+        uint64_t bit64 = cfg.bit_cycles64();
+        BOOST_REQUIRE_EQUAL(bit64, (uint64_t)cfg.oversample * (cfg.baud_div * 64 + cfg.baud_frac));
+
+        // Frame length is the exact fractional length, rounded down
+        LineWave one = uart_line_encode({0x96}, cfg);
+        BOOST_REQUIRE_EQUAL(one.size(), ((10 + cfg.idle_bits) * bit64) >> 6);
+
+        // Every bit boundary lands on its own floor(k x bit64 / 64)
+        std::vector<uint8_t> bits = uart_frame_bits(0x96);
+        for (unsigned k = 0; k < 10; k++) {
+            size_t lo = (k * bit64) >> 6;
+            size_t hi = ((k + 1) * bit64) >> 6;
+            for (size_t t = lo; t < hi; t++) BOOST_REQUIRE_EQUAL(one.get(t), bits[k] != 0);
+        }
+
+        std::vector<uint8_t> bytes;
+        for (unsigned i = 0; i < 64; i++) bytes.push_back((uint8_t)(i * 73 + 5));
+        LineWave wave = uart_line_encode(bytes, cfg);
+        std::vector<uint8_t> decoded = uart_line_decode(wave, cfg);
+        BOOST_CHECK_EQUAL_COLLECTIONS(decoded.begin(), decoded.end(), bytes.begin(), bytes.end());
+    }
+
+    // baud_frac = 0 keeps the whole-cycle layout
+    UartLineConfig whole{8, 3, 0};
+    for (unsigned k = 0; k <= 10; k++) BOOST_CHECK_EQUAL(whole.bit_edge(k), k * whole.bit_cycles());
+}
+
+// Test 6: Slice append, and a frame split across two captures
+BOOST_AUTO_TEST_CASE(uart_line_append_slice) {
+    UartLineConfig cfg{16, 1, 0};
+    LineWave wave = uart_line_encode({0x12, 0xEF, 0x5A}, cfg);
+
+    for (size_t from : {(size_t)0, (size_t)1, (size_t)63, (size_t)64, (size_t)100, wave.size()}) {
+        LineWave tail;
+        tail.append(1, 5);
+        tail.append(wave, from);
+        BOOST_REQUIRE_EQUAL(tail.size(), 5 + wave.size() - from);
+        for (size_t i = from; i < wave.size(); i++) BOOST_REQUIRE_EQUAL(tail.get(5 + i - from), wave.get(i));
+    }
+
+    // Carry the unfinished frame (from one cycle before its start edge)
+    // into the next capture
+    size_t split = 10 * cfg.bit_cycles() + 4 * cfg.bit_cycles();
+    LineWave first, second;
+    for (size_t i = 0; i < split; i++) first.push_back(wave.get(i));
+    std::vector<UartLineFrame> frames = uart_line_decode_frames(first, cfg);
+    BOOST_REQUIRE_EQUAL(frames.size(), 1u);
+    size_t pending = first.find_fall(frames[0].start + cfg.bit_centre(9));
+    BOOST_REQUIRE(pending != LineWave::npos);
+    second.append(first, pending - 1);
+    for (size_t i = split; i < wave.size(); i++) second.push_back(wave.get(i));
+    std::vector<uint8_t> rest = uart_line_decode(second, cfg);
+    BOOST_REQUIRE_EQUAL(rest.size(), 2u);
+    BOOST_CHECK_EQUAL(rest[0], 0xEF);
+    BOOST_CHECK_EQUAL(rest[1], 0x5A);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -5,14 +5,24 @@
  *
  * Test Coverage:
  * - Register read/write operations
- * - CTRL register (TX_EN, RX_EN)
+ * - CTRL register (TX_EN, RX_EN, OSR oversampling select, RTS_EN/CTS_EN)
  * - STATUS register (all flags and levels)
  * - TX_DATA register (FIFO push side effect)
  * - RX_DATA register (FIFO pop side effect with prefetch)
- * - BAUD_DIV register
+ * - Back-to-back RX_DATA drain rate (one byte per cycle)
+ * - Stream mode (CTRL.STREAM_EN): TX/RX handshakes, DMA burst requests
+ * - BAUD_DIV register and BAUD_FRAC fraction
  * - INT_ENABLE register
  * - INT_STATUS register (W1C semantics)
  * - FIFO_CTRL register (self-clearing bits)
+ * - FIFO_THRESH register and watermark interrupts
+ * - RX_TIMEOUT register and character timeout interrupt
+ * - Packed TX_DATA (wstrb lanes, reg_busy, TX_OVERRUN on dropped lanes) and
+ *   RX_DATA (count + 3 bytes)
+ * - FLOW_CTRL register and RTS deassertion on the RX FIFO level
+ * - PERF_CTRL/PERF_DATA performance counters (snapshot, clear)
+ * - CTRL.LOOPBACK output and the CTRL.PRBS_EN generator/checker
+ * - CTRL.AUTOBAUD: detector result loaded, self-clear, AUTOBAUD interrupt
  * - Reserved bit handling
  * - Error flag propagation
  * - Interrupt generation
@@ -21,8 +31,13 @@
 #include "Vuart_regs.h"
 #include <boost/test/unit_test.hpp>
 #include <verilated.h>
+#include "dut_driver.h"
+#include "uart_model.h"
+#include <deque>
 #include <vector>
 
+DUT_DRIVER_PORTS(Vuart_regs, uart_clk, rst_n);
+
 BOOST_AUTO_TEST_SUITE(UartRegs_ModuleTests)
 
 // Register offsets (word-addressed for Verilator, divide by 4)
@@ -34,20 +49,20 @@ constexpr uint8_t ADDR_BAUD_DIV   = 0x10 >> 2;
 constexpr uint8_t ADDR_INT_ENABLE = 0x14 >> 2;
 constexpr uint8_t ADDR_INT_STATUS = 0x18 >> 2;
 constexpr uint8_t ADDR_FIFO_CTRL  = 0x1C >> 2;
-
-struct UartRegsFixture {
-    Vuart_regs* dut;
-    int cycle_count;
-
+constexpr uint8_t ADDR_FIFO_THRESH = 0x20 >> 2;
+constexpr uint8_t ADDR_RX_TIMEOUT  = 0x24 >> 2;
+constexpr uint8_t ADDR_BAUD_FRAC   = 0x28 >> 2;
+constexpr uint8_t ADDR_FLOW_CTRL   = 0x2C >> 2;
+constexpr uint8_t ADDR_ISR_SNAPSHOT = 0x30 >> 2;
+constexpr uint8_t ADDR_PERF_CTRL   = 0x34 >> 2;
+constexpr uint8_t ADDR_PERF_DATA   = 0x38 >> 2;
+
+struct UartRegsFixture : DutDriver<Vuart_regs> {
     UartRegsFixture() {
-        dut = new Vuart_regs;
-        cycle_count = 0;
-
         // Initialize inputs
-        dut->uart_clk = 0;
-        dut->rst_n = 0;
         dut->reg_addr = 0;
         dut->reg_wdata = 0;
+        dut->reg_wstrb = 0xF;
         dut->reg_wen = 0;
         dut->reg_ren = 0;
 
@@ -65,37 +80,38 @@ struct UartRegsFixture {
         dut->rx_level = 0;
         dut->frame_error = 0;
         dut->overrun_error = 0;
-    }
+        dut->rx_done = 0;
+        dut->rx_frame_error = 0;
 
-    ~UartRegsFixture() {
-        delete dut;
-    }
+        // Baud generator input
+        dut->baud_tick = 0;
 
-    void tick() {
-        dut->uart_clk = 0;
-        dut->eval();
-        dut->uart_clk = 1;
-        dut->eval();
-        cycle_count++;
+        // Autobaud detector inputs
+        dut->autobaud_done = 0;
+        dut->autobaud_div = 0;
+        dut->autobaud_frac = 0;
+
+        // Stream inputs
+        dut->s_axis_tdata = 0;
+        dut->s_axis_tvalid = 0;
+        dut->m_axis_tready = 0;
     }
 
     void reset() {
-        dut->rst_n = 0;
         dut->reg_wen = 0;
         dut->reg_ren = 0;
-        for (int i = 0; i < 5; i++) tick();
-        dut->rst_n = 1;
-        tick();
-        cycle_count = 0;
+        pulse_reset();
     }
 
     // Helper: Write register
-    void write_reg(uint8_t addr, uint32_t data) {
+    void write_reg(uint8_t addr, uint32_t data, uint8_t strb = 0xF) {
         dut->reg_addr = addr;
         dut->reg_wdata = data;
+        dut->reg_wstrb = strb;
         dut->reg_wen = 1;
         tick();
         dut->reg_wen = 0;
+        dut->reg_wstrb = 0xF;
     }
 
     // Helper: Read register
@@ -107,6 +123,47 @@ struct UartRegsFixture {
         tick();  // Allow one cycle for read data to be valid
         return dut->reg_rdata;
     }
+
+    // Helper: Read register, value captured on the access cycle (as
+    // axi_lite_slave_if does) for reads with side effects
+    uint32_t read_reg_capture(uint8_t addr) {
+        dut->reg_addr = addr;
+        dut->reg_ren = 1;
+        dut->eval();
+        uint32_t value = dut->reg_rdata;
+        tick();
+        dut->reg_ren = 0;
+        tick();
+        return value;
+    }
+
+    // RX FIFO model for the prefetch tests: registered output, one entry
+    // per rd_en, rx_empty/rx_level follow the queue
+    std::deque<uint8_t> fifo;
+
+    void fifo_tick() {
+        dut->rx_empty = fifo.empty();
+        dut->rx_level = fifo.size();
+        dut->eval();
+        bool pop = dut->rd_en;
+        tick();
+        if (pop) {
+            dut->rx_data = fifo.front();
+            fifo.pop_front();
+        }
+        dut->rx_empty = fifo.empty();
+        dut->rx_level = fifo.size();
+    }
+
+    // Helper: n single-cycle baud ticks, one idle cycle after each
+    void baud_ticks(int n) {
+        for (int i = 0; i < n; i++) {
+            dut->baud_tick = 1;
+            tick();
+            dut->baud_tick = 0;
+            tick();
+        }
+    }
 };
 
 // Test 1: Reset state
@@ -158,8 +215,9 @@ BOOST_FIXTURE_TEST_CASE(uart_regs_ctrl_reserved, UartRegsFixture) {
     write_reg(ADDR_CTRL, 0xFFFFFFFF);
     uint32_t ctrl = read_reg(ADDR_CTRL);
 
-    // Only bits [1:0] should be writable
-    BOOST_CHECK_EQUAL(ctrl & 0xFFFFFFFC, 0);
+    // Only bits [12:0] should be writable
+    BOOST_CHECK_EQUAL(ctrl & 0xFFFFE000, 0);
+    BOOST_CHECK_EQUAL(dut->tx_early, 1);  // CTRL.TX_EARLY to uart_tx_path
 }
 
 // Test 4: STATUS register reflects TX/RX flags
@@ -250,9 +308,9 @@ BOOST_FIXTURE_TEST_CASE(uart_regs_rx_data_read, UartRegsFixture) {
     dut->rx_empty = 0;
     dut->rx_data = 0x55;
 
-    // Give prefetch FSM time to fetch (RX_IDLE → RX_FETCHING → RX_READY)
-    tick();  // Transition to RX_FETCHING
-    tick();  // Capture data, transition to RX_READY
+    // Give prefetch time to fetch
+    tick();  // rd_en
+    tick();  // Capture data into the holding buffer
 
     // Read RX_DATA
     uint32_t data = read_reg(ADDR_RX_DATA);
@@ -268,9 +326,9 @@ BOOST_FIXTURE_TEST_CASE(uart_regs_rx_data_mask, UartRegsFixture) {
     dut->rx_empty = 0;
     dut->rx_data = 0xFF;
 
-    // Give prefetch FSM time to fetch
-    tick();  // Transition to RX_FETCHING
-    tick();  // Capture data, transition to RX_READY
+    // Give prefetch time to fetch
+    tick();  // rd_en
+    tick();  // Capture data into the holding buffer
 
     uint32_t data = read_reg(ADDR_RX_DATA);
 
@@ -454,4 +512,716 @@ BOOST_FIXTURE_TEST_CASE(uart_regs_error_clear, UartRegsFixture) {
     // Implementation-dependent
 }
 
+// Test 21: FIFO_THRESH reset value and field widths
+BOOST_FIXTURE_TEST_CASE(uart_regs_fifo_thresh_rw, UartRegsFixture) {
+    reset();
+
+    // Reset: TX_LOW_WM = 0, RX_HIGH_WM = 1
+    uint32_t thresh = read_reg(ADDR_FIFO_THRESH);
+    BOOST_CHECK_EQUAL(thresh, 0x00010000u);
+
+    write_reg(ADDR_FIFO_THRESH, 0x00060002);
+    thresh = read_reg(ADDR_FIFO_THRESH);
+    BOOST_CHECK_EQUAL(thresh, 0x00060002u);
+
+    // FIFO_ADDR_WIDTH=3: only level bits [3:0] of each field implemented
+    write_reg(ADDR_FIFO_THRESH, 0xFFFFFFFF);
+    thresh = read_reg(ADDR_FIFO_THRESH);
+    BOOST_CHECK_EQUAL(thresh, 0x000F000Fu);
+}
+
+// Test 22: TX low watermark interrupt
+BOOST_FIXTURE_TEST_CASE(uart_regs_tx_low_watermark, UartRegsFixture) {
+    reset();
+
+    dut->tx_empty = 0;
+    dut->tx_level = 5;
+    write_reg(ADDR_FIFO_THRESH, 0x00010002);  // TX_LOW_WM = 2
+    write_reg(ADDR_INT_ENABLE, 0x00000010);   // TX_LOW_WM only
+    write_reg(ADDR_CTRL, 0x00000001);          // TX_EN
+
+    // Above threshold: no event
+    write_reg(ADDR_INT_STATUS, 0x0000003F);
+    uint32_t int_status = read_reg(ADDR_INT_STATUS);
+    BOOST_CHECK_EQUAL((int_status >> 4) & 1, 0);
+    BOOST_CHECK_EQUAL(dut->irq, 0);
+
+    // Drain to threshold
+    dut->tx_level = 2;
+    tick();
+    int_status = read_reg(ADDR_INT_STATUS);
+    BOOST_CHECK_EQUAL((int_status >> 4) & 1, 1);
+    BOOST_CHECK_EQUAL(dut->irq, 1);
+
+    // W1C does not stick while the level stays at/below threshold
+    write_reg(ADDR_INT_STATUS, 0x00000010);
+    int_status = read_reg(ADDR_INT_STATUS);
+    BOOST_CHECK_EQUAL((int_status >> 4) & 1, 1);
+
+    // Refilled above threshold: W1C clears
+    dut->tx_level = 6;
+    tick();
+    write_reg(ADDR_INT_STATUS, 0x00000010);
+    int_status = read_reg(ADDR_INT_STATUS);
+    BOOST_CHECK_EQUAL((int_status >> 4) & 1, 0);
+    BOOST_CHECK_EQUAL(dut->irq, 0);
+}
+
+// Test 23: RX high watermark interrupt
+BOOST_FIXTURE_TEST_CASE(uart_regs_rx_high_watermark, UartRegsFixture) {
+    reset();
+
+    write_reg(ADDR_FIFO_THRESH, 0x00040000);  // RX_HIGH_WM = 4
+    write_reg(ADDR_INT_ENABLE, 0x00000020);   // RX_HIGH_WM only
+    write_reg(ADDR_CTRL, 0x00000002);          // RX_EN
+
+    // Below threshold (holding register stays empty: rx_empty=1)
+    dut->rx_level = 3;
+    tick();
+    uint32_t int_status = read_reg(ADDR_INT_STATUS);
+    BOOST_CHECK_EQUAL((int_status >> 5) & 1, 0);
+    BOOST_CHECK_EQUAL(dut->irq, 0);
+
+    // At threshold
+    dut->rx_level = 4;
+    tick();
+    int_status = read_reg(ADDR_INT_STATUS);
+    BOOST_CHECK_EQUAL((int_status >> 5) & 1, 1);
+    BOOST_CHECK_EQUAL(dut->irq, 1);
+
+    // Threshold 0 disables the source
+    dut->rx_level = 0;
+    write_reg(ADDR_FIFO_THRESH, 0x00000000);
+    write_reg(ADDR_INT_STATUS, 0x00000020);
+    dut->rx_level = 8;
+    tick();
+    int_status = read_reg(ADDR_INT_STATUS);
+    BOOST_CHECK_EQUAL((int_status >> 5) & 1, 0);
+}
+
+// Test 24: RX_TIMEOUT read/write and field width
+BOOST_FIXTURE_TEST_CASE(uart_regs_rx_timeout_rw, UartRegsFixture) {
+    reset();
+
+    // Disabled after reset
+    BOOST_CHECK_EQUAL(read_reg(ADDR_RX_TIMEOUT), 0x00000000u);
+
+    write_reg(ADDR_RX_TIMEOUT, 0x00000028);  // 4 characters
+    BOOST_CHECK_EQUAL(read_reg(ADDR_RX_TIMEOUT), 0x00000028u);
+
+    // Only [7:0] implemented
+    write_reg(ADDR_RX_TIMEOUT, 0xFFFFFFFF);
+    BOOST_CHECK_EQUAL(read_reg(ADDR_RX_TIMEOUT), 0x000000FFu);
+}
+
+// Test 25: RX character timeout interrupt
+BOOST_FIXTURE_TEST_CASE(uart_regs_rx_timeout_irq, UartRegsFixture) {
+    reset();
+
+    write_reg(ADDR_RX_TIMEOUT, 0x00000002);  // 2 bit times = 32 ticks
+    write_reg(ADDR_INT_ENABLE, 0x00000040);  // RX_TIMEOUT only
+    write_reg(ADDR_CTRL, 0x00000002);        // RX_EN
+
+    // No bytes waiting: timer does not run
+    baud_ticks(64);
+    BOOST_CHECK_EQUAL(dut->irq, 0);
+
+    // One byte in the FIFO (holding register stays empty: rx_empty=1)
+    dut->rx_level = 1;
+    baud_ticks(31);
+    BOOST_CHECK_EQUAL(dut->irq, 0);
+    baud_ticks(1);
+    BOOST_CHECK_EQUAL(dut->irq, 1);
+    BOOST_CHECK_EQUAL((read_reg(ADDR_INT_STATUS) >> 6) & 1, 1);
+
+    // Source persists while the line stays idle
+    write_reg(ADDR_INT_STATUS, 0x00000040);
+    tick();
+    BOOST_CHECK_EQUAL(dut->irq, 1);
+
+    // Line activity restarts the timer
+    dut->rx_active = 1;
+    tick();
+    write_reg(ADDR_INT_STATUS, 0x00000040);
+    dut->rx_active = 0;
+    baud_ticks(31);
+    BOOST_CHECK_EQUAL(dut->irq, 0);
+    baud_ticks(1);
+    BOOST_CHECK_EQUAL(dut->irq, 1);
+
+    // RX_DATA read restarts the timer as well
+    read_reg(ADDR_RX_DATA);
+    write_reg(ADDR_INT_STATUS, 0x00000040);
+    baud_ticks(31);
+    BOOST_CHECK_EQUAL(dut->irq, 0);
+
+    // RX_TIMEOUT = 0 disables the source
+    write_reg(ADDR_RX_TIMEOUT, 0x00000000);
+    baud_ticks(64);
+    BOOST_CHECK_EQUAL(dut->irq, 0);
+}
+
+// Test 26: Packed TX_DATA write pushes the enabled lanes in order
+BOOST_FIXTURE_TEST_CASE(uart_regs_packed_tx_write, UartRegsFixture) {
+    reset();
+    write_reg(ADDR_CTRL, 0x00000005);  // TX_EN + PACK_EN
+
+    // Lanes 0, 1 and 3
+    dut->reg_addr = ADDR_TX_DATA;
+    dut->reg_wdata = 0x44332211;
+    dut->reg_wstrb = 0xB;
+    dut->reg_wen = 1;
+    dut->eval();
+    BOOST_CHECK_EQUAL(dut->wr_en, 0);      // Staged first
+    BOOST_CHECK_EQUAL(dut->reg_busy, 1);   // Bus must wait
+    tick();
+    dut->reg_wen = 0;
+    dut->reg_wstrb = 0xF;
+
+    std::vector<uint8_t> pushed;
+    for (int i = 0; i < 8 && dut->reg_busy; i++) {
+        dut->eval();
+        if (dut->wr_en) pushed.push_back(dut->wr_data);
+        tick();
+    }
+    std::vector<uint8_t> expected = {0x11, 0x22, 0x44};
+    BOOST_CHECK_EQUAL_COLLECTIONS(pushed.begin(), pushed.end(),
+                                  expected.begin(), expected.end());
+    BOOST_CHECK_EQUAL(dut->reg_busy, 0);
+    BOOST_CHECK_EQUAL((read_reg(ADDR_STATUS) >> 25) & 1, 0u);  // TX_OVERRUN
+
+    // Lanes that meet a full FIFO are dropped and flagged; busy stays bounded
+    dut->tx_full = 1;
+    write_reg(ADDR_TX_DATA, 0xDDCCBBAA, 0xF);
+    int busy_cycles = 0;
+    while (dut->reg_busy && busy_cycles < 8) {
+        dut->eval();
+        BOOST_CHECK_EQUAL(dut->wr_en, 0);
+        tick();
+        busy_cycles++;
+    }
+    BOOST_CHECK_EQUAL(busy_cycles, 4);
+    BOOST_CHECK_EQUAL((read_reg(ADDR_STATUS) >> 25) & 1, 1u);
+
+    // Sticky until a TX FIFO reset
+    dut->tx_full = 0;
+    tick();
+    BOOST_CHECK_EQUAL((read_reg(ADDR_STATUS) >> 25) & 1, 1u);
+    write_reg(ADDR_FIFO_CTRL, 0x00000001);
+    tick();
+    BOOST_CHECK_EQUAL((read_reg(ADDR_STATUS) >> 25) & 1, 0u);
+
+    // Without PACK_EN, wstrb is ignored and only [7:0] is pushed
+    dut->tx_full = 0;
+    write_reg(ADDR_CTRL, 0x00000001);
+    dut->reg_addr = ADDR_TX_DATA;
+    dut->reg_wdata = 0x00005A00;
+    dut->reg_wstrb = 0x2;
+    dut->reg_wen = 1;
+    dut->eval();
+    BOOST_CHECK_EQUAL(dut->wr_en, 1);
+    BOOST_CHECK_EQUAL(dut->wr_data, 0x00);
+    BOOST_CHECK_EQUAL(dut->reg_busy, 0);
+    tick();
+    dut->reg_wen = 0;
+    dut->reg_wstrb = 0xF;
+
+    // An unpacked write to a full FIFO is flagged the same way
+    dut->tx_full = 1;
+    write_reg(ADDR_TX_DATA, 0x000000A5);
+    BOOST_CHECK_EQUAL((read_reg(ADDR_STATUS) >> 25) & 1, 1u);
+    dut->tx_full = 0;
+}
+
+// Test 27: Packed RX_DATA read returns up to 3 bytes and a count
+BOOST_FIXTURE_TEST_CASE(uart_regs_packed_rx_read, UartRegsFixture) {
+    reset();
+    write_reg(ADDR_CTRL, 0x00000006);  // RX_EN + PACK_EN
+
+    fifo = {0xA1, 0xA2, 0xA3, 0xA4};
+    auto packed_read = [&] {
+        dut->reg_addr = ADDR_RX_DATA;
+        dut->reg_ren = 1;
+        dut->eval();
+        uint32_t value = dut->reg_rdata;  // Captured on the access cycle
+        fifo_tick();
+        dut->reg_ren = 0;
+        return value;
+    };
+
+    // Prefetch fills the 3-byte holding buffer, one byte stays in the FIFO
+    for (int i = 0; i < 8; i++) fifo_tick();
+    BOOST_CHECK_EQUAL(fifo.size(), 1u);
+
+    BOOST_CHECK_EQUAL(packed_read(), 0x03A3A2A1u);
+    for (int i = 0; i < 4; i++) fifo_tick();
+    BOOST_CHECK_EQUAL(packed_read(), 0x010000A4u);
+    for (int i = 0; i < 4; i++) fifo_tick();
+    BOOST_CHECK_EQUAL(packed_read(), 0x00000000u);  // Nothing held
+}
+
+// Test 28: Back-to-back RX_DATA reads drain one fresh byte per cycle
+BOOST_FIXTURE_TEST_CASE(uart_regs_rx_drain_rate, UartRegsFixture) {
+    reset();
+    write_reg(ADDR_CTRL, 0x00000002);  // RX_EN
+
+    for (int i = 0; i < 16; i++) fifo.push_back(0x40 + i);
+    const size_t total = fifo.size();
+
+    // Prefetch fills the two-entry holding buffer
+    for (int i = 0; i < 4; i++) fifo_tick();
+    BOOST_CHECK_EQUAL(fifo.size(), total - 2);
+
+    // reg_ren held high for one access per cycle, captured on the access
+    // cycle as axi_lite_slave_if does; a bubble shows up as a repeated byte
+    std::vector<uint8_t> drained;
+    uint64_t start = cycle_count;
+    dut->reg_addr = ADDR_RX_DATA;
+    dut->reg_ren = 1;
+    for (size_t i = 0; i < total; i++) {
+        dut->eval();
+        drained.push_back(dut->reg_rdata & 0xFF);
+        fifo_tick();
+    }
+    dut->reg_ren = 0;
+    uint64_t cycles = cycle_count - start;
+    BOOST_TEST_MESSAGE("RX drain: " << cycles << " cycles for " << total
+                       << " bytes (" << (double)cycles / total << " cycles/byte)");
+
+    // Every read returned the next byte, FIFO and holding buffer now empty
+    for (size_t i = 0; i < total; i++) {
+        BOOST_CHECK_EQUAL(drained[i], 0x40 + i);
+    }
+    BOOST_CHECK(fifo.empty());
+    BOOST_CHECK_EQUAL(dut->rd_en, 0);
+    BOOST_CHECK_EQUAL(read_reg(ADDR_RX_DATA) & 0xFF, 0x40u + total - 1);  // Stale
+}
+
+// Test 29: Stream mode hands the FIFO data path to the stream ports
+BOOST_FIXTURE_TEST_CASE(uart_regs_stream_mode, UartRegsFixture) {
+    reset();
+    write_reg(ADDR_FIFO_THRESH, 0x00030002);  // RX_HIGH_WM = 3, TX_LOW_WM = 2
+    write_reg(ADDR_CTRL, 0x0000000B);         // STREAM_EN + RX_EN + TX_EN
+
+    // TX: empty FIFO requests a burst, s_axis pushes straight through
+    dut->tx_level = 0;
+    dut->s_axis_tdata = 0x5A;
+    dut->s_axis_tvalid = 1;
+    dut->eval();
+    BOOST_CHECK_EQUAL(dut->tx_dma_req, 1);
+    BOOST_CHECK_EQUAL(dut->s_axis_tready, 1);
+    BOOST_CHECK_EQUAL(dut->wr_en, 1);
+    BOOST_CHECK_EQUAL(dut->wr_data, 0x5A);
+
+    // Full FIFO: back-pressure; above TX_LOW_WM: request drops
+    dut->tx_full = 1;
+    dut->tx_level = 3;
+    dut->eval();
+    BOOST_CHECK_EQUAL(dut->s_axis_tready, 0);
+    BOOST_CHECK_EQUAL(dut->wr_en, 0);
+    BOOST_CHECK_EQUAL(dut->tx_dma_req, 0);
+    dut->tx_full = 0;
+    dut->s_axis_tvalid = 0;
+
+    // TX_DATA writes are dropped while streaming
+    dut->reg_addr = ADDR_TX_DATA;
+    dut->reg_wdata = 0x33;
+    dut->reg_wen = 1;
+    dut->eval();
+    BOOST_CHECK_EQUAL(dut->wr_en, 0);
+    tick();
+    dut->reg_wen = 0;
+
+    // RX: prefetch fills the holding buffer, burst request at RX_HIGH_WM
+    fifo = {0xC1, 0xC2, 0xC3, 0xC4};
+    for (int i = 0; i < 4; i++) fifo_tick();
+    BOOST_CHECK_EQUAL(dut->m_axis_tvalid, 1);
+    BOOST_CHECK_EQUAL(dut->m_axis_tdata, 0xC1);
+    BOOST_CHECK_EQUAL(dut->rx_dma_req, 1);
+
+    // RX_DATA reads 0 and does not pop
+    dut->reg_addr = ADDR_RX_DATA;
+    dut->reg_ren = 1;
+    dut->eval();
+    BOOST_CHECK_EQUAL(dut->reg_rdata, 0u);
+    fifo_tick();
+    dut->reg_ren = 0;
+    BOOST_CHECK_EQUAL(dut->m_axis_tdata, 0xC1);
+
+    // Ready sink drains one byte per cycle
+    std::vector<uint8_t> drained;
+    dut->m_axis_tready = 1;
+    for (int i = 0; i < 4; i++) {
+        dut->eval();
+        BOOST_CHECK_EQUAL(dut->m_axis_tvalid, 1);
+        drained.push_back(dut->m_axis_tdata);
+        fifo_tick();
+    }
+    dut->m_axis_tready = 0;
+    std::vector<uint8_t> expected = {0xC1, 0xC2, 0xC3, 0xC4};
+    BOOST_CHECK_EQUAL_COLLECTIONS(drained.begin(), drained.end(),
+                                  expected.begin(), expected.end());
+    BOOST_CHECK_EQUAL(dut->m_axis_tvalid, 0);
+    BOOST_CHECK_EQUAL(dut->rx_dma_req, 0);
+
+    // Stream ports idle again once STREAM_EN is cleared
+    write_reg(ADDR_CTRL, 0x00000003);
+    dut->eval();
+    BOOST_CHECK_EQUAL(dut->s_axis_tready, 0);
+    BOOST_CHECK_EQUAL(dut->tx_dma_req, 0);
+}
+
+// Test 30: BAUD_FRAC read/write drives baud_frac
+BOOST_FIXTURE_TEST_CASE(uart_regs_baud_frac_rw, UartRegsFixture) {
+    reset();
+
+    // Integer divisor after reset
+    BOOST_CHECK_EQUAL(read_reg(ADDR_BAUD_FRAC), 0x00000000u);
+    BOOST_CHECK_EQUAL(dut->baud_frac, 0);
+
+    write_reg(ADDR_BAUD_FRAC, 0x00000019);  // 25/64
+    BOOST_CHECK_EQUAL(read_reg(ADDR_BAUD_FRAC), 0x00000019u);
+    BOOST_CHECK_EQUAL(dut->baud_frac, 0x19);
+
+    // Only [5:0] implemented; BAUD_DIV is untouched
+    write_reg(ADDR_BAUD_FRAC, 0xFFFFFFFF);
+    BOOST_CHECK_EQUAL(read_reg(ADDR_BAUD_FRAC), 0x0000003Fu);
+    BOOST_CHECK_EQUAL(read_reg(ADDR_BAUD_DIV), 0x00000004u);
+}
+
+// Test 31: CTRL.OSR drives osr_sel and scales the RX timeout to bit times
+BOOST_FIXTURE_TEST_CASE(uart_regs_ctrl_osr, UartRegsFixture) {
+    reset();
+    BOOST_CHECK_EQUAL(dut->osr_sel, 0);  // 16x after reset
+
+    write_reg(ADDR_CTRL, 0x00000013);  // 8x + TX_EN + RX_EN
+    BOOST_CHECK_EQUAL(read_reg(ADDR_CTRL), 0x00000013u);
+    BOOST_CHECK_EQUAL(dut->osr_sel, 1);
+
+    // RX_TIMEOUT = 2 bit times = 16 ticks at 8x
+    write_reg(ADDR_RX_TIMEOUT, 0x00000002);
+    write_reg(ADDR_INT_ENABLE, 0x00000040);
+    dut->rx_level = 1;
+    baud_ticks(15);
+    BOOST_CHECK_EQUAL(dut->irq, 0);
+    baud_ticks(1);
+    BOOST_CHECK_EQUAL(dut->irq, 1);
+
+    // 4x: 8 ticks (emptying the FIFO clears the timer)
+    dut->rx_level = 0;
+    write_reg(ADDR_CTRL, 0x00000023);
+    BOOST_CHECK_EQUAL(dut->osr_sel, 2);
+    tick();
+    write_reg(ADDR_INT_STATUS, 0x00000040);
+    dut->rx_level = 1;
+    baud_ticks(7);
+    BOOST_CHECK_EQUAL(dut->irq, 0);
+    baud_ticks(1);
+    BOOST_CHECK_EQUAL(dut->irq, 1);
+}
+
+// Test 32: FLOW_CTRL threshold drives rts_n from the RX FIFO level
+BOOST_FIXTURE_TEST_CASE(uart_regs_flow_ctrl_rts, UartRegsFixture) {
+    reset();
+
+    // Reset: threshold at half the 8-deep FIFO, flow control off
+    BOOST_CHECK_EQUAL(read_reg(ADDR_FLOW_CTRL), 0x00000004u);
+    BOOST_CHECK_EQUAL(dut->rts_n, 0);
+    BOOST_CHECK_EQUAL(dut->cts_en, 0);
+
+    // RTS_EN off: RTS stays asserted whatever the level
+    dut->rx_level = 8;
+    tick();
+    BOOST_CHECK_EQUAL(dut->rts_n, 0);
+
+    write_reg(ADDR_CTRL, 0x00000042);  // RTS_EN + RX_EN
+    tick();                            // rts_n is registered
+    BOOST_CHECK_EQUAL(dut->rts_n, 1);
+
+    // Below the threshold: asserted; at it: deasserted one cycle later
+    dut->rx_level = 3;
+    tick();
+    BOOST_CHECK_EQUAL(dut->rts_n, 0);
+    dut->rx_level = 4;
+    dut->eval();
+    BOOST_CHECK_EQUAL(dut->rts_n, 0);
+    tick();
+    BOOST_CHECK_EQUAL(dut->rts_n, 1);
+
+    // New threshold; 0 holds RTS deasserted
+    write_reg(ADDR_FLOW_CTRL, 0x00000006);
+    BOOST_CHECK_EQUAL(read_reg(ADDR_FLOW_CTRL), 0x00000006u);
+    BOOST_CHECK_EQUAL(dut->rts_n, 0);
+    dut->rx_level = 0;
+    write_reg(ADDR_FLOW_CTRL, 0x00000000);
+    tick();
+    BOOST_CHECK_EQUAL(dut->rts_n, 1);
+
+    // Only the level width is implemented; CTS_EN is bit 7
+    write_reg(ADDR_FLOW_CTRL, 0xFFFFFFFF);
+    BOOST_CHECK_EQUAL(read_reg(ADDR_FLOW_CTRL), 0x0000000Fu);
+    write_reg(ADDR_CTRL, 0x00000081);  // CTS_EN + TX_EN
+    BOOST_CHECK_EQUAL(dut->cts_en, 1);
+    tick();
+    BOOST_CHECK_EQUAL(dut->rts_n, 0);
+}
+
+// Test 33: ISR_SNAPSHOT combines pending interrupts, levels and errors
+BOOST_FIXTURE_TEST_CASE(uart_regs_isr_snapshot, UartRegsFixture) {
+    reset();
+    BOOST_CHECK_EQUAL(read_reg(ADDR_ISR_SNAPSHOT), 0x00000000u);
+
+    // Errors enabled; TX_READY set but not enabled (not pending)
+    write_reg(ADDR_INT_ENABLE, 0x0000000C);
+    write_reg(ADDR_CTRL, 0x00000001);
+    dut->frame_error = 1;
+    dut->overrun_error = 1;
+    tick();
+    dut->frame_error = 0;
+    dut->overrun_error = 0;
+
+    // 4 bytes received: 2 move to the holding buffer, 2 stay in the FIFO
+    fifo = {0x11, 0x22, 0x33, 0x44};
+    for (int i = 0; i < 4; i++) fifo_tick();
+    BOOST_CHECK_EQUAL(fifo.size(), 2u);
+    dut->tx_level = 5;
+
+    uint32_t snapshot = read_reg(ADDR_ISR_SNAPSHOT);
+    BOOST_CHECK_EQUAL(snapshot & 0x7F, 0x0Cu);           // Pending, masked
+    BOOST_CHECK_EQUAL((snapshot >> 8) & 0xFF, 5u);       // TX level
+    BOOST_CHECK_EQUAL((snapshot >> 16) & 0xFF, 4u);      // RX readable
+    BOOST_CHECK_EQUAL((snapshot >> 24) & 0x3, 0x3u);     // Overrun, frame
+    BOOST_CHECK_EQUAL(snapshot & 0xFC000080, 0u);        // Reserved
+
+    // Without CTRL.INT_RTC the read has no side effects
+    BOOST_CHECK_EQUAL(read_reg(ADDR_ISR_SNAPSHOT), snapshot);
+    BOOST_CHECK_EQUAL(read_reg(ADDR_INT_STATUS) & 0x0D, 0x0Du);
+    BOOST_CHECK_EQUAL(dut->irq, 1);
+}
+
+// Test 34: CTRL.INT_RTC clears INT_STATUS on read
+BOOST_FIXTURE_TEST_CASE(uart_regs_int_read_to_clear, UartRegsFixture) {
+    reset();
+    write_reg(ADDR_INT_ENABLE, 0x00000004);  // FRAME_ERR only
+    write_reg(ADDR_CTRL, 0x00000100);        // INT_RTC
+
+    // INT_STATUS read returns, then clears, the bits set
+    dut->frame_error = 1;
+    tick();
+    dut->frame_error = 0;
+    BOOST_CHECK_EQUAL(dut->irq, 1);
+    BOOST_CHECK_EQUAL(read_reg_capture(ADDR_INT_STATUS), 0x00000004u);
+    BOOST_CHECK_EQUAL(dut->irq, 0);
+    BOOST_CHECK_EQUAL(read_reg(ADDR_INT_STATUS), 0x00000000u);
+    BOOST_CHECK_EQUAL(read_reg(ADDR_STATUS) & (1u << 6), 0u);  // Sticky cleared
+
+    // ISR_SNAPSHOT read clears only the pending (enabled) bits it returns
+    dut->frame_error = 1;
+    dut->overrun_error = 1;
+    tick();
+    dut->frame_error = 0;
+    dut->overrun_error = 0;
+    BOOST_CHECK_EQUAL(read_reg_capture(ADDR_ISR_SNAPSHOT) & 0x7F, 0x04u);
+    BOOST_CHECK_EQUAL(dut->irq, 0);
+    BOOST_CHECK_EQUAL(read_reg_capture(ADDR_INT_STATUS), 0x00000008u);  // Overrun kept
+    BOOST_CHECK_EQUAL(read_reg(ADDR_STATUS) & 0xC0, 0u);
+
+    // An event on the read cycle is not lost
+    dut->frame_error = 1;
+    tick();
+    dut->reg_addr = ADDR_INT_STATUS;
+    dut->reg_ren = 1;
+    tick();                         // Read (clears) + new frame error
+    dut->reg_ren = 0;
+    dut->frame_error = 0;
+    tick();
+    BOOST_CHECK_EQUAL(read_reg_capture(ADDR_INT_STATUS), 0x00000004u);
+
+    // INT_RTC off: reads leave the bits set, W1C still clears
+    write_reg(ADDR_CTRL, 0x00000000);
+    dut->frame_error = 1;
+    tick();
+    dut->frame_error = 0;
+    BOOST_CHECK_EQUAL(read_reg_capture(ADDR_INT_STATUS), 0x00000004u);
+    BOOST_CHECK_EQUAL(read_reg_capture(ADDR_INT_STATUS), 0x00000004u);
+    write_reg(ADDR_INT_STATUS, 0x00000004);
+    BOOST_CHECK_EQUAL(read_reg(ADDR_INT_STATUS), 0x00000000u);
+}
+
+// Test 35: Performance counters count events and read through a snapshot
+BOOST_FIXTURE_TEST_CASE(uart_regs_perf_counters, UartRegsFixture) {
+    reset();
+    BOOST_CHECK_EQUAL(read_reg(ADDR_PERF_CTRL), 0x80000000u);  // PRESENT
+    BOOST_CHECK_EQUAL(read_reg(ADDR_PERF_DATA), 0u);
+
+    write_reg(ADDR_CTRL, 0x00000003);  // TX_EN + RX_EN
+    dut->tx_empty = 0;                 // Not stalled
+
+    // Two frames on uart_tx (counted as tx_active falls)
+    for (int i = 0; i < 2; i++) {
+        dut->tx_active = 1;
+        run_cycles(10);
+        dut->tx_active = 0;
+        run_cycles(2);
+    }
+
+    // Three bytes stored, one dropped on a full FIFO. Bytes 1 and 2 have
+    // bad stop bits: counted per strobe, while the sticky frame_error
+    // stays set from the first one
+    for (int i = 0; i < 4; i++) {
+        dut->rx_full = (i == 3);
+        dut->rx_done = 1;
+        dut->rx_frame_error = (i == 1 || i == 2);
+        if (i == 1) dut->frame_error = 1;
+        tick();
+        dut->rx_done = 0;
+        dut->rx_frame_error = 0;
+        tick();
+    }
+    dut->rx_full = 0;
+    dut->frame_error = 0;
+
+    // RX FIFO level peaks at 6
+    dut->rx_level = 6;
+    tick();
+    dut->rx_level = 2;
+    tick();
+
+    // Live counters are not visible until a snapshot
+    BOOST_CHECK_EQUAL(read_reg(ADDR_PERF_DATA), 0u);
+    write_reg(ADDR_PERF_CTRL, 0x00000100);  // SNAPSHOT, SEL=0
+    BOOST_CHECK_EQUAL(read_reg(ADDR_PERF_DATA), 2u);  // TX_BYTES
+
+    // Later events do not disturb the snapshot
+    dut->rx_done = 1;
+    tick();
+    dut->rx_done = 0;
+
+    const uint32_t expected[8] = {2, 3, 2, 1, 0, 6, 0, 0};
+    for (uint32_t sel = 0; sel < 8; sel++) {
+        write_reg(ADDR_PERF_CTRL, sel);
+        BOOST_CHECK_EQUAL(read_reg(ADDR_PERF_CTRL), 0x80000000u | sel);
+        BOOST_CHECK_EQUAL(read_reg(ADDR_PERF_DATA), expected[sel]);
+    }
+
+    // SNAPSHOT + CLEAR: the shadow gets the values from before the clear
+    write_reg(ADDR_PERF_CTRL, 0x00000301);  // SEL=1 RX_BYTES
+    BOOST_CHECK_EQUAL(read_reg(ADDR_PERF_DATA), 4u);
+
+    // TX stall: cycles with TX_EN set, uart_tx idle and the FIFO empty
+    dut->tx_empty = 1;
+    run_cycles(20);
+    dut->tx_empty = 0;
+    write_reg(ADDR_PERF_CTRL, 0x00000104);  // SNAPSHOT, SEL=4
+    BOOST_CHECK_EQUAL(read_reg(ADDR_PERF_DATA), 20u);
+
+    // Cleared counters restart; the high-water mark from the current level
+    write_reg(ADDR_PERF_CTRL, 0x00000000);
+    BOOST_CHECK_EQUAL(read_reg(ADDR_PERF_DATA), 0u);   // TX_BYTES
+    write_reg(ADDR_PERF_CTRL, 0x00000001);
+    BOOST_CHECK_EQUAL(read_reg(ADDR_PERF_DATA), 0u);   // RX_BYTES
+    write_reg(ADDR_PERF_CTRL, 0x00000005);
+    BOOST_CHECK_EQUAL(read_reg(ADDR_PERF_DATA), 2u);   // RX_HWM
+}
+
+// Test 36: CTRL.LOOPBACK output; PRBS_EN generator and checker
+BOOST_FIXTURE_TEST_CASE(uart_regs_loopback_prbs, UartRegsFixture) {
+    reset();
+    write_reg(ADDR_CTRL, 0x00000200);  // LOOPBACK
+    BOOST_CHECK_EQUAL(dut->loopback, 1);
+    BOOST_CHECK_EQUAL(read_reg(ADDR_CTRL), 0x00000200u);
+    write_reg(ADDR_CTRL, 0x00000000);
+    BOOST_CHECK_EQUAL(dut->loopback, 0);
+
+    // Generator: one byte per cycle while the FIFO has room, the sequence
+    // pauses (not skips) while it is full
+    std::vector<uint8_t> expected, pushed;
+    uint16_t state = uart_reg::PRBS_SEED;
+    for (int i = 0; i < 24; i++) expected.push_back(uart_reg::prbs15_byte(state));
+
+    write_reg(ADDR_CTRL, 0x00000400);  // PRBS_EN
+    for (int i = 0; i < 24; i++) {
+        dut->tx_full = (i >= 8 && i < 12);
+        dut->eval();
+        if (dut->wr_en) pushed.push_back(dut->wr_data);
+        tick();
+    }
+    dut->tx_full = 1;  // Hold the generator from here on
+    BOOST_CHECK_EQUAL_COLLECTIONS(pushed.begin(), pushed.end(),
+                                  expected.begin(), expected.begin() + pushed.size());
+    BOOST_CHECK_EQUAL(pushed.size(), 20u);
+
+    // A TX_DATA write does not displace the generated byte
+    dut->tx_full = 0;
+    dut->reg_addr = ADDR_TX_DATA;
+    dut->reg_wdata = 0x5A;
+    dut->reg_wen = 1;
+    dut->eval();
+    BOOST_CHECK_EQUAL(dut->wr_en, 1);
+    BOOST_CHECK_EQUAL(dut->wr_data, expected[20]);
+    tick();
+    dut->reg_wen = 0;
+    dut->tx_full = 1;
+
+    // Checker: any phase of the sequence, one flipped bit counts three
+    // times, the first two bytes only fill the history
+    state = 0x1234;
+    for (int i = 0; i < 40; i++) fifo.push_back(uart_reg::prbs15_byte(state));
+    fifo[10] ^= 0x10;
+    for (int i = 0; i < 100; i++) fifo_tick();
+    BOOST_CHECK(fifo.empty());
+    BOOST_CHECK_EQUAL(read_reg(ADDR_RX_DATA), 0u);
+    BOOST_CHECK_EQUAL((read_reg(ADDR_STATUS) >> 24) & 1, 1u);  // PRBS_LOCK
+
+    write_reg(ADDR_PERF_CTRL, 0x00000106);  // SNAPSHOT, SEL=6 PRBS_BITS
+    BOOST_CHECK_EQUAL(read_reg(ADDR_PERF_DATA), 8u * 38);
+    write_reg(ADDR_PERF_CTRL, 0x00000007);  // PRBS_ERRS
+    BOOST_CHECK_EQUAL(read_reg(ADDR_PERF_DATA), 3u);
+
+    // Clearing PRBS_EN unlocks and restarts from the seed
+    write_reg(ADDR_CTRL, 0x00000000);
+    BOOST_CHECK_EQUAL((read_reg(ADDR_STATUS) >> 24) & 1, 0u);
+    dut->tx_full = 0;
+    write_reg(ADDR_CTRL, 0x00000400);
+    dut->eval();
+    BOOST_CHECK_EQUAL(dut->wr_data, expected[0]);
+}
+
+// Test 37: Autobaud result loads BAUD_DIV/BAUD_FRAC, clears CTRL.AUTOBAUD
+// and raises INT_STATUS.AUTOBAUD
+BOOST_FIXTURE_TEST_CASE(uart_regs_autobaud_load, UartRegsFixture) {
+    reset();
+    write_reg(ADDR_INT_ENABLE, 0x00000080);  // AUTOBAUD only
+    write_reg(ADDR_CTRL, 0x00001002);        // RX_EN + AUTOBAUD
+    BOOST_CHECK_EQUAL(dut->autobaud_en, 1);
+    BOOST_CHECK_EQUAL(dut->irq, 0);
+
+    dut->autobaud_div = 0x0123;
+    dut->autobaud_frac = 0x15;
+    dut->autobaud_done = 1;
+    tick();
+    dut->autobaud_done = 0;
+
+    BOOST_CHECK_EQUAL(dut->autobaud_en, 0);
+    BOOST_CHECK_EQUAL(dut->baud_divisor, 0x0123);
+    BOOST_CHECK_EQUAL(dut->baud_frac, 0x15);
+    BOOST_CHECK_EQUAL(read_reg(ADDR_CTRL), 0x00000002u);  // Other bits kept
+    BOOST_CHECK_EQUAL(read_reg(ADDR_BAUD_DIV), 0x00000123u);
+    BOOST_CHECK_EQUAL(read_reg(ADDR_BAUD_FRAC), 0x00000015u);
+    BOOST_CHECK_EQUAL(read_reg(ADDR_INT_STATUS) & 0x80, 0x80u);
+    BOOST_CHECK_EQUAL(read_reg(ADDR_ISR_SNAPSHOT) & 0xFF, 0x80u);
+    BOOST_CHECK_EQUAL(dut->irq, 1);
+
+    write_reg(ADDR_INT_STATUS, 0x00000080);  // W1C
+    BOOST_CHECK_EQUAL(dut->irq, 0);
+
+    // A register write on the load cycle wins
+    write_reg(ADDR_CTRL, 0x00001002);
+    dut->autobaud_done = 1;
+    write_reg(ADDR_BAUD_DIV, 0x00000007);
+    dut->autobaud_done = 0;
+    BOOST_CHECK_EQUAL(read_reg(ADDR_BAUD_DIV), 0x00000007u);
+    BOOST_CHECK_EQUAL(read_reg(ADDR_BAUD_FRAC), 0x00000015u);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
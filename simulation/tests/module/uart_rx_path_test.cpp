@@ -12,52 +12,51 @@
  * - Multiple byte reception
  * - Back-to-back frames
  * - Duplicate write prevention
+ * - 8x oversampling (osr_sel)
+ * - rx_hold / rx_line (autobaud): line hidden from uart_rx, still visible
  */
 
 #include "Vuart_rx_path.h"
 #include <boost/test/unit_test.hpp>
 #include <verilated.h>
+#include "dut_driver.h"
 #include <vector>
 
+DUT_DRIVER_PORTS(Vuart_rx_path, uart_clk, rst_n);
+
 BOOST_AUTO_TEST_SUITE(UartRXPath_ModuleTests)
 
-struct UartRXPathFixture {
-    Vuart_rx_path* dut;
-    int cycle_count;
+struct UartRXPathFixture : DutDriver<Vuart_rx_path> {
+    int osr;  // sample_ticks per bit (osr_sel)
 
     UartRXPathFixture() {
-        dut = new Vuart_rx_path;
-        cycle_count = 0;
+        osr = 16;
 
         // Initialize inputs
-        dut->uart_clk = 0;
-        dut->rst_n = 0;
         dut->sample_tick = 0;
+        dut->osr_sel = 0;
         dut->rx_serial = 1;  // Idle high
+        dut->rx_hold = 0;
         dut->rd_en = 0;
-    }
 
-    ~UartRXPathFixture() {
-        delete dut;
-    }
-
-    void tick() {
-        dut->uart_clk = 0;
-        dut->eval();
-        dut->uart_clk = 1;
-        dut->eval();
-        cycle_count++;
+        // Trace triggers (UART_TRACE_TRIGGER)
+        trace_trigger("frame_error", [this] { return dut->frame_error != 0; });
+        trace_trigger("overrun", [this] { return dut->overrun_error != 0; });
     }
 
     void reset() {
-        dut->rst_n = 0;
         dut->sample_tick = 0;
         dut->rx_serial = 1;
+        dut->rx_hold = 0;
         dut->rd_en = 0;
-        for (int i = 0; i < 5; i++) tick();
-        dut->rst_n = 1;
-        tick();
-        cycle_count = 0;
+        set_oversample(16);
+        pulse_reset();
+    }
+
+    // Helper: Select 16x, 8x or 4x oversampling (osr_sel 00 / 01 / 10)
+    void set_oversample(int rate) {
+        osr = rate;
+        dut->osr_sel = (rate == 8) ? 1 : (rate == 4) ? 2 : 0;
     }
 
     // Helper: Generate sample tick pulse
@@ -67,25 +66,27 @@ struct UartRXPathFixture {
         dut->sample_tick = 0;
     }
 
+    // Helper: Hold the line at one level for a bit period (osr ticks)
+    void send_bit(uint8_t level) {
+        dut->rx_serial = level;
+        for (int i = 0; i < osr; i++) tick_with_sample();
+    }
+
     // Helper: Send serial frame (start + 8 data bits + stop)
     void send_frame(uint8_t data) {
         // Idle (high)
-        dut->rx_serial = 1;
-        for (int i = 0; i < 16; i++) tick_with_sample();
+        send_bit(1);
 
         // Start bit (low)
-        dut->rx_serial = 0;
-        for (int i = 0; i < 16; i++) tick_with_sample();
+        send_bit(0);
 
         // Data bits (LSB first)
         for (int bit = 0; bit < 8; bit++) {
-            dut->rx_serial = (data >> bit) & 1;
-            for (int i = 0; i < 16; i++) tick_with_sample();
+            send_bit((data >> bit) & 1);
         }
 
         // Stop bit (high)
-        dut->rx_serial = 1;
-        for (int i = 0; i < 16; i++) tick_with_sample();
+        send_bit(1);
 
         // Wait for FIFO write to complete
         for (int i = 0; i < 10; i++) tick_with_sample();
@@ -97,18 +98,15 @@ struct UartRXPathFixture {
     // Helper: Send frame with invalid stop bit (for error testing)
     void send_frame_invalid_stop(uint8_t data) {
         // Start bit
-        dut->rx_serial = 0;
-        for (int i = 0; i < 16; i++) tick_with_sample();
+        send_bit(0);
 
         // Data bits
         for (int bit = 0; bit < 8; bit++) {
-            dut->rx_serial = (data >> bit) & 1;
-            for (int i = 0; i < 16; i++) tick_with_sample();
+            send_bit((data >> bit) & 1);
         }
 
         // Stop bit (INVALID - should be high but we send low)
-        dut->rx_serial = 0;
-        for (int i = 0; i < 16; i++) tick_with_sample();
+        send_bit(0);
 
         // Wait for error detection
         for (int i = 0; i < 10; i++) tick_with_sample();
@@ -300,17 +298,15 @@ BOOST_FIXTURE_TEST_CASE(uart_rx_path_active_flag, UartRXPathFixture) {
     BOOST_CHECK_EQUAL(dut->rx_active, 1);
 
     // Complete the frame
-    for (int i = 0; i < 15; i++) tick_with_sample();  // Rest of start bit
+    for (int i = 0; i < osr - 1; i++) tick_with_sample();  // Rest of start bit
 
     // Data bits (all zeros)
-    dut->rx_serial = 0;
     for (int bit = 0; bit < 8; bit++) {
-        for (int i = 0; i < 16; i++) tick_with_sample();
+        send_bit(0);
     }
 
     // Stop bit
-    dut->rx_serial = 1;
-    for (int i = 0; i < 16; i++) tick_with_sample();
+    send_bit(1);
 
     // Wait for write to FIFO
     for (int i = 0; i < 10; i++) tick_with_sample();
@@ -383,4 +379,47 @@ BOOST_FIXTURE_TEST_CASE(uart_rx_path_data_patterns, UartRXPathFixture) {
     }
 }
 
+// Test 15: 8x oversampling through bit_sync into the FIFO
+// (uart_clk-rate sample_tick: the 3-cycle sync latency still lands the
+// sample inside each 8-tick bit; 4x at this tick rate would not)
+BOOST_FIXTURE_TEST_CASE(uart_rx_path_oversample_8x, UartRXPathFixture) {
+    reset();
+    set_oversample(8);
+
+    std::vector<uint8_t> patterns = {0xA5, 0x00, 0xFF, 0x3C};
+    for (uint8_t pattern : patterns) {
+        send_frame(pattern);
+    }
+    BOOST_CHECK_EQUAL(dut->rx_level, patterns.size());
+    BOOST_CHECK_EQUAL(dut->frame_error, 0);
+
+    for (uint8_t pattern : patterns) {
+        BOOST_CHECK_EQUAL(read_fifo(), pattern);
+    }
+    BOOST_CHECK_EQUAL(dut->rx_empty, 1);
+}
+
+// Test 16: rx_hold hides the line from uart_rx; rx_line still follows it
+BOOST_FIXTURE_TEST_CASE(uart_rx_path_hold, UartRXPathFixture) {
+    reset();
+
+    dut->rx_hold = 1;
+    bool line_seen_low = false;
+    dut->rx_serial = 0;
+    for (int i = 0; i < 4; i++) {
+        tick_with_sample();
+        if (!dut->rx_line) line_seen_low = true;
+    }
+    BOOST_CHECK(line_seen_low);   // Synchronized after the bit_sync stages
+    send_frame(0x55);
+    BOOST_CHECK_EQUAL(dut->rx_active, 0);
+    BOOST_CHECK_EQUAL(dut->rx_empty, 1);
+    BOOST_CHECK_EQUAL(dut->frame_error, 0);
+
+    // Released on an idle line: the next frame is received as usual
+    dut->rx_hold = 0;
+    send_frame(0xC3);
+    BOOST_CHECK_EQUAL(read_fifo(), 0xC3);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -1,13 +1,14 @@
 /*
  * uart_rx Module Tests
  *
- * Tests UART receiver with 8N1 format and 16× oversampling
+ * Tests UART receiver with 8N1 format and 16× (8×, 4×) oversampling
  *
  * Test Coverage:
  * - Reset behavior
  * - Start bit detection
  * - Start bit validation (false start detection)
  * - Data bit sampling at bit center (count 8 of 16)
+ * - 8× and 4× oversampling (osr_sel)
  * - LSB-first deserialization
  * - Stop bit validation
  * - Frame error detection
@@ -19,47 +20,41 @@
 #include "Vuart_rx.h"
 #include <boost/test/unit_test.hpp>
 #include <verilated.h>
+#include "dut_driver.h"
 #include <vector>
 
+DUT_DRIVER_PORTS(Vuart_rx, uart_clk, rst_n);
+
 BOOST_AUTO_TEST_SUITE(UartRX_ModuleTests)
 
-struct UartRXFixture {
-    Vuart_rx* dut;
-    int cycle_count;
+struct UartRXFixture : DutDriver<Vuart_rx> {
+    int osr;  // sample_ticks per bit (osr_sel)
 
     UartRXFixture() {
-        dut = new Vuart_rx;
-        cycle_count = 0;
+        osr = 16;
 
         // Initialize inputs
-        dut->uart_clk = 0;
-        dut->rst_n = 0;
         dut->sample_tick = 0;
+        dut->osr_sel = 0;
         dut->rx_serial_sync = 1;  // Idle high
         dut->rx_ready = 0;
-    }
 
-    ~UartRXFixture() {
-        delete dut;
-    }
-
-    void tick() {
-        dut->uart_clk = 0;
-        dut->eval();
-        dut->uart_clk = 1;
-        dut->eval();
-        cycle_count++;
+        // Trace triggers (UART_TRACE_TRIGGER)
+        trace_trigger("frame_error", [this] { return dut->frame_error != 0; });
     }
 
     void reset() {
-        dut->rst_n = 0;
         dut->sample_tick = 0;
         dut->rx_serial_sync = 1;
         dut->rx_ready = 0;
-        for (int i = 0; i < 5; i++) tick();
-        dut->rst_n = 1;
-        tick();
-        cycle_count = 0;
+        set_oversample(16);
+        pulse_reset();
+    }
+
+    // Helper: Select 16x, 8x or 4x oversampling (osr_sel 00 / 01 / 10)
+    void set_oversample(int rate) {
+        osr = rate;
+        dut->osr_sel = (rate == 8) ? 1 : (rate == 4) ? 2 : 0;
     }
 
     // Helper: Generate sample tick pulse
@@ -69,25 +64,27 @@ struct UartRXFixture {
         dut->sample_tick = 0;
     }
 
+    // Helper: Hold the line at one level for a bit period (osr ticks)
+    void send_bit(uint8_t level) {
+        dut->rx_serial_sync = level;
+        for (int i = 0; i < osr; i++) tick_with_sample();
+    }
+
     // Helper: Send serial frame (start + 8 data bits + stop)
     void send_frame(uint8_t data) {
         // Idle (high)
-        dut->rx_serial_sync = 1;
-        for (int i = 0; i < 16; i++) tick_with_sample();
+        send_bit(1);
 
         // Start bit (low)
-        dut->rx_serial_sync = 0;
-        for (int i = 0; i < 16; i++) tick_with_sample();
+        send_bit(0);
 
         // Data bits (LSB first)
         for (int bit = 0; bit < 8; bit++) {
-            dut->rx_serial_sync = (data >> bit) & 1;
-            for (int i = 0; i < 16; i++) tick_with_sample();
+            send_bit((data >> bit) & 1);
         }
 
         // Stop bit (high)
-        dut->rx_serial_sync = 1;
-        for (int i = 0; i < 16; i++) tick_with_sample();
+        send_bit(1);
 
         // Wait a few more cycles for rx_valid to assert
         for (int i = 0; i < 5; i++) tick_with_sample();
@@ -99,18 +96,15 @@ struct UartRXFixture {
     // Helper: Send frame with invalid stop bit (for error testing)
     void send_frame_invalid_stop(uint8_t data) {
         // Start bit
-        dut->rx_serial_sync = 0;
-        for (int i = 0; i < 16; i++) tick_with_sample();
+        send_bit(0);
 
         // Data bits
         for (int bit = 0; bit < 8; bit++) {
-            dut->rx_serial_sync = (data >> bit) & 1;
-            for (int i = 0; i < 16; i++) tick_with_sample();
+            send_bit((data >> bit) & 1);
         }
 
         // Stop bit (INVALID - should be high but we send low)
-        dut->rx_serial_sync = 0;
-        for (int i = 0; i < 16; i++) tick_with_sample();
+        send_bit(0);
     }
 };
 
@@ -286,21 +280,18 @@ BOOST_FIXTURE_TEST_CASE(uart_rx_active_flag, UartRXFixture) {
     BOOST_CHECK_EQUAL(dut->rx_active, 1);
 
     // Stay active through entire frame
-    for (int i = 0; i < 15; i++) tick_with_sample();  // Rest of start bit
+    for (int i = 0; i < osr - 1; i++) tick_with_sample();  // Rest of start bit
 
     for (int bit = 0; bit < 8; bit++) {
         dut->rx_serial_sync = 0;
-        for (int i = 0; i < 16; i++) {
+        for (int i = 0; i < osr; i++) {
             tick_with_sample();
             BOOST_CHECK_EQUAL(dut->rx_active, 1);
         }
     }
 
     // Stop bit
-    dut->rx_serial_sync = 1;
-    for (int i = 0; i < 16; i++) {
-        tick_with_sample();
-    }
+    send_bit(1);
 
     // Wait for rx_valid to assert
     for (int i = 0; i < 5; i++) tick_with_sample();
@@ -365,4 +356,45 @@ BOOST_FIXTURE_TEST_CASE(uart_rx_valid_held, UartRXFixture) {
     BOOST_CHECK_EQUAL(dut->rx_valid, 0);
 }
 
+// Test 15: 8x and 4x oversampling - frames, timing and frame error
+BOOST_FIXTURE_TEST_CASE(uart_rx_oversample_modes, UartRXFixture) {
+    std::vector<uint8_t> test_data = {0xA5, 0x00, 0xFF, 0x3C};
+
+    for (int rate : {8, 4}) {
+        reset();
+        set_oversample(rate);
+
+        for (uint8_t expected : test_data) {
+            send_frame(expected);
+
+            BOOST_CHECK_EQUAL(dut->rx_valid, 1);
+            BOOST_CHECK_EQUAL(dut->rx_data, expected);
+            BOOST_CHECK_EQUAL(dut->frame_error, 0);
+
+            dut->rx_ready = 1;
+            tick();
+            dut->rx_ready = 0;
+            BOOST_CHECK_EQUAL(dut->rx_active, 0);
+        }
+
+        // A frame lasts 10 x rate ticks: valid one tick after the stop bit
+        dut->rx_serial_sync = 1;
+        tick_with_sample();
+        send_bit(0);
+        for (int bit = 0; bit < 8; bit++) send_bit(1);
+        send_bit(1);
+        BOOST_CHECK_EQUAL(dut->rx_valid, 0);
+        tick_with_sample();
+        BOOST_CHECK_EQUAL(dut->rx_valid, 1);
+        BOOST_CHECK_EQUAL(dut->rx_data, 0xFF);
+        dut->rx_ready = 1;
+        tick();
+        dut->rx_ready = 0;
+
+        // Stop bit sampled at the shorter bit center
+        send_frame_invalid_stop(0x55);
+        BOOST_CHECK_EQUAL(dut->frame_error, 1);
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
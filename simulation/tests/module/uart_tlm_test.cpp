@@ -0,0 +1,484 @@
+/*
+ * UartTlm Model Tests
+ *
+ * Checks the transaction-level uart_top model against the Verilated RTL in
+ * lockstep (UartLockstep), plus standalone TLM throughput
+ *
+ * Test Coverage:
+ * - Register reset values and read/write masks
+ * - TX stream: FIFO levels, frame timing, transmitted bytes
+ * - RX stream: prefetch holding buffer, FIFO fill, overrun
+ * - Frame error, sticky flags, W1C and RX FIFO reset
+ * - Interrupt output
+ * - RX character timeout
+ * - Packed TX_DATA/RX_DATA access
+ * - Fractional baud divisor (BAUD_FRAC) frame timing
+ * - 8x oversampling (CTRL.OSR) frame timing and RX timeout
+ * - PERF_CTRL/PERF_DATA performance counters
+ * - FRAME_ERRS counts every bad frame while STATUS.FRAME_ERR stays set
+ * - Internal loopback (CTRL.LOOPBACK) and the PRBS self-test counters
+ * - Lockstep comparator reports divergence
+ * - TLM long-run throughput
+ */
+
+#include <boost/test/unit_test.hpp>
+#include <verilated.h>
+#include "uart_rtl_model.h"
+#include "uart_tlm.h"
+#include "uart_model.h"
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(UartTlm_ModuleTests)
+
+struct UartTlmFixture {
+    UartRtlModel rtl;
+    UartTlm tlm;
+    UartLockstep ls;
+
+    UartTlmFixture() : ls(rtl, tlm) {}
+
+    void reset() {
+        ls.reset();
+
+        // Realistic divisor so frame timing is exercised (64 clocks per bit)
+        ls.write_reg(uart_reg::BAUD_DIV, 0x00000004);
+    }
+
+    void check_in_sync() {
+        std::vector<std::string> errors = ls.mismatches();
+        for (const std::string& e : errors) {
+            BOOST_TEST_MESSAGE(e);
+        }
+        BOOST_CHECK_MESSAGE(errors.empty(),
+                            errors.size() << " lockstep mismatch(es), first: "
+                            << (errors.empty() ? "" : errors.front()));
+    }
+};
+
+// Test 1: Reset values and register masks match
+BOOST_FIXTURE_TEST_CASE(uart_tlm_register_map, UartTlmFixture) {
+    reset();
+
+    for (uint8_t addr = uart_reg::CTRL; addr <= uart_reg::PERF_DATA; addr++) {
+        ls.read_reg(addr);
+    }
+
+    // Reserved bits must be dropped the same way
+    ls.write_reg(uart_reg::CTRL, 0xFFFFFFFC);
+    ls.write_reg(uart_reg::INT_ENABLE, 0xFFFFFFFF);
+    ls.write_reg(uart_reg::BAUD_DIV, 0xFFFF0004);
+    ls.write_reg(uart_reg::FIFO_THRESH, 0xFFFFFFFF);
+    ls.write_reg(uart_reg::RX_TIMEOUT, 0xFFFFFFFF);
+    ls.write_reg(uart_reg::BAUD_FRAC, 0xFFFFFFFF);
+    ls.write_reg(uart_reg::FLOW_CTRL, 0xFFFFFFFF);
+    BOOST_CHECK_EQUAL(ls.read_reg(uart_reg::CTRL), 0x00001FFCu);  // PACK_EN ... AUTOBAUD
+    BOOST_CHECK_EQUAL(ls.read_reg(uart_reg::INT_ENABLE), 0x000000FFu);
+    BOOST_CHECK_EQUAL(ls.read_reg(uart_reg::BAUD_DIV), 0x00000004u);
+    BOOST_CHECK_EQUAL(ls.read_reg(uart_reg::FIFO_THRESH), 0x000F000Fu);  // 8-deep: 4-bit levels
+    BOOST_CHECK_EQUAL(ls.read_reg(uart_reg::RX_TIMEOUT), 0x000000FFu);
+    BOOST_CHECK_EQUAL(ls.read_reg(uart_reg::BAUD_FRAC), 0x0000003Fu);
+    BOOST_CHECK_EQUAL(ls.read_reg(uart_reg::FLOW_CTRL), 0x0000000Fu);
+
+    check_in_sync();
+}
+
+// Test 2: TX stream (FIFO drain, levels while polling, bytes on the line)
+BOOST_FIXTURE_TEST_CASE(uart_tlm_tx_stream, UartTlmFixture) {
+    reset();
+    ls.write_reg(uart_reg::CTRL, 0x00000003);
+
+    std::vector<uint8_t> tx_data = {0x55, 0xAA, 0x00, 0xFF, 0x3C, 0x81};
+    for (uint8_t byte : tx_data) {
+        ls.write_reg(uart_reg::TX_DATA, byte);
+    }
+
+    // Poll STATUS like a driver would while the FIFO drains
+    for (int i = 0; i < 30; i++) {
+        ls.read_reg(uart_reg::STATUS);
+        ls.run_cycles(160);
+    }
+    ls.run_cycles(1000);
+
+    uint32_t status = ls.read_reg(uart_reg::STATUS);
+    BOOST_CHECK(status & uart_reg::STATUS_TX_EMPTY);
+    BOOST_CHECK(!(status & uart_reg::STATUS_TX_ACTIVE));
+
+    std::vector<uint8_t> received;
+    uint8_t byte;
+    while (ls.recv_byte(byte)) received.push_back(byte);
+    BOOST_CHECK_EQUAL_COLLECTIONS(received.begin(), received.end(),
+                                  tx_data.begin(), tx_data.end());
+
+    check_in_sync();
+}
+
+// Test 3: RX stream into a full FIFO (holding buffer + 8, then overrun)
+BOOST_FIXTURE_TEST_CASE(uart_tlm_rx_overrun, UartTlmFixture) {
+    reset();
+    ls.write_reg(uart_reg::CTRL, 0x00000003);
+
+    std::vector<uint8_t> rx_data;
+    for (int i = 0; i < 11; i++) {
+        rx_data.push_back(0x10 + i);
+        ls.send_byte(rx_data.back());
+    }
+    ls.run_cycles(11 * 176 * 4 + 500);
+
+    uint32_t status = ls.read_reg(uart_reg::STATUS);
+    BOOST_CHECK(status & uart_reg::STATUS_RX_FULL);
+    BOOST_CHECK(status & uart_reg::STATUS_OVERRUN);
+    BOOST_CHECK_EQUAL((status >> 16) & 0xFF, 8u);
+    ls.read_reg(uart_reg::INT_STATUS);
+
+    // Two held bytes first, then the 8 FIFO entries; 11th byte lost
+    for (int i = 0; i < 10; i++) {
+        uint32_t data = ls.read_reg(uart_reg::RX_DATA);
+        BOOST_CHECK_EQUAL(data, (uint32_t)rx_data[i]);
+    }
+
+    status = ls.read_reg(uart_reg::STATUS);
+    BOOST_CHECK(status & uart_reg::STATUS_RX_EMPTY);
+    BOOST_CHECK(status & uart_reg::STATUS_OVERRUN);
+
+    check_in_sync();
+}
+
+// Test 4: Frame error, irq, W1C while the source persists, RX FIFO reset
+BOOST_FIXTURE_TEST_CASE(uart_tlm_frame_error_irq, UartTlmFixture) {
+    reset();
+    ls.write_reg(uart_reg::CTRL, 0x00000003);
+    ls.write_reg(uart_reg::INT_ENABLE, 0x00000004);  // FRAME_ERR only
+
+    BOOST_CHECK(!ls.irq());
+    ls.send_byte(0xA5, true);
+    ls.run_cycles(160 * 4 + 200);
+
+    BOOST_CHECK(ls.irq());
+    BOOST_CHECK(ls.read_reg(uart_reg::STATUS) & uart_reg::STATUS_FRAME_ERR);
+    BOOST_CHECK(ls.read_reg(uart_reg::INT_STATUS) & 0x4);
+
+    // RX path flag is sticky, so W1C alone does not clear it
+    ls.write_reg(uart_reg::INT_STATUS, 0x00000004);
+    BOOST_CHECK(ls.read_reg(uart_reg::INT_STATUS) & 0x4);
+
+    // RX FIFO reset clears the path flag; W1C now sticks
+    ls.write_reg(uart_reg::FIFO_CTRL, 0x00000002);
+    ls.write_reg(uart_reg::INT_STATUS, 0x00000004);
+    BOOST_CHECK(!(ls.read_reg(uart_reg::INT_STATUS) & 0x4));
+    BOOST_CHECK(!(ls.read_reg(uart_reg::STATUS) & uart_reg::STATUS_FRAME_ERR));
+    BOOST_CHECK(!ls.irq());
+
+    // Received byte is still in the holding register
+    BOOST_CHECK_EQUAL(ls.read_reg(uart_reg::RX_DATA), 0xA5u);
+
+    check_in_sync();
+}
+
+// Test 5: RX character timeout below the watermark, restart on RX_DATA read
+BOOST_FIXTURE_TEST_CASE(uart_tlm_rx_timeout, UartTlmFixture) {
+    reset();
+    ls.write_reg(uart_reg::FIFO_THRESH, 0x00080000);  // RX_HIGH_WM = 8
+    ls.write_reg(uart_reg::RX_TIMEOUT, 0x00000008);   // 8 bit times
+    ls.write_reg(uart_reg::INT_ENABLE, 0x00000040);   // RX_TIMEOUT only
+    ls.write_reg(uart_reg::CTRL, 0x00000003);
+
+    ls.send_byte(0x31);
+    ls.send_byte(0x32);
+    ls.run_cycles(2 * 176 * 4);
+    BOOST_CHECK(!ls.irq());
+
+    // 8 bits x 64 clocks after the last byte
+    ls.run_cycles(8 * 64 + 200);
+    BOOST_CHECK(ls.irq());
+    BOOST_CHECK(ls.read_reg(uart_reg::INT_STATUS) & uart_reg::INT_RX_TIMEOUT);
+
+    // Reading a byte restarts the timer; W1C sticks until it expires again
+    BOOST_CHECK_EQUAL(ls.read_reg(uart_reg::RX_DATA), 0x31u);
+    ls.write_reg(uart_reg::INT_STATUS, uart_reg::INT_RX_TIMEOUT);
+    BOOST_CHECK(!ls.irq());
+    ls.run_cycles(8 * 64 + 200);
+    BOOST_CHECK(ls.irq());
+
+    // Draining the last byte disarms it
+    BOOST_CHECK_EQUAL(ls.read_reg(uart_reg::RX_DATA), 0x32u);
+    ls.write_reg(uart_reg::INT_STATUS, uart_reg::INT_RX_TIMEOUT);
+    ls.run_cycles(4 * 8 * 64);
+    BOOST_CHECK(!ls.irq());
+
+    check_in_sync();
+}
+
+// Test 6: Packed TX (wstrb lanes) and packed RX (count + up to 3 bytes)
+BOOST_FIXTURE_TEST_CASE(uart_tlm_packed_access, UartTlmFixture) {
+    reset();
+    ls.write_reg(uart_reg::CTRL, 0x00000007);  // TX_EN + RX_EN + PACK_EN
+
+    uint64_t start = ls.cycles();
+    ls.write_reg(uart_reg::TX_DATA, 0x44332211, 0xF);
+    ls.write_reg(uart_reg::TX_DATA, 0x00660055, 0x5);
+    BOOST_CHECK_EQUAL(ls.cycles() - start, 2u + 4u + 2u);  // 1 + lanes each
+
+    std::vector<uint8_t> rx_data = {0x10, 0x11, 0x12, 0x13, 0x14};
+    for (uint8_t byte : rx_data) ls.send_byte(byte);
+    ls.run_cycles(6 * 176 * 4 + 500);
+
+    BOOST_CHECK_EQUAL(ls.read_reg(uart_reg::RX_DATA), 0x03121110u);
+    ls.run_cycles(2);
+    BOOST_CHECK_EQUAL(ls.read_reg(uart_reg::RX_DATA), 0x02001413u);
+    BOOST_CHECK_EQUAL(ls.read_reg(uart_reg::RX_DATA), 0x00000000u);
+
+    std::vector<uint8_t> expected = {0x11, 0x22, 0x33, 0x44, 0x55, 0x66};
+    std::vector<uint8_t> received;
+    uint8_t byte;
+    while (ls.recv_byte(byte)) received.push_back(byte);
+    BOOST_CHECK_EQUAL_COLLECTIONS(received.begin(), received.end(),
+                                  expected.begin(), expected.end());
+
+    check_in_sync();
+}
+
+// Test 7: Comparator flags a divergent model
+BOOST_AUTO_TEST_CASE(uart_tlm_lockstep_detects_divergence) {
+    UartTlm golden;
+    UartTlm model;
+    UartLockstep ls(golden, model);
+    ls.reset();
+
+    // Stimulus applied to one side only
+    model.write_reg(uart_reg::INT_ENABLE, 0x00000003);
+    golden.run_cycles(1);
+
+    ls.read_reg(uart_reg::INT_ENABLE);
+    BOOST_CHECK(!ls.in_sync());
+}
+
+// Test 8: TLM long runs (1000 frames, then a 1e9-cycle idle gap)
+BOOST_AUTO_TEST_CASE(uart_tlm_throughput) {
+    UartTlm uart;
+    uart.reset();
+    uart.write_reg(uart_reg::BAUD_DIV, 0x00000004);
+    uart.write_reg(uart_reg::CTRL, 0x00000001);
+
+    int received = 0;
+    for (int i = 0; i < 1000; i++) {
+        uart.write_reg(uart_reg::TX_DATA, i & 0xFF);
+        uart.run_cycles(700);
+
+        uint8_t byte;
+        if (uart.recv_byte(byte) && byte == (i & 0xFF)) received++;
+    }
+    BOOST_CHECK_EQUAL(received, 1000);
+
+    uint64_t start = uart.cycles();
+    uart.run_cycles(1000000000ull);
+    BOOST_CHECK_EQUAL(uart.cycles() - start, 1000000000ull);
+
+    uint32_t status = uart.read_reg(uart_reg::STATUS);
+    BOOST_CHECK(status & uart_reg::STATUS_TX_EMPTY);
+    BOOST_CHECK(!(status & uart_reg::STATUS_TX_ACTIVE));
+}
+
+// Test 9: Fractional divisor - TX and RX frames at BAUD_DIV + BAUD_FRAC/64
+BOOST_FIXTURE_TEST_CASE(uart_tlm_fractional_baud, UartTlmFixture) {
+    reset();
+    ls.write_reg(uart_reg::BAUD_DIV, 0x00000003);
+    ls.write_reg(uart_reg::BAUD_FRAC, 0x00000019);  // 3 + 25/64 cycles per tick
+    ls.write_reg(uart_reg::CTRL, 0x00000003);
+
+    std::vector<uint8_t> tx_data = {0x55, 0xA5, 0x0F, 0xF0};
+    for (uint8_t byte : tx_data) {
+        ls.write_reg(uart_reg::TX_DATA, byte);
+        ls.send_byte(byte ^ 0xFF);
+    }
+
+    // 4 frames of 160 ticks (~542 cycles each); poll STATUS meanwhile
+    for (int i = 0; i < 20; i++) {
+        ls.read_reg(uart_reg::STATUS);
+        ls.run_cycles(150);
+    }
+
+    for (uint8_t byte : tx_data) {
+        BOOST_CHECK_EQUAL(ls.read_reg(uart_reg::RX_DATA), (uint32_t)(byte ^ 0xFF));
+    }
+
+    std::vector<uint8_t> received;
+    uint8_t byte;
+    while (ls.recv_byte(byte)) received.push_back(byte);
+    BOOST_CHECK_EQUAL_COLLECTIONS(received.begin(), received.end(),
+                                  tx_data.begin(), tx_data.end());
+
+    check_in_sync();
+}
+
+// Test 10: 8x oversampling - frames and the RX timeout scale with CTRL.OSR
+BOOST_FIXTURE_TEST_CASE(uart_tlm_oversample_8x, UartTlmFixture) {
+    reset();
+    ls.write_reg(uart_reg::RX_TIMEOUT, 0x00000004);   // 4 bit times
+    ls.write_reg(uart_reg::INT_ENABLE, 0x00000040);   // RX_TIMEOUT only
+    ls.write_reg(uart_reg::CTRL, 0x00000013);         // 8x + TX_EN + RX_EN
+
+    std::vector<uint8_t> tx_data = {0x12, 0xEF, 0x7E};
+    for (uint8_t byte : tx_data) {
+        ls.write_reg(uart_reg::TX_DATA, byte);
+        ls.send_byte(byte);
+    }
+
+    // 3 frames of 80 ticks x 4 cycles, then the timeout; poll irq and STATUS
+    for (int i = 0; i < 40; i++) {
+        ls.read_reg(uart_reg::STATUS);
+        ls.irq();
+        ls.run_cycles(80);
+    }
+    BOOST_CHECK(ls.read_reg(uart_reg::INT_STATUS) & uart_reg::INT_RX_TIMEOUT);
+
+    for (uint8_t byte : tx_data) {
+        BOOST_CHECK_EQUAL(ls.read_reg(uart_reg::RX_DATA), (uint32_t)byte);
+    }
+
+    std::vector<uint8_t> received;
+    uint8_t byte;
+    while (ls.recv_byte(byte)) received.push_back(byte);
+    BOOST_CHECK_EQUAL_COLLECTIONS(received.begin(), received.end(),
+                                  tx_data.begin(), tx_data.end());
+
+    check_in_sync();
+}
+
+// Test 11: Snapshot ISR - ISR_SNAPSHOT + RX_DATA reads, INT_STATUS read-to-clear
+BOOST_FIXTURE_TEST_CASE(uart_tlm_isr_snapshot, UartTlmFixture) {
+    reset();
+    ls.write_reg(uart_reg::FIFO_THRESH, 0x00020000);  // RX_HIGH_WM = 2
+    ls.write_reg(uart_reg::INT_ENABLE, uart_reg::INT_RX_HIGH_WM);
+    ls.write_reg(uart_reg::CTRL, uart_reg::CTRL_RX_EN | uart_reg::CTRL_INT_RTC);
+
+    std::vector<uint8_t> rx_data = {0x31, 0x32, 0x33, 0x34, 0x35, 0x36};
+    for (uint8_t byte : rx_data) ls.send_byte(byte);
+
+    // ISR: one snapshot read gives the pending sources and the RX count,
+    // then only RX_DATA reads; no INT_STATUS write
+    std::vector<uint8_t> received;
+    for (int i = 0; i < 200 && received.size() < rx_data.size(); i++) {
+        ls.run_cycles(64);
+        if (!ls.irq()) continue;
+        uint32_t snapshot = ls.read_reg(uart_reg::ISR_SNAPSHOT);
+        unsigned count = (snapshot >> 16) & 0xFF;
+        for (unsigned n = 0; n < count; n++) {
+            received.push_back(ls.read_reg(uart_reg::RX_DATA) & 0xFF);
+        }
+    }
+    BOOST_CHECK_EQUAL_COLLECTIONS(received.begin(), received.end(),
+                                  rx_data.begin(), rx_data.end());
+
+    check_in_sync();
+}
+
+// Test 12: Performance counters agree after TX, RX, frame error and overrun
+BOOST_FIXTURE_TEST_CASE(uart_tlm_perf_counters, UartTlmFixture) {
+    reset();
+    ls.write_reg(uart_reg::CTRL, uart_reg::CTRL_TX_EN | uart_reg::CTRL_RX_EN);
+    ls.write_reg(uart_reg::PERF_CTRL, uart_reg::PERF_CLEAR);
+
+    for (uint8_t byte : {0x11, 0x22, 0x33, 0x44}) {
+        ls.write_reg(uart_reg::TX_DATA, byte);
+    }
+
+    // 11 bytes with nothing read: 2 held + 8 in the FIFO, then an overrun
+    for (int i = 0; i < 11; i++) {
+        ls.send_byte(0x40 + i, i == 1);
+    }
+    for (int i = 0; i < 100; i++) ls.run_cycles(100);
+
+    ls.write_reg(uart_reg::PERF_CTRL, uart_reg::PERF_SNAPSHOT);
+    const struct { unsigned sel; uint32_t value; } expected[] = {
+        {uart_reg::PERF_TX_BYTES, 4},
+        {uart_reg::PERF_RX_BYTES, 10},
+        {uart_reg::PERF_FRAME_ERRS, 1},
+        {uart_reg::PERF_OVERRUNS, 1},
+        {uart_reg::PERF_RX_HWM, 8},
+    };
+    for (const auto& e : expected) {
+        ls.write_reg(uart_reg::PERF_CTRL, e.sel);
+        BOOST_CHECK_EQUAL(ls.read_reg(uart_reg::PERF_DATA), e.value);
+    }
+
+    // Stall cycles follow frame timing: equal to within a bit time
+    ls.write_reg(uart_reg::PERF_CTRL, uart_reg::PERF_TX_STALLS);
+    int64_t rtl_stalls = rtl.read_reg(uart_reg::PERF_DATA);
+    int64_t tlm_stalls = tlm.read_reg(uart_reg::PERF_DATA);
+    BOOST_CHECK_GT(rtl_stalls, 0);
+    BOOST_CHECK_LE(std::abs(rtl_stalls - tlm_stalls), 64);
+
+    check_in_sync();
+}
+
+// Test 13: Internal loopback, then the PRBS self-test over it
+BOOST_FIXTURE_TEST_CASE(uart_tlm_loopback_prbs, UartTlmFixture) {
+    reset();
+    const uint32_t ctrl = uart_reg::CTRL_TX_EN | uart_reg::CTRL_RX_EN | uart_reg::CTRL_LOOPBACK;
+    ls.write_reg(uart_reg::CTRL, ctrl);
+
+    std::vector<uint8_t> bytes = {0x12, 0xFE, 0x00, 0x99};
+    for (uint8_t byte : bytes) ls.write_reg(uart_reg::TX_DATA, byte);
+    ls.send_byte(0x77);  // uart_rx is not sampled in loopback
+    for (int i = 0; i < 50; i++) {
+        ls.read_reg(uart_reg::STATUS);
+        ls.run_cycles(160);
+    }
+    for (uint8_t byte : bytes) {
+        BOOST_CHECK_EQUAL(ls.read_reg(uart_reg::RX_DATA) & 0xFF, byte);
+    }
+    uint8_t out;
+    BOOST_CHECK(!rtl.recv_byte(out));  // uart_tx held idle
+    BOOST_CHECK(!tlm.recv_byte(out));
+    check_in_sync();
+
+    // PRBS over the loop: locked, error free, bit counts within two bytes
+    ls.write_reg(uart_reg::PERF_CTRL, uart_reg::PERF_CLEAR);
+    ls.write_reg(uart_reg::CTRL, ctrl | uart_reg::CTRL_PRBS_EN);
+    for (int i = 0; i < 100; i++) ls.run_cycles(640);
+    ls.write_reg(uart_reg::PERF_CTRL, uart_reg::PERF_SNAPSHOT | uart_reg::PERF_PRBS_ERRS);
+    BOOST_CHECK_EQUAL(ls.read_reg(uart_reg::PERF_DATA), 0u);
+
+    ls.write_reg(uart_reg::PERF_CTRL, uart_reg::PERF_PRBS_BITS);
+    int64_t rtl_bits = rtl.read_reg(uart_reg::PERF_DATA);
+    int64_t tlm_bits = tlm.read_reg(uart_reg::PERF_DATA);
+    BOOST_CHECK_GT(rtl_bits, 8 * 90);
+    BOOST_CHECK_LE(std::abs(rtl_bits - tlm_bits), 16);
+    BOOST_CHECK(rtl.read_reg(uart_reg::STATUS) & uart_reg::STATUS_PRBS_LOCK);
+    BOOST_CHECK(tlm.read_reg(uart_reg::STATUS) & uart_reg::STATUS_PRBS_LOCK);
+}
+
+// Test 14: FRAME_ERRS counts every bad frame, not just the one that set
+// the sticky STATUS.FRAME_ERR (no RX FIFO reset in between)
+BOOST_FIXTURE_TEST_CASE(uart_tlm_frame_error_count, UartTlmFixture) {
+    reset();
+    ls.write_reg(uart_reg::CTRL, uart_reg::CTRL_TX_EN | uart_reg::CTRL_RX_EN);
+    ls.write_reg(uart_reg::PERF_CTRL, uart_reg::PERF_CLEAR);
+
+    // Bad stop bits on bytes 0, 2 and 4; STATUS polled in between
+    for (int i = 0; i < 6; i++) {
+        ls.send_byte(0x30 + i, i % 2 == 0);
+    }
+    for (int i = 0; i < 50; i++) {
+        ls.read_reg(uart_reg::STATUS);
+        ls.run_cycles(160);
+    }
+    BOOST_CHECK(ls.read_reg(uart_reg::STATUS) & uart_reg::STATUS_FRAME_ERR);
+
+    ls.write_reg(uart_reg::PERF_CTRL, uart_reg::PERF_SNAPSHOT | uart_reg::PERF_FRAME_ERRS);
+    BOOST_CHECK_EQUAL(rtl.read_reg(uart_reg::PERF_DATA), 3u);
+    BOOST_CHECK_EQUAL(tlm.read_reg(uart_reg::PERF_DATA), 3u);
+    ls.write_reg(uart_reg::PERF_CTRL, uart_reg::PERF_RX_BYTES);
+    BOOST_CHECK_EQUAL(ls.read_reg(uart_reg::PERF_DATA), 6u);
+
+    // Bad frames are stored like good ones
+    for (int i = 0; i < 6; i++) {
+        BOOST_CHECK_EQUAL(ls.read_reg(uart_reg::RX_DATA) & 0xFF, 0x30u + i);
+    }
+
+    check_in_sync();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -13,14 +13,41 @@
  * - Interrupt generation
  * - Error detection
  * - End-to-end loopback test
+ * - Idle fast-forward equivalence (PERF counters, pending RX timeout)
+ * - FIFO watermark interrupts
+ * - Deep FIFO build (256 entries, saturating STATUS levels)
+ * - RX character timeout below the watermark
+ * - 8x / 4x oversampling (CTRL.OSR) end to end
+ * - RTS/CTS flow control loopback: zero overruns into a slow reader
+ * - Bulk full-duplex traffic through the packed line model (uart_line.h)
+ * - Internal loopback (CTRL.LOOPBACK) and the PRBS-15 line-rate self-test
+ * - Early TX accept (CTRL.TX_EARLY): latency and start bit on a fresh baud phase
+ * - Autobaud (CTRL.AUTOBAUD): divisor sweep, lock time in bit periods, then
+ *   traffic at the detected rate
+ * - Idle gating build (IDLE_GATING=1): baud tick stopped while idle, RX
+ *   wakes on the start edge, RX timeout still counted, disabled RX isolated
  */
 
 #include "Vuart_top.h"
+#include "Vuart_top___024root.h"
+#include "Vuart_top_deep.h"
+#include "Vuart_top_deep___024root.h"
+#include "Vuart_top_gated.h"
+#include "Vuart_top_gated___024root.h"
 #include <boost/test/unit_test.hpp>
 #include <verilated.h>
+#include "dut_driver.h"
+#include "uart_model.h"
 #include <vector>
 #include <queue>
 
+DUT_DRIVER_PORTS(Vuart_top, uart_clk, rst_n);
+DUT_DRIVER_UART_REGS(Vuart_top, uart_top__DOT__uart_regs_inst);
+DUT_DRIVER_PORTS(Vuart_top_deep, uart_clk, rst_n);
+DUT_DRIVER_UART_REGS(Vuart_top_deep, uart_top__DOT__uart_regs_inst);
+DUT_DRIVER_PORTS(Vuart_top_gated, uart_clk, rst_n);
+DUT_DRIVER_UART_REGS(Vuart_top_gated, uart_top__DOT__uart_regs_inst);
+
 BOOST_AUTO_TEST_SUITE(UartTop_ModuleTests)
 
 // Register offsets (word-addressed)
@@ -31,49 +58,62 @@ constexpr uint8_t ADDR_RX_DATA    = 0x0C >> 2;
 constexpr uint8_t ADDR_BAUD_DIV   = 0x10 >> 2;
 constexpr uint8_t ADDR_INT_ENABLE = 0x14 >> 2;
 constexpr uint8_t ADDR_INT_STATUS = 0x18 >> 2;
-
-struct UartTopFixture {
-    Vuart_top* dut;
-    int cycle_count;
-
-    UartTopFixture() {
-        dut = new Vuart_top;
-        cycle_count = 0;
+constexpr uint8_t ADDR_FIFO_THRESH = 0x20 >> 2;
+constexpr uint8_t ADDR_RX_TIMEOUT  = 0x24 >> 2;
+constexpr uint8_t ADDR_FLOW_CTRL   = 0x2C >> 2;
+constexpr uint8_t ADDR_PERF_CTRL   = 0x34 >> 2;
+constexpr uint8_t ADDR_PERF_DATA   = 0x38 >> 2;
+
+// Register-port harness for every uart_top build (Vuart_top, deep FIFO,
+// idle gated)
+template <typename Model>
+struct UartTopFixtureT : DutDriver<Model> {
+    using DutDriver<Model>::dut;
+    using DutDriver<Model>::tick;
+    using DutDriver<Model>::run_cycles;
+    using DutDriver<Model>::run_until;
+    using DutDriver<Model>::drive_bits;
+    using DutDriver<Model>::sample_bits;
+    using DutDriver<Model>::pulse_reset;
+    using DutDriver<Model>::fast_forward;
+    using DutDriver<Model>::trace_trigger;
+
+    uint32_t baud_divisor;  // Last value written to BAUD_DIV
+    uint32_t ticks_per_bit; // CTRL.OSR: 16, 8 or 4
+
+    UartTopFixtureT() {
+        baud_divisor = 4;  // BAUD_DIV reset value
+        ticks_per_bit = 16;
 
         // Initialize inputs
-        dut->uart_clk = 0;
-        dut->rst_n = 0;
         dut->uart_rx = 1;  // Idle high
+        dut->uart_cts_n = 0;  // Clear to send (CTS_EN off by default)
+        dut->ext_baud_tick = 0;  // Internal baud_gen (EXT_BAUD_TICK=0)
         dut->reg_addr = 0;
         dut->reg_wdata = 0;
+        dut->reg_wstrb = 0xF;
         dut->reg_wen = 0;
         dut->reg_ren = 0;
-    }
 
-    ~UartTopFixture() {
-        delete dut;
-    }
+        // Stream ports unused
+        dut->s_axis_tdata = 0;
+        dut->s_axis_tvalid = 0;
+        dut->m_axis_tready = 0;
 
-    void tick() {
-        dut->uart_clk = 0;
-        dut->eval();
-        dut->uart_clk = 1;
-        dut->eval();
-        cycle_count++;
+        // Trace triggers (UART_TRACE_TRIGGER)
+        trace_trigger("irq", [this] { return dut->irq != 0; });
     }
 
     void reset() {
-        dut->rst_n = 0;
         dut->reg_wen = 0;
         dut->reg_ren = 0;
         dut->uart_rx = 1;
-        for (int i = 0; i < 5; i++) tick();
-        dut->rst_n = 1;
-        tick();
-        cycle_count = 0;
+        dut->uart_cts_n = 0;
+        pulse_reset();
 
         // Set baud divisor to 1 for simplified timing (16 clocks per bit)
         write_reg(ADDR_BAUD_DIV, 0x00000001);
+        ticks_per_bit = 16;
     }
 
     // Helper: Write register
@@ -83,6 +123,17 @@ struct UartTopFixture {
         dut->reg_wen = 1;
         tick();
         dut->reg_wen = 0;
+
+        if (addr == ADDR_BAUD_DIV) baud_divisor = data & 0xFFFF;
+        if (addr == ADDR_CTRL) {
+            uint32_t osr = (data >> 4) & 0x3;
+            ticks_per_bit = (osr == 1) ? 8 : (osr == 2) ? 4 : 16;
+        }
+    }
+
+    // Helper: Clocks per bit on the serial lines (OSR x BAUD_DIV)
+    unsigned bit_cycles() const {
+        return ticks_per_bit * (baud_divisor ? baud_divisor : 1);
     }
 
     // Helper: Read register
@@ -95,51 +146,100 @@ struct UartTopFixture {
         return dut->reg_rdata;
     }
 
+    // Helper: Read RX_DATA, captured on the access cycle (before the edge)
+    // as axi_lite_slave_if does. read_reg() samples two cycles later, after
+    // the prefetch has already moved the next byte into view.
+    uint32_t read_rx_data() {
+        dut->reg_addr = ADDR_RX_DATA;
+        dut->reg_ren = 1;
+        dut->eval();
+        uint32_t value = dut->reg_rdata;
+        tick();
+        dut->reg_ren = 0;
+        tick();
+        return value;
+    }
+
+    // Helper: Quiescence probe for fast-forward: both serial lines high
+    // and uart_regs_quiescent() (tests using the fixture leave BAUD_FRAC
+    // at 0, so the baud period is the divisor)
+    bool uart_quiescent() {
+        if (!dut->uart_rx || !dut->uart_tx) return false;
+        return uart_regs_quiescent([this](uint8_t addr) { return read_reg(addr); });
+    }
+
+    // Helper: Idle for n cycles (inputs static), skipping evaluation while
+    // quiescent. Cycle-exact with respect to simulating every clock.
+    void run_idle(uint64_t n) {
+        fast_forward(n, baud_divisor ? baud_divisor : 1,
+                     [this] { return uart_quiescent(); });
+    }
+
     // Helper: Send UART frame on RX line
     void send_uart_frame(uint8_t data) {
-        // Start bit
-        dut->uart_rx = 0;
-        for (int i = 0; i < 16; i++) tick();
-
-        // Data bits (LSB first)
-        for (int bit = 0; bit < 8; bit++) {
-            dut->uart_rx = (data >> bit) & 1;
-            for (int i = 0; i < 16; i++) tick();
-        }
-
-        // Stop bit
-        dut->uart_rx = 1;
-        for (int i = 0; i < 16; i++) tick();
+        // Start bit, data bits (LSB first), stop bit: one bit time each
+        // (16 clocks at BAUD_DIV=1, 16x)
+        drive_bits([this](uint8_t bit) { dut->uart_rx = bit; },
+                   uart_frame_bits(data), bit_cycles());
 
         // Extra time for processing
-        for (int i = 0; i < 20; i++) tick();
+        run_cycles(20);
     }
 
     // Helper: Receive UART frame from TX line
     uint8_t receive_uart_frame() {
-        uint8_t data = 0;
-
         // Wait for start bit (falling edge)
-        int timeout = 1000;
-        while (dut->uart_tx && timeout-- > 0) tick();
-        if (timeout <= 0) return 0xFF;  // Timeout
+        if (!run_until([this] { return !dut->uart_tx; }, 1000)) {
+            return 0xFF;  // Timeout
+        }
 
         // Sample data bits at middle of each bit period
         // With baud_divisor=1, each bit is 16 clocks (16 baud_ticks)
         // Bit timing: Start[0-15], Bit0[16-31], Bit1[32-47], ...
-        // Sample at middle (tick 8) of each bit period
-        for (int bit = 0; bit < 8; bit++) {
-            // First bit: advance 24 ticks (to tick 24 = middle of bit 0)
-            // Subsequent bits: advance 16 ticks (to middle of next bit)
-            int advance = (bit == 0) ? 24 : 16;
-            for (int i = 0; i < advance; i++) tick();
-            if (dut->uart_tx) data |= (1 << bit);
-        }
+        // First sample 24 clocks in (middle of bit 0), then every 16
+        unsigned bit = bit_cycles();
+        std::vector<uint8_t> bits =
+            sample_bits([this] { return dut->uart_tx; }, 8, bit, bit + bit / 2);
 
         // Stop bit
-        for (int i = 0; i < 16; i++) tick();
+        run_cycles(bit);
 
-        return data;
+        return bits_to_byte(bits);
+    }
+};
+
+struct UartTopFixture : UartTopFixtureT<Vuart_top> {};
+
+// uart_top built with TX_FIFO_DEPTH = RX_FIFO_DEPTH = 256
+struct UartTopDeepFixture : UartTopFixtureT<Vuart_top_deep> {
+    static constexpr unsigned FIFO_DEPTH = 256;
+};
+
+// uart_top built with IDLE_GATING = 1
+struct UartTopGatedFixture : UartTopFixtureT<Vuart_top_gated> {
+    UartLineConfig line;   // Rate set by configure()
+
+    // Helper: Reset, then BAUD_DIV and CTRL (OSR from the oversample rate)
+    void configure(unsigned baud_div, unsigned oversample, uint32_t ctrl) {
+        dut->reg_wen = 0;
+        dut->reg_ren = 0;
+        dut->uart_rx = 1;
+        pulse_reset();
+        line.baud_div = baud_div;
+        line.oversample = oversample;
+        uint32_t osr = (oversample == 8) ? 1 : (oversample == 4) ? 2 : 0;
+        write_reg(ADDR_BAUD_DIV, baud_div);
+        write_reg(ADDR_CTRL, ctrl | (osr << uart_reg::CTRL_OSR_SHIFT));
+    }
+
+    // Helper: Cycles with the baud generator enabled over the next n cycles
+    unsigned baud_cycles(unsigned n) {
+        unsigned on = 0;
+        for (unsigned i = 0; i < n; i++) {
+            tick();
+            on += dut->baud_enable_out;
+        }
+        return on;
     }
 };
 
@@ -306,4 +406,565 @@ BOOST_FIXTURE_TEST_CASE(uart_top_rx_active, UartTopFixture) {
     BOOST_CHECK_EQUAL((status >> 5) & 1, 1);  // RX_ACTIVE
 }
 
+// Test 11: Idle fast-forward is cycle-exact, PERF counters included
+BOOST_FIXTURE_TEST_CASE(uart_top_idle_fast_forward, UartTopFixture) {
+    reset();
+    UartTopFixture ref;
+    ref.reset();
+
+    // Realistic divisor so the baud phase matters; RX only at first
+    auto configure = [](UartTopFixture& f) {
+        f.write_reg(ADDR_BAUD_DIV, 0x00000004);
+        f.write_reg(ADDR_CTRL, 0x00000002);
+    };
+    configure(*this);
+    configure(ref);
+
+    // Long idle gap: fast-forwarded here, fully simulated on ref
+    run_idle(10001);
+    ref.run_cycles(10001);
+    BOOST_CHECK_GT(skipped_cycles, 0u);
+    BOOST_CHECK_EQUAL(cycle_count, ref.cycle_count);
+
+    // TX_EN set: TX_STALLS counts every idle cycle, skipped ones included
+    write_reg(ADDR_CTRL, 0x00000003);
+    ref.write_reg(ADDR_CTRL, 0x00000003);
+    uint64_t skipped = skipped_cycles;
+    run_idle(5001);
+    ref.run_cycles(5001);
+    BOOST_CHECK_GT(skipped_cycles, skipped);
+    BOOST_CHECK_EQUAL(cycle_count, ref.cycle_count);
+
+    // Every counter matches the fully simulated reference
+    auto perf = [](UartTopFixture& f) {
+        std::vector<uint32_t> counts;
+        f.write_reg(ADDR_PERF_CTRL, uart_reg::PERF_SNAPSHOT);
+        for (unsigned sel = 0; sel < uart_reg::PERF_NUM; sel++) {
+            f.write_reg(ADDR_PERF_CTRL, sel);
+            counts.push_back(f.read_reg(ADDR_PERF_DATA));
+        }
+        return counts;
+    };
+    std::vector<uint32_t> counts = perf(*this);
+    std::vector<uint32_t> ref_counts = perf(ref);
+    BOOST_CHECK_EQUAL_COLLECTIONS(counts.begin(), counts.end(),
+                                  ref_counts.begin(), ref_counts.end());
+    BOOST_CHECK_GT(counts[uart_reg::PERF_TX_STALLS], 5000u);
+
+    // Start bit must leave on exactly the same cycle on both
+    auto start_tx = [](UartTopFixture& f) {
+        f.write_reg(ADDR_TX_DATA, 0x0000005A);
+        return f.run_until([&f] { return !f.dut->uart_tx; }, 1000);
+    };
+    BOOST_CHECK(start_tx(*this));
+    BOOST_CHECK(start_tx(ref));
+    BOOST_CHECK_EQUAL(cycle_count, ref.cycle_count);
+}
+
+// Test 12: RX high watermark interrupt (count includes holding buffer)
+BOOST_FIXTURE_TEST_CASE(uart_top_rx_high_watermark, UartTopFixture) {
+    reset();
+
+    write_reg(ADDR_FIFO_THRESH, 0x00040000);  // RX_HIGH_WM = 4
+    write_reg(ADDR_INT_ENABLE, 0x00000020);   // RX_HIGH_WM only
+    write_reg(ADDR_CTRL, 0x00000002);          // RX_EN
+    run_cycles(10);
+
+    // Three bytes: 2 in the holding buffer + 1 in FIFO, no interrupt yet
+    for (uint8_t byte : {0x01, 0x02, 0x03}) {
+        send_uart_frame(byte);
+    }
+    BOOST_CHECK_EQUAL(dut->irq, 0);
+
+    // Fourth byte reaches the watermark
+    send_uart_frame(0x04);
+    BOOST_CHECK_EQUAL(dut->irq, 1);
+    uint32_t int_status = read_reg(ADDR_INT_STATUS);
+    BOOST_CHECK_EQUAL((int_status >> 5) & 1, 1);
+
+    // Drain one byte, then W1C: count 3 < 4, interrupt clears
+    uint32_t data = read_rx_data();
+    BOOST_CHECK_EQUAL(data & 0xFF, 0x01);
+    write_reg(ADDR_INT_STATUS, 0x00000020);
+    run_cycles(4);
+    BOOST_CHECK_EQUAL(dut->irq, 0);
+}
+
+// Test 13: Deep FIFO fill, saturated level field, TX low watermark
+BOOST_FIXTURE_TEST_CASE(uart_top_deep_fifo_tx_watermark, UartTopDeepFixture) {
+    reset();
+
+    // Baud disabled (CTRL=0): first byte parks in uart_tx, rest fill FIFO
+    for (unsigned i = 0; i < FIFO_DEPTH + 8; i++) {
+        write_reg(ADDR_TX_DATA, i & 0xFF);
+    }
+    uint32_t status = read_reg(ADDR_STATUS);
+    BOOST_CHECK_EQUAL((status >> 1) & 1, 1);         // TX_FULL
+    BOOST_CHECK_EQUAL((status >> 8) & 0xFF, 0xFFu);  // 256 saturates at 255
+
+    // Interrupt once the FIFO drains to 16 entries
+    write_reg(ADDR_FIFO_THRESH, 0x00010010);  // TX_LOW_WM = 16
+    write_reg(ADDR_INT_ENABLE, 0x00000010);   // TX_LOW_WM only
+    write_reg(ADDR_INT_STATUS, 0x0000003F);
+    write_reg(ADDR_CTRL, 0x00000001);          // TX_EN
+
+    run_cycles(1000);
+    BOOST_CHECK_EQUAL(dut->irq, 0);
+
+    // 240 frames of ~162 clocks each
+    BOOST_CHECK(run_until([this] { return dut->irq; }, 250 * 170));
+    status = read_reg(ADDR_STATUS);
+    BOOST_CHECK_EQUAL((status >> 8) & 0xFF, 16u);
+}
+
+// Test 14: RX timeout flushes a short message stuck below the watermark
+BOOST_FIXTURE_TEST_CASE(uart_top_rx_timeout, UartTopFixture) {
+    reset();
+
+    write_reg(ADDR_FIFO_THRESH, 0x00080000);  // RX_HIGH_WM = 8
+    write_reg(ADDR_RX_TIMEOUT, 0x00000028);   // 40 bit times (4 characters)
+    write_reg(ADDR_INT_ENABLE, 0x00000060);   // RX_HIGH_WM + RX_TIMEOUT
+    write_reg(ADDR_CTRL, 0x00000002);          // RX_EN
+    run_cycles(10);
+
+    // Three bytes never reach the watermark
+    for (uint8_t byte : {0x41, 0x42, 0x43}) {
+        send_uart_frame(byte);
+    }
+    BOOST_CHECK_EQUAL(dut->irq, 0);
+
+    // 40 bits x 16 clocks of idle line
+    run_idle(40 * bit_cycles() - 100);
+    BOOST_CHECK_EQUAL(dut->irq, 0);
+    BOOST_CHECK(run_until([this] { return dut->irq; }, 200));
+    uint32_t int_status = read_reg(ADDR_INT_STATUS);
+    BOOST_CHECK_EQUAL((int_status >> 6) & 1, 1);
+    BOOST_CHECK_EQUAL((int_status >> 5) & 1, 0);
+
+    // Drain the batch; the source goes away and W1C sticks
+    for (uint8_t expected : {0x41, 0x42, 0x43}) {
+        BOOST_CHECK_EQUAL(read_rx_data() & 0xFF, expected);
+        run_cycles(1);
+    }
+    write_reg(ADDR_INT_STATUS, 0x00000040);
+    run_idle(40 * bit_cycles() + 100);
+    BOOST_CHECK_EQUAL(dut->irq, 0);
+}
+
+// Test 15: 8x and 4x oversampling - TX and RX frames end to end
+// 8x runs at BAUD_DIV=1 (2x the 16x line rate). 4x runs at BAUD_DIV=2:
+// with a tick every clock, the 3-cycle RX synchronizer latency would be
+// most of a 4-clock bit.
+BOOST_FIXTURE_TEST_CASE(uart_top_oversample_modes, UartTopFixture) {
+    struct Mode { uint32_t ctrl; uint32_t div; unsigned bit; };
+    for (Mode mode : {Mode{0x13, 1, 8}, Mode{0x23, 2, 8}, Mode{0x23, 1, 4}}) {
+        reset();
+        write_reg(ADDR_BAUD_DIV, mode.div);
+        write_reg(ADDR_CTRL, mode.ctrl);
+        BOOST_CHECK_EQUAL(bit_cycles(), mode.bit);
+        run_cycles(10);
+
+        // TX: start bit lasts one bit time, frame decodes
+        write_reg(ADDR_TX_DATA, 0x000000C5);
+        BOOST_CHECK(run_until([this] { return !dut->uart_tx; }, 100));
+        uint64_t start = cycle_count;
+        BOOST_CHECK(run_until([this] { return dut->uart_tx; }, 100));
+        BOOST_CHECK_EQUAL(cycle_count - start, mode.bit);
+        run_cycles(10 * mode.bit);
+
+        write_reg(ADDR_TX_DATA, 0x0000003A);
+        BOOST_CHECK_EQUAL(receive_uart_frame(), 0x3A);
+        run_cycles(2 * mode.bit);
+
+        // RX only where the sample point clears the synchronizer latency
+        if (mode.bit < 8) continue;
+        for (uint8_t byte : {0x5A, 0x81}) {
+            send_uart_frame(byte);
+            run_cycles(mode.bit);
+            BOOST_CHECK_EQUAL(read_rx_data() & 0xFF, byte);
+        }
+    }
+}
+
+// Test 16: RTS/CTS loopback - sustained traffic into a slow reader
+// uart_tx drives uart_rx and uart_rts_n drives uart_cts_n. The s_axis
+// source keeps the TX FIFO topped up; the m_axis sink takes one byte every
+// two frame times. Without flow control the RX FIFO overruns; with RTS_EN
+// + CTS_EN the transmitter is held off and every byte arrives in order.
+BOOST_FIXTURE_TEST_CASE(uart_top_flow_control_loopback, UartTopFixture) {
+    constexpr unsigned BYTES = 48;
+    constexpr unsigned READ_INTERVAL = 2 * 160;  // Two frames at BAUD_DIV=1
+
+    std::vector<uint8_t> expected;
+    for (unsigned i = 0; i < BYTES; i++) expected.push_back((uint8_t)(i * 37 + 1));
+
+    for (bool flow : {false, true}) {
+        reset();
+        write_reg(ADDR_FLOW_CTRL, 0x00000004);  // RTS drops at 4 of 8 entries
+        // TX_EN + RX_EN + STREAM_EN (+ RTS_EN + CTS_EN)
+        write_reg(ADDR_CTRL, flow ? 0x000000CB : 0x0000000B);
+
+        unsigned sent = 0;
+        std::vector<uint8_t> received;
+        bool rts_deasserted = false;
+        uint64_t limit = (uint64_t)BYTES * READ_INTERVAL + 4000;
+        for (uint64_t i = 0; i < limit && received.size() < BYTES; i++) {
+            dut->uart_rx = dut->uart_tx;
+            dut->uart_cts_n = dut->uart_rts_n;
+            dut->s_axis_tvalid = sent < BYTES;
+            dut->s_axis_tdata = sent < BYTES ? expected[sent] : 0;
+            dut->m_axis_tready = (i % READ_INTERVAL) == 0;
+            dut->eval();  // Handshakes are decided before the edge
+            if (dut->s_axis_tvalid && dut->s_axis_tready) sent++;
+            if (dut->m_axis_tvalid && dut->m_axis_tready) {
+                received.push_back(dut->m_axis_tdata);
+            }
+            if (dut->uart_rts_n) rts_deasserted = true;
+            tick();
+        }
+        dut->s_axis_tvalid = 0;
+        dut->m_axis_tready = 0;
+        dut->uart_rx = 1;
+        dut->uart_cts_n = 0;
+        BOOST_CHECK_EQUAL(sent, BYTES);
+
+        uint32_t status = read_reg(ADDR_STATUS);
+        if (!flow) {
+            // Control run: the reader cannot keep up, bytes are dropped
+            BOOST_CHECK_EQUAL((status >> 7) & 1, 1);  // OVERRUN
+            BOOST_CHECK_LT(received.size(), BYTES);
+            continue;
+        }
+
+        BOOST_CHECK(rts_deasserted);
+        BOOST_CHECK_EQUAL((status >> 7) & 1, 0);      // No overrun
+        BOOST_CHECK_EQUAL((status >> 6) & 1, 0);      // No frame error
+        BOOST_CHECK_EQUAL_COLLECTIONS(received.begin(), received.end(),
+                                      expected.begin(), expected.end());
+    }
+}
+
+// Test 17: Bulk full-duplex traffic through the line model
+// 200 frames each way at once: the RX waveform is encoded up front, the
+// TX line is captured every cycle and decoded afterwards.
+BOOST_FIXTURE_TEST_CASE(uart_top_bulk_line_model, UartTopDeepFixture) {
+    constexpr unsigned BYTES = 200;
+    reset();
+
+    std::vector<uint8_t> tx_bytes, rx_bytes;
+    for (unsigned i = 0; i < BYTES; i++) {
+        tx_bytes.push_back((uint8_t)(i * 29 + 7));
+        rx_bytes.push_back((uint8_t)(i * 53 + 3));
+    }
+
+    // Baud disabled while the TX FIFO fills
+    for (uint8_t byte : tx_bytes) write_reg(ADDR_TX_DATA, byte);
+    write_reg(ADDR_CTRL, 0x00000003);
+
+    UartLineConfig line{16, 1, 0};
+    LineWave rx_wave = uart_line_encode(rx_bytes, line);
+    rx_wave.append(1, 40 * line.bit_cycles());  // TX tail and last RX write
+    LineWave tx_wave = drive_capture([this](bool bit) { dut->uart_rx = bit; }, rx_wave,
+                                     [this] { return dut->uart_tx != 0; });
+
+    std::vector<UartLineFrame> frames = uart_line_decode_frames(tx_wave, line);
+    BOOST_REQUIRE_EQUAL(frames.size(), BYTES);
+    for (unsigned i = 0; i < BYTES; i++) {
+        BOOST_CHECK_EQUAL(frames[i].data, tx_bytes[i]);
+        BOOST_CHECK(!frames[i].frame_error);
+    }
+
+    uint32_t status = read_reg(ADDR_STATUS);
+    BOOST_CHECK_EQUAL((status >> 6) & 3, 0u);  // No frame error, no overrun
+    for (unsigned i = 0; i < BYTES; i++) {
+        BOOST_CHECK_EQUAL(read_rx_data() & 0xFF, rx_bytes[i]);
+    }
+}
+
+// Test 18: Internal loopback - no external line, pins ignored
+// uart_rx is held low and CTS deasserted: with LOOPBACK the RX path and
+// the CTS gate follow TX and RTS instead, and uart_tx and uart_rts_n stay
+// idle.
+BOOST_FIXTURE_TEST_CASE(uart_top_internal_loopback, UartTopFixture) {
+    reset();
+    write_reg(ADDR_CTRL, 0x000002C3);  // TX_EN + RX_EN + RTS/CTS_EN + LOOPBACK
+    dut->uart_rx = 0;
+    dut->uart_cts_n = 1;
+
+    std::vector<uint8_t> bytes = {0x00, 0xFF, 0xA5, 0x3C, 0x81};
+    for (uint8_t byte : bytes) write_reg(ADDR_TX_DATA, byte);
+
+    bool tx_pin_idle = true;
+    bool rts_pin_idle = true;  // Deasserted: the far end must not send
+    for (unsigned i = 0; i < (bytes.size() + 2) * 10 * bit_cycles(); i++) {
+        if (!dut->uart_tx) tx_pin_idle = false;
+        if (!dut->uart_rts_n) rts_pin_idle = false;
+        tick();
+    }
+    BOOST_CHECK(tx_pin_idle);
+    BOOST_CHECK(rts_pin_idle);
+
+    uint32_t status = read_reg(ADDR_STATUS);
+    BOOST_CHECK_EQUAL((status >> 6) & 3, 0u);  // No frame error, no overrun
+    for (uint8_t byte : bytes) {
+        BOOST_CHECK_EQUAL(read_rx_data() & 0xFF, byte);
+    }
+
+    // Back to the pins
+    dut->uart_rx = 1;
+    dut->uart_cts_n = 0;
+    write_reg(ADDR_CTRL, 0x00000003);
+    write_reg(ADDR_TX_DATA, 0x5A);
+    BOOST_CHECK_EQUAL(dut->uart_rts_n, 0);  // RTS_EN clear: asserted
+    BOOST_CHECK_EQUAL(receive_uart_frame(), 0x5A);
+}
+
+// Test 19: PRBS-15 self-test at line rate
+// In loopback the checker locks and counts no errors; on the pins the TX
+// line carries the sequence from the seed and one flipped bit on uart_rx
+// counts three errors (self-synchronizing checker).
+BOOST_FIXTURE_TEST_CASE(uart_top_prbs_self_test, UartTopFixture) {
+    auto read_perf = [this](uint32_t sel) {
+        write_reg(ADDR_PERF_CTRL, 0x00000100 | sel);  // SNAPSHOT
+        return read_reg(ADDR_PERF_DATA);
+    };
+
+    reset();
+    write_reg(ADDR_CTRL, 0x00000603);  // TX_EN + RX_EN + LOOPBACK + PRBS_EN
+    bool tx_pin_idle = true;
+    for (unsigned i = 0; i < 40 * 10 * bit_cycles(); i++) {
+        if (!dut->uart_tx) tx_pin_idle = false;
+        tick();
+    }
+    BOOST_CHECK(tx_pin_idle);
+    BOOST_CHECK_EQUAL((read_reg(ADDR_STATUS) >> 24) & 1, 1u);  // PRBS_LOCK
+    BOOST_CHECK_GE(read_perf(uart_reg::PERF_PRBS_BITS), 8u * 35);
+    BOOST_CHECK_EQUAL(read_perf(uart_reg::PERF_PRBS_ERRS), 0u);
+    BOOST_CHECK_EQUAL(read_perf(uart_reg::PERF_OVERRUNS), 0u);
+
+    // External line: 60 reference bytes in, one bit flipped in byte 20
+    constexpr unsigned BYTES = 60;
+    reset();
+    write_reg(ADDR_CTRL, 0x00000403);  // TX_EN + RX_EN + PRBS_EN
+
+    std::vector<uint8_t> reference;
+    uint16_t state = uart_reg::PRBS_SEED;
+    for (unsigned i = 0; i < BYTES; i++) reference.push_back(uart_reg::prbs15_byte(state));
+    std::vector<uint8_t> rx_bytes = reference;
+    rx_bytes[20] ^= 0x10;
+
+    UartLineConfig line{16, 1, 0};
+    LineWave rx_wave = uart_line_encode(rx_bytes, line);
+    rx_wave.append(1, 4 * 10 * line.bit_cycles());
+    LineWave tx_wave = drive_capture([this](bool bit) { dut->uart_rx = bit; }, rx_wave,
+                                     [this] { return dut->uart_tx != 0; });
+
+    std::vector<uint8_t> sent = uart_line_decode(tx_wave, line);
+    BOOST_REQUIRE_GE(sent.size(), BYTES);
+    BOOST_CHECK_EQUAL_COLLECTIONS(sent.begin(), sent.begin() + BYTES,
+                                  reference.begin(), reference.end());
+
+    BOOST_CHECK_EQUAL(read_perf(uart_reg::PERF_PRBS_BITS), 8u * (BYTES - 2));
+    BOOST_CHECK_EQUAL(read_perf(uart_reg::PERF_PRBS_ERRS), 3u);
+}
+
+// Test 20: Early TX accept - the start bit comes 2 cycles sooner and lasts
+// a full bit time whatever the baud phase at the write
+BOOST_FIXTURE_TEST_CASE(uart_top_tx_early_accept, UartTopFixture) {
+    reset();
+    write_reg(ADDR_BAUD_DIV, 4);
+
+    unsigned fifo_latency = 0;
+    for (uint32_t ctrl : {0x001u, 0x801u}) {  // TX_EN, TX_EN + TX_EARLY
+        bool early = ctrl & uart_reg::CTRL_TX_EARLY;
+        write_reg(ADDR_CTRL, ctrl);
+        for (unsigned phase = 0; phase < 4; phase++) {
+            for (unsigned i = 0; i < phase; i++) tick();
+            write_reg(ADDR_TX_DATA, 0xA5);  // Bit 0 high: start bit ends on an edge
+
+            unsigned latency = 0, start_len = 0;
+            for (; dut->uart_tx && latency < 100; latency++) tick();
+            for (; !dut->uart_tx && start_len < 100; start_len++) tick();
+            BOOST_TEST_MESSAGE("TX_EARLY=" << early << " phase " << phase << ": latency "
+                               << latency << ", start bit " << start_len << " cycles");
+
+            if (!early) {
+                if (phase == 0) fifo_latency = latency;
+                BOOST_CHECK_EQUAL(latency, fifo_latency);
+                BOOST_CHECK_LE(start_len, bit_cycles());
+                BOOST_CHECK_GT(start_len, bit_cycles() - baud_divisor);
+            } else {
+                BOOST_CHECK_EQUAL(latency + 2, fifo_latency);
+                BOOST_CHECK_EQUAL(start_len, bit_cycles());
+            }
+            run_idle(10 * bit_cycles());
+        }
+    }
+}
+
+// Test 21: Autobaud - a 0x55 at the host's rate loads BAUD_DIV/BAUD_FRAC
+// and raises INT_STATUS.AUTOBAUD at its stop bit; the sync character is
+// not received and the next byte is, at the new rate
+BOOST_FIXTURE_TEST_CASE(uart_top_autobaud_sweep, UartTopFixture) {
+    // One frame, bit time bit_x64 / 64 cycles, then 3 idle bit times
+    auto frame_wave = [](uint8_t data, uint64_t bit_x64, size_t idle) {
+        LineWave wave;
+        wave.append(1, idle);
+        std::vector<uint8_t> bits = uart_frame_bits(data);
+        for (size_t i = 0; i < bits.size(); i++) {
+            wave.append(bits[i], (i + 1) * bit_x64 / 64 - i * bit_x64 / 64);
+        }
+        wave.append(1, 3 * bit_x64 / 64);
+        return wave;
+    };
+
+    // BAUD_DIV × 64 + BAUD_FRAC at 16x
+    for (uint32_t rate_x64 : {64u, 128u, 192u, 256u, 384u, 512u, 2u * 64 + 32, 3u * 64 + 12}) {
+        reset();   // BAUD_DIV 1
+        write_reg(ADDR_INT_ENABLE, uart_reg::INT_AUTOBAUD);
+        write_reg(ADDR_CTRL, uart_reg::CTRL_TX_EN | uart_reg::CTRL_RX_EN | uart_reg::CTRL_AUTOBAUD);
+        run_cycles(4);
+        BOOST_CHECK_EQUAL(dut->irq, 0);
+
+        const uint64_t bit_x64 = 16ull * rate_x64;
+        const double bit = bit_x64 / 64.0;
+        const size_t idle = 3 * bit_x64 / 64;
+        LineWave irq = drive_capture([this](bool level) { dut->uart_rx = level; },
+                                     frame_wave(0x55, bit_x64, idle),
+                                     [this] { return dut->irq != 0; });
+        size_t locked = irq.find_level(0, 1);
+        BOOST_REQUIRE_NE(locked, LineWave::npos);
+
+        // At the stop bit, after the synchronizer
+        double periods = (locked - idle) / bit;
+        BOOST_TEST_MESSAGE("rate " << rate_x64 / 64.0 << ": locked after " << periods
+                           << " bit periods");
+        BOOST_CHECK_GE(periods, 9.0);
+        BOOST_CHECK_LT(periods, 9.5);
+
+        BOOST_CHECK_EQUAL(read_reg(ADDR_BAUD_DIV) & 0xFFFF, rate_x64 / 64);
+        BOOST_CHECK_EQUAL(read_reg(uart_reg::BAUD_FRAC) & 0x3F, rate_x64 % 64);
+        BOOST_CHECK_EQUAL(read_reg(ADDR_CTRL) & uart_reg::CTRL_AUTOBAUD, 0u);
+        BOOST_CHECK_EQUAL(read_reg(ADDR_INT_STATUS) & uart_reg::INT_AUTOBAUD,
+                          uart_reg::INT_AUTOBAUD);
+        BOOST_CHECK_EQUAL((read_reg(ADDR_STATUS) >> 2) & 1, 1u);  // RX_EMPTY: 0x55 not received
+        write_reg(ADDR_INT_STATUS, uart_reg::INT_AUTOBAUD);
+        BOOST_CHECK_EQUAL(dut->irq, 0);
+
+        // Traffic at the detected rate
+        drive_wave([this](bool level) { dut->uart_rx = level; }, frame_wave(0xA7, bit_x64, idle));
+        BOOST_CHECK_EQUAL((read_reg(ADDR_STATUS) >> 2) & 1, 0u);
+        BOOST_CHECK_EQUAL(read_rx_data() & 0xFF, 0xA7u);
+    }
+}
+
+// Test 22: Idle gating - no baud tick on an idle line; a start edge after
+// a long idle wakes the generator and the frames are received, and a TX
+// write runs it for the frame only
+BOOST_FIXTURE_TEST_CASE(uart_top_gated_wake_on_rx_edge, UartTopGatedFixture) {
+    for (unsigned oversample : {16u, 8u}) {
+        for (unsigned div : {1u, 3u, 7u}) {
+            configure(div, oversample, uart_reg::CTRL_TX_EN | uart_reg::CTRL_RX_EN);
+            const unsigned bit = line.bit_cycles();
+            BOOST_CHECK_EQUAL(baud_cycles(50 * bit), 0u);
+
+            // Two frames after the long idle, any phase: received at once
+            const std::vector<uint8_t> bytes = {0xA5, 0x3C};
+            UartLineConfig gap = line;
+            gap.idle_bits = 1;
+            LineWave rx = uart_line_encode(bytes, gap);
+            rx.append(1, 3 + div);
+            LineWave on = drive_capture([this](bool level) { dut->uart_rx = level; }, rx,
+                                        [this] { return dut->baud_enable_out != 0; });
+            BOOST_CHECK_LE(on.find_level(0, 1), 3u);   // Through the synchronizer
+            BOOST_CHECK_EQUAL(dut->baud_enable_out, 0);
+            BOOST_CHECK_EQUAL(read_rx_data() & 0xFF, 0xA5u);
+            BOOST_CHECK_EQUAL(read_rx_data() & 0xFF, 0x3Cu);
+
+            // TX: running for the frame, stopped again after it
+            write_reg(ADDR_TX_DATA, 0x96);
+            LineWave tx = capture_wave([this] { return dut->uart_tx != 0; }, 12 * bit);
+            BOOST_CHECK(uart_line_decode(tx, line) == std::vector<uint8_t>({0x96}));
+            BOOST_CHECK_EQUAL(baud_cycles(bit), 0u);
+        }
+    }
+}
+
+// Test 23: Idle gating - the RX idle timer keeps the tick running until
+// RX_TIMEOUT fires; with RX_EN clear the RX line is isolated, so traffic
+// does not wake the generator for an idle transmitter
+BOOST_FIXTURE_TEST_CASE(uart_top_gated_timeout_and_isolation, UartTopGatedFixture) {
+    configure(2, 16, uart_reg::CTRL_TX_EN | uart_reg::CTRL_RX_EN);
+    const unsigned bit = line.bit_cycles();
+    write_reg(ADDR_RX_TIMEOUT, 4);
+
+    drive_wave([this](bool level) { dut->uart_rx = level; }, uart_line_encode({0x5A}, line));
+    run_cycles(3 * bit);
+    BOOST_CHECK_EQUAL(dut->baud_enable_out, 1);   // Timer counting
+    BOOST_CHECK_EQUAL(read_reg(ADDR_INT_STATUS) & uart_reg::INT_RX_TIMEOUT, 0u);
+    run_cycles(3 * bit);
+    BOOST_CHECK_EQUAL(read_reg(ADDR_INT_STATUS) & uart_reg::INT_RX_TIMEOUT,
+                      uart_reg::INT_RX_TIMEOUT);
+    BOOST_CHECK_EQUAL(baud_cycles(bit), 0u);      // Limit reached: stopped
+    BOOST_CHECK_EQUAL(read_rx_data() & 0xFF, 0x5Au);
+
+    // TX only: traffic on the RX pin is not seen
+    configure(2, 16, uart_reg::CTRL_TX_EN);
+    LineWave noise = uart_line_encode({0x00, 0xF0, 0x55}, line);
+    LineWave on = drive_capture([this](bool level) { dut->uart_rx = level; }, noise,
+                                [this] { return dut->baud_enable_out != 0; });
+    BOOST_CHECK_EQUAL(on.find_level(0, 1), LineWave::npos);
+
+    // RX enabled afterwards: only the next frame is received
+    write_reg(ADDR_CTRL, uart_reg::CTRL_TX_EN | uart_reg::CTRL_RX_EN);
+    drive_wave([this](bool level) { dut->uart_rx = level; }, uart_line_encode({0xC3}, line));
+    run_cycles(bit);
+    BOOST_CHECK_EQUAL(read_rx_data() & 0xFF, 0xC3u);
+    BOOST_CHECK_EQUAL(read_reg(ADDR_STATUS) & uart_reg::STATUS_RX_EMPTY,
+                      uart_reg::STATUS_RX_EMPTY);
+}
+
+// Test 24: Idle fast-forward holds off while the RX timeout is pending and
+// resumes once the bytes are read; the interrupt fires on the same cycle
+// as on a fully simulated reference
+BOOST_FIXTURE_TEST_CASE(uart_top_idle_fast_forward_rx_timeout, UartTopFixture) {
+    reset();
+    UartTopFixture ref;
+    ref.reset();
+
+    auto configure = [](UartTopFixture& f) {
+        f.write_reg(ADDR_BAUD_DIV, 0x00000004);
+        f.write_reg(ADDR_RX_TIMEOUT, 0x00000028);   // 40 bit times
+        f.write_reg(ADDR_INT_ENABLE, 0x00000040);   // RX_TIMEOUT
+        f.write_reg(ADDR_CTRL, 0x00000002);          // RX_EN
+        f.send_uart_frame(0x3C);
+    };
+    configure(*this);
+    configure(ref);
+    BOOST_REQUIRE_EQUAL(cycle_count, ref.cycle_count);
+
+    // Byte waiting: the idle timer runs, nothing may be skipped
+    run_idle(20 * bit_cycles());
+    ref.run_cycles(20 * bit_cycles());
+    BOOST_CHECK_EQUAL(skipped_cycles, 0u);
+    BOOST_CHECK_EQUAL(dut->irq, 0);
+    BOOST_CHECK(run_until([this] { return dut->irq; }, 40 * bit_cycles()));
+    BOOST_CHECK(ref.run_until([&ref] { return ref.dut->irq; }, 40 * bit_cycles()));
+    BOOST_CHECK_EQUAL(cycle_count, ref.cycle_count);
+
+    // Read and acknowledged: the timer is idle again and cycles are skipped
+    auto drain = [](UartTopFixture& f) {
+        BOOST_CHECK_EQUAL(f.read_rx_data() & 0xFF, 0x3Cu);
+        f.write_reg(ADDR_INT_STATUS, 0x00000040);
+    };
+    drain(*this);
+    drain(ref);
+    run_idle(10001);
+    ref.run_cycles(10001);
+    BOOST_CHECK_GT(skipped_cycles, 0u);
+    BOOST_CHECK_EQUAL(cycle_count, ref.cycle_count);
+    BOOST_CHECK_EQUAL(dut->irq, ref.dut->irq);
+    BOOST_CHECK_EQUAL(read_reg(ADDR_INT_STATUS), ref.read_reg(ADDR_INT_STATUS));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -10,52 +10,51 @@
  * - Multiple byte transmission
  * - Back-to-back writes
  * - Serial output validation
+ * - 8x / 4x oversampling (osr_sel)
+ * - CTS flow control (tx_cts holds the FIFO, no byte lost)
+ * - Early accept: measured write-to-start-bit latency (3 cycles through
+ *   the FIFO, 1 bypassed), bytes written while busy still queue in order
  */
 
 #include "Vuart_tx_path.h"
 #include <boost/test/unit_test.hpp>
 #include <verilated.h>
+#include "dut_driver.h"
 #include <vector>
 #include <queue>
 
+DUT_DRIVER_PORTS(Vuart_tx_path, uart_clk, rst_n);
+
 BOOST_AUTO_TEST_SUITE(UartTXPath_ModuleTests)
 
-struct UartTXPathFixture {
-    Vuart_tx_path* dut;
-    int cycle_count;
+struct UartTXPathFixture : DutDriver<Vuart_tx_path> {
+    int osr;  // baud_ticks per bit (osr_sel)
 
     UartTXPathFixture() {
-        dut = new Vuart_tx_path;
-        cycle_count = 0;
+        osr = 16;
 
         // Initialize inputs
-        dut->uart_clk = 0;
-        dut->rst_n = 0;
         dut->baud_tick = 0;
+        dut->osr_sel = 0;
+        dut->tx_cts = 1;  // Clear to send
+        dut->early_accept = 0;
         dut->wr_data = 0;
         dut->wr_en = 0;
     }
 
-    ~UartTXPathFixture() {
-        delete dut;
-    }
-
-    void tick() {
-        dut->uart_clk = 0;
-        dut->eval();
-        dut->uart_clk = 1;
-        dut->eval();
-        cycle_count++;
-    }
-
     void reset() {
-        dut->rst_n = 0;
         dut->wr_en = 0;
         dut->baud_tick = 0;
-        for (int i = 0; i < 5; i++) tick();
-        dut->rst_n = 1;
-        tick();
-        cycle_count = 0;
+        dut->tx_cts = 1;
+        dut->early_accept = 0;
+        set_oversample(16);
+        pulse_reset();
+    }
+
+    // Helper: Select 16x, 8x or 4x oversampling (osr_sel 00 / 01 / 10)
+    void set_oversample(int rate) {
+        osr = rate;
+        dut->osr_sel = (rate == 8) ? 1 : (rate == 4) ? 2 : 0;
     }
 
     // Helper: Generate baud tick pulse
@@ -76,8 +75,8 @@ struct UartTXPathFixture {
     // Helper: Collect serial frame (10 bits)
     std::vector<int> collect_frame() {
         std::vector<int> bits;
-        for (int i = 0; i < 10 * 16; i++) {
-            if (i % 16 == 8) {  // Sample in middle of bit
+        for (int i = 0; i < 10 * osr; i++) {
+            if (i % osr == osr / 2) {  // Sample in middle of bit
                 bits.push_back(dut->tx_serial);
             }
             tick_with_baud();
@@ -252,7 +251,7 @@ BOOST_FIXTURE_TEST_CASE(uart_tx_path_write_during_tx, UartTXPathFixture) {
     BOOST_CHECK_EQUAL(dut->tx_level, 1);  // One in FIFO (first being transmitted)
 
     // Finish first frame
-    for (int i = 0; i < 160; i++) tick_with_baud();
+    for (int i = 0; i < 10 * osr; i++) tick_with_baud();
 
     // Second byte should start automatically
     BOOST_CHECK_EQUAL(dut->tx_active, 1);
@@ -340,4 +339,90 @@ BOOST_FIXTURE_TEST_CASE(uart_tx_path_fill_and_drain, UartTXPathFixture) {
     BOOST_CHECK_EQUAL(dut->tx_level, 0);
 }
 
+// Test 13: FIFO drains at 8x and 4x oversampling (10 x rate ticks per frame)
+BOOST_FIXTURE_TEST_CASE(uart_tx_path_oversample_modes, UartTXPathFixture) {
+    for (int rate : {8, 4}) {
+        reset();
+        set_oversample(rate);
+
+        std::vector<uint8_t> tx_data = {0x5A, 0xC3, 0x01};
+        for (uint8_t byte : tx_data) write_fifo(byte);
+
+        for (uint8_t expected : tx_data) {
+            while (!dut->tx_active) tick_with_baud();
+            std::vector<int> bits = collect_frame();
+            BOOST_CHECK_EQUAL(bits[0], 0);
+            BOOST_CHECK_EQUAL(extract_data(bits), expected);
+            BOOST_CHECK_EQUAL(bits[9], 1);
+        }
+
+        for (int i = 0; i < 4; i++) tick_with_baud();
+        BOOST_CHECK_EQUAL(dut->tx_empty, 1);
+        BOOST_CHECK_EQUAL(dut->tx_active, 0);
+    }
+}
+
+// Test 14: CTS low holds the queue - a byte already fetched from the FIFO
+// when CTS drops is kept and sent first once CTS returns
+BOOST_FIXTURE_TEST_CASE(uart_tx_path_cts_hold, UartTXPathFixture) {
+    reset();
+
+    write_fifo(0x11);
+    tick();              // 0x11 fetched into the FIFO output register
+    dut->tx_cts = 0;     // CTS drops before uart_tx takes it
+    write_fifo(0x22);
+    write_fifo(0x33);
+
+    for (int i = 0; i < 10 * osr; i++) {
+        tick_with_baud();
+        BOOST_CHECK_EQUAL(dut->tx_active, 0);
+        BOOST_CHECK_EQUAL(dut->tx_serial, 1);
+    }
+    BOOST_CHECK_EQUAL(dut->tx_level, 2);  // Queue intact, nothing dropped
+
+    dut->tx_cts = 1;
+    for (uint8_t expected : {0x11, 0x22, 0x33}) {
+        while (!dut->tx_active) tick_with_baud();
+        std::vector<int> bits = collect_frame();
+        BOOST_CHECK_EQUAL(extract_data(bits), expected);
+    }
+    BOOST_CHECK_EQUAL(dut->tx_empty, 1);
+}
+
+
+// Test 15: Early accept - a write to an idle path skips the FIFO round trip
+BOOST_FIXTURE_TEST_CASE(uart_tx_path_early_accept_latency, UartTXPathFixture) {
+    // Cycles from the write edge to the start bit on tx_serial
+    for (int early : {0, 1}) {
+        reset();
+        dut->early_accept = early;
+        write_fifo(0x5A);
+        BOOST_CHECK_EQUAL(dut->tx_empty, early ? 1 : 0);  // Bypassed: never queued
+        BOOST_CHECK_EQUAL(dut->tx_level, early ? 0 : 1);
+
+        int latency = 0;
+        while (dut->tx_serial && latency < 10) {
+            tick();
+            latency++;
+        }
+        BOOST_TEST_MESSAGE("early_accept=" << early << ": write to start bit "
+                           << latency << " cycles");
+        BOOST_CHECK_EQUAL(latency, early ? 1 : 3);
+        BOOST_CHECK_EQUAL(dut->tx_active, 1);
+    }
+
+    // A write while busy queues behind the bypassed byte
+    write_fifo(0xC3);
+    BOOST_CHECK_EQUAL(dut->tx_level, 1);
+    std::vector<int> bits = collect_frame();
+    BOOST_CHECK_EQUAL(bits[0], 0);
+    BOOST_CHECK_EQUAL(extract_data(bits), 0x5A);
+    BOOST_CHECK_EQUAL(bits[9], 1);
+
+    while (!dut->tx_active) tick_with_baud();
+    bits = collect_frame();
+    BOOST_CHECK_EQUAL(extract_data(bits), 0xC3);
+    BOOST_CHECK_EQUAL(dut->tx_empty, 1);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
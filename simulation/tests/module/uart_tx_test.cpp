@@ -8,60 +8,54 @@
  * - Ready/valid handshake
  * - Frame format (start bit, 8 data bits LSB first, stop bit)
  * - Idle state (tx_serial high)
- * - Bit timing (16 baud_ticks per bit)
+ * - Bit timing (16 baud_ticks per bit; 8 and 4 with osr_sel)
  * - Back-to-back transmissions
  * - tx_active flag
  * - Various data patterns
+ * - CTS gating of frame starts (tx_cts)
  */
 
 #include "Vuart_tx.h"
 #include <boost/test/unit_test.hpp>
 #include <verilated.h>
+#include "dut_driver.h"
 #include <vector>
 
+DUT_DRIVER_PORTS(Vuart_tx, uart_clk, rst_n);
+
 BOOST_AUTO_TEST_SUITE(UartTX_ModuleTests)
 
-struct UartTXFixture {
-    Vuart_tx* dut;
-    int cycle_count;
+struct UartTXFixture : DutDriver<Vuart_tx> {
     int baud_tick_count;
+    int osr;  // baud_ticks per bit (osr_sel)
 
     UartTXFixture() {
-        dut = new Vuart_tx;
-        cycle_count = 0;
         baud_tick_count = 0;
+        osr = 16;
 
         // Initialize inputs
-        dut->uart_clk = 0;
-        dut->rst_n = 0;
         dut->baud_tick = 0;
+        dut->osr_sel = 0;
+        dut->tx_cts = 1;  // Clear to send
         dut->tx_data = 0;
         dut->tx_valid = 0;
     }
 
-    ~UartTXFixture() {
-        delete dut;
-    }
-
-    void tick() {
-        dut->uart_clk = 0;
-        dut->eval();
-        dut->uart_clk = 1;
-        dut->eval();
-        cycle_count++;
-    }
-
     void reset() {
-        dut->rst_n = 0;
         dut->tx_valid = 0;
         dut->baud_tick = 0;
-        for (int i = 0; i < 5; i++) tick();
-        dut->rst_n = 1;
-        tick();
-        cycle_count = 0;
+        dut->tx_cts = 1;
+        set_oversample(16);
+        pulse_reset();
         baud_tick_count = 0;
     }
 
+    // Helper: Select 16x, 8x or 4x oversampling (osr_sel 00 / 01 / 10)
+    void set_oversample(int rate) {
+        osr = rate;
+        dut->osr_sel = (rate == 8) ? 1 : (rate == 4) ? 2 : 0;
+    }
+
     // Helper: Generate baud tick (pulses for 1 cycle every 16 cycles for testing)
     void tick_with_baud() {
         // Simple pattern: baud_tick high every cycle for this test
@@ -75,9 +69,9 @@ struct UartTXFixture {
     // Helper: Collect serial bits over a frame (10 bits: start + 8 data + stop)
     std::vector<int> collect_frame() {
         std::vector<int> bits;
-        for (int i = 0; i < 10 * 16; i++) {
+        for (int i = 0; i < 10 * osr; i++) {
             // Sample in middle of each bit period (at tick 8 of 16)
-            if (i % 16 == 8) {
+            if (i % osr == osr / 2) {
                 bits.push_back(dut->tx_serial);
             }
             tick_with_baud();
@@ -153,7 +147,7 @@ BOOST_FIXTURE_TEST_CASE(uart_tx_start_bit, UartTXFixture) {
     BOOST_CHECK_EQUAL(dut->tx_active, 1);
 
     // Start bit lasts 16 baud_ticks
-    for (int i = 1; i < 16; i++) {
+    for (int i = 1; i < osr; i++) {
         tick_with_baud();
         BOOST_CHECK_EQUAL(dut->tx_serial, 0);
     }
@@ -167,7 +161,7 @@ BOOST_FIXTURE_TEST_CASE(uart_tx_data_bits_lsb_first, UartTXFixture) {
     start_transmission(0xAA);
 
     // Skip start bit (16 ticks)
-    for (int i = 0; i < 16; i++) {
+    for (int i = 0; i < osr; i++) {
         tick_with_baud();
     }
 
@@ -175,9 +169,9 @@ BOOST_FIXTURE_TEST_CASE(uart_tx_data_bits_lsb_first, UartTXFixture) {
     std::vector<int> expected = {0, 1, 0, 1, 0, 1, 0, 1};
     for (int bit : expected) {
         // Sample in middle of bit period
-        for (int i = 0; i < 8; i++) tick_with_baud();
+        for (int i = 0; i < osr / 2; i++) tick_with_baud();
         BOOST_CHECK_EQUAL(dut->tx_serial, bit);
-        for (int i = 8; i < 16; i++) tick_with_baud();
+        for (int i = osr / 2; i < osr; i++) tick_with_baud();
     }
 }
 
@@ -188,12 +182,12 @@ BOOST_FIXTURE_TEST_CASE(uart_tx_stop_bit, UartTXFixture) {
     start_transmission(0x55);
 
     // Skip start bit + 8 data bits (9 * 16 = 144 ticks)
-    for (int i = 0; i < 9 * 16; i++) {
+    for (int i = 0; i < 9 * osr; i++) {
         tick_with_baud();
     }
 
     // Now in STOP state, stop bit should be 1 for 16 ticks
-    for (int i = 0; i < 16; i++) {
+    for (int i = 0; i < osr; i++) {
         tick_with_baud();
         BOOST_CHECK_EQUAL(dut->tx_serial, 1);
     }
@@ -239,7 +233,7 @@ BOOST_FIXTURE_TEST_CASE(uart_tx_active_flag, UartTXFixture) {
     BOOST_CHECK_EQUAL(dut->tx_active, 1);
 
     // Stay active during entire frame (160 baud_ticks)
-    for (int i = 0; i < 159; i++) {
+    for (int i = 0; i < 10 * osr - 1; i++) {
         tick_with_baud();
         BOOST_CHECK_EQUAL(dut->tx_active, 1);
     }
@@ -324,7 +318,7 @@ BOOST_FIXTURE_TEST_CASE(uart_tx_valid_held_high, UartTXFixture) {
     BOOST_CHECK_EQUAL(dut->tx_active, 1);
 
     // Even though valid stays high, no new transaction
-    for (int i = 0; i < 160; i++) {
+    for (int i = 0; i < 10 * osr; i++) {
         tick_with_baud();
     }
 
@@ -340,9 +334,9 @@ BOOST_FIXTURE_TEST_CASE(uart_tx_ready_during_transmission, UartTXFixture) {
     start_transmission(0x99);
 
     // tx_ready should be 0 throughout transmission
-    for (int i = 0; i < 160; i++) {
+    for (int i = 0; i < 10 * osr; i++) {
         tick_with_baud();
-        if (i < 159) {  // Not yet complete
+        if (i < 10 * osr - 1) {  // Not yet complete
             BOOST_CHECK_EQUAL(dut->tx_ready, 0);
         }
     }
@@ -376,4 +370,77 @@ BOOST_FIXTURE_TEST_CASE(uart_tx_multiple_patterns, UartTXFixture) {
     }
 }
 
+// Test 15: 8x and 4x oversampling - bit period and frame length follow osr_sel
+BOOST_FIXTURE_TEST_CASE(uart_tx_oversample_modes, UartTXFixture) {
+    for (int rate : {8, 4}) {
+        reset();
+        set_oversample(rate);
+
+        start_transmission(0xA5);
+        std::vector<int> bits = collect_frame();
+
+        BOOST_CHECK_EQUAL(bits.size(), 10);
+        BOOST_CHECK_EQUAL(bits[0], 0);  // Start bit
+        for (int i = 0; i < 8; i++) {
+            BOOST_CHECK_EQUAL(bits[i + 1], (0xA5 >> i) & 1);
+        }
+        BOOST_CHECK_EQUAL(bits[9], 1);  // Stop bit
+
+        // Frame is exactly 10 x rate ticks: ready again, line idle
+        BOOST_CHECK_EQUAL(dut->tx_ready, 1);
+        BOOST_CHECK_EQUAL(dut->tx_active, 0);
+
+        // Start bit of the next frame lasts exactly rate ticks
+        start_transmission(0xFF);
+        int low_ticks = 0;
+        for (int i = 0; i < 2 * rate; i++) {
+            tick_with_baud();
+            if (!dut->tx_serial) low_ticks++;
+        }
+        BOOST_CHECK_EQUAL(low_ticks, rate);
+    }
+}
+
+// Test 16: CTS gating - no start while tx_cts is low, frame in flight completes
+BOOST_FIXTURE_TEST_CASE(uart_tx_cts_gating, UartTXFixture) {
+    reset();
+
+    // Not clear to send: byte offered but never accepted
+    dut->tx_cts = 0;
+    dut->tx_data = 0x3C;
+    dut->tx_valid = 1;
+    for (int i = 0; i < 40; i++) {
+        tick_with_baud();
+        BOOST_CHECK_EQUAL(dut->tx_ready, 0);
+        BOOST_CHECK_EQUAL(dut->tx_active, 0);
+        BOOST_CHECK_EQUAL(dut->tx_serial, 1);
+    }
+
+    // CTS asserts: accepted on the next edge
+    dut->tx_cts = 1;
+    dut->eval();
+    BOOST_CHECK_EQUAL(dut->tx_ready, 1);
+    tick_with_baud();
+    dut->tx_valid = 0;
+    BOOST_CHECK_EQUAL(dut->tx_active, 1);
+
+    // CTS drops mid-frame: the frame still goes out intact
+    for (int i = 0; i < 3 * osr; i++) tick_with_baud();
+    dut->tx_cts = 0;
+    std::vector<int> bits;
+    for (int i = 3 * osr; i < 10 * osr; i++) {
+        if (i % osr == osr / 2) bits.push_back(dut->tx_serial);
+        tick_with_baud();
+    }
+    BOOST_CHECK_EQUAL(bits.size(), 7);
+    for (int i = 0; i < 6; i++) {
+        BOOST_CHECK_EQUAL(bits[i], (0x3C >> (i + 2)) & 1);
+    }
+    BOOST_CHECK_EQUAL(bits[6], 1);  // Stop bit
+
+    // Back in IDLE, held off again
+    BOOST_CHECK_EQUAL(dut->tx_active, 0);
+    BOOST_CHECK_EQUAL(dut->tx_ready, 0);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
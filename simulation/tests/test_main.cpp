@@ -2,23 +2,83 @@
  * Boost.Test Main Entry Point
  *
  * This file provides the main() function for all test suites.
+ *
+ * Waveform tracing is off by default. UART_TRACE* environment variables
+ * or --trace* arguments after "--" turn it on for selected test cases
+ * (see common/trace_control.h); the observer below tells the trace
+ * session which case is running and whether it has failed.
+ *
+ * Coverage is collected only when UART_COVERAGE_DIR or --coverage-dir=
+ * is given (see common/coverage_collect.h); the process writes one shard
+ * to that directory at exit.
  */
 
 #define BOOST_TEST_MODULE uart_tests
 #include <boost/test/unit_test.hpp>
 #include <verilated.h>
+#include <cstdio>
+#include <string>
+#include "trace_control.h"
+#include "coverage_collect.h"
+
+// Feeds test case start/failure/finish to the trace session
+struct TraceObserver : boost::unit_test::test_observer {
+    void test_unit_start(boost::unit_test::test_unit const& tu) override {
+        if (tu.p_type == boost::unit_test::TUT_CASE) {
+            TraceSession::instance().begin_test(tu.p_name);
+        }
+    }
+
+    void test_unit_finish(boost::unit_test::test_unit const& tu, unsigned long) override {
+        if (tu.p_type == boost::unit_test::TUT_CASE) {
+            TraceSession::instance().end_test();
+        }
+    }
+
+    void assertion_result(boost::unit_test::assertion_result ar) override {
+        if (ar == boost::unit_test::AR_FAILED) TraceSession::instance().fail();
+    }
+
+    void exception_caught(boost::execution_exception const&) override {
+        TraceSession::instance().fail();
+    }
+};
 
 // Global setup/teardown
 struct GlobalFixture {
+    TraceObserver trace_observer;
+
     GlobalFixture() {
         // Initialize Verilator
         Verilated::debug(0);
         Verilated::randReset(2);
-        Verilated::traceEverOn(true);
+
+        // Trace and coverage options: environment first, command line overrides
+        TraceConfig& config = TraceSession::instance().config;
+        CoverageCollector& coverage = CoverageCollector::instance();
+        config.from_env();
+        coverage.from_env();
+        auto& suite = boost::unit_test::framework::master_test_suite();
+        for (int i = 1; i < suite.argc; i++) {
+            if (!config.parse_arg(suite.argv[i]) && !coverage.parse_arg(suite.argv[i])) {
+                std::fprintf(stderr, "ignoring argument: %s\n", suite.argv[i]);
+            }
+        }
+
+        if (config.enabled()) {
+            Verilated::traceEverOn(true);
+            Verilated::mkdir(config.dir.c_str());
+            boost::unit_test::framework::register_observer(trace_observer);
+        }
+        if (coverage.enabled()) Verilated::mkdir(coverage.dir.c_str());
     }
 
     ~GlobalFixture() {
         // Cleanup Verilator
+        if (TraceSession::instance().config.enabled()) {
+            boost::unit_test::framework::deregister_observer(trace_observer);
+        }
+        CoverageCollector::instance().write_shard("module_tests");
     }
 };
 